@@ -62,6 +62,8 @@ namespace MiniEngine
         float delta_time;
         while (true)
         {
+            // input is sampled here, after the frame limiter and the wait for the frame in flight
+            mEngineRuntime->BeginFrame();
             delta_time = mEngineRuntime->CalculateDeltaTime();
             gEditorGlobalContext.mSceneManager->Tick(delta_time);
             gEditorGlobalContext.mInputManager->Tick(delta_time);
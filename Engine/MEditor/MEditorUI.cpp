@@ -29,6 +29,8 @@
 #include <imgui_internal.h>
 #include <stb_image.h>
 
+#include <algorithm>
+
 namespace MiniEngine
 {
     std::vector<std::pair<std::string, bool>> gEditorNodeStateArray;
@@ -321,6 +323,16 @@ namespace MiniEngine
 
         // initialize imgui vulkan render backend
         init_info.mRenderSystem->InitializeUIRenderBackend(this);
+
+        gRuntimeGlobalContext.mAssetManager->AddFileChangeCallback([this](const std::vector<FileChange>& changes) {
+            for (const FileChange& change : changes)
+            {
+                if (change.mType != FileChangeType::Modified)
+                {
+                    mbFileTreeDirty = true;
+                }
+            }
+        });
     }
 
 
@@ -519,6 +531,7 @@ namespace MiniEngine
         showEditorGameWindow(&mbGameEngineWindowOpen);
         showEditorFileContentWindow(&mbFileContentWindowOpen);
         showEditorDetailWindow(&mbDetailWindowOpen);
+        showEditorProfilerWindow(&mbProfilerWindowOpen);
     }
 
     void MEditorUI::showEditorMenu(bool *pOpen)
@@ -564,6 +577,7 @@ namespace MiniEngine
             ImGui::DockBuilderDockWindow("Components Details", right);
             ImGui::DockBuilderDockWindow("File Content", left_file_content);
             ImGui::DockBuilderDockWindow("Game Engine", left_game_engine);
+            ImGui::DockBuilderDockWindow("Profiler", right);
 
             ImGui::DockBuilderFinish(main_docking_id);
         }
@@ -629,6 +643,7 @@ namespace MiniEngine
                 ImGui::MenuItem("Game", nullptr, &mbGameEngineWindowOpen);
                 ImGui::MenuItem("File Content", nullptr, &mbFileContentWindowOpen);
                 ImGui::MenuItem("Detail", nullptr, &mbDetailWindowOpen);
+                ImGui::MenuItem("Profiler", nullptr, &mbProfilerWindowOpen);
                 ImGui::EndMenu();
             }
             ImGui::EndMenuBar();
@@ -708,13 +723,16 @@ namespace MiniEngine
             ImGui::TableSetupColumn("Type", ImGuiTableColumnFlags_WidthFixed);
             ImGui::TableHeadersRow();
 
+            // with hot reload the tree is rebuilt when files are added or removed, otherwise once per second
             auto current_time = std::chrono::steady_clock::now();
-            if (current_time - mLastFileTreeUpdate > std::chrono::seconds(1))
+            bool is_timed_out = !gRuntimeGlobalContext.mAssetManager->IsHotReloadEnabled() &&
+                                current_time - mLastFileTreeUpdate > std::chrono::seconds(1);
+            if (mbFileTreeDirty || is_timed_out)
             {
                 mEditorFileService.BuildEngineFileTree();
                 mLastFileTreeUpdate = current_time;
+                mbFileTreeDirty     = false;
             }
-            mLastFileTreeUpdate = current_time;
 
             EditorFileNode* editor_root_node = mEditorFileService.GetEditorRootNode();
             buildEditorFileAssetsUITree(editor_root_node);
@@ -923,6 +941,107 @@ namespace MiniEngine
         ImGui::End();
     }
 
+    void MEditorUI::showEditorProfilerWindow(bool* pOpen)
+    {
+        ImGuiWindowFlags window_flags = ImGuiWindowFlags_None;
+
+        if (!*pOpen)
+            return;
+
+        if (!ImGui::Begin("Profiler", pOpen, window_flags))
+        {
+            ImGui::End();
+            return;
+        }
+
+        std::shared_ptr<Profiler> profiler = gRuntimeGlobalContext.mProfiler;
+
+        bool enabled = profiler->IsEnabled();
+        if (ImGui::Checkbox("Enabled", &enabled))
+        {
+            profiler->SetEnabled(enabled);
+        }
+        ImGui::SameLine();
+        ImGui::Checkbox("Pause", &mbProfilerPaused);
+        ImGui::SameLine();
+        if (ImGui::Button("Export Chrome Trace"))
+        {
+            std::filesystem::path trace_path = gRuntimeGlobalContext.mConfigManager->GetRootFolder() / "ProfilerTrace.json";
+            if (profiler->ExportChromeTrace(trace_path))
+            {
+                LOG_INFO("profiler trace exported to {}", trace_path.generic_string());
+            }
+            else
+            {
+                LOG_ERROR("export profiler trace to {} failed", trace_path.generic_string());
+            }
+        }
+
+        if (!mbProfilerPaused)
+        {
+            mProfilerFrame = profiler->GetLastFrame();
+        }
+
+        ImGui::Text("Frame %llu: %.3f ms",
+                    static_cast<unsigned long long>(mProfilerFrame.frame_index),
+                    (mProfilerFrame.end_ns - mProfilerFrame.begin_ns) / 1000000.0);
+        ImGui::Text("Input to present: %.3f ms", mProfilerFrame.GetInputLatencyMs());
+
+        if (ImGui::CollapsingHeader("CPU", ImGuiTreeNodeFlags_DefaultOpen))
+        {
+            showProfileScopeTable("cpu_scopes", mProfilerFrame.cpu_scopes);
+        }
+        if (ImGui::CollapsingHeader("GPU", ImGuiTreeNodeFlags_DefaultOpen))
+        {
+            showProfileScopeTable("gpu_scopes", mProfilerFrame.gpu_scopes);
+        }
+
+        ImGui::End();
+    }
+
+    void MEditorUI::showProfileScopeTable(const char* tableID, const std::vector<ProfileScope>& scopes)
+    {
+        // scopes are recorded when they end, sort them back into call order per thread
+        std::vector<ProfileScope> sorted_scopes = scopes;
+        std::sort(sorted_scopes.begin(), sorted_scopes.end(), [](const ProfileScope& lhs, const ProfileScope& rhs) {
+            if (lhs.thread_index != rhs.thread_index)
+                return lhs.thread_index < rhs.thread_index;
+            if (lhs.begin_ns != rhs.begin_ns)
+                return lhs.begin_ns < rhs.begin_ns;
+            return lhs.depth < rhs.depth;
+        });
+
+        if (!ImGui::BeginTable(tableID, 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_Resizable))
+            return;
+
+        ImGui::TableSetupColumn("Scope", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Thread", ImGuiTableColumnFlags_WidthFixed);
+        ImGui::TableSetupColumn("ms", ImGuiTableColumnFlags_WidthFixed);
+        ImGui::TableHeadersRow();
+
+        for (const ProfileScope& scope : sorted_scopes)
+        {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            // Indent(0) would fall back to the default spacing
+            float indent = scope.depth * ImGui::GetStyle().IndentSpacing;
+            if (indent > 0.0f)
+                ImGui::Indent(indent);
+            ImGui::TextUnformatted(scope.name);
+            if (indent > 0.0f)
+                ImGui::Unindent(indent);
+            ImGui::TableNextColumn();
+            if (scope.thread_index == s_profiler_gpu_thread_index)
+                ImGui::TextUnformatted("GPU");
+            else
+                ImGui::Text("%u", scope.thread_index);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", (scope.end_ns - scope.begin_ns) / 1000000.0);
+        }
+
+        ImGui::EndTable();
+    }
+
     void MEditorUI::setUIColorStyle()
     {
         ImGuiStyle* style  = &ImGui::GetStyle();
@@ -4,6 +4,7 @@
 #include "MEditor/MEditorFileService.hpp"
 
 #include "MRuntime/Core/Math/Vector2.hpp"
+#include "MRuntime/Core/Profiler/Profiler.hpp"
 #include "MRuntime/Function/UI/WindowUI.hpp"
 #include "MRuntime/Function/Framework/Object/Object.hpp"
 
@@ -38,6 +39,8 @@ namespace MiniEngine
         void showEditorFileContentWindow(bool* pOpen);
         void showEditorGameWindow(bool* pOpen);
         void showEditorDetailWindow(bool* pOpen);
+        void showEditorProfilerWindow(bool* pOpen);
+        void showProfileScopeTable(const char* tableID, const std::vector<ProfileScope>& scopes);
 
         void setUIColorStyle();
 
@@ -46,6 +49,7 @@ namespace MiniEngine
         std::unordered_map<std::string, unsigned int>                            mNewObjectIndexMap;
         EditorFileService                                                        mEditorFileService;
         std::chrono::time_point<std::chrono::steady_clock>                       mLastFileTreeUpdate;
+        ProfileFrame                                                             mProfilerFrame;
 
         bool mbEditorMenuWindowOpen      = true;
         bool mbAssetWindowOpen           = true;
@@ -54,5 +58,8 @@ namespace MiniEngine
         bool mbDetailWindowOpen          = true;
         bool mbSceneLightsWindowOpen     = true;
         bool mbSceneLightsDataWindowOpen = true;
+        bool mbProfilerWindowOpen        = false;
+        bool mbProfilerPaused            = false;
+        bool mbFileTreeDirty             = true;
     };
 }
\ No newline at end of file
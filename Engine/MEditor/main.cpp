@@ -6,6 +6,8 @@
 
 #include "MEditor/MEditor.hpp"
 #include "MRuntime/MEngine.hpp"
+#include "MRuntime/Function/Global/GlobalContext.hpp"
+#include "MRuntime/Function/Render/WindowSystem.hpp"
 
 #define MINIENGINE_XSTR(s) MINIENGINE_STR(s)
 #define MINIENGINE_STR(s) #s
@@ -21,6 +23,16 @@ int main(int argc, char* argv[])
     Engine->StartEngine(configFilePath.generic_string());
     Engine->Initialize();
 
+    // 无窗口模式：跳过编辑器，按固定帧数运行并输出帧耗时
+    if (MiniEngine::gRuntimeGlobalContext.mWindowSystem->IsHeadless())
+    {
+        Engine->Run();
+
+        Engine->Clear();
+        Engine->ShutdownEngine();
+        return 0;
+    }
+
     // 创建编辑器
     auto Editor = new MiniEngine::MEditor();
     Editor->Initialize(Engine);
@@ -15,18 +15,57 @@
 
 // #define LOG_FATAL(...) std::cerr << "file: " << __FILE__ << "\tline: " << __LINE__ << "\tfatal: " << __VA_ARGS__ << "\n"
 
+// log calls below this level are compiled out together with their arguments,
+// override with -DMINIENGINE_LOG_LEVEL=MINIENGINE_LOG_LEVEL_xxx
+#define MINIENGINE_LOG_LEVEL_DEBUG 0
+#define MINIENGINE_LOG_LEVEL_INFO 1
+#define MINIENGINE_LOG_LEVEL_WARN 2
+#define MINIENGINE_LOG_LEVEL_ERROR 3
+
+#ifndef MINIENGINE_LOG_LEVEL
+#ifdef NDEBUG
+#define MINIENGINE_LOG_LEVEL MINIENGINE_LOG_LEVEL_INFO
+#else
+#define MINIENGINE_LOG_LEVEL MINIENGINE_LOG_LEVEL_DEBUG
+#endif
+#endif
+
+// the level is checked before the arguments are touched, filtered calls cost a branch
 #define LOG_HELPER(LOG_LEVEL, ...) \
-    gRuntimeGlobalContext.mLoggerSystem->Log(LOG_LEVEL, "[" + std::string(__FUNCTION__) + "] " + __VA_ARGS__);
+    do \
+    { \
+        if (gRuntimeGlobalContext.mLoggerSystem->ShouldLog(LOG_LEVEL)) \
+        { \
+            gRuntimeGlobalContext.mLoggerSystem->Log(LOG_LEVEL, __FUNCTION__, __VA_ARGS__); \
+        } \
+    } while (0)
 
-#define LOG_DEBUG(...) LOG_HELPER(LogSystem::LogLevel::Debug, __VA_ARGS__);
+#if MINIENGINE_LOG_LEVEL <= MINIENGINE_LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) LOG_HELPER(LogSystem::LogLevel::Debug, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) ((void)0)
+#endif
 
-#define LOG_INFO(...) LOG_HELPER(LogSystem::LogLevel::Info, __VA_ARGS__);
+#if MINIENGINE_LOG_LEVEL <= MINIENGINE_LOG_LEVEL_INFO
+#define LOG_INFO(...) LOG_HELPER(LogSystem::LogLevel::Info, __VA_ARGS__)
+#else
+#define LOG_INFO(...) ((void)0)
+#endif
 
-#define LOG_WARN(...) LOG_HELPER(LogSystem::LogLevel::Warning, __VA_ARGS__);
+#if MINIENGINE_LOG_LEVEL <= MINIENGINE_LOG_LEVEL_WARN
+#define LOG_WARN(...) LOG_HELPER(LogSystem::LogLevel::Warning, __VA_ARGS__)
+#else
+#define LOG_WARN(...) ((void)0)
+#endif
 
-#define LOG_ERROR(...) LOG_HELPER(LogSystem::LogLevel::Error, __VA_ARGS__);
+#if MINIENGINE_LOG_LEVEL <= MINIENGINE_LOG_LEVEL_ERROR
+#define LOG_ERROR(...) LOG_HELPER(LogSystem::LogLevel::Error, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) ((void)0)
+#endif
 
-#define LOG_FATAL(...) LOG_HELPER(LogSystem::LogLevel::Fatal, __VA_ARGS__);
+// fatal messages throw and are never compiled out
+#define LOG_FATAL(...) LOG_HELPER(LogSystem::LogLevel::Fatal, __VA_ARGS__)
 
 #define PolitSleep(_ms) std::this_thread::sleep_for(std::chrono::milliseconds(_ms));
 
@@ -0,0 +1,173 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <memory>
+
+namespace MiniEngine
+{
+    namespace
+    {
+        // shared with the helper tasks, which may only get to run after the ParallelFor returned
+        struct ParallelForJob
+        {
+            const std::function<void(uint32_t, uint32_t)>* func {nullptr};
+            uint32_t                                       count {0};
+            uint32_t                                       batch_size {0};
+            uint32_t                                       batch_count {0};
+            std::atomic<uint32_t>                          next_batch {0};
+            std::atomic<bool>                              cancelled {false};
+
+            std::mutex              finished_mutex;
+            std::condition_variable finished_condition;
+            uint32_t                finished_batch_count {0};
+            std::exception_ptr      exception;
+        };
+
+        // claims batches until all are taken, batches claimed after a failure are skipped but still counted
+        void runParallelForBatches(ParallelForJob& job)
+        {
+            uint32_t batch_index;
+            while ((batch_index = job.next_batch.fetch_add(1, std::memory_order_relaxed)) < job.batch_count)
+            {
+                std::exception_ptr exception;
+                if (!job.cancelled.load(std::memory_order_relaxed))
+                {
+                    uint32_t begin = batch_index * job.batch_size;
+                    uint32_t end   = std::min(begin + job.batch_size, job.count);
+                    try
+                    {
+                        (*job.func)(begin, end);
+                    }
+                    catch (...)
+                    {
+                        exception = std::current_exception();
+                        job.cancelled.store(true, std::memory_order_relaxed);
+                    }
+                }
+
+                std::lock_guard<std::mutex> lock(job.finished_mutex);
+                if (exception && !job.exception)
+                {
+                    job.exception = exception;
+                }
+                if (++job.finished_batch_count == job.batch_count)
+                {
+                    job.finished_condition.notify_all();
+                }
+            }
+        }
+    } // namespace
+
+    ThreadPool::~ThreadPool()
+    {
+        Clear();
+    }
+
+    void ThreadPool::Initialize(uint32_t thread_count)
+    {
+        if (thread_count == 0)
+        {
+            uint32_t hardware_thread_count = std::thread::hardware_concurrency();
+            thread_count                   = hardware_thread_count > 1 ? hardware_thread_count - 1 : 1;
+        }
+
+        mbStopping = false;
+        mWorkers.reserve(thread_count);
+        for (uint32_t i = 0; i < thread_count; ++i)
+        {
+            mWorkers.emplace_back(&ThreadPool::workerLoop, this);
+        }
+    }
+
+    void ThreadPool::Clear()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mTaskMutex);
+            mbStopping = true;
+        }
+        mTaskCondition.notify_all();
+
+        for (std::thread& worker : mWorkers)
+        {
+            if (worker.joinable())
+            {
+                worker.join();
+            }
+        }
+        mWorkers.clear();
+        mTasks.clear();
+    }
+
+    void ThreadPool::Enqueue(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mTaskMutex);
+            mTasks.emplace_back(std::move(task));
+        }
+        mTaskCondition.notify_one();
+    }
+
+    void ThreadPool::ParallelFor(uint32_t                                        count,
+                                 uint32_t                                        min_batch_size,
+                                 const std::function<void(uint32_t, uint32_t)>& func)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        min_batch_size        = std::max(min_batch_size, 1u);
+        uint32_t worker_count = GetThreadCount() + 1;
+        uint32_t batch_size   = std::max(min_batch_size, (count + worker_count - 1) / worker_count);
+        uint32_t batch_count  = (count + batch_size - 1) / batch_size;
+
+        if (batch_count == 1 || mWorkers.empty())
+        {
+            func(0, count);
+            return;
+        }
+
+        std::shared_ptr<ParallelForJob> job = std::make_shared<ParallelForJob>();
+        job->func                           = &func;
+        job->count                          = count;
+        job->batch_size                     = batch_size;
+        job->batch_count                    = batch_count;
+
+        // the helpers only claim batches, a helper that runs late finds none left and returns
+        uint32_t helper_count = std::min(batch_count - 1, GetThreadCount());
+        for (uint32_t helper_index = 0; helper_index < helper_count; ++helper_index)
+        {
+            Enqueue([job]() { runParallelForBatches(*job); });
+        }
+
+        // batches not picked up by a worker yet are run here, so a nested call or busy workers can't deadlock it
+        runParallelForBatches(*job);
+
+        std::unique_lock<std::mutex> lock(job->finished_mutex);
+        job->finished_condition.wait(lock, [&job]() { return job->finished_batch_count == job->batch_count; });
+        if (job->exception)
+        {
+            std::rethrow_exception(job->exception);
+        }
+    }
+
+    void ThreadPool::workerLoop()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(mTaskMutex);
+                mTaskCondition.wait(lock, [this]() { return mbStopping || !mTasks.empty(); });
+                if (mbStopping && mTasks.empty())
+                {
+                    return;
+                }
+                task = std::move(mTasks.front());
+                mTasks.pop_front();
+            }
+            task();
+        }
+    }
+} // namespace MiniEngine
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace MiniEngine
+{
+    // fixed size worker pool shared by the runtime systems
+    class ThreadPool
+    {
+    public:
+        ~ThreadPool();
+
+        // 0 means hardware concurrency minus the calling thread
+        void Initialize(uint32_t thread_count = 0);
+        void Clear();
+
+        uint32_t GetThreadCount() const { return static_cast<uint32_t>(mWorkers.size()); }
+
+        // fire and forget
+        void Enqueue(std::function<void()> task);
+
+        // split [0, count) into batches of at least min_batch_size and run them on the workers.
+        // the calling thread only takes batches of this call, never unrelated queued tasks, and returns when all
+        // batches are done. the first exception thrown by a batch skips the batches not started yet and is
+        // rethrown on the calling thread once the running ones finished
+        void ParallelFor(uint32_t                                        count,
+                         uint32_t                                        min_batch_size,
+                         const std::function<void(uint32_t, uint32_t)>& func);
+
+    private:
+        void workerLoop();
+
+    private:
+        std::vector<std::thread>          mWorkers;
+        std::deque<std::function<void()>> mTasks;
+        std::mutex                        mTaskMutex;
+        std::condition_variable           mTaskCondition;
+        bool                              mbStopping {false};
+    };
+} // namespace MiniEngine
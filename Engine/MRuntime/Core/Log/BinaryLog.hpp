@@ -0,0 +1,168 @@
+#pragma once
+
+#include <spdlog/spdlog.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+namespace MiniEngine
+{
+    static uint32_t const s_binary_log_payload_size  = 200;
+    static uint32_t const s_binary_log_ring_capacity = 1024;
+
+    // copies a log argument into a record and reads it back on the formatting thread,
+    // types without a codec make the call fall back to formatting on the calling thread
+    template<typename T, typename = void>
+    struct BinaryLogCodec
+    {
+        static constexpr bool s_supported = false;
+    };
+
+    template<typename T>
+    static constexpr bool s_is_binary_log_string_v = std::is_same_v<T, const char*> || std::is_same_v<T, char*> ||
+                                                     std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>;
+
+    // arithmetic values, enums and non string pointers are copied as raw bytes
+    template<typename T>
+    struct BinaryLogCodec<T, std::enable_if_t<std::is_arithmetic_v<T> || std::is_enum_v<T> || (std::is_pointer_v<T> && !s_is_binary_log_string_v<T>)>>
+    {
+        static constexpr bool s_supported = true;
+        using Decoded                     = T;
+
+        static bool Encode(uint8_t*& cursor, const uint8_t* end, const T& value)
+        {
+            if (static_cast<size_t>(end - cursor) < sizeof(T))
+            {
+                return false;
+            }
+            memcpy(cursor, &value, sizeof(T));
+            cursor += sizeof(T);
+            return true;
+        }
+
+        static Decoded Decode(const uint8_t*& cursor)
+        {
+            T value;
+            memcpy(&value, cursor, sizeof(T));
+            cursor += sizeof(T);
+            return value;
+        }
+    };
+
+    // strings are copied as length and characters since the caller's storage may be gone when the record is formatted
+    template<typename T>
+    struct BinaryLogCodec<T, std::enable_if_t<s_is_binary_log_string_v<T>>>
+    {
+        static constexpr bool s_supported = true;
+        using Decoded                     = std::string_view;
+
+        static bool Encode(uint8_t*& cursor, const uint8_t* end, const T& value)
+        {
+            std::string_view string;
+            if constexpr (std::is_pointer_v<T>)
+            {
+                string = value != nullptr ? std::string_view(value) : std::string_view();
+            }
+            else
+            {
+                string = value;
+            }
+            uint32_t length = static_cast<uint32_t>(string.size());
+            if (static_cast<size_t>(end - cursor) < sizeof(length) + length)
+            {
+                return false;
+            }
+            memcpy(cursor, &length, sizeof(length));
+            memcpy(cursor + sizeof(length), string.data(), length);
+            cursor += sizeof(length) + length;
+            return true;
+        }
+
+        static Decoded Decode(const uint8_t*& cursor)
+        {
+            uint32_t length;
+            memcpy(&length, cursor, sizeof(length));
+            Decoded value(reinterpret_cast<const char*>(cursor + sizeof(length)), length);
+            cursor += sizeof(length) + length;
+            return value;
+        }
+    };
+
+    struct BinaryLogRecord
+    {
+        using FormatFunc = void (*)(const BinaryLogRecord& record, fmt::memory_buffer& buffer);
+
+        FormatFunc                  format_func {nullptr};
+        // both point to string literals, the format pointer doubles as the format id
+        const char*                 function {nullptr};
+        const char*                 format {nullptr};
+        spdlog::log_clock::time_point time;
+        spdlog::level::level_enum   level {spdlog::level::info};
+        uint8_t                     payload[s_binary_log_payload_size];
+    };
+
+    template<typename... TARGS>
+    void FormatBinaryLogRecord(const BinaryLogRecord& record, fmt::memory_buffer& buffer)
+    {
+        const uint8_t* cursor = record.payload;
+        // braced initialization decodes the arguments from left to right
+        std::tuple<typename BinaryLogCodec<TARGS>::Decoded...> values {BinaryLogCodec<TARGS>::Decode(cursor)...};
+        (void)cursor;
+        std::apply(
+            [&](const auto&... decoded) {
+                fmt::vformat_to(std::back_inserter(buffer), fmt::string_view(record.format), fmt::make_format_args(decoded...));
+            },
+            values);
+    }
+
+    // single producer ring, written by one logging thread. it is drained by the log thread, or by the
+    // writer itself when the ring is full, whoever holds the read mutex
+    class BinaryLogRing
+    {
+    public:
+        std::mutex& GetReadMutex() { return mReadMutex; }
+
+        // set once the writing thread is gone, an empty ring of an exited thread can be freed
+        void MarkOwnerExited() { mbOwnerExited.store(true, std::memory_order_release); }
+        bool IsOwnerExited() const { return mbOwnerExited.load(std::memory_order_acquire); }
+
+        BinaryLogRecord* TryBeginWrite()
+        {
+            uint32_t head = mHead.load(std::memory_order_relaxed);
+            if (head - mTail.load(std::memory_order_acquire) == s_binary_log_ring_capacity)
+            {
+                return nullptr;
+            }
+            return &mRecords[head % s_binary_log_ring_capacity];
+        }
+
+        void EndWrite() { mHead.store(mHead.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+        const BinaryLogRecord* TryBeginRead()
+        {
+            uint32_t tail = mTail.load(std::memory_order_relaxed);
+            if (tail == mHead.load(std::memory_order_acquire))
+            {
+                return nullptr;
+            }
+            return &mRecords[tail % s_binary_log_ring_capacity];
+        }
+
+        void EndRead() { mTail.store(mTail.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+    private:
+        alignas(64) std::atomic<uint32_t> mHead {0};
+        alignas(64) std::atomic<uint32_t> mTail {0};
+        std::mutex                        mReadMutex;
+        std::atomic<bool>                 mbOwnerExited {false};
+        std::array<BinaryLogRecord, s_binary_log_ring_capacity> mRecords;
+    };
+} // namespace MiniEngine
@@ -4,8 +4,38 @@
 
 #include "LogSystem.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iterator>
+
 namespace MiniEngine
 {
+    namespace
+    {
+        // shares the ring with the log system, the ring is handed back when the thread exits
+        struct ThreadBinaryLogRing
+        {
+            ~ThreadBinaryLogRing() { Reset(0, nullptr); }
+
+            void Reset(uint64_t new_log_system_id, std::shared_ptr<BinaryLogRing> new_ring)
+            {
+                if (ring != nullptr)
+                {
+                    ring->MarkOwnerExited();
+                }
+                log_system_id = new_log_system_id;
+                ring          = std::move(new_ring);
+            }
+
+            uint64_t                       log_system_id {0};
+            std::shared_ptr<BinaryLogRing> ring;
+        };
+
+        std::atomic<uint64_t> g_log_system_id {1};
+        thread_local ThreadBinaryLogRing t_binary_log_ring;
+    } // namespace
+
     LogSystem::LogSystem()
     {
         auto console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
@@ -24,11 +54,190 @@ namespace MiniEngine
         mLogger->set_level(spdlog::level::trace);
 
         spdlog::register_logger(mLogger);
+
+        mLogSystemID = g_log_system_id.fetch_add(1, std::memory_order_relaxed);
     }
 
     LogSystem::~LogSystem()
     {
+        mbBinaryMode.store(false, std::memory_order_relaxed);
+        if (mDrainThread.joinable())
+        {
+            mbDrainRunning.store(false, std::memory_order_release);
+            mDrainThread.join();
+        }
+
         mLogger->flush();
         spdlog::drop_all();
     }
-}
\ No newline at end of file
+
+    bool LogSystem::ParseLevel(const std::string& name, LogLevel& level)
+    {
+        if (name == "Debug")
+            level = LogLevel::Debug;
+        else if (name == "Info")
+            level = LogLevel::Info;
+        else if (name == "Warning")
+            level = LogLevel::Warning;
+        else if (name == "Error")
+            level = LogLevel::Error;
+        else if (name == "Fatal")
+            level = LogLevel::Fatal;
+        else
+            return false;
+        return true;
+    }
+
+    void LogSystem::SetBinaryMode(bool enabled)
+    {
+        if (enabled && !mDrainThread.joinable())
+        {
+            mbDrainRunning.store(true, std::memory_order_release);
+            mDrainThread = std::thread(&LogSystem::drainBinaryLog, this);
+        }
+        mbBinaryMode.store(enabled, std::memory_order_relaxed);
+    }
+
+    spdlog::level::level_enum LogSystem::toSpdlogLevel(LogLevel level)
+    {
+        switch (level)
+        {
+            case LogLevel::Debug:
+                return spdlog::level::debug;
+            case LogLevel::Info:
+                return spdlog::level::info;
+            case LogLevel::Warning:
+                return spdlog::level::warn;
+            case LogLevel::Error:
+                return spdlog::level::err;
+            case LogLevel::Fatal:
+                return spdlog::level::critical;
+            default:
+                return spdlog::level::off;
+        }
+    }
+
+    void LogSystem::logFormatted(LogLevel level, const char* function, fmt::string_view format, fmt::format_args args)
+    {
+        fmt::memory_buffer buffer;
+        fmt::format_to(std::back_inserter(buffer), "[{}] ", function);
+        size_t prefix_size = buffer.size();
+        try
+        {
+            fmt::vformat_to(std::back_inserter(buffer), format, args);
+        }
+        catch (const fmt::format_error&)
+        {
+            // messages that are not meant as format strings, e.g. json text
+            buffer.resize(prefix_size);
+            buffer.append(format.data(), format.data() + format.size());
+        }
+
+        spdlog::string_view_t message(buffer.data(), buffer.size());
+        mLogger->log(toSpdlogLevel(level), message);
+
+        if (level == LogLevel::Fatal)
+        {
+            throw std::runtime_error(std::string(message.data(), message.size()));
+        }
+    }
+
+    BinaryLogRing* LogSystem::getThreadBinaryLogRing()
+    {
+        if (t_binary_log_ring.log_system_id != mLogSystemID)
+        {
+            // the log system keeps the ring until the records of an exited thread are drained
+            std::lock_guard<std::mutex> lock(mRingMutex);
+            mRings.push_back(std::make_shared<BinaryLogRing>());
+            t_binary_log_ring.Reset(mLogSystemID, mRings.back());
+        }
+        return t_binary_log_ring.ring.get();
+    }
+
+    void LogSystem::drainBinaryLog()
+    {
+        while (mbDrainRunning.load(std::memory_order_acquire))
+        {
+            if (drainBinaryLogRings() == 0)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+        while (drainBinaryLogRings() > 0)
+        {
+        }
+    }
+
+    size_t LogSystem::drainBinaryLogRings()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mRingMutex);
+            mDrainRings.clear();
+            for (std::shared_ptr<BinaryLogRing>& ring : mRings)
+            {
+                mDrainRings.push_back(ring.get());
+            }
+        }
+
+        size_t drained_count = 0;
+        mExitedRings.clear();
+        for (BinaryLogRing* ring : mDrainRings)
+        {
+            // read before draining, an exited thread writes nothing after setting it
+            bool owner_exited = ring->IsOwnerExited();
+            drained_count += drainBinaryLogRing(*ring);
+            if (owner_exited)
+            {
+                mExitedRings.push_back(ring);
+            }
+        }
+
+        // only the drain thread erases rings, so the pointers above stay valid without holding the lock
+        if (!mExitedRings.empty())
+        {
+            std::lock_guard<std::mutex> lock(mRingMutex);
+            mRings.erase(std::remove_if(mRings.begin(),
+                                        mRings.end(),
+                                        [this](const std::shared_ptr<BinaryLogRing>& ring) {
+                                            return std::find(mExitedRings.begin(), mExitedRings.end(), ring.get()) !=
+                                                   mExitedRings.end();
+                                        }),
+                         mRings.end());
+        }
+        return drained_count;
+    }
+
+    size_t LogSystem::drainBinaryLogRing(BinaryLogRing& ring)
+    {
+        std::lock_guard<std::mutex> lock(ring.GetReadMutex());
+
+        size_t             drained_count = 0;
+        fmt::memory_buffer buffer;
+        while (const BinaryLogRecord* record = ring.TryBeginRead())
+        {
+            formatBinaryLogRecord(*record, buffer);
+            // keep the time of the call rather than the time it was formatted
+            mLogger->log(record->time, spdlog::source_loc {}, record->level, spdlog::string_view_t(buffer.data(), buffer.size()));
+            ring.EndRead();
+            drained_count++;
+        }
+        return drained_count;
+    }
+
+    void LogSystem::formatBinaryLogRecord(const BinaryLogRecord& record, fmt::memory_buffer& buffer)
+    {
+        buffer.clear();
+        fmt::format_to(std::back_inserter(buffer), "[{}] ", record.function);
+        size_t prefix_size = buffer.size();
+        try
+        {
+            record.format_func(record, buffer);
+        }
+        catch (const fmt::format_error&)
+        {
+            buffer.resize(prefix_size);
+            buffer.append(record.format, record.format + strlen(record.format));
+        }
+    }
+}
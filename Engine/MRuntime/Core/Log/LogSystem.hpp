@@ -1,9 +1,16 @@
 #pragma once
 
+#include "MRuntime/Core/Log/BinaryLog.hpp"
+
 #include <spdlog/spdlog.h>
 
+#include <atomic>
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <thread>
+#include <vector>
 
 namespace MiniEngine
 {
@@ -18,45 +25,89 @@ namespace MiniEngine
             Error,
             Fatal
         };
-    
+
     public:
         LogSystem();
         ~LogSystem();
 
-        template<typename... TARGS>
-        void Log(LogLevel level, TARGS&&... args)
+        // checked by the log macros before any argument is formatted
+        bool ShouldLog(LogLevel level) const { return mLogger->should_log(toSpdlogLevel(level)); }
+        void SetLevel(LogLevel level) { mLogger->set_level(toSpdlogLevel(level)); }
+        static bool ParseLevel(const std::string& name, LogLevel& level);
+
+        // in binary mode call sites only copy the format id and raw arguments into a per-thread ring,
+        // the log thread formats them afterwards. fatal messages are always formatted immediately
+        void SetBinaryMode(bool enabled);
+        bool IsBinaryMode() const { return mbBinaryMode.load(std::memory_order_relaxed); }
+
+        template<typename TFORMAT, typename... TARGS>
+        void Log(LogLevel level, const char* function, const TFORMAT& format, TARGS&&... args)
         {
-            switch (level)
+            // only string literals have a stable address that can be used as the format id
+            if constexpr (std::is_array_v<TFORMAT> && (BinaryLogCodec<std::decay_t<TARGS>>::s_supported && ...))
             {
-                case LogLevel::Debug:
-                    mLogger->debug(std::forward<TARGS>(args)...);
-                    break;
-                case LogLevel::Info:
-                    mLogger->info(std::forward<TARGS>(args)...);
-                    break;
-                case LogLevel::Warning:
-                    mLogger->warn(std::forward<TARGS>(args)...);
-                    break;
-                case LogLevel::Error:
-                    mLogger->error(std::forward<TARGS>(args)...);
-                    break;
-                case LogLevel::Fatal:
-                    mLogger->critical(std::forward<TARGS>(args)...);
-                    FatalCallback(std::forward<TARGS>(args)...);
-                    break;
-                default:
-                    break;
+                if (level != LogLevel::Fatal && IsBinaryMode() && tryLogBinary(level, function, format, args...))
+                {
+                    return;
+                }
             }
+            logFormatted(level, function, fmt::string_view(format), fmt::make_format_args(args...));
         }
 
+    private:
+        static spdlog::level::level_enum toSpdlogLevel(LogLevel level);
+
+        void logFormatted(LogLevel level, const char* function, fmt::string_view format, fmt::format_args args);
+
         template<typename... TARGS>
-        void FatalCallback(TARGS&&... args)
+        bool tryLogBinary(LogLevel level, const char* function, const char* format, TARGS&&... args)
         {
-            const std::string format_str = fmt::format(std::forward<TARGS>(args)...);
-            throw std::runtime_error(format_str);
+            BinaryLogRing*   ring   = getThreadBinaryLogRing();
+            BinaryLogRecord* record = ring->TryBeginWrite();
+            if (record == nullptr)
+            {
+                // ring is full, drain it on the calling thread so the new record stays behind the older ones
+                drainBinaryLogRing(*ring);
+                record = ring->TryBeginWrite();
+            }
+
+            if constexpr (sizeof...(TARGS) > 0)
+            {
+                uint8_t*       cursor = record->payload;
+                const uint8_t* end    = record->payload + s_binary_log_payload_size;
+                if (!(BinaryLogCodec<std::decay_t<TARGS>>::Encode(cursor, end, args) && ...))
+                {
+                    // too large for a record, the queued records have to go out before it is formatted inline
+                    drainBinaryLogRing(*ring);
+                    return false;
+                }
+            }
+
+            record->format_func = &FormatBinaryLogRecord<std::decay_t<TARGS>...>;
+            record->function    = function;
+            record->format      = format;
+            record->time        = spdlog::log_clock::now();
+            record->level       = toSpdlogLevel(level);
+            ring->EndWrite();
+            return true;
         }
 
+        BinaryLogRing* getThreadBinaryLogRing();
+        void drainBinaryLog();
+        size_t drainBinaryLogRings();
+        size_t drainBinaryLogRing(BinaryLogRing& ring);
+        static void formatBinaryLogRecord(const BinaryLogRecord& record, fmt::memory_buffer& buffer);
+
         private:
             std::shared_ptr<spdlog::logger> mLogger;
+
+            std::atomic<bool>                           mbBinaryMode {false};
+            std::atomic<bool>                           mbDrainRunning {false};
+            std::thread                                 mDrainThread;
+            std::mutex                                  mRingMutex;
+            std::vector<std::shared_ptr<BinaryLogRing>> mRings;
+            std::vector<BinaryLogRing*>                 mDrainRings;
+            std::vector<BinaryLogRing*>                 mExitedRings;
+            uint64_t                                    mLogSystemID {0};
     };
-}
\ No newline at end of file
+}
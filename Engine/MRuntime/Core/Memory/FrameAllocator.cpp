@@ -0,0 +1,109 @@
+#include "FrameAllocator.hpp"
+
+#include "MRuntime/Core/Base/Marco.hpp"
+#include "MRuntime/Core/Memory/HeapStats.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+namespace MiniEngine
+{
+    LinearAllocator::LinearAllocator(size_t block_size) : mBlockSize {block_size} { addBlock(mBlockSize); }
+
+    LinearAllocator::~LinearAllocator() { releaseBlocks(); }
+
+    void LinearAllocator::Reset()
+    {
+        if (mBlocks.size() > 1)
+        {
+            // the last frame overflowed, one block of the whole size avoids growing again
+            size_t capacity = GetCapacity();
+            releaseBlocks();
+            addBlock(capacity);
+        }
+        mBlockOffset = 0;
+        mUsedSize    = 0;
+    }
+
+    size_t LinearAllocator::GetCapacity() const
+    {
+        size_t capacity = 0;
+        for (const Block& block : mBlocks)
+        {
+            capacity += block.mSize;
+        }
+        return capacity;
+    }
+
+    void* LinearAllocator::do_allocate(size_t bytes, size_t alignment)
+    {
+        Block*    block   = &mBlocks.back();
+        uintptr_t address = reinterpret_cast<uintptr_t>(block->mData) + mBlockOffset;
+        uintptr_t aligned = (address + alignment - 1) & ~(uintptr_t(alignment) - 1);
+        if (aligned + bytes > reinterpret_cast<uintptr_t>(block->mData) + block->mSize)
+        {
+            addBlock(std::max(mBlockSize, bytes + alignment));
+            block   = &mBlocks.back();
+            address = reinterpret_cast<uintptr_t>(block->mData);
+            aligned = (address + alignment - 1) & ~(uintptr_t(alignment) - 1);
+        }
+
+        mBlockOffset = aligned + bytes - reinterpret_cast<uintptr_t>(block->mData);
+        mUsedSize += bytes;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    void LinearAllocator::addBlock(size_t min_size)
+    {
+        Block block;
+        block.mSize = std::max(min_size, mBlockSize);
+        block.mData = static_cast<uint8_t*>(std::malloc(block.mSize));
+        if (block.mData == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        mBlocks.push_back(block);
+        mBlockOffset = 0;
+    }
+
+    void LinearAllocator::releaseBlocks()
+    {
+        for (Block& block : mBlocks)
+        {
+            std::free(block.mData);
+        }
+        mBlocks.clear();
+    }
+
+    void FrameAllocator::Initialize(uint32_t frame_count)
+    {
+        ASSERT(frame_count > 0);
+
+        mAllocators.clear();
+        for (uint32_t index = 0; index < frame_count; ++index)
+        {
+            mAllocators.push_back(std::make_unique<LinearAllocator>());
+        }
+        mFrameIndex                    = 0;
+        mFrameBeginHeapAllocationCount = GetHeapAllocationCount();
+    }
+
+    void FrameAllocator::Clear() { mAllocators.clear(); }
+
+    void FrameAllocator::BeginFrame(uint32_t frame_index)
+    {
+        ASSERT(frame_index < mAllocators.size());
+
+        uint64_t heap_allocation_count = GetHeapAllocationCount();
+        mLastFrameHeapAllocationCount  = heap_allocation_count - mFrameBeginHeapAllocationCount;
+        mFrameBeginHeapAllocationCount = heap_allocation_count;
+        mLastFrameUsedSize             = mAllocators[mFrameIndex]->GetUsedSize();
+
+        // containers of the frame that used this index last are gone by now
+        mFrameIndex = frame_index;
+        mAllocators[mFrameIndex]->Reset();
+    }
+
+    std::pmr::memory_resource* FrameAllocator::GetResource() { return mAllocators[mFrameIndex].get(); }
+} // namespace MiniEngine
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace MiniEngine
+{
+    static size_t const s_linear_allocator_block_size = 1024 * 1024;
+
+    /// Bump allocator, deallocate is a no-op and Reset releases everything at once.
+    /// A full block is followed by a new one, after the next Reset a single block holds the whole peak
+    class LinearAllocator : public std::pmr::memory_resource
+    {
+    public:
+        explicit LinearAllocator(size_t block_size = s_linear_allocator_block_size);
+        ~LinearAllocator() override;
+
+        LinearAllocator(const LinearAllocator&)            = delete;
+        LinearAllocator& operator=(const LinearAllocator&) = delete;
+
+        void Reset();
+
+        size_t GetUsedSize() const { return mUsedSize; }
+        size_t GetCapacity() const;
+
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override;
+        void  do_deallocate(void* /*pointer*/, size_t /*bytes*/, size_t /*alignment*/) override {}
+        bool  do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    private:
+        struct Block
+        {
+            uint8_t* mData {nullptr};
+            size_t   mSize {0};
+        };
+
+        void addBlock(size_t min_size);
+        void releaseBlocks();
+
+    private:
+        size_t             mBlockSize;
+        std::vector<Block> mBlocks;
+        size_t             mBlockOffset {0};
+        size_t             mUsedSize {0};
+    };
+
+    /// One LinearAllocator per frame in flight for transient containers of the logic and render ticks.
+    /// Memory taken during a frame stays valid until the same frame index comes around again, main thread only
+    class FrameAllocator
+    {
+    public:
+        void Initialize(uint32_t frame_count);
+        void Clear();
+
+        // resets the allocator of frame_index, called once at the start of a frame
+        void BeginFrame(uint32_t frame_index);
+
+        std::pmr::memory_resource* GetResource();
+
+        // statistics of the frame before the current one, the heap allocations stay 0 unless IsHeapStatsAvailable()
+        uint64_t GetLastFrameHeapAllocationCount() const { return mLastFrameHeapAllocationCount; }
+        size_t   GetLastFrameUsedSize() const { return mLastFrameUsedSize; }
+
+    private:
+        std::vector<std::unique_ptr<LinearAllocator>> mAllocators;
+        uint32_t                                      mFrameIndex {0};
+
+        uint64_t mFrameBeginHeapAllocationCount {0};
+        uint64_t mLastFrameHeapAllocationCount {0};
+        size_t   mLastFrameUsedSize {0};
+    };
+} // namespace MiniEngine
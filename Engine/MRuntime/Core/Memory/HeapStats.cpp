@@ -0,0 +1,103 @@
+#include "HeapStats.hpp"
+
+#if defined(MINIENGINE_HEAP_STATS)
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+namespace MiniEngine
+{
+    namespace
+    {
+        // constant initialized, operator new already runs during static initialization
+        std::atomic<uint64_t> g_heap_allocation_count {0};
+        std::atomic<uint64_t> g_heap_allocated_bytes {0};
+
+        void* countedAllocate(std::size_t size)
+        {
+            g_heap_allocation_count.fetch_add(1, std::memory_order_relaxed);
+            g_heap_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+            return std::malloc(size == 0 ? 1 : size);
+        }
+
+        void* countedAllocate(std::size_t size, std::size_t alignment)
+        {
+            g_heap_allocation_count.fetch_add(1, std::memory_order_relaxed);
+            g_heap_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+#if defined(_MSC_VER)
+            return _aligned_malloc(size == 0 ? 1 : size, alignment);
+#else
+            // aligned_alloc wants a multiple of the alignment
+            std::size_t aligned_size = (size + alignment - 1) / alignment * alignment;
+            return std::aligned_alloc(alignment, aligned_size == 0 ? alignment : aligned_size);
+#endif
+        }
+
+        void alignedFree(void* pointer)
+        {
+#if defined(_MSC_VER)
+            _aligned_free(pointer);
+#else
+            std::free(pointer);
+#endif
+        }
+    } // namespace
+
+    bool IsHeapStatsAvailable() { return true; }
+
+    uint64_t GetHeapAllocationCount() { return g_heap_allocation_count.load(std::memory_order_relaxed); }
+
+    uint64_t GetHeapAllocatedBytes() { return g_heap_allocated_bytes.load(std::memory_order_relaxed); }
+} // namespace MiniEngine
+
+// replaced for the whole program, the counters show how many allocations a frame makes
+void* operator new(std::size_t size)
+{
+    void* pointer = MiniEngine::countedAllocate(size);
+    if (pointer == nullptr)
+        throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new[](std::size_t size) { return operator new(size); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return MiniEngine::countedAllocate(size); }
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return MiniEngine::countedAllocate(size); }
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    void* pointer = MiniEngine::countedAllocate(size, static_cast<std::size_t>(alignment));
+    if (pointer == nullptr)
+        throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) { return operator new(size, alignment); }
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { MiniEngine::alignedFree(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { MiniEngine::alignedFree(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept { MiniEngine::alignedFree(pointer); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept { MiniEngine::alignedFree(pointer); }
+
+#else
+
+namespace MiniEngine
+{
+    bool IsHeapStatsAvailable() { return false; }
+
+    uint64_t GetHeapAllocationCount() { return 0; }
+
+    uint64_t GetHeapAllocatedBytes() { return 0; }
+} // namespace MiniEngine
+
+#endif
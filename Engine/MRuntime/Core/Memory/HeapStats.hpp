@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+
+namespace MiniEngine
+{
+    // the global operator new is only replaced when the engine is built with MINIENGINE_HEAP_STATS, counting costs
+    // two shared atomics per allocation on every thread. without it the counts are unavailable and stay 0
+    bool IsHeapStatsAvailable();
+
+    // counted by the replaced global operator new, from any thread since the process started
+    uint64_t GetHeapAllocationCount();
+    uint64_t GetHeapAllocatedBytes();
+} // namespace MiniEngine
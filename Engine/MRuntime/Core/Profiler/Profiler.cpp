@@ -0,0 +1,231 @@
+#include "Profiler.hpp"
+
+#include "MRuntime/Core/Meta/Json.hpp"
+#include "MRuntime/Function/Global/GlobalContext.hpp"
+
+#include <fstream>
+#include <string>
+
+namespace MiniEngine
+{
+    namespace
+    {
+        struct ProfileThreadState
+        {
+            uint32_t                  thread_index {UINT32_MAX};
+            std::vector<ProfileScope> open_scopes;
+        };
+
+        thread_local ProfileThreadState t_profile_thread_state;
+        std::atomic<uint32_t>           g_profile_thread_count {0};
+
+        // chrome trace rows, cpu threads follow after the frame and gpu rows
+        int const s_chrome_trace_frame_tid = 0;
+        int const s_chrome_trace_gpu_tid   = 1;
+
+        Json makeChromeTraceEvent(const char* name, int tid, uint64_t begin_ns, uint64_t end_ns)
+        {
+            return Json::object {{"name", name},
+                                 {"ph", "X"},
+                                 {"pid", 0},
+                                 {"tid", tid},
+                                 {"ts", static_cast<double>(begin_ns) / 1000.0},
+                                 {"dur", static_cast<double>(end_ns - begin_ns) / 1000.0}};
+        }
+
+        Json makeChromeTraceCounter(const char* name, uint64_t time_ns, double value)
+        {
+            return Json::object {{"name", name},
+                                 {"ph", "C"},
+                                 {"pid", 0},
+                                 {"ts", static_cast<double>(time_ns) / 1000.0},
+                                 {"args", Json::object {{"ms", value}}}};
+        }
+
+        Json makeChromeTraceThreadName(int tid, const std::string& name)
+        {
+            return Json::object {{"name", "thread_name"},
+                                 {"ph", "M"},
+                                 {"pid", 0},
+                                 {"tid", tid},
+                                 {"args", Json::object {{"name", name}}}};
+        }
+    } // namespace
+
+    void Profiler::Initialize()
+    {
+        std::lock_guard<std::mutex> lock(mFrameMutex);
+        mStartTime    = std::chrono::steady_clock::now();
+        mCurrentFrame = ProfileFrame {};
+        mFrameHistory.clear();
+    }
+
+    void Profiler::Clear()
+    {
+        std::lock_guard<std::mutex> lock(mFrameMutex);
+        mCurrentFrame = ProfileFrame {};
+        mFrameHistory.clear();
+    }
+
+    void Profiler::BeginFrame()
+    {
+        uint64_t now = GetTimeNs();
+
+        std::lock_guard<std::mutex> lock(mFrameMutex);
+        mCurrentFrame.end_ns = now;
+
+        uint64_t next_frame_index = mCurrentFrame.frame_index + 1;
+        mFrameHistory.emplace_back(std::move(mCurrentFrame));
+
+        // the new frame takes over the scope storage of the dropped one, no allocations once the history is full
+        ProfileFrame next_frame;
+        while (mFrameHistory.size() > s_profiler_history_frame_count)
+        {
+            next_frame = std::move(mFrameHistory.front());
+            mFrameHistory.pop_front();
+        }
+        next_frame.cpu_scopes.clear();
+        next_frame.gpu_scopes.clear();
+
+        mCurrentFrame             = std::move(next_frame);
+        mCurrentFrame.frame_index = next_frame_index;
+        mCurrentFrame.begin_ns    = now;
+        mCurrentFrame.end_ns      = 0;
+        mCurrentFrame.input_ns    = 0;
+        mCurrentFrame.present_ns  = 0;
+    }
+
+    void Profiler::BeginScope(const char* name)
+    {
+        ProfileThreadState& thread_state = t_profile_thread_state;
+        if (thread_state.thread_index == UINT32_MAX)
+        {
+            thread_state.thread_index = g_profile_thread_count.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        ProfileScope scope;
+        scope.name         = name;
+        scope.thread_index = thread_state.thread_index;
+        scope.depth        = static_cast<uint32_t>(thread_state.open_scopes.size());
+        scope.begin_ns     = GetTimeNs();
+        thread_state.open_scopes.push_back(scope);
+    }
+
+    void Profiler::EndScope()
+    {
+        ProfileThreadState& thread_state = t_profile_thread_state;
+        if (thread_state.open_scopes.empty())
+        {
+            return;
+        }
+
+        ProfileScope scope = thread_state.open_scopes.back();
+        thread_state.open_scopes.pop_back();
+        scope.end_ns = GetTimeNs();
+
+        std::lock_guard<std::mutex> lock(mFrameMutex);
+        mCurrentFrame.cpu_scopes.push_back(scope);
+    }
+
+    void Profiler::AddGpuScopes(const std::vector<ProfileScope>& scopes)
+    {
+        std::lock_guard<std::mutex> lock(mFrameMutex);
+        mCurrentFrame.gpu_scopes.insert(mCurrentFrame.gpu_scopes.end(), scopes.begin(), scopes.end());
+    }
+
+    void Profiler::MarkInputSampled()
+    {
+        uint64_t now = GetTimeNs();
+
+        std::lock_guard<std::mutex> lock(mFrameMutex);
+        mCurrentFrame.input_ns = now;
+    }
+
+    void Profiler::MarkPresented()
+    {
+        uint64_t now = GetTimeNs();
+
+        std::lock_guard<std::mutex> lock(mFrameMutex);
+        mCurrentFrame.present_ns = now;
+    }
+
+    uint64_t Profiler::GetTimeNs() const
+    {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - mStartTime).count());
+    }
+
+    ProfileFrame Profiler::GetLastFrame() const
+    {
+        std::lock_guard<std::mutex> lock(mFrameMutex);
+        return mFrameHistory.empty() ? ProfileFrame {} : mFrameHistory.back();
+    }
+
+    bool Profiler::ExportChromeTrace(const std::filesystem::path& path) const
+    {
+        std::deque<ProfileFrame> frames;
+        {
+            std::lock_guard<std::mutex> lock(mFrameMutex);
+            frames = mFrameHistory;
+        }
+
+        Json::array events;
+        events.push_back(makeChromeTraceThreadName(s_chrome_trace_frame_tid, "Frame"));
+        events.push_back(makeChromeTraceThreadName(s_chrome_trace_gpu_tid, "GPU"));
+
+        uint32_t thread_count = g_profile_thread_count.load(std::memory_order_relaxed);
+        for (uint32_t thread_index = 0; thread_index < thread_count; ++thread_index)
+        {
+            events.push_back(makeChromeTraceThreadName(s_chrome_trace_gpu_tid + 1 + thread_index,
+                                                       "Thread " + std::to_string(thread_index)));
+        }
+
+        for (const ProfileFrame& frame : frames)
+        {
+            std::string frame_name = "Frame " + std::to_string(frame.frame_index);
+            events.push_back(makeChromeTraceEvent(frame_name.c_str(), s_chrome_trace_frame_tid, frame.begin_ns, frame.end_ns));
+            if (frame.present_ns != 0)
+            {
+                events.push_back(makeChromeTraceCounter("Input Latency", frame.present_ns, frame.GetInputLatencyMs()));
+            }
+
+            for (const ProfileScope& scope : frame.cpu_scopes)
+            {
+                events.push_back(makeChromeTraceEvent(
+                    scope.name, s_chrome_trace_gpu_tid + 1 + static_cast<int>(scope.thread_index), scope.begin_ns, scope.end_ns));
+            }
+            for (const ProfileScope& scope : frame.gpu_scopes)
+            {
+                events.push_back(makeChromeTraceEvent(scope.name, s_chrome_trace_gpu_tid, scope.begin_ns, scope.end_ns));
+            }
+        }
+
+        std::ofstream trace_file(path, std::ios::trunc);
+        if (!trace_file.is_open())
+        {
+            return false;
+        }
+
+        Json trace = Json::object {{"traceEvents", events}, {"displayTimeUnit", "ms"}};
+        trace_file << trace.dump();
+        return trace_file.good();
+    }
+
+    ProfileScopeGuard::ProfileScopeGuard(const char* name)
+    {
+        Profiler* profiler = gRuntimeGlobalContext.mProfiler.get();
+        if (profiler != nullptr && profiler->IsEnabled())
+        {
+            profiler->BeginScope(name);
+            mProfiler = profiler;
+        }
+    }
+
+    ProfileScopeGuard::~ProfileScopeGuard()
+    {
+        if (mProfiler != nullptr)
+        {
+            mProfiler->EndScope();
+        }
+    }
+} // namespace MiniEngine
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <vector>
+
+namespace MiniEngine
+{
+    // gpu timestamp scopes are reported on this thread index
+    static uint32_t const s_profiler_gpu_thread_index   = UINT32_MAX;
+    static uint32_t const s_profiler_history_frame_count = 300;
+
+    struct ProfileScope
+    {
+        // not copied, string literals only
+        const char* name {nullptr};
+        uint32_t    thread_index {0};
+        uint32_t    depth {0};
+        // nanoseconds since the profiler was initialized
+        uint64_t    begin_ns {0};
+        uint64_t    end_ns {0};
+    };
+
+    struct ProfileFrame
+    {
+        uint64_t                  frame_index {0};
+        uint64_t                  begin_ns {0};
+        uint64_t                  end_ns {0};
+        std::vector<ProfileScope> cpu_scopes;
+        // the gpu runs frames in flight behind the cpu, these scopes belong to an earlier frame
+        std::vector<ProfileScope> gpu_scopes;
+        // input sampled and frame handed to the presentation engine, zero when the frame did not
+        uint64_t                  input_ns {0};
+        uint64_t                  present_ns {0};
+
+        // cpu side latency from the input sample to the present call, the display adds its own on top
+        double GetInputLatencyMs() const
+        {
+            return input_ns != 0 && present_ns > input_ns ? (present_ns - input_ns) / 1000000.0 : 0.0;
+        }
+    };
+
+    // hierarchical cpu scopes from any thread plus gpu scopes reported by the rhi, grouped by frame
+    class Profiler
+    {
+    public:
+        void Initialize();
+        void Clear();
+
+        void SetEnabled(bool enabled) { mbEnabled.store(enabled, std::memory_order_relaxed); }
+        bool IsEnabled() const { return mbEnabled.load(std::memory_order_relaxed); }
+
+        // closes the frame being recorded and starts the next one
+        void BeginFrame();
+
+        void BeginScope(const char* name);
+        void EndScope();
+        void AddGpuScopes(const std::vector<ProfileScope>& scopes);
+
+        void MarkInputSampled();
+        void MarkPresented();
+
+        uint64_t GetTimeNs() const;
+
+        ProfileFrame GetLastFrame() const;
+        // writes the recorded history in the chrome://tracing json format
+        bool ExportChromeTrace(const std::filesystem::path& path) const;
+
+    private:
+        std::chrono::steady_clock::time_point mStartTime;
+        std::atomic<bool>                     mbEnabled {true};
+
+        mutable std::mutex       mFrameMutex;
+        ProfileFrame             mCurrentFrame;
+        std::deque<ProfileFrame> mFrameHistory;
+    };
+
+    class ProfileScopeGuard
+    {
+    public:
+        explicit ProfileScopeGuard(const char* name);
+        ~ProfileScopeGuard();
+
+        ProfileScopeGuard(const ProfileScopeGuard&) = delete;
+        ProfileScopeGuard& operator=(const ProfileScopeGuard&) = delete;
+
+    private:
+        Profiler* mProfiler {nullptr};
+    };
+} // namespace MiniEngine
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+
+#define PROFILE_SCOPE(name) ::MiniEngine::ProfileScopeGuard PROFILE_CONCAT(profile_scope_, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__FUNCTION__)
@@ -1,6 +1,9 @@
 #pragma once
 #include "MRuntime/Core/Meta/Reflection/Reflection.hpp"
 
+#include <string>
+#include <vector>
+
 namespace MiniEngine
 {
     class GObject;
@@ -16,7 +19,14 @@ namespace MiniEngine
 
         // Instantiating the component after definition loaded
         virtual void PostLoadResource(std::weak_ptr<GObject> parent_object) { mParentObject = parent_object; }
+        // true if PostLoadResource touches nothing but the component and thread safe systems, scenes then
+        // run it on the workers. the others run on the logic thread once the object is added to the scene
+        virtual bool IsPostLoadThreadSafe() const { return false; }
+        // asset urls read by PostLoadResource, the component is loaded again when one of them changes
+        virtual void GetAssetDependencies(std::vector<std::string>& /*asset_urls*/) const {}
         virtual void Tick(float delta_time) {};
+        // once per rendered frame, alpha blends the state before the last logic tick with the current one
+        virtual void Interpolate(float /*alpha*/) {}
         bool IsDirty() const { return mbIsDirty; }
         void SetDirtyFlag(bool is_dirty) { mbIsDirty = is_dirty; }
 
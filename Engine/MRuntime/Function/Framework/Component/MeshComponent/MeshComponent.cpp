@@ -31,19 +31,24 @@ namespace MiniEngine
 
             if (meshComponent.mMaterialDesc.mbWithTexture)
             {
-                MaterialRes material_res;
-                asset_manager->LoadAsset(sub_mesh.mMaterial, material_res);
+                // materials are never changed after loading, all meshes using one share it
+                std::shared_ptr<const MaterialRes> material_res =
+                    asset_manager->LoadSharedAsset<MaterialRes>(sub_mesh.mMaterial);
+                if (material_res == nullptr)
+                {
+                    material_res = std::make_shared<MaterialRes>();
+                }
 
                 meshComponent.mMaterialDesc.mBaseColorTextureFile =
-                    asset_manager->GetFullPath(material_res.mBaseColorTextureFile).generic_string();
+                    asset_manager->GetFullPath(material_res->mBaseColorTextureFile).generic_string();
                 meshComponent.mMaterialDesc.mMetallicRoughnessTextureFile =
-                    asset_manager->GetFullPath(material_res.mMetallicRoughnessTextureFile).generic_string();
+                    asset_manager->GetFullPath(material_res->mMetallicRoughnessTextureFile).generic_string();
                 meshComponent.mMaterialDesc.mNormalTextureFile =
-                    asset_manager->GetFullPath(material_res.mNormalTextureFile).generic_string();
+                    asset_manager->GetFullPath(material_res->mNormalTextureFile).generic_string();
                 meshComponent.mMaterialDesc.mOcclusionTextureFile =
-                    asset_manager->GetFullPath(material_res.mOcclusionTextureFile).generic_string();
+                    asset_manager->GetFullPath(material_res->mOcclusionTextureFile).generic_string();
                 meshComponent.mMaterialDesc.mEmissiveTextureFile =
-                    asset_manager->GetFullPath(material_res.mEmissiveTextureFile).generic_string();
+                    asset_manager->GetFullPath(material_res->mEmissiveTextureFile).generic_string();
             }
 
             auto object_space_transform = sub_mesh.mTransform.GetMatrix();
@@ -54,34 +59,46 @@ namespace MiniEngine
         }
     }
 
-    void MeshComponent::Tick(float delta_time)
+    void MeshComponent::GetAssetDependencies(std::vector<std::string>& asset_urls) const
+    {
+        // mesh and texture files are reloaded by the render system
+        for (const SubMeshRes& sub_mesh : mMeshRes.mSubMeshes)
+        {
+            if (!sub_mesh.mMaterial.empty())
+            {
+                asset_urls.push_back(sub_mesh.mMaterial);
+            }
+        }
+    }
+
+    void MeshComponent::Interpolate(float alpha)
     {
         if (!mParentObject.lock())
             return;
 
         TransformComponent* transformComp = mParentObject.lock()->TryGetComponent(TransformComponent);
 
-        if (transformComp->IsDirty())
+        // moving objects go out every rendered frame, also when no logic tick ran in it
+        const bool is_moving = transformComp->IsMoving();
+        if (transformComp->IsDirty() || is_moving || mbIsInterpolating)
         {
-            std::vector<GameObjectPartDesc> dirtyMeshParts;
-            
-            for (GameObjectPartDesc& mesh_part : mRawMeshes)
-            {
-                Matrix4x4 object_transform_matrix = mesh_part.mTransformDesc.mTransformMatrix;
+            const Matrix4x4 object_transform = transformComp->GetInterpolatedMatrix(alpha);
 
+            // copy assignment into the kept vector, a moving object does not allocate every frame
+            mDirtyMeshParts = mRawMeshes;
+            for (GameObjectPartDesc& mesh_part : mDirtyMeshParts)
+            {
                 mesh_part.mTransformDesc.mTransformMatrix =
-                    transformComp->GetMatrix() * object_transform_matrix;
-                dirtyMeshParts.push_back(mesh_part);
-
-                mesh_part.mTransformDesc.mTransformMatrix = object_transform_matrix;
+                    object_transform * mesh_part.mTransformDesc.mTransformMatrix;
             }
 
             RenderSwapContext& renderSwapContext = gRuntimeGlobalContext.mRenderSystem->GetSwapContext();
             RenderSwapData&    logicSwapData     = renderSwapContext.GetLogicSwapData();
 
-            logicSwapData.AddDirtyGameObject(GameObjectDesc {mParentObject.lock()->GetID(), dirtyMeshParts});
+            logicSwapData.AddDirtyGameObject(mParentObject.lock()->GetID(), mDirtyMeshParts);
 
             transformComp->SetDirtyFlag(false);
+            mbIsInterpolating = is_moving;
         }
     }
 } // namespace MiniEngine
@@ -18,14 +18,20 @@ namespace MiniEngine
         MeshComponent() {};
 
         void PostLoadResource(std::weak_ptr<GObject> parent_object) override;
+        // only reads shared assets and config paths
+        bool IsPostLoadThreadSafe() const override { return true; }
+        void GetAssetDependencies(std::vector<std::string>& asset_urls) const override;
 
         const std::vector<GameObjectPartDesc>& GetRawMeshes() const { return mRawMeshes; }
 
-        void Tick(float delta_time) override;
+        void Interpolate(float alpha) override;
 
     private:
         META(Enable)
         MeshComponentRes mMeshRes;
         std::vector<GameObjectPartDesc> mRawMeshes;
+        std::vector<GameObjectPartDesc> mDirtyMeshParts;
+        // sent a blended transform last frame, the final state still has to go out once the object stops
+        bool                            mbIsInterpolating {false};
     };
 } // namespace MiniEngine
@@ -9,6 +9,7 @@ namespace MiniEngine
         mParentObject       = parent_gobject;
         mTransformBuffer[0] = mTransform;
         mTransformBuffer[1] = mTransform;
+        mPreviousTransform  = mTransform;
         mbIsDirty            = true;
     }
 
@@ -36,11 +37,37 @@ namespace MiniEngine
 
     void TransformComponent::Tick(float delta_time)
     {
+        mPreviousTransform = mTransformBuffer[mCurrentIndex];
         std::swap(mCurrentIndex, mNextIndex);
 
         if (gbIsEditorMode)
         {
             mTransformBuffer[mNextIndex] = mTransform;
         }
+        else
+        {
+            // the setters of the next tick change single fields, the rest has to be the current state
+            mTransformBuffer[mNextIndex] = mTransformBuffer[mCurrentIndex];
+        }
+
+        const Transform& current_transform = mTransformBuffer[mCurrentIndex];
+        mbIsMoving = !(mPreviousTransform.m_position == current_transform.m_position &&
+                       mPreviousTransform.m_rotation == current_transform.m_rotation &&
+                       mPreviousTransform.m_scale == current_transform.m_scale);
+    }
+
+    Matrix4x4 TransformComponent::GetInterpolatedMatrix(float alpha) const
+    {
+        const Transform& current_transform = mTransformBuffer[mCurrentIndex];
+        if (!mbIsMoving || alpha >= 1.0f)
+        {
+            return current_transform.GetMatrix();
+        }
+
+        Transform transform(
+            Vector3::Lerp(mPreviousTransform.m_position, current_transform.m_position, alpha),
+            Quaternion::NLerp(alpha, mPreviousTransform.m_rotation, current_transform.m_rotation, true),
+            Vector3::Lerp(mPreviousTransform.m_scale, current_transform.m_scale, alpha));
+        return transform.GetMatrix();
     }
 } // namespace MiniEngine
@@ -17,6 +17,7 @@ namespace MiniEngine
         TransformComponent() = default;
 
         void PostLoadResource(std::weak_ptr<GObject> parent_object) override;
+        bool IsPostLoadThreadSafe() const override { return true; }
 
         Vector3    GetPosition() const { return mTransformBuffer[mCurrentIndex].m_position; }
         Vector3    GetScale() const { return mTransformBuffer[mCurrentIndex].m_scale; }
@@ -31,6 +32,10 @@ namespace MiniEngine
 
         Matrix4x4 GetMatrix() const { return mTransformBuffer[mCurrentIndex].GetMatrix(); }
 
+        // moved by the last logic tick, the rendered transform is then between the previous and current one
+        bool      IsMoving() const { return mbIsMoving; }
+        Matrix4x4 GetInterpolatedMatrix(float alpha) const;
+
         void Tick(float delta_time) override;
 
     protected:
@@ -40,5 +45,8 @@ namespace MiniEngine
         Transform mTransformBuffer[2];
         size_t    mCurrentIndex {0};
         size_t    mNextIndex {1};
+
+        Transform mPreviousTransform;
+        bool      mbIsMoving {false};
     };
 } // namespace MiniEngine
@@ -5,6 +5,8 @@
 #include "MRuntime/Function/Global/GlobalContext.hpp"
 #include "MRuntime/Function/Framework/Component/Component.hpp"
 #include "MRuntime/Function/Framework/Component/TransformComponent/TransformComponent.hpp"
+#include "MRuntime/Function/Render/RenderSwapContext.hpp"
+#include "MRuntime/Function/Render/RenderSystem.hpp"
 
 #include <cassert>
 #include <unordered_set>
@@ -45,6 +47,17 @@ namespace MiniEngine
         }
     }
 
+    void GObject::Interpolate(float alpha)
+    {
+        for (auto &component : mComponents)
+        {
+            if (shouldComponentTick(component.GetTypeName()))
+            {
+                component->Interpolate(alpha);
+            }
+        }
+    }
+
     bool GObject::HasComponent(const std::string &compenent_type_name) const
     {
         for (const auto &component : mComponents)
@@ -56,7 +69,7 @@ namespace MiniEngine
         return false;
     }
 
-    bool GObject::Load(const ObjectInstanceRes &object_instance_res)
+    bool GObject::Load(const ObjectInstanceRes &object_instance_res, bool is_logic_thread)
     {
         // clear old components
         mComponents.clear();
@@ -65,20 +78,24 @@ namespace MiniEngine
 
         // load object instanced components
         mComponents = object_instance_res.mInstancedComponents;
+        mInstancedComponentTypes.clear();
         for (auto component : mComponents)
         {
             if (component)
             {
-                component->PostLoadResource(weak_from_this());
+                mInstancedComponentTypes.insert(component.GetTypeName());
+                postLoadComponent(component, is_logic_thread);
             }
         }
 
         // load object definition components
         mDefinitionURL = object_instance_res.mDefinition;
 
+        // the definition is parsed once for all its instances, every instance reads its own components from it
         ObjectDefinitionRes definition_res;
 
-        const bool is_loaded_success = gRuntimeGlobalContext.mAssetManager->LoadAsset(mDefinitionURL, definition_res);
+        const bool is_loaded_success =
+            gRuntimeGlobalContext.mAssetManager->InstantiateAsset(mDefinitionURL, definition_res);
         if (!is_loaded_success)
             return false;
 
@@ -87,13 +104,92 @@ namespace MiniEngine
             const std::string type_name = loaded_component.GetTypeName();
             // don't create component if it has been instanced
             if (HasComponent(type_name))
+            {
+                ME_REFLECTION_DELETE(loaded_component);
+                continue;
+            }
+
+            postLoadComponent(loaded_component, is_logic_thread);
+
+            mComponents.push_back(loaded_component);
+        }
+
+        return true;
+    }
+
+    void GObject::FinishLoad()
+    {
+        for (auto &component : mComponents)
+        {
+            if (component && !component->IsPostLoadThreadSafe())
+            {
+                component->PostLoadResource(weak_from_this());
+            }
+        }
+    }
+
+    void GObject::postLoadComponent(Reflection::ReflectionPtr<Component> &component, bool is_logic_thread)
+    {
+        if (is_logic_thread || component->IsPostLoadThreadSafe())
+        {
+            component->PostLoadResource(weak_from_this());
+        }
+    }
+
+    void GObject::GetAssetDependencies(std::vector<std::string> &asset_urls) const
+    {
+        asset_urls.push_back(mDefinitionURL);
+        for (const auto &component : mComponents)
+        {
+            if (component)
+            {
+                component->GetAssetDependencies(asset_urls);
+            }
+        }
+    }
+
+    bool GObject::ReloadResource()
+    {
+        ObjectDefinitionRes definition_res;
+
+        const bool is_loaded_success =
+            gRuntimeGlobalContext.mAssetManager->InstantiateAsset(mDefinitionURL, definition_res);
+        if (!is_loaded_success)
+            return false;
+
+        // components from the old definition are replaced, instanced ones resolve their resources again
+        std::vector<Reflection::ReflectionPtr<Component>> components;
+        for (auto &component : mComponents)
+        {
+            if (mInstancedComponentTypes.find(component.GetTypeName()) != mInstancedComponentTypes.end())
+            {
+                component->PostLoadResource(weak_from_this());
+                components.push_back(component);
+            }
+            else
+            {
+                ME_REFLECTION_DELETE(component);
+            }
+        }
+        mComponents = components;
+
+        for (auto loaded_component : definition_res.mComponents)
+        {
+            if (HasComponent(loaded_component.GetTypeName()))
+            {
+                ME_REFLECTION_DELETE(loaded_component);
                 continue;
+            }
 
             loaded_component->PostLoadResource(weak_from_this());
 
             mComponents.push_back(loaded_component);
         }
 
+        // the number of mesh parts may have changed, the dirty transform adds the new ones
+        RenderSwapData &logic_swap_data = gRuntimeGlobalContext.mRenderSystem->GetSwapContext().GetLogicSwapData();
+        logic_swap_data.AddDeleteGameObject(GameObjectDesc {mID, {}});
+
         return true;
     }
 
@@ -22,10 +22,18 @@ namespace MiniEngine
         virtual ~GObject();
 
         virtual void Tick(float delta_time);
+        void         Interpolate(float alpha);
 
-        bool Load(const ObjectInstanceRes& object_instance_res);
+        // on another thread than the logic thread, the components that are not thread safe wait for FinishLoad
+        bool Load(const ObjectInstanceRes& object_instance_res, bool is_logic_thread = true);
+        void FinishLoad();
         void Save(ObjectInstanceRes& out_object_instance_res);
 
+        // asset urls the object was loaded from, the definition and what its components read
+        void GetAssetDependencies(std::vector<std::string>& asset_urls) const;
+        // loads the definition again and lets every component resolve its resources, instanced data is kept
+        bool ReloadResource();
+
         GObjectID GetID() const { return mID; }
 
         void               SetName(std::string name) { mName = name; }
@@ -65,10 +73,14 @@ namespace MiniEngine
 #define TryGetComponent(COMPONENT_TYPE) TryGetComponent<COMPONENT_TYPE>(#COMPONENT_TYPE)
 #define TryGetComponentConst(COMPONENT_TYPE) TryGetComponentConst<const COMPONENT_TYPE>(#COMPONENT_TYPE)
 
+    protected:
+        void postLoadComponent(Reflection::ReflectionPtr<Component>& component, bool is_logic_thread);
+
     protected:
         GObjectID   mID {kInvalidGObjectID};
         std::string mName;
         std::string mDefinitionURL;
+        TypeNameSet mInstancedComponentTypes;
 
         // we have to use the ReflectionPtr due to that the components need to be reflected 
         // in editor, and it's polymorphism
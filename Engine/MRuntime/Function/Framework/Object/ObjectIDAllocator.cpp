@@ -8,9 +8,9 @@ namespace MiniEngine
 
     GObjectID ObjectIDAllocator::Allocate()
     {
-        std::atomic<GObjectID> new_object_ret = mNextID.load();
-        mNextID++;
-        if (mNextID >= kInvalidGObjectID)
+        // scenes load their objects on the workers
+        GObjectID new_object_ret = mNextID.fetch_add(1);
+        if (new_object_ret + 1 >= kInvalidGObjectID)
         {
             LOG_FATAL("gobject id overflow");
         }
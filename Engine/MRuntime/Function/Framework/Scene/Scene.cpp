@@ -6,12 +6,72 @@
 #include "MRuntime/Resource/ResourceType/Common/Scene.hpp"
 
 #include "MRuntime/MEngine.hpp"
+#include "MRuntime/Core/Base/ThreadPool.hpp"
 #include "MRuntime/Function/Framework/Object/Object.hpp"
 
+#include <atomic>
 #include <limits>
+#include <unordered_set>
 
 namespace MiniEngine
 {
+    struct ScenePendingLoad
+    {
+        std::atomic<bool>                     mbIsParsed {false};
+        bool                                  mbIsSuccess {false};
+        std::vector<std::shared_ptr<GObject>> mObjects;
+    };
+
+    namespace
+    {
+        // loads the objects on the workers in three steps: the distinct definitions are parsed, the objects
+        // read their components and the thread safe ones resolve their resources. failed objects are nullptr,
+        // the caller finishes the others with FinishLoad
+        std::vector<std::shared_ptr<GObject>> instantiateObjects(const std::vector<ObjectInstanceRes>& objects)
+        {
+            std::shared_ptr<AssetManager> asset_manager = gRuntimeGlobalContext.mAssetManager;
+            std::shared_ptr<ThreadPool>   thread_pool   = gRuntimeGlobalContext.mThreadPool;
+
+            std::unordered_set<std::string> definition_set;
+            std::vector<std::string>        definition_urls;
+            for (const ObjectInstanceRes& object_instance_res : objects)
+            {
+                if (definition_set.insert(object_instance_res.mDefinition).second)
+                {
+                    definition_urls.push_back(object_instance_res.mDefinition);
+                }
+            }
+            thread_pool->ParallelFor(
+                static_cast<uint32_t>(definition_urls.size()), 1, [&](uint32_t begin, uint32_t end) {
+                    for (uint32_t url_index = begin; url_index < end; ++url_index)
+                    {
+                        asset_manager->PreloadAsset(definition_urls[url_index]);
+                    }
+                });
+
+            // ids follow the scene order no matter which worker loads the object
+            std::vector<std::shared_ptr<GObject>> gobjects(objects.size());
+            for (std::shared_ptr<GObject>& gobject : gobjects)
+            {
+                GObjectID object_id = ObjectIDAllocator::Allocate();
+                ASSERT(object_id != kInvalidGObjectID);
+                gobject = std::make_shared<GObject>(object_id);
+            }
+
+            thread_pool->ParallelFor(static_cast<uint32_t>(objects.size()), 64, [&](uint32_t begin, uint32_t end) {
+                for (uint32_t object_index = begin; object_index < end; ++object_index)
+                {
+                    if (!gobjects[object_index]->Load(objects[object_index], false))
+                    {
+                        LOG_ERROR("loading object " + objects[object_index].mName + " failed");
+                        gobjects[object_index].reset();
+                    }
+                }
+            });
+            return gobjects;
+        }
+    } // namespace
+
     void Scene::Clear()
     {
         mGObjects.clear();
@@ -58,9 +118,13 @@ namespace MiniEngine
             return false;
         }
 
-        for (const ObjectInstanceRes& object_instance_res : scene_res.mObjects)
+        for (const std::shared_ptr<GObject>& gobject : instantiateObjects(scene_res.mObjects))
         {
-            CreateObject(object_instance_res);
+            if (gobject)
+            {
+                gobject->FinishLoad();
+                mGObjects.emplace(gobject->GetID(), gobject);
+            }
         }
 
         // create active character
@@ -79,9 +143,77 @@ namespace MiniEngine
         return true;
     }
 
+    void Scene::LoadAsync(const std::string& scene_res_url)
+    {
+        LOG_INFO("streaming scene: {}", scene_res_url);
+
+        mSceneResURL     = scene_res_url;
+        mNextObjectIndex = 0;
+
+        // owned by the task too, the scene may be unloaded before the worker is done
+        std::shared_ptr<ScenePendingLoad> pending_load = std::make_shared<ScenePendingLoad>();
+        mPendingLoad                                   = pending_load;
+        gRuntimeGlobalContext.mThreadPool->Enqueue([pending_load, scene_res_url]() {
+            SceneRes scene_res;
+            pending_load->mbIsSuccess = gRuntimeGlobalContext.mAssetManager->LoadAsset(scene_res_url, scene_res);
+            if (pending_load->mbIsSuccess)
+            {
+                pending_load->mObjects = instantiateObjects(scene_res.mObjects);
+            }
+            pending_load->mbIsParsed.store(true, std::memory_order_release);
+        });
+    }
+
+    bool Scene::StreamIn(std::chrono::steady_clock::time_point deadline)
+    {
+        if (mbIsLoaded)
+        {
+            return true;
+        }
+        if (mPendingLoad == nullptr || !mPendingLoad->mbIsParsed.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+
+        // a scene that failed to parse stays empty instead of being requested again
+        const std::vector<std::shared_ptr<GObject>>& objects = mPendingLoad->mObjects;
+        if (!mPendingLoad->mbIsSuccess)
+        {
+            LOG_ERROR("streaming scene {} failed", mSceneResURL);
+        }
+        else
+        {
+            // the objects were loaded on the workers, what is left are the components that are not thread safe
+            while (mNextObjectIndex < objects.size())
+            {
+                const std::shared_ptr<GObject>& gobject = objects[mNextObjectIndex++];
+                if (gobject)
+                {
+                    gobject->FinishLoad();
+                    mGObjects.emplace(gobject->GetID(), gobject);
+                }
+                if (std::chrono::steady_clock::now() >= deadline)
+                {
+                    break;
+                }
+            }
+            if (mNextObjectIndex < objects.size())
+            {
+                return false;
+            }
+        }
+
+        mPendingLoad.reset();
+        mbIsLoaded = true;
+        LOG_INFO("scene streamed in: {} with {} objects", mSceneResURL, mGObjects.size());
+        return true;
+    }
+
     void Scene::Unload()
     {
         Clear();
+        mPendingLoad.reset();
+        mbIsLoaded = false;
         LOG_INFO("unload scene: {}", mSceneResURL);
     }
 
@@ -121,7 +253,9 @@ namespace MiniEngine
 
     void Scene::Tick(float delta_time)
     {
-        if (!mbIsLoaded)
+        // objects of a streaming scene tick as soon as they exist, so their render resources are requested
+        // over the frames the scene takes to stream in
+        if (!mbIsLoaded && mPendingLoad == nullptr)
         {
             return;
         }
@@ -137,6 +271,22 @@ namespace MiniEngine
 
     }
 
+    void Scene::Interpolate(float alpha)
+    {
+        if (!mbIsLoaded && mPendingLoad == nullptr)
+        {
+            return;
+        }
+
+        for (const auto& id_object_pair : mGObjects)
+        {
+            if (id_object_pair.second)
+            {
+                id_object_pair.second->Interpolate(alpha);
+            }
+        }
+    }
+
     std::weak_ptr<GObject> Scene::GetGObjectByID(GObjectID go_id) const
     {
         auto iter = mGObjects.find(go_id);
@@ -2,6 +2,7 @@
 
 #include "MRuntime/Function/Framework/Object/ObjectIDAllocator.hpp"
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -10,6 +11,7 @@ namespace MiniEngine
 {
     class GObject;
     class ObjectInstanceRes;
+    struct ScenePendingLoad;
 
     using SceneObjectsMap = std::unordered_map<GObjectID, std::shared_ptr<GObject>>;
 
@@ -22,9 +24,16 @@ namespace MiniEngine
         bool Load(const std::string& scene_res_url);
         void Unload();
 
+        // reads the scene and loads its objects on the workers, StreamIn adds them to the scene
+        void LoadAsync(const std::string& scene_res_url);
+        // adds objects of an async load until the deadline, at least one per call. true once all are added
+        bool StreamIn(std::chrono::steady_clock::time_point deadline);
+        bool IsLoaded() const { return mbIsLoaded; }
+
         bool Save();
 
         void Tick(float delta_time);
+        void Interpolate(float alpha);
 
         const std::string& GetSceneResUrl() const { return mSceneResURL; }
 
@@ -43,5 +52,9 @@ namespace MiniEngine
 
         // all game objects in this scene, key: object id, value: object instance
         SceneObjectsMap mGObjects;
+
+        // the workers write the loaded objects here, objects up to the index are added
+        std::shared_ptr<ScenePendingLoad> mPendingLoad;
+        size_t                            mNextObjectIndex {0};
     };
 } // namespace MiniEngine
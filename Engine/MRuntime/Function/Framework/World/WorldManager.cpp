@@ -5,8 +5,16 @@
 #include "MRuntime/resource/AssetManager/AssetManager.hpp"
 #include "MRuntime/resource/ConfigManager/ConfigManager.hpp"
 
+#include "MRuntime/Function/Framework/Object/Object.hpp"
 #include "MRuntime/Function/Framework/Scene/Scene.hpp"
 #include "MRuntime/Function/Global/GlobalContext.hpp"
+#include "MRuntime/Function/Render/RenderCamera.hpp"
+#include "MRuntime/Function/Render/RenderSystem.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <unordered_set>
 
 namespace MiniEngine
 {
@@ -16,6 +24,9 @@ namespace MiniEngine
     {
         mbIsWorldLoaded   = false;
         mCurrentWorldURL = gRuntimeGlobalContext.mConfigManager->GetDefaultWorldURL();
+
+        gRuntimeGlobalContext.mAssetManager->AddFileChangeCallback(
+            [this](const std::vector<FileChange>& changes) { onAssetFilesChanged(changes); });
     }
 
     void WorldManager::Clear()
@@ -26,9 +37,16 @@ namespace MiniEngine
             scene_pair.second->Unload();
         }
         mLoadedScenes.clear();
+        mStreamingScenes.clear();
 
         mCurrentActiveScene.reset();
 
+        // definitions and materials cached while the scenes were loaded
+        if (gRuntimeGlobalContext.mAssetManager)
+        {
+            gRuntimeGlobalContext.mAssetManager->ClearAssetCache();
+        }
+
         // clear world
         mCurrentWorldResource.reset();
         mCurrentWorldURL.clear();
@@ -42,12 +60,99 @@ namespace MiniEngine
             LoadWorld(mCurrentWorldURL);
         }
 
-        // tick the active scene
+        updateStreaming();
+
+        // tick the active scene and the streaming cells
+        for (const auto& scene_pair : mLoadedScenes)
+        {
+            scene_pair.second->Tick(delta_time);
+        }
+    }
+
+    void WorldManager::Interpolate(float alpha)
+    {
+        if (!mbIsWorldLoaded)
+        {
+            return;
+        }
+
+        for (const auto& scene_pair : mLoadedScenes)
+        {
+            scene_pair.second->Interpolate(alpha);
+        }
+    }
+
+    void WorldManager::updateStreaming()
+    {
+        if (!mbIsWorldLoaded || mCurrentWorldResource->mStreamingCells.empty())
+        {
+            return;
+        }
+
+        // distance from the camera to the cell bounds
+        Vector3 camera_position = gRuntimeGlobalContext.mRenderSystem->GetRenderCamera()->Position();
+        auto    cell_distance   = [&camera_position](const StreamingCellRes& cell) {
+            Vector3 offset = camera_position - cell.mCenter;
+            Vector3 outside(std::max(std::fabs(offset.x) - cell.mHalfExtent.x, 0.0f),
+                            std::max(std::fabs(offset.y) - cell.mHalfExtent.y, 0.0f),
+                            std::max(std::fabs(offset.z) - cell.mHalfExtent.z, 0.0f));
+            return outside.Length();
+        };
+
         std::shared_ptr<Scene> active_scene = mCurrentActiveScene.lock();
-        if (active_scene)
+        for (const StreamingCellRes& cell : mCurrentWorldResource->mStreamingCells)
+        {
+            if (active_scene && cell.mSceneURL == active_scene->GetSceneResUrl())
+                continue;
+
+            // the gap between the distances keeps a cell on the border from loading and unloading every frame
+            float distance  = cell_distance(cell);
+            bool  is_loaded = mLoadedScenes.find(cell.mSceneURL) != mLoadedScenes.end();
+            if (!is_loaded && distance < mCurrentWorldResource->mStreamingLoadDistance)
+            {
+                std::shared_ptr<Scene> scene = std::make_shared<Scene>();
+                scene->LoadAsync(cell.mSceneURL);
+                mLoadedScenes.emplace(cell.mSceneURL, scene);
+                mStreamingScenes.push_back(scene);
+            }
+            else if (is_loaded && distance > mCurrentWorldResource->mStreamingUnloadDistance)
+            {
+                unloadStreamingCell(cell.mSceneURL);
+            }
+        }
+
+        // one budget for all cells, the earliest requested cell is finished first
+        auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                            std::chrono::duration<float, std::milli>(mCurrentWorldResource->mStreamingTimeBudgetMs));
+        while (!mStreamingScenes.empty() && std::chrono::steady_clock::now() < deadline)
+        {
+            if (!mStreamingScenes.front()->StreamIn(deadline))
+                break;
+            mStreamingScenes.erase(mStreamingScenes.begin());
+        }
+    }
+
+    void WorldManager::unloadStreamingCell(const std::string& scene_url)
+    {
+        auto iter = mLoadedScenes.find(scene_url);
+        if (iter == mLoadedScenes.end())
+        {
+            return;
+        }
+        std::shared_ptr<Scene> scene = iter->second;
+
+        // the render entities of the cell go away with its objects
+        RenderSwapContext& swap_context = gRuntimeGlobalContext.mRenderSystem->GetSwapContext();
+        for (const auto& id_object_pair : scene->GetAllGObjects())
         {
-            active_scene->Tick(delta_time);
+            swap_context.GetLogicSwapData().AddDeleteGameObject(GameObjectDesc {id_object_pair.first, {}});
         }
+
+        scene->Unload();
+        mStreamingScenes.erase(std::remove(mStreamingScenes.begin(), mStreamingScenes.end(), scene),
+                               mStreamingScenes.end());
+        mLoadedScenes.erase(iter);
     }
 
     bool WorldManager::LoadWorld(const std::string& world_url)
@@ -138,4 +243,63 @@ namespace MiniEngine
 
         active_scene->Save();
     }
+
+    void WorldManager::onAssetFilesChanged(const std::vector<FileChange>& changes)
+    {
+        std::shared_ptr<Scene> active_scene = mCurrentActiveScene.lock();
+        if (!mbIsWorldLoaded || active_scene == nullptr)
+        {
+            return;
+        }
+
+        std::unordered_set<std::string> changed_files;
+        for (const FileChange& change : changes)
+        {
+            if (change.mType != FileChangeType::Removed && change.mPath.extension() == ".json")
+            {
+                changed_files.insert(change.mPath.lexically_normal().generic_string());
+            }
+        }
+        if (changed_files.empty())
+        {
+            return;
+        }
+
+        std::shared_ptr<AssetManager> asset_manager = gRuntimeGlobalContext.mAssetManager;
+        auto is_changed = [&](const std::string& asset_url) {
+            return changed_files.find(asset_manager->GetFullPath(asset_url).lexically_normal().generic_string()) !=
+                   changed_files.end();
+        };
+
+        // object instances live in the scene file, so a changed scene is loaded again as a whole
+        if (is_changed(active_scene->GetSceneResUrl()))
+        {
+            LOG_INFO("scene file changed, reloading {}", active_scene->GetSceneResUrl());
+            ReloadCurrentScene();
+            gRuntimeGlobalContext.mRenderSystem->ClearForLevelReloading();
+            return;
+        }
+
+        std::vector<std::string> asset_urls;
+        for (const auto& id_object_pair : active_scene->GetAllGObjects())
+        {
+            const std::shared_ptr<GObject>& object = id_object_pair.second;
+            if (object == nullptr)
+                continue;
+
+            asset_urls.clear();
+            object->GetAssetDependencies(asset_urls);
+            if (std::none_of(asset_urls.begin(), asset_urls.end(), is_changed))
+                continue;
+
+            if (object->ReloadResource())
+            {
+                LOG_INFO("reloaded object {}", object->GetName());
+            }
+            else
+            {
+                LOG_ERROR("reload object {} failed", object->GetName());
+            }
+        }
+    }
 } // namespace MiniEngine
@@ -4,13 +4,16 @@
 
 #include <filesystem>
 #include <string>
+#include <vector>
 
 namespace MiniEngine
 {
     class Scene;
+    struct FileChange;
 
     /// Manage all game worlds, it should be support multiple worlds, including game world and editor world.
-    /// Currently, the implement just supports one active world and one active scene
+    /// Currently, the implement just supports one active world and one active scene.
+    /// The streaming cells of the world are loaded next to the active scene while the camera is close to them
     class WorldManager
     {
     public:
@@ -23,11 +26,18 @@ namespace MiniEngine
         void SaveCurrentScene();
 
         void                 Tick(float delta_time);
+        // once per rendered frame after the logic steps, alpha goes from the previous to the current logic state
+        void                 Interpolate(float alpha);
         std::weak_ptr<Scene> GetCurrentActiveScene() const { return mCurrentActiveScene; }
 
     private:
         bool LoadWorld(const std::string& world_url);
         bool LoadScene(const std::string& scene_url);
+
+        void updateStreaming();
+        void unloadStreamingCell(const std::string& scene_url);
+
+        void onAssetFilesChanged(const std::vector<FileChange>& changes);
     
     private:
         bool                      mbIsWorldLoaded {false};
@@ -38,5 +48,8 @@ namespace MiniEngine
         std::unordered_map<std::string, std::shared_ptr<Scene>> mLoadedScenes;
         // active scene, currently we just support one active scene
         std::weak_ptr<Scene> mCurrentActiveScene;
+
+        // scenes of the streaming cells in mLoadedScenes that are still creating objects
+        std::vector<std::shared_ptr<Scene>> mStreamingScenes;
     };
 } // namespace MiniEngine
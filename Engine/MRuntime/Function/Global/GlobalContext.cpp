@@ -4,6 +4,9 @@
 
 #include "MRuntime/Core/Base/Marco.hpp"
 #include "MRuntime/Core/Log/LogSystem.hpp"
+#include "MRuntime/Core/Base/ThreadPool.hpp"
+#include "MRuntime/Core/Profiler/Profiler.hpp"
+#include "MRuntime/Core/Memory/FrameAllocator.hpp"
 #include "MRuntime/Function/Input/InputSystem.hpp"
 #include "MRuntime/Platform/FileSystem/FileSystem.hpp"
 #include "MRuntime/Function/Render/WindowSystem.hpp"
@@ -11,6 +14,7 @@
 #include "MRuntime/Function/Render/RenderDebugConfig.hpp"
 #include "MRuntime/Function/Render/DebugDraw/DebugDrawManager.hpp"
 #include "MRuntime/Resource/AssetManager/AssetManager.hpp"
+#include "MRuntime/Resource/DerivedDataCache/DerivedDataCache.hpp"
 #include "MRuntime/Function/Framework/World/WorldManager.hpp"
 #include "MRuntime/Resource/ConfigManager/ConfigManager.hpp"
 
@@ -26,14 +30,31 @@ namespace MiniEngine
         mFileSystem = std::make_shared<FileSystem>();
 
         mLoggerSystem = std::make_shared<LogSystem>();
+        LogSystem::LogLevel log_level;
+        if (LogSystem::ParseLevel(mConfigManager->GetLogLevel(), log_level))
+        {
+            mLoggerSystem->SetLevel(log_level);
+        }
+        mLoggerSystem->SetBinaryMode(mConfigManager->IsBinaryLogEnabled());
+
+        mProfiler = std::make_shared<Profiler>();
+        mProfiler->Initialize();
+
+        mThreadPool = std::make_shared<ThreadPool>();
+        mThreadPool->Initialize();
 
         mAssetManager = std::make_shared<AssetManager>();
+        mAssetManager->Initialize();
+
+        mDerivedDataCache = std::make_shared<DerivedDataCache>();
+        mDerivedDataCache->Initialize(mConfigManager->GetDerivedDataFolder());
 
         mWorldManager = std::make_shared<WorldManager>();
         mWorldManager->Initialize();
 
         mWindowSystem = std::make_shared<WindowSystem>();
         WindowCreateInfo window_create_info;
+        window_create_info.IsHeadless = mConfigManager->IsHeadless();
         mWindowSystem->Initialize(window_create_info);
 
         mRenderSystem = std::make_shared<RenderSystem>();
@@ -41,6 +62,10 @@ namespace MiniEngine
         render_init_info.mWindowSystem = mWindowSystem;
         mRenderSystem->Initialize(render_init_info);
 
+        // one frame arena per frame in flight
+        mFrameAllocator = std::make_shared<FrameAllocator>();
+        mFrameAllocator->Initialize(mRenderSystem->GetRHI()->GetMaxFramesInFlight());
+
         mDebugDrawManager = std::make_shared<DebugDrawManager>();
         mDebugDrawManager->Initialize();
 
@@ -60,12 +85,25 @@ namespace MiniEngine
         mRenderSystem->Clear();
         mRenderSystem.reset();
 
+        mFrameAllocator->Clear();
+        mFrameAllocator.reset();
+
         mWindowSystem.reset();
 
+        mDerivedDataCache->Clear();
+        mDerivedDataCache.reset();
+
+        mThreadPool->Clear();
+        mThreadPool.reset();
+
+        mProfiler->Clear();
+        mProfiler.reset();
+
         mLoggerSystem.reset();
 
         mFileSystem.reset();
 
+        mAssetManager->Clear();
         mAssetManager.reset();
 
         mWorldManager->Clear();
@@ -6,12 +6,16 @@
 namespace MiniEngine
 {
     class LogSystem;
+    class ThreadPool;
+    class Profiler;
+    class FrameAllocator;
     class InputSystem;
     class FileSystem;
     class WindowSystem;
     class RenderSystem;
     class DebugDrawManager;
     class AssetManager;
+    class DerivedDataCache;
     class WorldManager;
     class ConfigManager;
     class RenderDebugConfig;
@@ -23,6 +27,9 @@ namespace MiniEngine
         void ShutdownSystems();
 
         std::shared_ptr<LogSystem>          mLoggerSystem;
+        std::shared_ptr<ThreadPool>         mThreadPool;
+        std::shared_ptr<Profiler>           mProfiler;
+        std::shared_ptr<FrameAllocator>     mFrameAllocator;
         std::shared_ptr<InputSystem>        mInputSystem;
         std::shared_ptr<FileSystem>         mFileSystem;
         std::shared_ptr<WindowSystem>       mWindowSystem;
@@ -30,6 +37,7 @@ namespace MiniEngine
 
         std::shared_ptr<DebugDrawManager>   mDebugDrawManager;
         std::shared_ptr<AssetManager>       mAssetManager;
+        std::shared_ptr<DerivedDataCache>   mDerivedDataCache;
         std::shared_ptr<WorldManager>       mWorldManager;
         std::shared_ptr<ConfigManager>      mConfigManager;
         std::shared_ptr<RenderDebugConfig>  mRenderDebugConfig;
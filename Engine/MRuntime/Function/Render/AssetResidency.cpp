@@ -0,0 +1,75 @@
+#include "AssetResidency.hpp"
+
+namespace MiniEngine
+{
+    void AssetResidency::AddReference(size_t asset_id)
+    {
+        Asset& asset = mAssets[asset_id];
+        if (asset.unused)
+        {
+            mUnusedAssets.erase(asset.unused_iter);
+            mUnusedSize -= asset.size;
+            asset.unused = false;
+        }
+        ++asset.ref_count;
+    }
+
+    void AssetResidency::ReleaseReference(size_t asset_id)
+    {
+        auto iter = mAssets.find(asset_id);
+        if (iter == mAssets.end() || iter->second.ref_count == 0)
+        {
+            return;
+        }
+
+        Asset& asset = iter->second;
+        if (--asset.ref_count == 0)
+        {
+            asset.unused      = true;
+            asset.unused_iter = mUnusedAssets.insert(mUnusedAssets.end(), asset_id);
+            mUnusedSize += asset.size;
+        }
+    }
+
+    void AssetResidency::SetSize(size_t asset_id, uint64_t size)
+    {
+        Asset& asset = mAssets[asset_id];
+        if (asset.unused)
+        {
+            mUnusedSize = mUnusedSize - asset.size + size;
+        }
+        asset.size = size;
+    }
+
+    void AssetResidency::Remove(size_t asset_id)
+    {
+        auto iter = mAssets.find(asset_id);
+        if (iter == mAssets.end())
+        {
+            return;
+        }
+
+        if (iter->second.unused)
+        {
+            mUnusedAssets.erase(iter->second.unused_iter);
+            mUnusedSize -= iter->second.size;
+        }
+        mAssets.erase(iter);
+    }
+
+    void AssetResidency::CollectEvictions(uint64_t unused_budget, std::vector<size_t>& evicted_asset_ids)
+    {
+        while (mUnusedSize > unused_budget && !mUnusedAssets.empty())
+        {
+            size_t asset_id = mUnusedAssets.front();
+            evicted_asset_ids.push_back(asset_id);
+            Remove(asset_id);
+        }
+    }
+
+    uint32_t AssetResidency::GetReferenceCount(size_t asset_id) const
+    {
+        auto iter = mAssets.find(asset_id);
+        return iter != mAssets.end() ? iter->second.ref_count : 0;
+    }
+} // namespace MiniEngine
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace MiniEngine
+{
+    /// Reference counts of the meshes or materials used by render entities.
+    /// An asset nothing references any more stays loaded in a least recently used list, it is only evicted once
+    /// the unused assets exceed the budget, so a level loaded again or an object spawned again finds it warm
+    class AssetResidency
+    {
+    public:
+        void AddReference(size_t asset_id);
+        void ReleaseReference(size_t asset_id);
+
+        // gpu memory of a loaded asset
+        void SetSize(size_t asset_id, uint64_t size);
+        void Remove(size_t asset_id);
+
+        // least recently released assets until the unused ones fit the budget, they are removed here
+        void CollectEvictions(uint64_t unused_budget, std::vector<size_t>& evicted_asset_ids);
+
+        uint32_t GetReferenceCount(size_t asset_id) const;
+        uint32_t GetUnusedCount() const { return static_cast<uint32_t>(mUnusedAssets.size()); }
+        uint64_t GetUnusedSize() const { return mUnusedSize; }
+
+    private:
+        struct Asset
+        {
+            uint32_t                    ref_count {0};
+            uint64_t                    size {0};
+            bool                        unused {false};
+            std::list<size_t>::iterator unused_iter;
+        };
+
+        std::unordered_map<size_t, Asset> mAssets;
+        // least recently released first
+        std::list<size_t> mUnusedAssets;
+        uint64_t          mUnusedSize {0};
+    };
+} // namespace MiniEngine
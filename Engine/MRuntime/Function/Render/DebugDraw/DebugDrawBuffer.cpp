@@ -2,6 +2,7 @@
 #include "MRuntime/Function/Global/GlobalContext.hpp"
 #include "MRuntime/Function/Render/RenderSystem.hpp"
 
+#include <algorithm>
 #include <stdexcept>
 
 namespace MiniEngine
@@ -10,11 +11,15 @@ namespace MiniEngine
     { 
         mRHI = gRuntimeGlobalContext.mRenderSystem->GetRHI();
         mFont = font;
+        mVertexResources.resize(mRHI->GetMaxFramesInFlight());
+        mUniformResources.resize(mRHI->GetMaxFramesInFlight());
+        mUniformDynamicResources.resize(mRHI->GetMaxFramesInFlight());
         setupDescriptorSet(); 
     }
     void DebugDrawAllocator::Destory()
     {
         Clear();
+        ClearBuffer();
         unloadMeshBuffer();
     }
 
@@ -24,18 +29,23 @@ namespace MiniEngine
         mCurrentFrame = (mCurrentFrame + 1) % kDeferredDeleteResourceFrameCount;
     }
 
-    RHIBuffer* DebugDrawAllocator::GetVertexBuffer(){return mVertexResource.mBuffer;}
+    RHIBuffer* DebugDrawAllocator::GetVertexBuffer()
+    {
+        return mVertexCount > 0 ? mVertexResources[mRHI->GetCurrentFrameIndex()].mResource.mBuffer : nullptr;
+    }
     RHIDescriptorSet* &DebugDrawAllocator::GetDescriptorSet() { return mDescriptor.mDescSets[mRHI->GetCurrentFrameIndex()]; }
 
-    size_t DebugDrawAllocator::CacheVertexs(const std::vector<DebugDrawVertex>& vertexs)
+    DebugDrawVertex* DebugDrawAllocator::AllocateVertexs(size_t vertex_count)
     {
-        size_t offset = mVertexCache.size();
-        mVertexCache.resize(offset + vertexs.size());
-        for (size_t i = 0; i < vertexs.size(); i++)
+        mVertexCount = vertex_count;
+        if (vertex_count == 0)
         {
-            mVertexCache[i + offset] = vertexs[i];
+            return nullptr;
         }
-        return offset;
+
+        MappedResource& vertex_resource = mVertexResources[mRHI->GetCurrentFrameIndex()];
+        reserveBuffer(vertex_resource, static_cast<uint64_t>(vertex_count * sizeof(DebugDrawVertex)), RHI_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+        return static_cast<DebugDrawVertex*>(vertex_resource.mMappedData);
     }
     void DebugDrawAllocator::CacheUniformObject(Matrix4x4 proj_view_matrix)
     {
@@ -53,10 +63,6 @@ namespace MiniEngine
         return offset;
     }
 
-    size_t DebugDrawAllocator::GetVertexCacheOffset() const
-    {
-        return mVertexCache.size();
-    }
     size_t DebugDrawAllocator::GetUniformDynamicCacheOffset() const
     {
         return mUBODynamicCache.size();
@@ -64,88 +70,90 @@ namespace MiniEngine
 
     void DebugDrawAllocator::Allocator()
     {
-        ClearBuffer();
-        uint64_t vertex_bufferSize = static_cast<uint64_t>(mVertexCache.size() * sizeof(DebugDrawVertex));
-        if (vertex_bufferSize > 0)
-        {
-            mRHI->CreateBuffer(
-                vertex_bufferSize,
-                RHI_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-                RHI_MEMORY_PROPERTY_HOST_VISIBLE_BIT | RHI_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                mVertexResource.mBuffer,
-                mVertexResource.mMemory);
-
-            void* data;
-            mRHI->MapMemory(mVertexResource.mMemory, 0, vertex_bufferSize, 0, &data);
-            memcpy(data, mVertexCache.data(), vertex_bufferSize);
-            mRHI->UnmapMemory(mVertexResource.mMemory);
-        }
+        uint32_t frame_index = mRHI->GetCurrentFrameIndex();
+        bool descriptor_dirty = false;
 
         uint64_t uniform_BufferSize = static_cast<uint64_t>(sizeof(UniformBufferObject));
-        if (uniform_BufferSize > 0)
-        {
-            mRHI->CreateBuffer(
-                uniform_BufferSize,
-                RHI_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-                RHI_MEMORY_PROPERTY_HOST_VISIBLE_BIT | RHI_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                mUniformResource.mBuffer,
-                mUniformResource.mMemory);
-            
-            void* data;
-            mRHI->MapMemory(mUniformResource.mMemory, 0, uniform_BufferSize, 0, &data);
-            memcpy(data, &mUniformBufferObject.mProjViewMatrix, uniform_BufferSize);
-            mRHI->UnmapMemory(mUniformResource.mMemory);
-        }
+        MappedResource& uniform_resource = mUniformResources[frame_index];
+        descriptor_dirty |= reserveBuffer(uniform_resource, uniform_BufferSize, RHI_BUFFER_USAGE_UNIFORM_BUFFER_BIT);
+        memcpy(uniform_resource.mMappedData, &mUniformBufferObject.mProjViewMatrix, uniform_BufferSize);
 
         uint64_t uniform_dynamic_BufferSize = static_cast<uint64_t>(sizeof(UniformBufferDynamicObject) * mUBODynamicCache.size());
         if (uniform_dynamic_BufferSize > 0)
         {
-            mRHI->CreateBuffer(
-                uniform_dynamic_BufferSize,
-                RHI_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-                RHI_MEMORY_PROPERTY_HOST_VISIBLE_BIT | RHI_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                mUniformDynamicResource.mBuffer,
-                mUniformDynamicResource.mMemory);
-            
-            void* data;
-            mRHI->MapMemory(mUniformDynamicResource.mMemory, 0, uniform_dynamic_BufferSize, 0, &data);
-            memcpy(data, mUBODynamicCache.data(), uniform_dynamic_BufferSize);
-            mRHI->UnmapMemory(mUniformDynamicResource.mMemory);
+            MappedResource& uniform_dynamic_resource = mUniformDynamicResources[frame_index];
+            descriptor_dirty |= reserveBuffer(uniform_dynamic_resource, uniform_dynamic_BufferSize, RHI_BUFFER_USAGE_UNIFORM_BUFFER_BIT);
+            memcpy(uniform_dynamic_resource.mMappedData, mUBODynamicCache.data(), uniform_dynamic_BufferSize);
+        }
+
+        // the descriptor set of this frame only changes when one of its buffers was recreated
+        if (descriptor_dirty)
+        {
+            updateDescriptorSet();
         }
-        
-        updateDescriptorSet();
     }
 
     void DebugDrawAllocator::Clear()
     {
-        ClearBuffer();
-        mVertexCache.clear();
+        mVertexCount = 0;
         mUniformBufferObject.mProjViewMatrix = Matrix4x4::IDENTITY;
         mUBODynamicCache.clear();
     }
 
     void DebugDrawAllocator::ClearBuffer()
     {
-        if (mVertexResource.mBuffer)
+        for (MappedResource& resource : mVertexResources)
         {
-            mDeferredDeleteQueue[mCurrentFrame].push(mVertexResource);
-            mVertexResource.mBuffer = nullptr;
-            mVertexResource.mMemory = nullptr;
+            retireBuffer(resource);
         }
-        if (mUniformResource.mBuffer)
+        for (MappedResource& resource : mUniformResources)
         {
-            mDeferredDeleteQueue[mCurrentFrame].push(mUniformResource);
-            mUniformResource.mBuffer = nullptr;
-            mUniformResource.mMemory = nullptr;
+            retireBuffer(resource);
         }
-        if (mUniformDynamicResource.mBuffer)
+        for (MappedResource& resource : mUniformDynamicResources)
         {
-            mDeferredDeleteQueue[mCurrentFrame].push(mUniformDynamicResource);
-            mUniformDynamicResource.mBuffer = nullptr;
-            mUniformDynamicResource.mMemory = nullptr;
+            retireBuffer(resource);
         }
     }
 
+    bool DebugDrawAllocator::reserveBuffer(MappedResource& resource, uint64_t size, RHIBufferUsageFlags usage)
+    {
+        if (size <= resource.mCapacity)
+        {
+            return false;
+        }
+
+        // grow geometrically so that a rising primitive count settles after a few frames
+        static const uint64_t min_capacity = 64 * 1024;
+        uint64_t capacity = std::max(std::max(size, resource.mCapacity * 2), min_capacity);
+
+        retireBuffer(resource);
+        mRHI->CreateBuffer(
+            capacity,
+            usage,
+            RHI_MEMORY_PROPERTY_HOST_VISIBLE_BIT | RHI_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            resource.mResource.mBuffer,
+            resource.mResource.mMemory);
+        mRHI->MapMemory(resource.mResource.mMemory, 0, capacity, 0, &resource.mMappedData);
+        resource.mCapacity = capacity;
+        return true;
+    }
+
+    void DebugDrawAllocator::retireBuffer(MappedResource& resource)
+    {
+        if (resource.mResource.mBuffer == nullptr)
+        {
+            return;
+        }
+
+        mRHI->UnmapMemory(resource.mResource.mMemory);
+        mDeferredDeleteQueue[mCurrentFrame].push(resource.mResource);
+        resource.mResource.mBuffer = nullptr;
+        resource.mResource.mMemory = nullptr;
+        resource.mMappedData = nullptr;
+        resource.mCapacity = 0;
+    }
+
     void DebugDrawAllocator::flushPendingDelete()
     {
         uint32_t current_frame_to_delete = (mCurrentFrame + 1) % kDeferredDeleteResourceFrameCount;
@@ -193,14 +201,7 @@ namespace MiniEngine
         mDescriptor.mDescSets.resize(mRHI->GetMaxFramesInFlight());
         for (size_t i = 0; i < mRHI->GetMaxFramesInFlight(); i++)
         {
-            RHIDescriptorSetAllocateInfo allocInfo{};
-            allocInfo.sType = RHI_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-            allocInfo.pNext = NULL;
-            allocInfo.descriptorPool = mRHI->GetDescriptorPool();
-            allocInfo.descriptorSetCount = 1;
-            allocInfo.pSetLayouts = &mDescriptor.mDescLayout;
-
-            if (RHI_SUCCESS != mRHI->AllocateDescriptorSets(&allocInfo, mDescriptor.mDescSets[i]))
+            if (RHI_SUCCESS != mRHI->AllocateDescriptorSet(mDescriptor.mDescLayout, mDescriptor.mDescSets[i]))
             {
                 throw std::runtime_error("debug draw descriptor set");
             }
@@ -235,21 +236,23 @@ namespace MiniEngine
         }
     }
 
-    //update every tick
+    //update when the buffers of the current frame are recreated
     void DebugDrawAllocator::updateDescriptorSet()
     {
+        uint32_t frame_index = mRHI->GetCurrentFrameIndex();
+
         RHIDescriptorBufferInfo buffer_info[2];
-        buffer_info[0].buffer = mUniformResource.mBuffer;
+        buffer_info[0].buffer = mUniformResources[frame_index].mResource.mBuffer;
         buffer_info[0].offset = 0;
         buffer_info[0].range = sizeof(UniformBufferObject);
 
-        buffer_info[1].buffer = mUniformDynamicResource.mBuffer;
+        buffer_info[1].buffer = mUniformDynamicResources[frame_index].mResource.mBuffer;
         buffer_info[1].offset = 0;
         buffer_info[1].range = sizeof(UniformBufferDynamicObject);
         
         RHIWriteDescriptorSet descriptor_write[2];
         descriptor_write[0].sType = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptor_write[0].dstSet = mDescriptor.mDescSets[mRHI->GetCurrentFrameIndex()];
+        descriptor_write[0].dstSet = mDescriptor.mDescSets[frame_index];
         descriptor_write[0].dstBinding = 0;
         descriptor_write[0].dstArrayElement = 0;
         descriptor_write[0].pNext = nullptr;
@@ -260,7 +263,7 @@ namespace MiniEngine
         descriptor_write[0].pTexelBufferView = nullptr;
 
         descriptor_write[1].sType = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        descriptor_write[1].dstSet = mDescriptor.mDescSets[mRHI->GetCurrentFrameIndex()];
+        descriptor_write[1].dstSet = mDescriptor.mDescSets[frame_index];
         descriptor_write[1].dstBinding = 1;
         descriptor_write[1].dstArrayElement = 0;
         descriptor_write[1].pNext = nullptr;
@@ -17,12 +17,13 @@ namespace MiniEngine
         void Clear();
         void ClearBuffer();
         
-        size_t CacheVertexs(const std::vector<DebugDrawVertex>& vertexs);
+        // makes room for the vertices of this frame and returns the mapped memory to write them into
+        DebugDrawVertex* AllocateVertexs(size_t vertex_count);
         void CacheUniformObject(Matrix4x4 proj_view_matrix);
         size_t CacheUniformDynamicObject(const std::vector<std::pair<Matrix4x4,Vector4> >& model_colors);
 
-        size_t GetVertexCacheOffset() const;
         size_t GetUniformDynamicCacheOffset() const;
+        // uploads the cached uniform data of this frame
         void Allocator();
 
         RHIBuffer* GetVertexBuffer();
@@ -45,6 +46,7 @@ namespace MiniEngine
         void prepareDescriptorSet();
         void updateDescriptorSet();
         void flushPendingDelete();
+
         void unloadMeshBuffer();
         void loadSphereMeshBuffer();
         void loadCylinderMeshBuffer();
@@ -77,14 +79,25 @@ namespace MiniEngine
         //descriptor
         Descriptor mDescriptor;
 
-        //changeable resource
-        Resource mVertexResource;
-        std::vector<DebugDrawVertex> mVertexCache;
+        // persistently mapped buffer that is reused across frames and only recreated when it has to grow
+        struct MappedResource
+        {
+            Resource mResource;
+            void*    mMappedData = nullptr;
+            uint64_t mCapacity = 0;
+        };
+
+        bool reserveBuffer(MappedResource& resource, uint64_t size, RHIBufferUsageFlags usage);
+        void retireBuffer(MappedResource& resource);
+
+        //changeable resource, one per frame in flight since the gpu may still read the previous ones
+        std::vector<MappedResource> mVertexResources;
+        size_t mVertexCount = 0;
 
-        Resource mUniformResource;
+        std::vector<MappedResource> mUniformResources;
         UniformBufferObject mUniformBufferObject;
 
-        Resource mUniformDynamicResource;
+        std::vector<MappedResource> mUniformDynamicResources;
         std::vector<UniformBufferDynamicObject>mUBODynamicCache;
 
         //static mesh resource
@@ -50,6 +50,8 @@ namespace MiniEngine
         for (size_t debug_draw_group_index = 0; debug_draw_group_index < debug_draw_group_count; debug_draw_group_index++)
         {
             if (mDebugDrawGroup[debug_draw_group_index] == nullptr)continue;
+            // primitives submitted this frame join before expiry so that one frame primitives are drawn exactly once
+            mDebugDrawGroup[debug_draw_group_index]->FlushThreadBuffers();
             mDebugDrawGroup[debug_draw_group_index]->RemoveDeadPrimitives(deltaTime);
         }
     }
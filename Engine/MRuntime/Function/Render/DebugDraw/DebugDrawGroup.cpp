@@ -3,13 +3,106 @@
 #include "MRuntime/Function/Global/GlobalContext.hpp"
 #include "MRuntime/Function/Render/RenderSystem.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <unordered_set>
 #include <vector>
 
 namespace MiniEngine
 {
+    namespace
+    {
+        struct ThreadAppendBufferEntry
+        {
+            uint64_t group_id;
+            void*    buffer;
+        };
+
+        std::atomic<uint64_t> g_debug_draw_group_id {1};
+        // groups this thread has drawn into, a thread usually touches only a handful of them
+        thread_local std::vector<ThreadAppendBufferEntry> t_thread_append_buffers;
+
+        // a destroyed group can not reach the lookups of other threads, each thread prunes its own
+        // entries against the live ids on its next draw after a destruction
+        std::mutex                   g_live_group_mutex;
+        std::unordered_set<uint64_t> g_live_group_ids;
+        std::atomic<uint64_t>        g_destroyed_group_count {0};
+        thread_local uint64_t        t_seen_destroyed_group_count {0};
+
+        void pruneDestroyedGroupEntries()
+        {
+            uint64_t destroyed_count = g_destroyed_group_count.load(std::memory_order_acquire);
+            if (destroyed_count == t_seen_destroyed_group_count)
+                return;
+
+            std::lock_guard<std::mutex> guard(g_live_group_mutex);
+            t_thread_append_buffers.erase(std::remove_if(t_thread_append_buffers.begin(),
+                                                         t_thread_append_buffers.end(),
+                                                         [](const ThreadAppendBufferEntry& entry) {
+                                                             return g_live_group_ids.count(entry.group_id) == 0;
+                                                         }),
+                                          t_thread_append_buffers.end());
+            t_seen_destroyed_group_count = destroyed_count;
+        }
+
+        const size_t s_triangle_line_indices[] = {0, 1, 1, 2, 2, 0};
+        const size_t s_quad_line_indices[]     = {0, 1, 1, 2, 2, 3, 3, 0};
+        const size_t s_box_line_indices[]      = {0, 1, 1, 3, 3, 2, 2, 0, 4, 5, 5, 7, 7, 6, 6, 4, 0, 4, 1, 5, 3, 7, 2, 6};
+    } // namespace
+
+    void DebugDrawPrimitiveStorage::Append(const DebugDrawPrimitiveStorage& other)
+    {
+        mPoints.Append(other.mPoints);
+        mLines.Append(other.mLines);
+        mTriangles.Append(other.mTriangles);
+        mQuads.Append(other.mQuads);
+        mBoxes.Append(other.mBoxes);
+        mCylinders.Append(other.mCylinders);
+        mSpheres.Append(other.mSpheres);
+        mCapsules.Append(other.mCapsules);
+        mTexts.Append(other.mTexts);
+    }
+
+    void DebugDrawPrimitiveStorage::Clear()
+    {
+        mPoints.Clear();
+        mLines.Clear();
+        mTriangles.Clear();
+        mQuads.Clear();
+        mBoxes.Clear();
+        mCylinders.Clear();
+        mSpheres.Clear();
+        mCapsules.Clear();
+        mTexts.Clear();
+    }
+
+    void DebugDrawPrimitiveStorage::RemoveDead(float delta_time)
+    {
+        mPoints.RemoveDead(delta_time);
+        mLines.RemoveDead(delta_time);
+        mTriangles.RemoveDead(delta_time);
+        mQuads.RemoveDead(delta_time);
+        mBoxes.RemoveDead(delta_time);
+        mCylinders.RemoveDead(delta_time);
+        mSpheres.RemoveDead(delta_time);
+        mCapsules.RemoveDead(delta_time);
+        mTexts.RemoveDead(delta_time);
+    }
+
+    DebugDrawGroup::DebugDrawGroup() : mGroupID(g_debug_draw_group_id.fetch_add(1, std::memory_order_relaxed))
+    {
+        std::lock_guard<std::mutex> guard(g_live_group_mutex);
+        g_live_group_ids.insert(mGroupID);
+    }
+
     DebugDrawGroup::~DebugDrawGroup()
     {
         Clear();
+
+        std::lock_guard<std::mutex> guard(g_live_group_mutex);
+        g_live_group_ids.erase(mGroupID);
+        g_destroyed_group_count.fetch_add(1, std::memory_order_release);
     }
 
     void DebugDrawGroup::Initialize()
@@ -24,15 +117,13 @@ namespace MiniEngine
 
     void DebugDrawGroup::ClearData()
     {
-        mPoints.clear();
-        mLines.clear();
-        mTriangles.clear();
-        mQuads.clear();
-        mBoxes.clear();
-        mCylinders.clear();
-        mSpheres.clear();
-        mCapsules.clear();
-        mTexts.clear();
+        mStorage.Clear();
+
+        std::lock_guard<std::mutex> thread_buffer_guard(mThreadBufferMutex);
+        for (std::unique_ptr<ThreadAppendBuffer>& thread_buffer : mThreadBuffers)
+        {
+            flipThreadAppendBuffer(*thread_buffer).Clear();
+        }
     }
 
     void DebugDrawGroup::SetName(const std::string &name)
@@ -45,43 +136,52 @@ namespace MiniEngine
         return mName;
     }
 
+    DebugDrawGroup::ThreadAppendBuffer& DebugDrawGroup::getThreadAppendBuffer()
+    {
+        pruneDestroyedGroupEntries();
+
+        for (const ThreadAppendBufferEntry& entry : t_thread_append_buffers)
+        {
+            if (entry.group_id == mGroupID)
+            {
+                return *static_cast<ThreadAppendBuffer*>(entry.buffer);
+            }
+        }
+
+        // first draw of this thread into the group
+        std::lock_guard<std::mutex> guard(mThreadBufferMutex);
+        mThreadBuffers.push_back(std::make_unique<ThreadAppendBuffer>());
+        ThreadAppendBuffer* thread_buffer = mThreadBuffers.back().get();
+        t_thread_append_buffers.push_back({mGroupID, thread_buffer});
+        return *thread_buffer;
+    }
+
     void DebugDrawGroup::AddPoint(const Vector3 &position, const Vector4 &color, const float life_time, const bool no_depth_test)
     {
-        std::lock_guard<std::mutex> guard(mMutex);
         DebugDrawPoint point;
+        point.mVertex.mPos   = position;
         point.mVertex.mColor = color;
-        point.SetTime(life_time);
-        point.mFillMode = FillMode::Wireframe;
-        point.mVertex.mPos = position;
-        point.mbNoDepthTest = no_depth_test;
-        mPoints.push_back(point);
+
+        ThreadAppendScope append(getThreadAppendBuffer());
+        append.GetStorage().mPoints.Add(point, life_time, no_depth_test);
     }
 
     void DebugDrawGroup::AddLine(const Vector3 &point0, const Vector3 &point1, const Vector4 &color0, const Vector4 &color1, const float life_time, const bool no_depth_test)
     {
-        std::lock_guard<std::mutex> guard(mMutex);
         DebugDrawLine line;
-        line.SetTime(life_time);
-        line.mFillMode = FillMode::Wireframe;
-        line.mbNoDepthTest = no_depth_test;
-
         line.mVertex[0].mPos   = point0;
         line.mVertex[0].mColor = color0;
 
         line.mVertex[1].mPos   = point1;
         line.mVertex[1].mColor = color1;
 
-        mLines.push_back(line);
+        ThreadAppendScope append(getThreadAppendBuffer());
+        append.GetStorage().mLines.Add(line, life_time, no_depth_test);
     }
 
     void DebugDrawGroup::AddTriangle(const Vector3 &point0, const Vector3 &point1, const Vector3 &point2, const Vector4 &color0, const Vector4 &color1, const Vector4 &color2, const float life_time, const bool no_depth_test, const FillMode fillmod)
     {
-        std::lock_guard<std::mutex> guard(mMutex);
         DebugDrawTriangle triangle;
-        triangle.SetTime(life_time);
-        triangle.mFillMode = fillmod;
-        triangle.mbNoDepthTest = no_depth_test;
-
         triangle.mVertex[0].mPos   = point0;
         triangle.mVertex[0].mColor = color0;
 
@@ -90,13 +190,14 @@ namespace MiniEngine
 
         triangle.mVertex[2].mPos   = point2;
         triangle.mVertex[2].mColor = color2;
-        
-        mTriangles.push_back(triangle);
+
+        ThreadAppendScope append(getThreadAppendBuffer());
+        append.GetStorage().mTriangles.Add(triangle, life_time, no_depth_test, fillmod);
     }
     
     void DebugDrawGroup::AddQuad(const Vector3 &point0, const Vector3 &point1, const Vector3 &point2, const Vector3 &point3, const Vector4 &color0, const Vector4 &color1, const Vector4 &color2, const Vector4 &color3, const float life_time, const bool no_depth_test, const FillMode fillmode)
     {
-        std::lock_guard<std::mutex> guard(mMutex);
+        ThreadAppendScope append(getThreadAppendBuffer());
         if (fillmode == FillMode::Wireframe)
         {
             DebugDrawQuad quad;
@@ -113,81 +214,67 @@ namespace MiniEngine
             quad.mVertex[3].mPos   = point3;
             quad.mVertex[3].mColor = color3;
 
-            quad.SetTime(life_time);
-            quad.mbNoDepthTest = no_depth_test;
-
-            mQuads.push_back(quad);
+            append.GetStorage().mQuads.Add(quad, life_time, no_depth_test);
         }
         else
         {
             DebugDrawTriangle triangle;
-            triangle.SetTime(life_time);
-            triangle.mFillMode         = FillMode::Solid;
-            triangle.mbNoDepthTest   = no_depth_test;
-
-            triangle.mVertex[0].mPos     = point0;
-            triangle.mVertex[0].mColor   = color0;
-            triangle.mVertex[1].mPos     = point1;
-            triangle.mVertex[1].mColor   = color1;
-            triangle.mVertex[2].mPos     = point2;
-            triangle.mVertex[2].mColor   = color2;
-            mTriangles.push_back(triangle);
-
-            triangle.mVertex[0].mPos     = point0;
+            triangle.mVertex[0].mPos   = point0;
+            triangle.mVertex[0].mColor = color0;
+            triangle.mVertex[1].mPos   = point1;
+            triangle.mVertex[1].mColor = color1;
+            triangle.mVertex[2].mPos   = point2;
+            triangle.mVertex[2].mColor = color2;
+            append.GetStorage().mTriangles.Add(triangle, life_time, no_depth_test, FillMode::Solid);
+
+            triangle.mVertex[0].mPos   = point0;
             triangle.mVertex[0].mColor = color0;
-            triangle.mVertex[1].mPos     = point2;
+            triangle.mVertex[1].mPos   = point2;
             triangle.mVertex[1].mColor = color2;
-            triangle.mVertex[2].mPos     = point3;
+            triangle.mVertex[2].mPos   = point3;
             triangle.mVertex[2].mColor = color3;
-            mTriangles.push_back(triangle);
+            append.GetStorage().mTriangles.Add(triangle, life_time, no_depth_test, FillMode::Solid);
         }
     }
 
     void DebugDrawGroup::AddBox(const Vector3 &center_point, const Vector3 &half_extends, const Vector4 &rotate, const Vector4 &color, const float life_time, const bool no_depth_test)
     {
-        std::lock_guard<std::mutex> guard(mMutex);
         DebugDrawBox box;
         box.mCenterPoint = center_point;
         box.mHalfExtents = half_extends;
         box.mRotation = rotate;
         box.mColor = color;
-        box.mbNoDepthTest = no_depth_test;
-        box.SetTime(life_time);
 
-        mBoxes.push_back(box);
+        ThreadAppendScope append(getThreadAppendBuffer());
+        append.GetStorage().mBoxes.Add(box, life_time, no_depth_test);
     }
 
     void DebugDrawGroup::AddSphere(const Vector3 &center, const float radius, const Vector4 &color, const float life_time, const bool no_depth_test)
     {
-        std::lock_guard<std::mutex> guard(mMutex);
         DebugDrawSphere sphere;
         sphere.mCenter = center;
         sphere.mRadius = radius;
         sphere.mColor = color;
-        sphere.mbNoDepthTest = no_depth_test;
-        sphere.SetTime(life_time);
 
-        mSpheres.push_back(sphere);
+        ThreadAppendScope append(getThreadAppendBuffer());
+        append.GetStorage().mSpheres.Add(sphere, life_time, no_depth_test);
     }
 
     void DebugDrawGroup::AddCylinder(const Vector3 &center, const float radius, const float height, const Vector4 &rotate, const Vector4 &color, const float life_time, const bool no_depth_test)
     {
-        std::lock_guard<std::mutex> guard(mMutex);
         DebugDrawCylinder cylinder;
         cylinder.mRadius = radius;
         cylinder.mCenter = center;
         cylinder.mHeight = height;
         cylinder.mRotation = rotate;
         cylinder.mColor = color;
-        cylinder.mbNoDepthTest = no_depth_test;
-        cylinder.SetTime(life_time);
 
-        mCylinders.push_back(cylinder);
+        ThreadAppendScope append(getThreadAppendBuffer());
+        append.GetStorage().mCylinders.Add(cylinder, life_time, no_depth_test);
     }
 
     void DebugDrawGroup::AddCapsule(const Vector3 &center, const Vector4 &rotation, const Vector3 &scale, const float radius, const float height, const Vector4 &color, const float life_time, const bool no_depth_test)
     {
-        std::lock_guard<std::mutex> guard(mMutex);
         DebugDrawCapsule capsule;
         capsule.mCenter = center;
         capsule.mRotation = rotation;
@@ -195,217 +282,127 @@ namespace MiniEngine
         capsule.mRadius = radius;
         capsule.mHeight = height;
         capsule.mColor = color;
-        capsule.mbNoDepthTest = no_depth_test;
-        capsule.SetTime(life_time);
 
-        mCapsules.push_back(capsule);
+        ThreadAppendScope append(getThreadAppendBuffer());
+        append.GetStorage().mCapsules.Add(capsule, life_time, no_depth_test);
     }
 
     void DebugDrawGroup::AddText(const std::string &content, const Vector4 &color, const Vector3 &coordinate, const int size, const bool is_screen_text, const float life_time)
     {
-        std::lock_guard<std::mutex> guard(mMutex);
         DebugDrawText text;
         text.mContent = content;
         text.mColor = color;
         text.mCoordinate = coordinate;
         text.mSize = size;
         text.mbIsScreenText = is_screen_text;
-        text.SetTime(life_time);
-        mTexts.push_back(text);
+
+        ThreadAppendScope append(getThreadAppendBuffer());
+        append.GetStorage().mTexts.Add(text, life_time, false);
     }
 
-    void DebugDrawGroup::RemoveDeadPrimitives(float delta_time)
+    DebugDrawGroup::ThreadAppendScope::ThreadAppendScope(ThreadAppendBuffer& buffer) : mBuffer(buffer)
     {
-        for (std::list<DebugDrawPoint>::iterator point = mPoints.begin(); point != mPoints.end();)
-        {
-            if (point->IsTimeOut(delta_time)) {
-                point = mPoints.erase(point);
-            }
-            else {
-                point++;
-            }
-        }
-        for (std::list<DebugDrawLine>::iterator line = mLines.begin(); line != mLines.end();)
-        {
-            if (line->IsTimeOut(delta_time)) {
-                line = mLines.erase(line);
-            }
-            else {
-                line++;
-            }
-        }
-        for (std::list<DebugDrawTriangle>::iterator triangle = mTriangles.begin(); triangle != mTriangles.end();)
-        {
-            if (triangle->IsTimeOut(delta_time)) {
-                triangle = mTriangles.erase(triangle);
-            }
-            else {
-                triangle++;
-            }
-        }
-        for (std::list<DebugDrawQuad>::iterator quad = mQuads.begin(); quad != mQuads.end();)
-        {
-            if (quad->IsTimeOut(delta_time)) {
-                quad = mQuads.erase(quad);
-            }
-            else {
-                quad++;
-            }
-        }
-        for (std::list<DebugDrawBox>::iterator box = mBoxes.begin(); box != mBoxes.end();)
-        {
-            if (box->IsTimeOut(delta_time)) {
-                box = mBoxes.erase(box);
-            }
-            else {
-                box++;
-            }
-        }
-        for (std::list<DebugDrawCylinder>::iterator cylinder = mCylinders.begin(); cylinder != mCylinders.end();)
-        {
-            if (cylinder->IsTimeOut(delta_time)) {
-                cylinder = mCylinders.erase(cylinder);
-            }
-            else {
-                cylinder++;
-            }
-        }
-        for (std::list<DebugDrawSphere>::iterator sphere = mSpheres.begin(); sphere != mSpheres.end();)
-        {
-            if (sphere->IsTimeOut(delta_time)) {
-                sphere = mSpheres.erase(sphere);
-            }
-            else {
-                sphere++;
-            }
-        }
-        for (std::list<DebugDrawCapsule>::iterator capsule = mCapsules.begin(); capsule != mCapsules.end();)
+        uint32_t state = mBuffer.mState.fetch_or(2u, std::memory_order_acquire);
+        mStorage       = &mBuffer.mStorages[state & 1u];
+    }
+
+    DebugDrawGroup::ThreadAppendScope::~ThreadAppendScope()
+    {
+        mBuffer.mState.fetch_and(~2u, std::memory_order_release);
+    }
+
+    DebugDrawPrimitiveStorage& DebugDrawGroup::flipThreadAppendBuffer(ThreadAppendBuffer& buffer)
+    {
+        uint32_t state = buffer.mState.fetch_xor(1u, std::memory_order_acq_rel);
+
+        // an append that picked the old storage before the flip is at most one Add away from done:
+        // the scope only wraps a single push into the storage, takes no lock and never calls back
+        // into the group, so the wait is bounded by that push (a reallocation at worst) plus the
+        // time slice of a writer preempted inside it, which the yield hands back
+        while (buffer.mState.load(std::memory_order_acquire) & 2u)
         {
-            if (capsule->IsTimeOut(delta_time)) {
-                capsule = mCapsules.erase(capsule);
-            }
-            else {
-                capsule++;
-            }
+            std::this_thread::yield();
         }
-        for (std::list<DebugDrawText>::iterator text = mTexts.begin(); text != mTexts.end();)
+        return buffer.mStorages[state & 1u];
+    }
+
+    void DebugDrawGroup::FlushThreadBuffers()
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        flushThreadBuffers();
+    }
+
+    void DebugDrawGroup::flushThreadBuffers()
+    {
+        std::lock_guard<std::mutex> thread_buffer_guard(mThreadBufferMutex);
+        for (std::unique_ptr<ThreadAppendBuffer>& thread_buffer : mThreadBuffers)
         {
-            if (text->IsTimeOut(delta_time)) {
-                text = mTexts.erase(text);
-            }
-            else {
-                text++;
-            }
+            DebugDrawPrimitiveStorage& storage = flipThreadAppendBuffer(*thread_buffer);
+            mStorage.Append(storage);
+            storage.Clear();
         }
     }
 
+    void DebugDrawGroup::RemoveDeadPrimitives(float delta_time)
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        mStorage.RemoveDead(delta_time);
+    }
+
     void DebugDrawGroup::MergeFrom(DebugDrawGroup *group)
     {
         std::lock_guard<std::mutex> guard(mMutex);
         std::lock_guard<std::mutex> guard_2(group->mMutex);
-        mPoints.insert(mPoints.end(), group->mPoints.begin(), group->mPoints.end());
-        mLines.insert(mLines.end(), group->mLines.begin(), group->mLines.end());
-        mTriangles.insert(mTriangles.end(), group->mTriangles.begin(), group->mTriangles.end());
-        mQuads.insert(mQuads.end(), group->mQuads.begin(), group->mQuads.end());
-        mBoxes.insert(mBoxes.end(), group->mBoxes.begin(), group->mBoxes.end());
-        mCylinders.insert(mCylinders.end(), group->mCylinders.begin(), group->mCylinders.end());
-        mSpheres.insert(mSpheres.end(), group->mSpheres.begin(), group->mSpheres.end());
-        mCapsules.insert(mCapsules.end(), group->mCapsules.begin(), group->mCapsules.end());
-        mTexts.insert(mTexts.end(), group->mTexts.begin(), group->mTexts.end());
+        // primitives still in the thread buffers of the source would otherwise miss this merge
+        group->flushThreadBuffers();
+        mStorage.Append(group->mStorage);
     }
 
     size_t DebugDrawGroup::GetPointCount(bool no_depth_test) const
     {
-        size_t count = 0;
-        for (const DebugDrawPoint point : mPoints)
-        {
-            if (point.mbNoDepthTest == no_depth_test)count++;
-        }
-        return count;
+        return mStorage.mPoints.Count(no_depth_test);
     }
 
     size_t DebugDrawGroup::GetLineCount(bool no_depth_test) const
     {
-        size_t line_count = 0;
-        for (const DebugDrawLine line : mLines)
-        {
-            if (line.mbNoDepthTest == no_depth_test)line_count++;
-        }
-        for (const DebugDrawTriangle triangle : mTriangles)
-        {
-            if (triangle.mFillMode == FillMode::Wireframe && triangle.mbNoDepthTest == no_depth_test)
-            {
-                line_count += 3;
-            }
-        }
-        for (const DebugDrawQuad quad : mQuads)
-        {
-            if (quad.mFillMode == FillMode::Wireframe && quad.mbNoDepthTest == no_depth_test)
-            {
-                line_count += 4;
-            }
-        }
-        for (const DebugDrawBox box : mBoxes)
-        {
-            if (box.mbNoDepthTest == no_depth_test)line_count += 12;
-        }
-        return line_count;
+        return mStorage.mLines.Count(no_depth_test) +
+               mStorage.mTriangles.Count(no_depth_test, FillMode::Wireframe) * 3 +
+               mStorage.mQuads.Count(no_depth_test, FillMode::Wireframe) * 4 +
+               mStorage.mBoxes.Count(no_depth_test) * 12;
     }
 
     size_t DebugDrawGroup::GetTriangleCount(bool no_depth_test) const
     {
-        size_t triangle_count = 0;
-        for (const DebugDrawTriangle triangle : mTriangles)
-        {
-            if (triangle.mFillMode == FillMode::Solid && triangle.mbNoDepthTest == no_depth_test)
-            {
-                triangle_count++;
-            }
-        }
-        return triangle_count;
+        return mStorage.mTriangles.Count(no_depth_test, FillMode::Solid);
     }
 
     size_t DebugDrawGroup::GetUniformDynamicDataCount() const
     {
-        return mSpheres.size() + mCylinders.size() + mCapsules.size();
+        // a capsule is drawn in three parts
+        return mStorage.mSpheres.Size() + mStorage.mCylinders.Size() + mStorage.mCapsules.Size() * 3;
     }
 
     size_t DebugDrawGroup::GetSphereCount(bool no_depth_test) const
     {
-        size_t count = 0;
-        for (const DebugDrawSphere sphere : mSpheres)
-        {
-            if (sphere.mbNoDepthTest == no_depth_test)count++;
-        }
-        return count; 
+        return mStorage.mSpheres.Count(no_depth_test);
     }
 
     size_t DebugDrawGroup::GetCylinderCount(bool no_depth_test) const
     {
-        size_t count = 0;
-        for (const DebugDrawCylinder cylinder : mCylinders)
-        {
-            if (cylinder.mbNoDepthTest == no_depth_test)count++;
-        }
-        return count;
+        return mStorage.mCylinders.Count(no_depth_test);
     }
 
     size_t DebugDrawGroup::GetCapsuleCount(bool no_depth_test) const
     {
-        size_t count = 0;
-        for (const DebugDrawCapsule capsule : mCapsules)
-        {
-            if (capsule.mbNoDepthTest == no_depth_test)count++;
-        }
-        return count;
+        return mStorage.mCapsules.Count(no_depth_test);
     }
 
     size_t DebugDrawGroup::GetTextCharacterCount() const
     {
         size_t count = 0;
-        for (const DebugDrawText text : mTexts)
+        for (size_t i = 0; i < mStorage.mTexts.Size(); i++)
         {
-            for (unsigned char character : text.mContent)
+            for (unsigned char character : mStorage.mTexts.Get(i).mContent)
             {
                 if (character != '\n')count++;
             }
@@ -413,114 +410,109 @@ namespace MiniEngine
         return count;
     }
 
-    void DebugDrawGroup::WritePointData(std::vector<DebugDrawVertex> &vertexs, bool no_depth_test)
+    size_t DebugDrawGroup::WritePointData(DebugDrawVertex* vertexs, bool no_depth_test) const
     {
-        size_t vertexs_count = GetPointCount(no_depth_test);
-        vertexs.resize(vertexs_count);
-
         size_t current_index = 0;
-        for (DebugDrawPoint point : mPoints)
+        for (size_t i = 0; i < mStorage.mPoints.Size(); i++)
         {
-            if (point.mbNoDepthTest == no_depth_test)vertexs[current_index++] = point.mVertex;
+            if (mStorage.mPoints.IsNoDepthTest(i) == no_depth_test)vertexs[current_index++] = mStorage.mPoints.Get(i).mVertex;
         }
+        return current_index;
     }
 
-    void DebugDrawGroup::WriteLineData(std::vector<DebugDrawVertex> &vertexs, bool no_depth_test)
+    size_t DebugDrawGroup::WriteLineData(DebugDrawVertex* vertexs, bool no_depth_test) const
     {
-        size_t vertexs_count = GetLineCount(no_depth_test) * 2;
-        vertexs.resize(vertexs_count);
-
         size_t current_index = 0;
-        for (DebugDrawLine line : mLines)
+        for (size_t i = 0; i < mStorage.mLines.Size(); i++)
         {
-            if (line.mFillMode == FillMode::Wireframe && line.mbNoDepthTest == no_depth_test)
+            if (mStorage.mLines.IsNoDepthTest(i) == no_depth_test)
             {
+                const DebugDrawLine& line = mStorage.mLines.Get(i);
                 vertexs[current_index++] = line.mVertex[0];
                 vertexs[current_index++] = line.mVertex[1];
             }
         }
-        for (DebugDrawTriangle triangle : mTriangles)
+        for (size_t i = 0; i < mStorage.mTriangles.Size(); i++)
         {
-            if (triangle.mFillMode == FillMode::Wireframe && triangle.mbNoDepthTest == no_depth_test)
+            if (mStorage.mTriangles.GetFillMode(i) == FillMode::Wireframe && mStorage.mTriangles.IsNoDepthTest(i) == no_depth_test)
             {
-                std::vector<size_t> indies = { 0,1, 1,2, 2,0 };
-                for (size_t i : indies)
+                const DebugDrawTriangle& triangle = mStorage.mTriangles.Get(i);
+                for (size_t index : s_triangle_line_indices)
                 {
-                    vertexs[current_index++] = triangle.mVertex[i];
+                    vertexs[current_index++] = triangle.mVertex[index];
                 }
             }
         }
-        for (DebugDrawQuad quad : mQuads)
+        for (size_t i = 0; i < mStorage.mQuads.Size(); i++)
         {
-            if (quad.mFillMode == FillMode::Wireframe && quad.mbNoDepthTest == no_depth_test)
+            if (mStorage.mQuads.GetFillMode(i) == FillMode::Wireframe && mStorage.mQuads.IsNoDepthTest(i) == no_depth_test)
             {
-                std::vector<size_t> indies = { 0,1, 1,2, 2,3, 3,0 };
-                for (size_t i : indies)
+                const DebugDrawQuad& quad = mStorage.mQuads.Get(i);
+                for (size_t index : s_quad_line_indices)
                 {
-                    vertexs[current_index++] = quad.mVertex[i];
+                    vertexs[current_index++] = quad.mVertex[index];
                 }
             }
         }
-        for (DebugDrawBox box : mBoxes)
+        for (size_t i = 0; i < mStorage.mBoxes.Size(); i++)
         {
-            if (box.mbNoDepthTest == no_depth_test)
+            if (mStorage.mBoxes.IsNoDepthTest(i) == no_depth_test)
             {
-                std::vector<DebugDrawVertex> verts_4d(8);
+                const DebugDrawBox& box = mStorage.mBoxes.Get(i);
+                DebugDrawVertex verts_4d[8];
                 float f[2] = { -1.0f,1.0f };
-                for (size_t i = 0; i < 8; i++)
+                for (size_t j = 0; j < 8; j++)
                 {
-                    Vector3 v(f[i & 1] * box.mHalfExtents.x, f[(i >> 1) & 1] * box.mHalfExtents.y, f[(i >> 2) & 1] * box.mHalfExtents.z);
+                    Vector3 v(f[j & 1] * box.mHalfExtents.x, f[(j >> 1) & 1] * box.mHalfExtents.y, f[(j >> 2) & 1] * box.mHalfExtents.z);
                     Vector3 uv, uuv;
                     Vector3 qvec(box.mRotation.x, box.mRotation.y, box.mRotation.z);
                     uv = qvec.CrossProduct(v);
                     uuv = qvec.CrossProduct(uv);
                     uv *= (2.0f * box.mRotation.w);
                     uuv *= 2.0f;
-                    verts_4d[i].mPos = v + uv + uuv + box.mCenterPoint;
-                    verts_4d[i].mColor = box.mColor;
+                    verts_4d[j].mPos = v + uv + uuv + box.mCenterPoint;
+                    verts_4d[j].mColor = box.mColor;
                 }
-                std::vector<size_t> indies = { 0,1, 1,3, 3,2, 2,0, 4,5, 5,7, 7,6, 6,4, 0,4, 1,5, 3,7, 2,6 };
-                for (size_t i : indies)
+                for (size_t index : s_box_line_indices)
                 {
-                    vertexs[current_index++] = verts_4d[i];
+                    vertexs[current_index++] = verts_4d[index];
                 }
             }
         }
+        return current_index;
     }
 
-    void DebugDrawGroup::WriteTriangleData(std::vector<DebugDrawVertex> &vertexs, bool no_depth_test)
+    size_t DebugDrawGroup::WriteTriangleData(DebugDrawVertex* vertexs, bool no_depth_test) const
     {
-        size_t vertexs_count = GetTriangleCount(no_depth_test) * 3;
-        vertexs.resize(vertexs_count);
-
         size_t current_index = 0;
-        for (DebugDrawTriangle triangle : mTriangles)
+        for (size_t i = 0; i < mStorage.mTriangles.Size(); i++)
         {
-            if (triangle.mFillMode == FillMode::Solid && triangle.mbNoDepthTest == no_depth_test)
+            if (mStorage.mTriangles.GetFillMode(i) == FillMode::Solid && mStorage.mTriangles.IsNoDepthTest(i) == no_depth_test)
             {
+                const DebugDrawTriangle& triangle = mStorage.mTriangles.Get(i);
                 vertexs[current_index++] = triangle.mVertex[0];
                 vertexs[current_index++] = triangle.mVertex[1];
                 vertexs[current_index++] = triangle.mVertex[2];
             }
         }
+        return current_index;
     }
 
-    void DebugDrawGroup::WriteUniformDynamicDataToCache(std::vector<std::pair<Matrix4x4, Vector4>> &datas)
+    void DebugDrawGroup::WriteUniformDynamicDataToCache(std::vector<std::pair<Matrix4x4, Vector4>> &datas) const
     {
         // cache uniformDynamic data ,first has_depth_test ,second no_depth_test
-        size_t data_count = GetUniformDynamicDataCount() * 3;
-        datas.resize(data_count);
+        datas.reserve(datas.size() + GetUniformDynamicDataCount());
 
         bool no_depth_tests[] = { false,true };
         for (int32_t i = 0; i < 2; i++)
         {
             bool no_depth_test = no_depth_tests[i];
 
-            size_t current_index = 0;
-            for (DebugDrawSphere sphere : mSpheres)
+            for (size_t j = 0; j < mStorage.mSpheres.Size(); j++)
             {
-                if (sphere.mbNoDepthTest == no_depth_test)
+                if (mStorage.mSpheres.IsNoDepthTest(j) == no_depth_test)
                 {
+                    const DebugDrawSphere& sphere = mStorage.mSpheres.Get(j);
                     Matrix4x4 model = Matrix4x4::IDENTITY;
 
                     Matrix4x4 tmp = Matrix4x4::IDENTITY;
@@ -528,13 +520,14 @@ namespace MiniEngine
                     model = model * tmp;
                     tmp = Matrix4x4::BuildScaleMatrix(sphere.mRadius, sphere.mRadius, sphere.mRadius);
                     model = model * tmp;
-                    datas[current_index++] = std::make_pair(model, sphere.mColor);
+                    datas.emplace_back(model, sphere.mColor);
                 }
             }
-            for (DebugDrawCylinder cylinder : mCylinders)
+            for (size_t j = 0; j < mStorage.mCylinders.Size(); j++)
             {
-                if (cylinder.mbNoDepthTest == no_depth_test)
+                if (mStorage.mCylinders.IsNoDepthTest(j) == no_depth_test)
                 {
+                    const DebugDrawCylinder& cylinder = mStorage.mCylinders.Get(j);
                     Matrix4x4 model = Matrix4x4::IDENTITY;
 
                     //rolate
@@ -555,13 +548,14 @@ namespace MiniEngine
                     ro[2][0] = 2.0f * x * z + 2.0f * w * y;        ro[2][1] = 2.0f * y * z - 2.0f * w * x;        ro[2][2] = 1.0f - 2.0f * x * x - 2.0f * y * y;
                     model = model * ro;
 
-                    datas[current_index++] = std::make_pair(model, cylinder.mColor);
+                    datas.emplace_back(model, cylinder.mColor);
                 }
             }
-            for (DebugDrawCapsule capsule : mCapsules)
+            for (size_t j = 0; j < mStorage.mCapsules.Size(); j++)
             {
-                if (capsule.mbNoDepthTest == no_depth_test)
+                if (mStorage.mCapsules.IsNoDepthTest(j) == no_depth_test)
                 {
+                    const DebugDrawCapsule& capsule = mStorage.mCapsules.Get(j);
                     Matrix4x4 model1 = Matrix4x4::IDENTITY;
                     Matrix4x4 model2 = Matrix4x4::IDENTITY;
                     Matrix4x4 model3 = Matrix4x4::IDENTITY;
@@ -604,26 +598,24 @@ namespace MiniEngine
                     model2 = model2 * tmp;
                     model3 = model3 * tmp;
 
-                    datas[current_index++] = std::make_pair(model1, capsule.mColor);
-                    datas[current_index++] = std::make_pair(model2, capsule.mColor);
-                    datas[current_index++] = std::make_pair(model3, capsule.mColor);
+                    datas.emplace_back(model1, capsule.mColor);
+                    datas.emplace_back(model2, capsule.mColor);
+                    datas.emplace_back(model3, capsule.mColor);
                 }
             }
         }
     }
 
-    void DebugDrawGroup::WriteTextData(std::vector<DebugDrawVertex> &vertexs, DebugDrawFont *font, Matrix4x4 m_proj_view_matrix)
+    size_t DebugDrawGroup::WriteTextData(DebugDrawVertex* vertexs, DebugDrawFont *font, Matrix4x4 m_proj_view_matrix) const
     {
         RHISwapChainDesc swapChainDesc = gRuntimeGlobalContext.mRenderSystem->GetRHI()->GetSwapChainInfo();
         uint32_t screenWidth = swapChainDesc.viewport->width;
         uint32_t screenHeight = swapChainDesc.viewport->height;
 
-        size_t vertexs_count = GetTextCharacterCount() * 6;
-        vertexs.resize(vertexs_count);
-
         size_t current_index = 0;
-        for(DebugDrawText text : mTexts)
+        for (size_t i = 0; i < mStorage.mTexts.Size(); i++)
         {
+            const DebugDrawText& text = mStorage.mTexts.Get(i);
             float absoluteW = text.mSize, absoluteH = text.mSize * 2;
             float w = absoluteW / (1.0f * screenWidth / 2.0f), h = absoluteH / (1.0f * screenHeight / 2.0f);
             Vector3 coordinate = text.mCoordinate;
@@ -679,5 +671,6 @@ namespace MiniEngine
                 }
             }
         }
+        return current_index;
     }
 }
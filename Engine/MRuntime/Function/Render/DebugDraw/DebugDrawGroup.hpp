@@ -3,14 +3,35 @@
 #include "DebugDrawPrimitive.hpp"
 #include "DebugDrawFont.hpp"
 
+#include <atomic>
+#include <memory>
 #include <mutex>
-#include <list>
 
 namespace MiniEngine
 {
+    struct DebugDrawPrimitiveStorage
+    {
+        void Append(const DebugDrawPrimitiveStorage& other);
+        void Clear();
+        void RemoveDead(float delta_time);
+
+        DebugDrawPrimitiveList<DebugDrawTriangle> mTriangles;
+        DebugDrawPrimitiveList<DebugDrawPoint>    mPoints;
+        DebugDrawPrimitiveList<DebugDrawLine>     mLines;
+        DebugDrawPrimitiveList<DebugDrawQuad>     mQuads;
+        DebugDrawPrimitiveList<DebugDrawBox>      mBoxes;
+        DebugDrawPrimitiveList<DebugDrawCylinder> mCylinders;
+        DebugDrawPrimitiveList<DebugDrawSphere>   mSpheres;
+        DebugDrawPrimitiveList<DebugDrawCapsule>  mCapsules;
+        DebugDrawPrimitiveList<DebugDrawText>     mTexts;
+    };
+
+    // Add* calls append to a buffer owned by the calling thread without taking a lock.
+    // the thread buffers are merged into the group storage once per frame by FlushThreadBuffers
     class DebugDrawGroup
     {
     public:
+        DebugDrawGroup();
         virtual ~DebugDrawGroup();
         void Initialize();
         void Clear();
@@ -99,6 +120,7 @@ namespace MiniEngine
             const float        life_time = kDebugDrawOneFrame
         );
 
+        void FlushThreadBuffers();
         void RemoveDeadPrimitives(float delta_time);
         void MergeFrom(DebugDrawGroup* group);
 
@@ -111,24 +133,51 @@ namespace MiniEngine
         size_t GetCapsuleCount(bool no_depth_test) const;
         size_t GetTextCharacterCount() const;
 
-        void WritePointData(std::vector<DebugDrawVertex>& vertexs, bool no_depth_test);
-        void WriteLineData(std::vector<DebugDrawVertex>& vertexs, bool no_depth_test);
-        void WriteTriangleData(std::vector<DebugDrawVertex>& vertexs, bool no_depth_test);
-        void WriteUniformDynamicDataToCache(std::vector<std::pair<Matrix4x4, Vector4> >& datas);
-        void WriteTextData(std::vector<DebugDrawVertex>& vertexs, DebugDrawFont* font, Matrix4x4 m_proj_view_matrix);
-        
+        // write into memory sized by the matching Get*Count, return the number of vertices written
+        size_t WritePointData(DebugDrawVertex* vertexs, bool no_depth_test) const;
+        size_t WriteLineData(DebugDrawVertex* vertexs, bool no_depth_test) const;
+        size_t WriteTriangleData(DebugDrawVertex* vertexs, bool no_depth_test) const;
+        size_t WriteTextData(DebugDrawVertex* vertexs, DebugDrawFont* font, Matrix4x4 m_proj_view_matrix) const;
+        // appends depth tested objects first, then the ones without depth test
+        void WriteUniformDynamicDataToCache(std::vector<std::pair<Matrix4x4, Vector4> >& datas) const;
+
+    private:
+        // the owning thread appends to one storage, the flush flips the index and reads the other one
+        struct ThreadAppendBuffer
+        {
+            DebugDrawPrimitiveStorage mStorages[2];
+            // bit 0 selects the storage appended to, bit 1 is set while the owning thread appends
+            std::atomic<uint32_t>     mState {0};
+        };
+
+        // flags the append for the flush, which waits for it if it started before the flip
+        class ThreadAppendScope
+        {
+        public:
+            explicit ThreadAppendScope(ThreadAppendBuffer& buffer);
+            ~ThreadAppendScope();
+
+            DebugDrawPrimitiveStorage& GetStorage() const { return *mStorage; }
+
+        private:
+            ThreadAppendBuffer&        mBuffer;
+            DebugDrawPrimitiveStorage* mStorage {nullptr};
+        };
+
+        ThreadAppendBuffer& getThreadAppendBuffer();
+        // the storage appended to until now, safe to read and clear until the next flip
+        static DebugDrawPrimitiveStorage& flipThreadAppendBuffer(ThreadAppendBuffer& buffer);
+        void                              flushThreadBuffers();
+
     private:
         std::mutex mMutex;
         std::string mName;
-        
-        std::list<DebugDrawTriangle> mTriangles;
-        std::list<DebugDrawPoint>    mPoints;
-        std::list<DebugDrawLine>     mLines;
-        std::list<DebugDrawQuad>     mQuads;
-        std::list<DebugDrawBox>      mBoxes;
-        std::list<DebugDrawCylinder> mCylinders;
-        std::list<DebugDrawSphere>   mSpheres;
-        std::list<DebugDrawCapsule>  mCapsules;
-        std::list<DebugDrawText>     mTexts;
+        // never reused, thread local lookups of destroyed groups can not match a new one before they are pruned
+        uint64_t mGroupID {0};
+
+        DebugDrawPrimitiveStorage mStorage;
+
+        std::mutex                                       mThreadBufferMutex;
+        std::vector<std::unique_ptr<ThreadAppendBuffer>> mThreadBuffers;
     };
-} // namespace MiniEngine
+} // namespace MiniEngine
\ No newline at end of file
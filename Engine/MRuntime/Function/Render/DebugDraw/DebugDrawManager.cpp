@@ -1,7 +1,11 @@
 #include "DebugDrawManager.hpp"
+#include "MRuntime/Core/Base/Marco.hpp"
 #include "MRuntime/Core/Math/MathHeaders.hpp"
 #include "MRuntime/Function/Global/GlobalContext.hpp"
 #include "MRuntime/Function/Render/RenderSystem.hpp"
+#include "MRuntime/Core/Profiler/Profiler.hpp"
+
+#include <iterator>
 
 namespace MiniEngine
 {
@@ -75,6 +79,8 @@ namespace MiniEngine
 
     void DebugDrawManager::Draw(uint32_t currentSwapChainImageIndex)
     {
+        PROFILE_SCOPE("DebugDrawManager::Draw");
+
         static uint32_t once = 1;
         swapDataToRender();
         once = 0;
@@ -107,43 +113,51 @@ namespace MiniEngine
     {
         mBufferAllocator->Clear();
 
-        std::vector<DebugDrawVertex> vertexs;
+        const DebugDrawGroup& group = mDebugDrawGroupForRender;
+        size_t vertex_count = group.GetPointCount(false) + group.GetLineCount(false) * 2 + group.GetTriangleCount(false) * 3 +
+                              group.GetPointCount(true) + group.GetLineCount(true) * 2 + group.GetTriangleCount(true) * 3 +
+                              group.GetTextCharacterCount() * 6;
 
-        mDebugDrawGroupForRender.WritePointData(vertexs, false);
-        mPointStartOffset = mBufferAllocator->CacheVertexs(vertexs);
-        mPointEndOffset = mBufferAllocator->GetVertexCacheOffset();
+        // vertices are written straight into the persistently mapped buffer of this frame
+        DebugDrawVertex* vertexs = mBufferAllocator->AllocateVertexs(vertex_count);
+        size_t current_offset = 0;
 
-        mDebugDrawGroupForRender.WriteLineData(vertexs, false);
-        mLineStartOffset = mBufferAllocator->CacheVertexs(vertexs);
-        mLineEndOffset = mBufferAllocator->GetVertexCacheOffset();
+        mPointStartOffset = current_offset;
+        current_offset += vertex_count > 0 ? group.WritePointData(vertexs + current_offset, false) : 0;
+        mPointEndOffset = current_offset;
 
-        mDebugDrawGroupForRender.WriteTriangleData(vertexs, false);
-        mTriangleStartOffset = mBufferAllocator->CacheVertexs(vertexs);
-        mTriangleEndOffset = mBufferAllocator->GetVertexCacheOffset();
+        mLineStartOffset = current_offset;
+        current_offset += vertex_count > 0 ? group.WriteLineData(vertexs + current_offset, false) : 0;
+        mLineEndOffset = current_offset;
 
-        mDebugDrawGroupForRender.WritePointData(vertexs, true);
-        mNoDepthTestPointStartOffset = mBufferAllocator->CacheVertexs(vertexs);
-        mNoDepthTestPointEndOffset = mBufferAllocator->GetVertexCacheOffset();
+        mTriangleStartOffset = current_offset;
+        current_offset += vertex_count > 0 ? group.WriteTriangleData(vertexs + current_offset, false) : 0;
+        mTriangleEndOffset = current_offset;
 
-        mDebugDrawGroupForRender.WriteLineData(vertexs, true);
-        mNoDepthTestLineStartOffset = mBufferAllocator->CacheVertexs(vertexs);
-        mNoDepthTestLineEndOffset = mBufferAllocator->GetVertexCacheOffset();
+        mNoDepthTestPointStartOffset = current_offset;
+        current_offset += vertex_count > 0 ? group.WritePointData(vertexs + current_offset, true) : 0;
+        mNoDepthTestPointEndOffset = current_offset;
 
-        mDebugDrawGroupForRender.WriteTriangleData(vertexs, true);
-        mNoDepthTestTriangleStartOffset = mBufferAllocator->CacheVertexs(vertexs);
-        mNoDepthTestTriangleEndOffset = mBufferAllocator->GetVertexCacheOffset();
+        mNoDepthTestLineStartOffset = current_offset;
+        current_offset += vertex_count > 0 ? group.WriteLineData(vertexs + current_offset, true) : 0;
+        mNoDepthTestLineEndOffset = current_offset;
 
-        mDebugDrawGroupForRender.WriteTextData(vertexs, mFont, mProjViewMatrix);
-        mTextStartOffset = mBufferAllocator->CacheVertexs(vertexs);
-        mTextEndOffset = mBufferAllocator->GetVertexCacheOffset();
+        mNoDepthTestTriangleStartOffset = current_offset;
+        current_offset += vertex_count > 0 ? group.WriteTriangleData(vertexs + current_offset, true) : 0;
+        mNoDepthTestTriangleEndOffset = current_offset;
 
-        mBufferAllocator->CacheUniformObject(mProjViewMatrix);
+        mTextStartOffset = current_offset;
+        current_offset += vertex_count > 0 ? group.WriteTextData(vertexs + current_offset, mFont, mProjViewMatrix) : 0;
+        mTextEndOffset = current_offset;
 
-        std::vector<std::pair<Matrix4x4, Vector4> > dynamicObject = { std::make_pair(Matrix4x4::IDENTITY,Vector4(0,0,0,0)) };
-        mBufferAllocator->CacheUniformDynamicObject(dynamicObject);//cache the first model matrix as Identity matrix, color as empty color. (default object)
+        ASSERT(current_offset == vertex_count);
+
+        mBufferAllocator->CacheUniformObject(mProjViewMatrix);
 
-        mDebugDrawGroupForRender.WriteUniformDynamicDataToCache(dynamicObject);
-        mBufferAllocator->CacheUniformDynamicObject(dynamicObject);//cache the wire frame uniform dynamic object
+        mUniformDynamicCache.clear();
+        mUniformDynamicCache.emplace_back(Matrix4x4::IDENTITY, Vector4(0, 0, 0, 0));//cache the first model matrix as Identity matrix, color as empty color. (default object)
+        group.WriteUniformDynamicDataToCache(mUniformDynamicCache);//cache the wire frame uniform dynamic object
+        mBufferAllocator->CacheUniformDynamicObject(mUniformDynamicCache);
 
         mBufferAllocator->Allocator();
     }
@@ -159,9 +173,9 @@ namespace MiniEngine
     {
         //draw wire frame object : sphere, cylinder, capsule
         
-        std::vector<DebugDrawPipeline*>vc_pipelines{ mDebugDrawPipelines[DebugDrawPipelineType::Line],
-                                                     mDebugDrawPipelines[DebugDrawPipelineType::LineNoDepthTest] };
-        std::vector<bool>no_depth_tests = { false,true };
+        DebugDrawPipeline* vc_pipelines[] = { mDebugDrawPipelines[DebugDrawPipelineType::Line],
+                                              mDebugDrawPipelines[DebugDrawPipelineType::LineNoDepthTest] };
+        const bool no_depth_tests[] = { false,true };
 
         for (int32_t i = 0; i < 2; i++)
         {
@@ -291,27 +305,27 @@ namespace MiniEngine
         RHIDeviceSize offsets[] = { 0 };
         mRHI->CmdBindVertexBuffersPFN(mRHI->GetCurrentCommandBuffer(), 0, 1, vertex_buffers, offsets);
 
-        std::vector<DebugDrawPipeline*>vc_pipelines{ mDebugDrawPipelines[DebugDrawPipelineType::Point],
-                                                     mDebugDrawPipelines[DebugDrawPipelineType::Line],
-                                                     mDebugDrawPipelines[DebugDrawPipelineType::Triangle],
-                                                     mDebugDrawPipelines[DebugDrawPipelineType::PointNoDepthTest],
-                                                     mDebugDrawPipelines[DebugDrawPipelineType::LineNoDepthTest],
-                                                     mDebugDrawPipelines[DebugDrawPipelineType::TriangleNoDepthTest],
-                                                     mDebugDrawPipelines[DebugDrawPipelineType::TriangleNoDepthTest] };
-        std::vector<size_t>vc_start_offsets{ mPointStartOffset,
-                                             mLineStartOffset,
-                                             mTriangleStartOffset,
-                                             mNoDepthTestPointStartOffset,
-                                             mNoDepthTestLineStartOffset,
-                                             mNoDepthTestTriangleStartOffset,
-                                             mTextStartOffset };
-        std::vector<size_t>vc_end_offsets{ mPointEndOffset,
-                                           mLineEndOffset,
-                                           mTriangleEndOffset,
-                                           mNoDepthTestPointEndOffset,
-                                           mNoDepthTestLineEndOffset,
-                                           mNoDepthTestTriangleEndOffset,
-                                           mTextEndOffset };
+        DebugDrawPipeline* vc_pipelines[] = { mDebugDrawPipelines[DebugDrawPipelineType::Point],
+                                              mDebugDrawPipelines[DebugDrawPipelineType::Line],
+                                              mDebugDrawPipelines[DebugDrawPipelineType::Triangle],
+                                              mDebugDrawPipelines[DebugDrawPipelineType::PointNoDepthTest],
+                                              mDebugDrawPipelines[DebugDrawPipelineType::LineNoDepthTest],
+                                              mDebugDrawPipelines[DebugDrawPipelineType::TriangleNoDepthTest],
+                                              mDebugDrawPipelines[DebugDrawPipelineType::TriangleNoDepthTest] };
+        const size_t vc_start_offsets[] = { mPointStartOffset,
+                                            mLineStartOffset,
+                                            mTriangleStartOffset,
+                                            mNoDepthTestPointStartOffset,
+                                            mNoDepthTestLineStartOffset,
+                                            mNoDepthTestTriangleStartOffset,
+                                            mTextStartOffset };
+        const size_t vc_end_offsets[] = { mPointEndOffset,
+                                          mLineEndOffset,
+                                          mTriangleEndOffset,
+                                          mNoDepthTestPointEndOffset,
+                                          mNoDepthTestLineEndOffset,
+                                          mNoDepthTestTriangleEndOffset,
+                                          mTextEndOffset };
         RHIClearValue clear_values[2];
         clear_values[0].color = { 0.0f,0.0f,0.0f,0.0f };
         clear_values[1].depthStencil = { 1.0f, 0 };
@@ -322,7 +336,7 @@ namespace MiniEngine
         renderpass_begin_info.clearValueCount = (sizeof(clear_values) / sizeof(clear_values[0]));
         renderpass_begin_info.pClearValues = clear_values;
 
-        for (size_t i = 0; i < vc_pipelines.size(); i++)
+        for (size_t i = 0; i < std::size(vc_pipelines); i++)
         {
             if (vc_end_offsets[i] - vc_start_offsets[i] == 0)
             {
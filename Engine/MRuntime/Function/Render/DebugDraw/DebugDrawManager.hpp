@@ -41,6 +41,8 @@ namespace MiniEngine
         DebugDrawFont* mFont = nullptr;
 
         Matrix4x4 mProjViewMatrix;
+        // reused every frame to avoid reallocating
+        std::vector<std::pair<Matrix4x4, Vector4> > mUniformDynamicCache;
         
         size_t mPointStartOffset;
         size_t mPointEndOffset;
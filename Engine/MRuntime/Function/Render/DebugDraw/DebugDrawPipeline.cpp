@@ -41,8 +41,8 @@ namespace MiniEngine
         color_attachment_description.storeOp = RHI_ATTACHMENT_STORE_OP_STORE;
         color_attachment_description.stencilLoadOp = RHI_ATTACHMENT_LOAD_OP_DONT_CARE;
         color_attachment_description.stencilStoreOp = RHI_ATTACHMENT_STORE_OP_DONT_CARE;
-        color_attachment_description.initialLayout = RHI_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-        color_attachment_description.finalLayout = RHI_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+        color_attachment_description.initialLayout = mRHI->GetSwapChainInfo().presentLayout;
+        color_attachment_description.finalLayout = mRHI->GetSwapChainInfo().presentLayout;
 
         RHIAttachmentReference color_attachment_reference{};
         color_attachment_reference.attachment = 0;
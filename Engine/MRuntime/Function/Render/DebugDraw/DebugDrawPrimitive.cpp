@@ -2,45 +2,22 @@
 
 namespace MiniEngine
 {
-    bool DebugDrawPrimitive::IsTimeOut(float deltaTime)
+    void ResolveDebugDrawLifeTime(float life_time, DebugDrawTimeType& time_type, float& remaining_time)
     {
-        if (mTimeType == DebugDrawTimeType::Infinity)
+        if (fabs(life_time - kDebugDrawInfinityLifeTime) < 1e-6)
         {
-            return false;
+            time_type      = DebugDrawTimeType::Infinity;
+            remaining_time = 0.0f;
         }
-        else if (mTimeType == DebugDrawTimeType::OneFrame)
+        else if (fabs(life_time - kDebugDrawOneFrame) < 1e-6)
         {
-            if (!mbRendered)
-            {
-                mbRendered = true;
-                return false;
-            }
-            else return true;
+            time_type      = DebugDrawTimeType::OneFrame;
+            remaining_time = 0.03f;
         }
         else
         {
-            mLifeTime -= deltaTime;
-            return (mLifeTime < 0.0f);
-        }
-        return false;
-    }
-
-    void DebugDrawPrimitive::SetTime(float inLifeTime)
-    {
-        if (fabs(inLifeTime - kDebugDrawInfinityLifeTime) < 1e-6)
-        {
-            mTimeType = DebugDrawTimeType::Infinity;
-            mLifeTime = 0.0f;
-        }
-        else if (fabs(inLifeTime - kDebugDrawOneFrame) < 1e-6)
-        {
-            mTimeType = DebugDrawTimeType::OneFrame;
-            mLifeTime = 0.03f;
-        }
-        else
-        {
-            mTimeType = DebugDrawTimeType::Common;
-            mLifeTime = inLifeTime;
+            time_type      = DebugDrawTimeType::Common;
+            remaining_time = life_time;
         }
     }
 }
\ No newline at end of file
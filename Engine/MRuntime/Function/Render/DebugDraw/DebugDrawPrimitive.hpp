@@ -4,6 +4,8 @@
 #include "MRuntime/Function/Render/Interface/RHIStruct.hpp"
 
 #include <array>
+#include <string>
+#include <vector>
 
 namespace MiniEngine
 {
@@ -79,44 +81,156 @@ namespace MiniEngine
         Count,
     };
 
-    class DebugDrawPrimitive
+    // resolves the life_time argument of the Add* calls, infinity and one frame are marked by the special values above
+    void ResolveDebugDrawLifeTime(float life_time, DebugDrawTimeType& time_type, float& remaining_time);
+
+    // primitives of one type stored contiguously in soa form,
+    // expiry only walks the small lifetime arrays and removes dead entries by swapping with the last one
+    template<typename T>
+    class DebugDrawPrimitiveList
     {
     public:
-        bool IsTimeOut(float deltaTime);
-        void SetTime(float inLifeTime);
+        void Add(const T& primitive, float life_time, bool no_depth_test, FillMode fill_mode = FillMode::Wireframe)
+        {
+            DebugDrawTimeType time_type;
+            float             remaining_time;
+            ResolveDebugDrawLifeTime(life_time, time_type, remaining_time);
 
-    public:
-        DebugDrawTimeType mTimeType {DebugDrawTimeType::Infinity};
-        float             mLifeTime {0.f};
-        FillMode          mFillMode {FillMode::Wireframe};
-        bool mbNoDepthTest = false;
+            mPrimitives.push_back(primitive);
+            mTimeTypes.push_back(time_type);
+            mLifeTimes.push_back(remaining_time);
+            mbNoDepthTests.push_back(no_depth_test ? 1 : 0);
+            mFillModes.push_back(fill_mode);
+        }
+
+        void Append(const DebugDrawPrimitiveList& other)
+        {
+            mPrimitives.insert(mPrimitives.end(), other.mPrimitives.begin(), other.mPrimitives.end());
+            mTimeTypes.insert(mTimeTypes.end(), other.mTimeTypes.begin(), other.mTimeTypes.end());
+            mLifeTimes.insert(mLifeTimes.end(), other.mLifeTimes.begin(), other.mLifeTimes.end());
+            mbNoDepthTests.insert(mbNoDepthTests.end(), other.mbNoDepthTests.begin(), other.mbNoDepthTests.end());
+            mFillModes.insert(mFillModes.end(), other.mFillModes.begin(), other.mFillModes.end());
+        }
+
+        // keeps the capacity so that steady state frames do not allocate
+        void Clear()
+        {
+            mPrimitives.clear();
+            mTimeTypes.clear();
+            mLifeTimes.clear();
+            mbNoDepthTests.clear();
+            mFillModes.clear();
+        }
+
+        void RemoveDead(float delta_time)
+        {
+            size_t index = 0;
+            while (index < mPrimitives.size())
+            {
+                if (isTimeOut(index, delta_time))
+                {
+                    swapRemove(index);
+                }
+                else
+                {
+                    index++;
+                }
+            }
+        }
+
+        size_t Size() const { return mPrimitives.size(); }
+        bool   Empty() const { return mPrimitives.empty(); }
+
+        size_t Count(bool no_depth_test) const
+        {
+            size_t count = 0;
+            for (uint8_t primitive_no_depth_test : mbNoDepthTests)
+            {
+                count += (primitive_no_depth_test != 0) == no_depth_test ? 1 : 0;
+            }
+            return count;
+        }
+
+        size_t Count(bool no_depth_test, FillMode fill_mode) const
+        {
+            size_t count = 0;
+            for (size_t i = 0; i < mPrimitives.size(); i++)
+            {
+                count += (IsNoDepthTest(i) == no_depth_test && mFillModes[i] == fill_mode) ? 1 : 0;
+            }
+            return count;
+        }
+
+        const T& Get(size_t index) const { return mPrimitives[index]; }
+        bool     IsNoDepthTest(size_t index) const { return mbNoDepthTests[index] != 0; }
+        FillMode GetFillMode(size_t index) const { return mFillModes[index]; }
+
+    private:
+        bool isTimeOut(size_t index, float delta_time)
+        {
+            switch (mTimeTypes[index])
+            {
+                case DebugDrawTimeType::Infinity:
+                    return false;
+                case DebugDrawTimeType::OneFrame:
+                    // survive the first check so that it is drawn once, the negative life time expires it on the next one
+                    mTimeTypes[index] = DebugDrawTimeType::Common;
+                    mLifeTimes[index] = -1.0f;
+                    return false;
+                default:
+                    mLifeTimes[index] -= delta_time;
+                    return mLifeTimes[index] < 0.0f;
+            }
+        }
+
+        void swapRemove(size_t index)
+        {
+            size_t last = mPrimitives.size() - 1;
+            if (index != last)
+            {
+                mPrimitives[index]    = std::move(mPrimitives[last]);
+                mTimeTypes[index]     = mTimeTypes[last];
+                mLifeTimes[index]     = mLifeTimes[last];
+                mbNoDepthTests[index] = mbNoDepthTests[last];
+                mFillModes[index]     = mFillModes[last];
+            }
+            mPrimitives.pop_back();
+            mTimeTypes.pop_back();
+            mLifeTimes.pop_back();
+            mbNoDepthTests.pop_back();
+            mFillModes.pop_back();
+        }
 
     private:
-        bool mbRendered = false; // for one frame object
+        std::vector<T>                 mPrimitives;
+        std::vector<DebugDrawTimeType> mTimeTypes;
+        std::vector<float>             mLifeTimes;
+        std::vector<uint8_t>           mbNoDepthTests;
+        std::vector<FillMode>          mFillModes;
     };
 
-    class DebugDrawPoint : public DebugDrawPrimitive
+    class DebugDrawPoint
     {
     public:
         DebugDrawVertex mVertex;
         static const DebugDrawPrimitiveType meTypeValue = DebugDrawPrimitiveType::Point;
     };
 
-    class DebugDrawLine : public DebugDrawPrimitive
+    class DebugDrawLine
     {
     public:
         DebugDrawVertex mVertex[2];
         static const DebugDrawPrimitiveType meTypeValue = DebugDrawPrimitiveType::Line;
     };
 
-    class DebugDrawTriangle : public DebugDrawPrimitive
+    class DebugDrawTriangle
     {
     public:
         DebugDrawVertex                     mVertex[3];
         static const DebugDrawPrimitiveType meTypeValue = DebugDrawPrimitiveType::Triangle;
     };
 
-    class DebugDrawQuad : public DebugDrawPrimitive
+    class DebugDrawQuad
     {
     public:
         DebugDrawVertex mVertex[4];
@@ -124,7 +238,7 @@ namespace MiniEngine
         static const DebugDrawPrimitiveType meTypeValue = DebugDrawPrimitiveType::Quad;
     };
 
-    class DebugDrawBox : public DebugDrawPrimitive
+    class DebugDrawBox
     {
     public:
         Vector3 mCenterPoint;
@@ -135,7 +249,7 @@ namespace MiniEngine
         static const DebugDrawPrimitiveType meTypeValue = DebugDrawPrimitiveType::DrawBox;
     };
 
-    class DebugDrawCylinder : public DebugDrawPrimitive
+    class DebugDrawCylinder
     {
     public:
         Vector3 mCenter;
@@ -146,7 +260,7 @@ namespace MiniEngine
 
         static const DebugDrawPrimitiveType meTypeValue = DebugDrawPrimitiveType::Cylinder;
     };
-    class DebugDrawSphere : public DebugDrawPrimitive
+    class DebugDrawSphere
     {
     public:
         Vector3 mCenter;
@@ -156,7 +270,7 @@ namespace MiniEngine
         static const DebugDrawPrimitiveType meTypeValue = DebugDrawPrimitiveType::Sphere;
     };
 
-    class DebugDrawCapsule : public DebugDrawPrimitive
+    class DebugDrawCapsule
     {
     public:
         Vector3 mCenter;
@@ -169,7 +283,7 @@ namespace MiniEngine
         static const DebugDrawPrimitiveType meTypeValue = DebugDrawPrimitiveType::Capsule;
     };
 
-    class DebugDrawText : public DebugDrawPrimitive
+    class DebugDrawText
     {
     public:
         std::string mContent;
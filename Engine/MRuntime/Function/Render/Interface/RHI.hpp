@@ -4,6 +4,7 @@
 #include <GLFW/glfw3.h>
 #include <vk_mem_alloc.h>
 
+#include <filesystem>
 #include <memory>
 
 #include "Function/Render/Interface/RHIStruct.hpp"
@@ -14,6 +15,12 @@ namespace MiniEngine
     struct RHIInitInfo
     {
         std::shared_ptr<WindowSystem> windowSystem;
+        // pipeline cache blob is loaded from and saved to this file, empty disables persistence
+        std::filesystem::path         pipelineCachePath;
+        // fewer frames in flight trade throughput for latency, clamped to what the rhi was built for
+        uint8_t                       framesInFlight {3};
+        // falls back to fifo when the surface does not support it
+        RHIPresentModeKHR             presentMode {RHI_PRESENT_MODE_MAILBOX_KHR};
     };
 
     class RHI
@@ -25,6 +32,11 @@ namespace MiniEngine
         // allocate and create
         virtual bool AllocateCommandBuffers(const RHICommandBufferAllocateInfo* pAllocateInfo, RHICommandBuffer* &pCommandBuffers) = 0;
         virtual bool AllocateDescriptorSets(const RHIDescriptorSetAllocateInfo* pAllocateInfo, RHIDescriptorSet* &pDescriptorSets) = 0;
+        // sets from pools growing per layout, a freed set is reused once the frames in flight are done with it
+        virtual bool AllocateDescriptorSet(RHIDescriptorSetLayout* layout, RHIDescriptorSet* &pDescriptorSet) = 0;
+        virtual void FreeDescriptorSet(RHIDescriptorSetLayout* layout, RHIDescriptorSet* descriptorSet) = 0;
+        // only valid until the current frame in flight begins again
+        virtual bool AllocateTransientDescriptorSet(RHIDescriptorSetLayout* layout, RHIDescriptorSet* &pDescriptorSet) = 0;
         virtual void CreateSwapChain()                                                      = 0;
         virtual void CreateSwapChainImageViews()                                            = 0;
         virtual RHIShader* CreateShaderModule(const std::vector<unsigned char>& shaderCode) = 0;
@@ -76,6 +88,7 @@ namespace MiniEngine
         virtual void CmdSetViewportPFN(RHICommandBuffer* commandBuffer,  uint32_t firstViewport,  uint32_t viewportCount,  const RHIViewport* pViewports) = 0;
         virtual void CmdSetScissorPFN(RHICommandBuffer* commandBuffer,  uint32_t firstScissor,  uint32_t scissorCount,  const RHIRect2D* pScissors) = 0;
         virtual void CmdClearAttachmentsPFN(RHICommandBuffer* commandBuffer, uint32_t attachmentCount, const RHIClearAttachment* pAttachments, uint32_t rectCount, const RHIClearRect* pRects) = 0;
+        virtual void CmdExecuteCommandsPFN(RHICommandBuffer* commandBuffer, uint32_t commandBufferCount, RHICommandBuffer* const* pCommandBuffers) = 0;
         
         virtual void CmdCopyImageToBuffer(RHICommandBuffer* commandBuffer, RHIImage* srcImage, RHIImageLayout srcImageLayout, RHIBuffer* dstBuffer, uint32_t regionCount, const RHIBufferImageCopy* pRegions) = 0;
         virtual void CmdCopyImageToImage(RHICommandBuffer* commandBuffer, RHIImage* srcImage, RHIImageAspectFlagBits srcFlag, RHIImage* dstImage, RHIImageAspectFlagBits dstFlag, uint32_t width, uint32_t height) = 0;
@@ -104,15 +117,25 @@ namespace MiniEngine
         virtual uint8_t GetMaxFramesInFlight() const = 0;
         virtual uint8_t GetCurrentFrameIndex() const = 0;
         virtual void SetCurrentFrameIndex(uint8_t index) = 0;
+        // size of the texture array of the bindless materials, 0 without descriptor indexing support
+        virtual uint32_t GetMaxBindlessTextureCount() const = 0;
 
         // command write
         virtual bool PrepareBeforePass(std::function<void()> passUpdateAfterRecreateSwapChain) = 0;
         virtual void SubmitRendering(std::function<void()> passUpdateAfterRecreateSwapChain)   = 0;
         virtual RHICommandBuffer* BeginSingleTimeCommand() = 0;
         virtual void EndSingleTimeCommand(RHICommandBuffer* cmdBuffer) = 0;
+        // secondary command buffer continuing a subpass in the current frame, end it with EndCommandBufferPFN.
+        // every recorder index owns its command pools, different indices may be recorded on different threads
+        virtual uint32_t GetMaxSecondaryCommandRecorderCount() const = 0;
+        virtual RHICommandBuffer* BeginSecondaryCommandBuffer(uint32_t recorder_index, RHIRenderPass* render_pass, uint32_t subpass, RHIFrameBuffer* framebuffer) = 0;
         virtual void PushEvent(RHICommandBuffer* commond_buffer, const char* name, const float* color) = 0;
         virtual void PopEvent(RHICommandBuffer* commond_buffer) = 0;
 
+        // pipeline cache, used when nullptr is passed to the pipeline creation
+        virtual RHIPipelineCache* GetPipelineCache() const = 0;
+        virtual void SavePipelineCache() = 0;
+
         // Destroy
         virtual void Clear() = 0;
         virtual void ClearSwapchain() = 0;
@@ -129,6 +152,9 @@ namespace MiniEngine
         virtual void DestroyDevice() = 0;
         virtual void DestroyCommandPool(RHICommandPool* commandPool) = 0;
         virtual void DestroyBuffer(RHIBuffer* &buffer) = 0;
+        // release resources created with CreateBufferVMA and CreateGlobalImage, nullptr is ignored
+        virtual void DestroyBufferVMA(VmaAllocator allocator, RHIBuffer* &buffer, VmaAllocation allocation) = 0;
+        virtual void DestroyImageVMA(VmaAllocator allocator, RHIImage* &image, RHIImageView* &imageView, VmaAllocation allocation) = 0;
         virtual void FreeCommandBuffers(RHICommandPool* commandPool, uint32_t commandBufferCount, RHICommandBuffer* pCommandBuffers) = 0;
 
         // Buffer Memory
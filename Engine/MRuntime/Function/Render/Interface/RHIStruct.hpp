@@ -397,6 +397,14 @@ namespace MiniEngine
         const RHIDescriptorSetLayoutBinding* pBindings;
     };
 
+    struct RHIDescriptorSetLayoutBindingFlagsCreateInfo
+    {
+        RHIStructureType                 sType = RHI_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+        const void*                      pNext;
+        uint32_t                         bindingCount;
+        const RHIDescriptorBindingFlags* pBindingFlags;
+    };
+
     struct RHIDeviceCreateInfo
     {
         RHIStructureType                  sType = RHI_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -1155,6 +1163,8 @@ namespace MiniEngine
         RHIViewport*               viewport;
         RHIRect2D*                 scissor;
         std::vector<RHIImageView*> imageViews;
+        // layout the images are left in at the end of the frame
+        RHIImageLayout             presentLayout;
     };
 
     struct RHIDepthImageDesc
@@ -0,0 +1,261 @@
+#include "VulkanDescriptorAllocator.hpp"
+
+#include "MRuntime/Core/Base/Marco.hpp"
+#include "VulkanRHIResource.hpp"
+#include "VulkanUtil.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace MiniEngine
+{
+    namespace
+    {
+        // the first pool of a layout is small, most layouts only ever hold a handful of sets
+        const uint32_t s_first_pool_set_count = 16;
+        const uint32_t s_max_pool_set_count   = 1024;
+        // keeps pools of large sets such as the bindless texture array from reserving thousands of sets
+        const uint32_t s_max_pool_descriptor_count = 16384;
+
+        // transient pools are shared by every layout, so they are sized for a mix of them
+        const uint32_t             s_transient_pool_set_count = 256;
+        const VkDescriptorPoolSize s_transient_pool_sizes[]   = {
+            {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1},
+            {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1},
+            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1},
+            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 4},
+            {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4},
+            {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1},
+            {VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, 1},
+        };
+    } // namespace
+
+    void VulkanDescriptorAllocator::Initialize(VkDevice device, uint32_t frame_count)
+    {
+        mDevice = device;
+        mFrames.resize(frame_count);
+        mFrameIndex = 0;
+    }
+
+    void VulkanDescriptorAllocator::Clear()
+    {
+        for (auto& [layout, layout_pools] : mLayoutPools)
+        {
+            for (VkDescriptorPool pool : layout_pools.pools)
+            {
+                vkDestroyDescriptorPool(mDevice, pool, nullptr);
+            }
+            for (RHIDescriptorSet* descriptor_set : layout_pools.free_sets)
+            {
+                delete static_cast<VulkanDescriptorSet*>(descriptor_set);
+            }
+        }
+        mLayoutPools.clear();
+
+        for (FrameDescriptors& frame : mFrames)
+        {
+            for (VkDescriptorPool pool : frame.transient_pools)
+            {
+                vkDestroyDescriptorPool(mDevice, pool, nullptr);
+            }
+            for (RHIDescriptorSet* descriptor_set : frame.transient_sets)
+            {
+                delete static_cast<VulkanDescriptorSet*>(descriptor_set);
+            }
+            for (FreedDescriptorSet& freed_set : frame.freed_sets)
+            {
+                delete static_cast<VulkanDescriptorSet*>(freed_set.descriptor_set);
+            }
+        }
+        mFrames.clear();
+    }
+
+    void VulkanDescriptorAllocator::BeginFrame(uint8_t frame_index)
+    {
+        mFrameIndex             = frame_index;
+        FrameDescriptors& frame = mFrames[frame_index];
+
+        // the gpu is done with everything this frame referenced
+        for (FreedDescriptorSet& freed_set : frame.freed_sets)
+        {
+            mLayoutPools[freed_set.layout].free_sets.push_back(freed_set.descriptor_set);
+        }
+        frame.freed_sets.clear();
+
+        for (uint32_t i = 0; i <= frame.transient_pool_index && i < frame.transient_pools.size(); ++i)
+        {
+            vkResetDescriptorPool(mDevice, frame.transient_pools[i], 0);
+        }
+        frame.transient_pool_index = 0;
+        frame.transient_set_count  = 0;
+    }
+
+    void VulkanDescriptorAllocator::RegisterLayout(VkDescriptorSetLayout               layout,
+                                                   VkDescriptorSetLayoutCreateFlags    flags,
+                                                   const VkDescriptorSetLayoutBinding* bindings,
+                                                   uint32_t                            binding_count)
+    {
+        LayoutPools& layout_pools = mLayoutPools[layout];
+        layout_pools.set_pool_sizes.clear();
+        layout_pools.pool_flags = (flags & VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT) ?
+                                      VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT :
+                                      0;
+        uint32_t set_descriptor_count = 0;
+        for (uint32_t i = 0; i < binding_count; ++i)
+        {
+            set_descriptor_count += bindings[i].descriptorCount;
+            auto iter = std::find_if(layout_pools.set_pool_sizes.begin(),
+                                     layout_pools.set_pool_sizes.end(),
+                                     [&](const VkDescriptorPoolSize& size) { return size.type == bindings[i].descriptorType; });
+            if (iter != layout_pools.set_pool_sizes.end())
+            {
+                iter->descriptorCount += bindings[i].descriptorCount;
+            }
+            else
+            {
+                layout_pools.set_pool_sizes.push_back({bindings[i].descriptorType, bindings[i].descriptorCount});
+            }
+        }
+        layout_pools.max_pool_set_count =
+            std::clamp(s_max_pool_descriptor_count / std::max(set_descriptor_count, 1u), 1u, s_max_pool_set_count);
+        layout_pools.next_pool_set_count = std::min(s_first_pool_set_count, layout_pools.max_pool_set_count);
+    }
+
+    RHIDescriptorSet* VulkanDescriptorAllocator::Allocate(VkDescriptorSetLayout layout)
+    {
+        auto iter = mLayoutPools.find(layout);
+        if (iter == mLayoutPools.end())
+        {
+            LOG_ERROR("descriptor set layout was not created by the rhi");
+            return nullptr;
+        }
+        LayoutPools& layout_pools = iter->second;
+
+        // a recycled set keeps its old writes, callers update it like a new one
+        if (!layout_pools.free_sets.empty())
+        {
+            RHIDescriptorSet* descriptor_set = layout_pools.free_sets.back();
+            layout_pools.free_sets.pop_back();
+            return descriptor_set;
+        }
+
+        if (layout_pools.remaining_set_count == 0)
+        {
+            layout_pools.pools.push_back(
+                createPool(layout_pools.set_pool_sizes, layout_pools.next_pool_set_count, layout_pools.pool_flags));
+            layout_pools.remaining_set_count = layout_pools.next_pool_set_count;
+            layout_pools.next_pool_set_count = std::min(layout_pools.next_pool_set_count * 2, layout_pools.max_pool_set_count);
+        }
+
+        VkDescriptorSet vk_descriptor_set;
+        VK_CHECK(allocateFromPool(layout_pools.pools.back(), layout, vk_descriptor_set));
+        --layout_pools.remaining_set_count;
+
+        VulkanDescriptorSet* descriptor_set = new VulkanDescriptorSet();
+        descriptor_set->SetResource(vk_descriptor_set);
+        return descriptor_set;
+    }
+
+    void VulkanDescriptorAllocator::Free(VkDescriptorSetLayout layout, RHIDescriptorSet* descriptor_set)
+    {
+        if (descriptor_set == nullptr)
+        {
+            return;
+        }
+        // frames still in flight may read the set, it is handed out again once this frame slot comes around
+        mFrames[mFrameIndex].freed_sets.push_back({layout, descriptor_set});
+    }
+
+    RHIDescriptorSet* VulkanDescriptorAllocator::AllocateTransient(VkDescriptorSetLayout layout)
+    {
+        FrameDescriptors& frame = mFrames[mFrameIndex];
+
+        if (frame.transient_set_count == frame.transient_sets.size())
+        {
+            frame.transient_sets.push_back(new VulkanDescriptorSet());
+        }
+        VulkanDescriptorSet* descriptor_set = static_cast<VulkanDescriptorSet*>(frame.transient_sets[frame.transient_set_count++]);
+        descriptor_set->SetResource(allocateTransient(layout));
+        return descriptor_set;
+    }
+
+    uint32_t VulkanDescriptorAllocator::GetPoolCount() const
+    {
+        size_t pool_count = 0;
+        for (const auto& [layout, layout_pools] : mLayoutPools)
+        {
+            pool_count += layout_pools.pools.size();
+        }
+        for (const FrameDescriptors& frame : mFrames)
+        {
+            pool_count += frame.transient_pools.size();
+        }
+        return static_cast<uint32_t>(pool_count);
+    }
+
+    VkDescriptorPool VulkanDescriptorAllocator::createPool(const std::vector<VkDescriptorPoolSize>& set_pool_sizes,
+                                                           uint32_t                                 max_sets,
+                                                           VkDescriptorPoolCreateFlags              flags)
+    {
+        std::vector<VkDescriptorPoolSize> pool_sizes(set_pool_sizes);
+        for (VkDescriptorPoolSize& pool_size : pool_sizes)
+        {
+            pool_size.descriptorCount *= max_sets;
+        }
+
+        VkDescriptorPoolCreateInfo pool_info {};
+        pool_info.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        pool_info.flags         = flags;
+        pool_info.poolSizeCount = static_cast<uint32_t>(pool_sizes.size());
+        pool_info.pPoolSizes    = pool_sizes.data();
+        pool_info.maxSets       = max_sets;
+
+        VkDescriptorPool pool;
+        if (vkCreateDescriptorPool(mDevice, &pool_info, nullptr, &pool) != VK_SUCCESS)
+        {
+            throw std::runtime_error("create descriptor pool");
+        }
+        return pool;
+    }
+
+    VkResult VulkanDescriptorAllocator::allocateFromPool(VkDescriptorPool       pool,
+                                                         VkDescriptorSetLayout  layout,
+                                                         VkDescriptorSet&       descriptor_set)
+    {
+        VkDescriptorSetAllocateInfo allocate_info {};
+        allocate_info.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocate_info.descriptorPool     = pool;
+        allocate_info.descriptorSetCount = 1;
+        allocate_info.pSetLayouts        = &layout;
+        return vkAllocateDescriptorSets(mDevice, &allocate_info, &descriptor_set);
+    }
+
+    VkDescriptorSet VulkanDescriptorAllocator::allocateTransient(VkDescriptorSetLayout layout)
+    {
+        FrameDescriptors& frame = mFrames[mFrameIndex];
+
+        static const std::vector<VkDescriptorPoolSize> transient_pool_sizes(std::begin(s_transient_pool_sizes),
+                                                                            std::end(s_transient_pool_sizes));
+        while (true)
+        {
+            bool new_pool = frame.transient_pool_index == frame.transient_pools.size();
+            if (new_pool)
+            {
+                frame.transient_pools.push_back(createPool(transient_pool_sizes, s_transient_pool_set_count, 0));
+            }
+
+            VkDescriptorSet descriptor_set;
+            VkResult result = allocateFromPool(frame.transient_pools[frame.transient_pool_index], layout, descriptor_set);
+            if (result == VK_SUCCESS)
+            {
+                return descriptor_set;
+            }
+            if (new_pool || (result != VK_ERROR_OUT_OF_POOL_MEMORY && result != VK_ERROR_FRAGMENTED_POOL))
+            {
+                throw std::runtime_error("allocate transient descriptor set");
+            }
+            // this pool is full, the next one is reset along with it
+            ++frame.transient_pool_index;
+        }
+    }
+} // namespace MiniEngine
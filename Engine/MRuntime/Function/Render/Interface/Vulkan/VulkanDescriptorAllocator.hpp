@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Function/Render/Interface/RHIStruct.hpp"
+#include "vulkan/vulkan_core.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace MiniEngine
+{
+    /// Descriptor sets from pools that are created on demand instead of one pool sized up front.
+    /// Persistent sets come from pools of their layout, every new pool holds twice the sets of the previous one.
+    /// A freed set is handed out again for the same layout once the fence of the frame it was freed in was waited on.
+    /// Transient sets come from pools of the frame in flight and are all released when the frame begins again
+    class VulkanDescriptorAllocator
+    {
+    public:
+        void Initialize(VkDevice device, uint32_t frame_count);
+        void Clear();
+
+        // call after the fence of the frame was waited on
+        void BeginFrame(uint8_t frame_index);
+
+        // the pool sizes of a layout are taken from its bindings, update after bind layouts get update after bind pools
+        void RegisterLayout(VkDescriptorSetLayout               layout,
+                            VkDescriptorSetLayoutCreateFlags    flags,
+                            const VkDescriptorSetLayoutBinding* bindings,
+                            uint32_t                            binding_count);
+
+        RHIDescriptorSet* Allocate(VkDescriptorSetLayout layout);
+        void              Free(VkDescriptorSetLayout layout, RHIDescriptorSet* descriptor_set);
+
+        // valid until the current frame in flight begins again
+        RHIDescriptorSet* AllocateTransient(VkDescriptorSetLayout layout);
+
+        uint32_t GetPoolCount() const;
+
+    private:
+        struct LayoutPools
+        {
+            std::vector<VkDescriptorPoolSize> set_pool_sizes;
+            VkDescriptorPoolCreateFlags       pool_flags {0};
+            std::vector<VkDescriptorPool>     pools;
+            uint32_t                          remaining_set_count {0};
+            uint32_t                          next_pool_set_count {0};
+            uint32_t                          max_pool_set_count {0};
+            std::vector<RHIDescriptorSet*>    free_sets;
+        };
+
+        struct FreedDescriptorSet
+        {
+            VkDescriptorSetLayout layout;
+            RHIDescriptorSet*     descriptor_set;
+        };
+
+        struct FrameDescriptors
+        {
+            std::vector<VkDescriptorPool>   transient_pools;
+            uint32_t                        transient_pool_index {0};
+            std::vector<RHIDescriptorSet*>  transient_sets;
+            uint32_t                        transient_set_count {0};
+            std::vector<FreedDescriptorSet> freed_sets;
+        };
+
+        VkDescriptorPool createPool(const std::vector<VkDescriptorPoolSize>& set_pool_sizes,
+                                    uint32_t                                 max_sets,
+                                    VkDescriptorPoolCreateFlags              flags);
+        VkResult         allocateFromPool(VkDescriptorPool pool, VkDescriptorSetLayout layout, VkDescriptorSet& descriptor_set);
+        VkDescriptorSet  allocateTransient(VkDescriptorSetLayout layout);
+
+    private:
+        VkDevice                                               mDevice {VK_NULL_HANDLE};
+        std::unordered_map<VkDescriptorSetLayout, LayoutPools> mLayoutPools;
+        std::vector<FrameDescriptors>                          mFrames;
+        uint8_t                                                mFrameIndex {0};
+    };
+} // namespace MiniEngine
@@ -62,6 +62,7 @@
 #include "VulkanRHI.hpp"
 
 #include "MRuntime/Core/Base/Marco.hpp"
+#include "MRuntime/Core/Profiler/Profiler.hpp"
 #include "VulkanRHIResource.hpp"
 #include "VulkanUtil.hpp"
 #include "MRuntime/Function/Render/WindowSystem.hpp"
@@ -69,7 +70,9 @@
 #include <cmath>
 #include <algorithm>
 #include <cstring>
+#include <fstream>
 #include <iostream>
+#include <memory>
 #include <set>
 #include <stdexcept>
 #include <string>
@@ -81,9 +84,46 @@
 
 namespace MiniEngine
 {
+    namespace
+    {
+        // scratch for translating rhi arrays into vulkan ones, lives on the stack unless a call passes more than N elements
+        template<typename T, size_t N>
+        class TranslationArray
+        {
+        public:
+            explicit TranslationArray(size_t size)
+            {
+                if (size > N)
+                {
+                    mHeapData.reset(new T[size]);
+                    mData = mHeapData.get();
+                }
+                std::fill_n(mData, size, T {});
+            }
+
+            TranslationArray(const TranslationArray&) = delete;
+            TranslationArray& operator=(const TranslationArray&) = delete;
+
+            T*       data() { return mData; }
+            T&       operator[](size_t index) { return mData[index]; }
+            const T& operator[](size_t index) const { return mData[index]; }
+
+        private:
+            T                    mInlineData[N];
+            T*                   mData {mInlineData};
+            std::unique_ptr<T[]> mHeapData;
+        };
+    } // namespace
+
     void VulkanRHI::Initialize(RHIInitInfo initInfo) {
 
         mWindow = initInfo.windowSystem->GetWindow();
+        mbHeadless = initInfo.windowSystem->IsHeadless();
+        if (mbHeadless)
+        {
+            // nothing is presented, so the swapchain extension is not required
+            mDeviceExtensions.clear();
+        }
         std::array<int, 2> windowSize = initInfo.windowSystem->GetWindowSize();
 
         // 视口初始化（详见视口变换与裁剪坐标）
@@ -122,6 +162,9 @@ namespace MiniEngine
 #error Unknown Compiler
 #endif
 
+        mFramesInFlight = std::clamp<uint8_t>(initInfo.framesInFlight, 1, mkMaxFramesInFlight);
+        mPresentMode    = static_cast<VkPresentModeKHR>(initInfo.presentMode);
+
         // Vulkan初始化
         // 初始化Vulkan实例：设置应用名称、版本、拓展模块等
         createInstance();
@@ -138,13 +181,18 @@ namespace MiniEngine
 
         createCommandBuffers();
         createDescriptorPool();
+        mDescriptorAllocator.Initialize(mDevice, mFramesInFlight);
         createSyncPrimitives();
+        createTimestampQueryPools();
 
         CreateSwapChain();
         CreateSwapChainImageViews();
         CreateFramebufferImageAndView();
 
         createAssetAllocator();
+
+        mPipelineCachePath = initInfo.pipelineCachePath;
+        createPipelineCache();
     }
 
     void VulkanRHI::PrepareContext() {
@@ -154,6 +202,49 @@ namespace MiniEngine
 
     void VulkanRHI::Clear()
     {
+        if (mPipelineCache != nullptr)
+        {
+            SavePipelineCache();
+            vkDestroyPipelineCache(mDevice, ((VulkanPipelineCache*)mPipelineCache)->GetResource(), nullptr);
+            delete mPipelineCache;
+            mPipelineCache = nullptr;
+        }
+
+        for (uint8_t i = 0; i < mkMaxFramesInFlight; ++i)
+        {
+            if (mTimestampQueryPools[i] != VK_NULL_HANDLE)
+            {
+                vkDestroyQueryPool(mDevice, mTimestampQueryPools[i], nullptr);
+                mTimestampQueryPools[i] = VK_NULL_HANDLE;
+            }
+        }
+
+        for (RHICommandBuffer* command_buffer : mSingleTimeCommandBufferFreeList)
+        {
+            delete command_buffer;
+        }
+        mSingleTimeCommandBufferFreeList.clear();
+
+        mDescriptorAllocator.Clear();
+
+        for (auto& frame_secondary_command_pools : mSecondaryCommandPools)
+        {
+            for (SecondaryCommandPool& secondary_command_pool : frame_secondary_command_pools)
+            {
+                for (RHICommandBuffer* command_buffer : secondary_command_pool.command_buffers)
+                {
+                    delete command_buffer;
+                }
+                secondary_command_pool.command_buffers.clear();
+                secondary_command_pool.used_count = 0;
+                if (secondary_command_pool.pool != VK_NULL_HANDLE)
+                {
+                    vkDestroyCommandPool(mDevice, secondary_command_pool.pool, nullptr);
+                    secondary_command_pool.pool = VK_NULL_HANDLE;
+                }
+            }
+        }
+
         if (mbEnableValidationLayers)
         {
             destroyDebugUtilsMessengerEXT(mInstance, mDebugMessenger, nullptr);
@@ -162,6 +253,8 @@ namespace MiniEngine
 
     void VulkanRHI::WaitForFences() 
     {
+        PROFILE_SCOPE("VulkanRHI::WaitForFences");
+
         VK_CHECK(pfnVkWaitForFences(mDevice, 1, &mIsFrameInFlightFences[mCurrentFrameIndex], VK_TRUE, UINT64_MAX)) 
     }
 
@@ -169,7 +262,7 @@ namespace MiniEngine
     {
         //fence
         int fence_size = fenceCount;
-        std::vector<VkFence> vk_fence_list(fence_size);
+        TranslationArray<VkFence, 8> vk_fence_list(fence_size);
         for (int i = 0; i < fence_size; ++i)
         {
             const auto& rhi_fence_element = pFences[i];
@@ -344,53 +437,71 @@ namespace MiniEngine
     void VulkanRHI::ResetCommandPool()
     {
         VK_CHECK(pfnVkResetCommandPool(mDevice, mCommandPools[mCurrentFrameIndex], 0));
+
+        for (SecondaryCommandPool& secondary_command_pool : mSecondaryCommandPools[mCurrentFrameIndex])
+        {
+            if (secondary_command_pool.used_count > 0)
+            {
+                VK_CHECK(pfnVkResetCommandPool(mDevice, secondary_command_pool.pool, 0));
+                secondary_command_pool.used_count = 0;
+            }
+        }
+
+        mDescriptorAllocator.BeginFrame(mCurrentFrameIndex);
     }
 
     bool VulkanRHI::PrepareBeforePass(std::function<void()> passUpdateAfterRecreateSwapchain)
     {
-        VkResult acquire_image_result =
-            vkAcquireNextImageKHR(mDevice,
-                                  mSwapChain,
-                                  UINT64_MAX,
-                                  mImageAvailableForRenderSemaphores[mCurrentFrameIndex],
-                                  VK_NULL_HANDLE,
-                                  &mCurrentSwapChainImageIndex);
-
-        if (VK_ERROR_OUT_OF_DATE_KHR == acquire_image_result)
-        {
-            RecreateSwapChain();
-            passUpdateAfterRecreateSwapchain();
-            return RHI_SUCCESS;
-        }
-        else if (VK_SUBOPTIMAL_KHR == acquire_image_result)
+        if (mbHeadless)
         {
-            RecreateSwapChain();
-            passUpdateAfterRecreateSwapchain();
-
-            // NULL submit to wait semaphore
-            VkPipelineStageFlags wait_stages[] = {VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT};
-            VkSubmitInfo         submit_info   = {};
-            submit_info.sType                  = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-            submit_info.waitSemaphoreCount     = 1;
-            submit_info.pWaitSemaphores        = &mImageAvailableForRenderSemaphores[mCurrentFrameIndex];
-            submit_info.pWaitDstStageMask      = wait_stages;
-            submit_info.commandBufferCount     = 0;
-            submit_info.pCommandBuffers        = NULL;
-            submit_info.signalSemaphoreCount   = 0;
-            submit_info.pSignalSemaphores      = NULL;
-
-            VK_CHECK(pfnVkResetFences(mDevice, 1, &mIsFrameInFlightFences[mCurrentFrameIndex]))
-            VK_CHECK(vkQueueSubmit(((VulkanQueue*)mGraphicsQueue)->GetResource(), 1, &submit_info, mIsFrameInFlightFences[mCurrentFrameIndex]))
-
-            mCurrentFrameIndex = (mCurrentFrameIndex + 1) % mkMaxFramesInFlight;
-            return RHI_SUCCESS;
+            mCurrentSwapChainImageIndex = mCurrentFrameIndex;
         }
         else
         {
-            if (VK_SUCCESS != acquire_image_result)
+            VkResult acquire_image_result =
+                vkAcquireNextImageKHR(mDevice,
+                                      mSwapChain,
+                                      UINT64_MAX,
+                                      mImageAvailableForRenderSemaphores[mCurrentFrameIndex],
+                                      VK_NULL_HANDLE,
+                                      &mCurrentSwapChainImageIndex);
+
+            if (VK_ERROR_OUT_OF_DATE_KHR == acquire_image_result)
             {
-                LOG_ERROR("vkAcquireNextImageKHR failed!");
-                return false;
+                RecreateSwapChain();
+                passUpdateAfterRecreateSwapchain();
+                return RHI_SUCCESS;
+            }
+            else if (VK_SUBOPTIMAL_KHR == acquire_image_result)
+            {
+                RecreateSwapChain();
+                passUpdateAfterRecreateSwapchain();
+
+                // NULL submit to wait semaphore
+                VkPipelineStageFlags wait_stages[] = {VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT};
+                VkSubmitInfo         submit_info   = {};
+                submit_info.sType                  = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+                submit_info.waitSemaphoreCount     = 1;
+                submit_info.pWaitSemaphores        = &mImageAvailableForRenderSemaphores[mCurrentFrameIndex];
+                submit_info.pWaitDstStageMask      = wait_stages;
+                submit_info.commandBufferCount     = 0;
+                submit_info.pCommandBuffers        = NULL;
+                submit_info.signalSemaphoreCount   = 0;
+                submit_info.pSignalSemaphores      = NULL;
+
+                VK_CHECK(pfnVkResetFences(mDevice, 1, &mIsFrameInFlightFences[mCurrentFrameIndex]))
+                VK_CHECK(vkQueueSubmit(((VulkanQueue*)mGraphicsQueue)->GetResource(), 1, &submit_info, mIsFrameInFlightFences[mCurrentFrameIndex]))
+
+                mCurrentFrameIndex = (mCurrentFrameIndex + 1) % mFramesInFlight;
+                return RHI_SUCCESS;
+            }
+            else
+            {
+                if (VK_SUCCESS != acquire_image_result)
+                {
+                    LOG_ERROR("vkAcquireNextImageKHR failed!");
+                    return false;
+                }
             }
         }
 
@@ -401,11 +512,16 @@ namespace MiniEngine
         command_buffer_begin_info.pInheritanceInfo = nullptr;
         VK_CHECK(pfnVkBeginCommandBuffer(mVkCommandBuffers[mCurrentFrameIndex], &command_buffer_begin_info))
 
+        beginGpuProfileFrame();
+
         return false;
     }
 
     void VulkanRHI::SubmitRendering(std::function<void()> passUpdateAfterRecreateSwapchain)
     {
+        // unmatched events are dropped
+        mbGpuProfileFrameActive = false;
+
         // end command buffer
         VkResult res_end_command_buffer = pfnVkEndCommandBuffer(mVkCommandBuffers[mCurrentFrameIndex]);
         if (VK_SUCCESS != res_end_command_buffer)
@@ -414,6 +530,12 @@ namespace MiniEngine
             return;
         }
 
+        if (mbHeadless)
+        {
+            submitHeadlessRendering();
+            return;
+        }
+
         VkSemaphore semaphores[2] = { ((VulkanSemaphore*)mImageAvailableForTextureCopySemaphores[mCurrentFrameIndex])->GetResource(),
                                      mImageFinishedForPresentationSemaphores[mCurrentFrameIndex] };
 
@@ -455,8 +577,24 @@ namespace MiniEngine
                 return;
             }
         }
+        gRuntimeGlobalContext.mProfiler->MarkPresented();
 
-        mCurrentFrameIndex = (mCurrentFrameIndex + 1) % mkMaxFramesInFlight;
+        mCurrentFrameIndex = (mCurrentFrameIndex + 1) % mFramesInFlight;
+    }
+
+    void VulkanRHI::submitHeadlessRendering()
+    {
+        // no image to wait for and nobody to present to, the fence alone paces the frames
+        VkSubmitInfo submit_info       = {};
+        submit_info.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submit_info.commandBufferCount = 1;
+        submit_info.pCommandBuffers    = &mVkCommandBuffers[mCurrentFrameIndex];
+        VK_CHECK(pfnVkResetFences(mDevice, 1, &mIsFrameInFlightFences[mCurrentFrameIndex]))
+
+        VK_CHECK(vkQueueSubmit(((VulkanQueue*)mGraphicsQueue)->GetResource(), 1, &submit_info, mIsFrameInFlightFences[mCurrentFrameIndex]))
+        gRuntimeGlobalContext.mProfiler->MarkPresented();
+
+        mCurrentFrameIndex = (mCurrentFrameIndex + 1) % mFramesInFlight;
     }
 
     RHICommandBuffer* VulkanRHI::BeginSingleTimeCommand()
@@ -476,7 +614,19 @@ namespace MiniEngine
 
         pfnVkBeginCommandBuffer(command_buffer, &beginInfo);
 
-        RHICommandBuffer* rhi_command_buffer = new VulkanCommandBuffer();
+        RHICommandBuffer* rhi_command_buffer = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mSingleTimeCommandBufferMutex);
+            if (!mSingleTimeCommandBufferFreeList.empty())
+            {
+                rhi_command_buffer = mSingleTimeCommandBufferFreeList.back();
+                mSingleTimeCommandBufferFreeList.pop_back();
+            }
+        }
+        if (rhi_command_buffer == nullptr)
+        {
+            rhi_command_buffer = new VulkanCommandBuffer();
+        }
         ((VulkanCommandBuffer*)rhi_command_buffer)->SetResource(command_buffer);
         return rhi_command_buffer;
     }
@@ -495,7 +645,72 @@ namespace MiniEngine
         vkQueueWaitIdle(((VulkanQueue*)mGraphicsQueue)->GetResource());
 
         vkFreeCommandBuffers(mDevice, ((VulkanCommandPool*)mRHICommandPool)->GetResource(), 1, &vk_command_buffer);
-        delete(command_buffer);
+        ((VulkanCommandBuffer*)command_buffer)->SetResource(VK_NULL_HANDLE);
+        std::lock_guard<std::mutex> lock(mSingleTimeCommandBufferMutex);
+        mSingleTimeCommandBufferFreeList.push_back(command_buffer);
+    }
+
+    uint32_t VulkanRHI::GetMaxSecondaryCommandRecorderCount() const { return mkMaxSecondaryCommandRecorderCount; }
+
+    RHICommandBuffer* VulkanRHI::BeginSecondaryCommandBuffer(uint32_t        recorder_index,
+                                                             RHIRenderPass*  render_pass,
+                                                             uint32_t        subpass,
+                                                             RHIFrameBuffer* framebuffer)
+    {
+        ASSERT(recorder_index < mkMaxSecondaryCommandRecorderCount);
+        SecondaryCommandPool& secondary_command_pool = mSecondaryCommandPools[mCurrentFrameIndex][recorder_index];
+
+        // pools are created the first time a recorder is used, only the recorder's own thread touches them
+        if (secondary_command_pool.pool == VK_NULL_HANDLE)
+        {
+            VkCommandPoolCreateInfo command_pool_create_info {};
+            command_pool_create_info.sType            = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+            command_pool_create_info.flags            = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+            command_pool_create_info.queueFamilyIndex = mQueueIndices.graphicsFamily.value();
+            if (vkCreateCommandPool(mDevice, &command_pool_create_info, nullptr, &secondary_command_pool.pool) != VK_SUCCESS)
+            {
+                LOG_ERROR("vk create secondary command pool");
+                return nullptr;
+            }
+        }
+
+        if (secondary_command_pool.used_count == secondary_command_pool.command_buffers.size())
+        {
+            VkCommandBufferAllocateInfo command_buffer_allocate_info {};
+            command_buffer_allocate_info.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            command_buffer_allocate_info.commandPool        = secondary_command_pool.pool;
+            command_buffer_allocate_info.level              = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+            command_buffer_allocate_info.commandBufferCount = 1;
+
+            VkCommandBuffer vk_command_buffer;
+            if (vkAllocateCommandBuffers(mDevice, &command_buffer_allocate_info, &vk_command_buffer) != VK_SUCCESS)
+            {
+                LOG_ERROR("vk allocate secondary command buffer");
+                return nullptr;
+            }
+            RHICommandBuffer* command_buffer = new VulkanCommandBuffer();
+            ((VulkanCommandBuffer*)command_buffer)->SetResource(vk_command_buffer);
+            secondary_command_pool.command_buffers.push_back(command_buffer);
+        }
+        RHICommandBuffer* command_buffer = secondary_command_pool.command_buffers[secondary_command_pool.used_count++];
+
+        VkCommandBufferInheritanceInfo inheritance_info {};
+        inheritance_info.sType       = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        inheritance_info.renderPass  = ((VulkanRenderPass*)render_pass)->GetResource();
+        inheritance_info.subpass     = subpass;
+        inheritance_info.framebuffer = framebuffer ? ((VulkanFrameBuffer*)framebuffer)->GetResource() : VK_NULL_HANDLE;
+
+        VkCommandBufferBeginInfo begin_info {};
+        begin_info.sType            = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        begin_info.flags            = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+        begin_info.pInheritanceInfo = &inheritance_info;
+
+        if (pfnVkBeginCommandBuffer(((VulkanCommandBuffer*)command_buffer)->GetResource(), &begin_info) != VK_SUCCESS)
+        {
+            LOG_ERROR("vk begin secondary command buffer");
+            return nullptr;
+        }
+        return command_buffer;
     }
 
     // validation layers
@@ -531,11 +746,14 @@ namespace MiniEngine
 
     std::vector<const char*> VulkanRHI::getRequiredExtensions()
     {
-        uint32_t     glfwExtensionCount = 0;
-        const char** glfwExtensions;
-        glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
-
-        std::vector<const char*> extensions(glfwExtensions, glfwExtensions + glfwExtensionCount);
+        std::vector<const char*> extensions;
+        if (!mbHeadless)
+        {
+            uint32_t     glfwExtensionCount = 0;
+            const char** glfwExtensions;
+            glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+            extensions.assign(glfwExtensions, glfwExtensions + glfwExtensionCount);
+        }
 
         if (mbEnableValidationLayers || mbEnableDebugUtilsLabel)
         {
@@ -576,9 +794,11 @@ namespace MiniEngine
         if (mbEnableValidationLayers && !checkValidationLayersSupport())
         {
             LOG_ERROR("validation layers requested, but not available!");
+            mbEnableValidationLayers = false;
         }
 
-        mVulkanAPIVersion = VK_API_VERSION_1_0;
+        // 1.1 for vkGetPhysicalDeviceFeatures2, descriptor indexing is queried through it
+        mVulkanAPIVersion = VK_API_VERSION_1_1;
 
         // app info
         VkApplicationInfo appInfo {};
@@ -643,6 +863,11 @@ namespace MiniEngine
 
     void VulkanRHI::createWindowSurface()
     {
+        if (mbHeadless)
+        {
+            return;
+        }
+
         if (glfwCreateWindowSurface(mInstance, mWindow, nullptr, &mSurface) != VK_SUCCESS)
         {
             LOG_ERROR("glfwCreateWindowSurface failed!");
@@ -745,9 +970,23 @@ namespace MiniEngine
             physical_device_features.geometryShader = VK_TRUE;
         }
 
+        // support bindless materials, only when the device has everything they use
+        VkPhysicalDeviceDescriptorIndexingFeaturesEXT descriptor_indexing_features {};
+        descriptor_indexing_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+        if (queryBindlessSupport(mPhysicalDevice))
+        {
+            descriptor_indexing_features.shaderSampledImageArrayNonUniformIndexing   = VK_TRUE;
+            descriptor_indexing_features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+            descriptor_indexing_features.descriptorBindingPartiallyBound             = VK_TRUE;
+            descriptor_indexing_features.runtimeDescriptorArray                      = VK_TRUE;
+            mDeviceExtensions.push_back(VK_KHR_MAINTENANCE3_EXTENSION_NAME);
+            mDeviceExtensions.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+        }
+
         // device create info
         VkDeviceCreateInfo device_create_info {};
         device_create_info.sType                   = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+        device_create_info.pNext                   = mMaxBindlessTextureCount > 0 ? &descriptor_indexing_features : nullptr;
         device_create_info.pQueueCreateInfos       = queue_create_infos.data();
         device_create_info.queueCreateInfoCount    = static_cast<uint32_t>(queue_create_infos.size());
         device_create_info.pEnabledFeatures        = &physical_device_features;
@@ -790,6 +1029,7 @@ namespace MiniEngine
         pfnVkCmdBindIndexBuffer    = (PFN_vkCmdBindIndexBuffer)vkGetDeviceProcAddr(mDevice, "vkCmdBindIndexBuffer");
         pfnVkCmdBindDescriptorSets = (PFN_vkCmdBindDescriptorSets)vkGetDeviceProcAddr(mDevice, "vkCmdBindDescriptorSets");
         pfnVkCmdClearAttachments   = (PFN_vkCmdClearAttachments)vkGetDeviceProcAddr(mDevice, "vkCmdClearAttachments");
+        pfnVkCmdExecuteCommands    = (PFN_vkCmdExecuteCommands)vkGetDeviceProcAddr(mDevice, "vkCmdExecuteCommands");
 
         mDepthImageFormat = (RHIFormat)findDepthFormat();
     }
@@ -957,6 +1197,8 @@ namespace MiniEngine
 
         if (result == VK_SUCCESS)
         {
+            mDescriptorAllocator.RegisterLayout(
+                vk_descriptorSetLayout, create_info.flags, create_info.pBindings, create_info.bindingCount);
             return RHI_SUCCESS;
         }
         else
@@ -1338,11 +1580,7 @@ namespace MiniEngine
 
         pPipelines = new VulkanPipeline();
         VkPipeline vk_pipelines;
-        VkPipelineCache vk_pipeline_cache = VK_NULL_HANDLE;
-        if (pipelineCache != nullptr)
-        {
-            vk_pipeline_cache = ((VulkanPipelineCache*)pipelineCache)->GetResource();
-        }
+        VkPipelineCache vk_pipeline_cache = getPipelineCacheResource(pipelineCache);
         VkResult result = vkCreateGraphicsPipelines(mDevice, vk_pipeline_cache, createInfoCount, &create_info, nullptr, &vk_pipelines);
         ((VulkanPipeline*)pPipelines)->SetResource(vk_pipelines);
 
@@ -1394,11 +1632,7 @@ namespace MiniEngine
 
         pPipelines = new VulkanPipeline();
         VkPipeline vk_pipelines;
-        VkPipelineCache vk_pipeline_cache = VK_NULL_HANDLE;
-        if (pipelineCache != nullptr)
-        {
-            vk_pipeline_cache = ((VulkanPipelineCache*)pipelineCache)->GetResource();
-        }
+        VkPipelineCache vk_pipeline_cache = getPipelineCacheResource(pipelineCache);
         VkResult result = vkCreateComputePipelines(mDevice, vk_pipeline_cache, createInfoCount, &create_info, nullptr, &vk_pipelines);
         ((VulkanPipeline*)pPipelines)->SetResource(vk_pipelines);
 
@@ -1667,7 +1901,7 @@ namespace MiniEngine
     {
         //fence
         int fence_size = fenceCount;
-        std::vector<VkFence> vk_fence_list(fence_size);
+        TranslationArray<VkFence, 8> vk_fence_list(fence_size);
         for (int i = 0; i < fence_size; ++i)
         {
             const auto& rhi_fence_element = pFences[i];
@@ -1693,7 +1927,7 @@ namespace MiniEngine
     {
         //fence
         int fence_size = fenceCount;
-        std::vector<VkFence> vk_fence_list(fence_size);
+        TranslationArray<VkFence, 8> vk_fence_list(fence_size);
         for (int i = 0; i < fence_size; ++i)
         {
             const auto& rhi_fence_element = pFences[i];
@@ -1797,7 +2031,7 @@ namespace MiniEngine
 
         //clear_values
         int clear_value_size = pRenderPassBegin->clearValueCount;
-        std::vector<VkClearValue> vk_clear_value_list(clear_value_size);
+        TranslationArray<VkClearValue, 8> vk_clear_value_list(clear_value_size);
         for (int i = 0; i < clear_value_size; ++i)
         {
             const auto& rhi_clear_value_element = pRenderPassBegin->pClearValues[i];
@@ -1857,7 +2091,7 @@ namespace MiniEngine
     {
         //viewport
         int viewport_size = viewportCount;
-        std::vector<VkViewport> vk_viewport_list(viewport_size);
+        TranslationArray<VkViewport, 4> vk_viewport_list(viewport_size);
         for (int i = 0; i < viewport_size; ++i)
         {
             const auto& rhi_viewport_element = pViewports[i];
@@ -1878,7 +2112,7 @@ namespace MiniEngine
     {
         //rect_2d
         int rect_2d_size = scissorCount;
-        std::vector<VkRect2D> vk_rect_2d_list(rect_2d_size);
+        TranslationArray<VkRect2D, 4> vk_rect_2d_list(rect_2d_size);
         for (int i = 0; i < rect_2d_size; ++i)
         {
             const auto& rhi_rect_2d_element = pScissors[i];
@@ -1909,7 +2143,7 @@ namespace MiniEngine
     {
         //buffer
         int buffer_size = bindingCount;
-        std::vector<VkBuffer> vk_buffer_list(buffer_size);
+        TranslationArray<VkBuffer, 16> vk_buffer_list(buffer_size);
         for (int i = 0; i < buffer_size; ++i)
         {
             const auto& rhi_buffer_element = pBuffers[i];
@@ -1920,7 +2154,7 @@ namespace MiniEngine
 
         //offset
         int offset_size = bindingCount;
-        std::vector<VkDeviceSize> vk_device_size_list(offset_size);
+        TranslationArray<VkDeviceSize, 16> vk_device_size_list(offset_size);
         for (int i = 0; i < offset_size; ++i)
         {
             const auto& rhi_offset_element = pOffsets[i];
@@ -1949,7 +2183,7 @@ namespace MiniEngine
     {
         //descriptor_set
         int descriptor_set_size = descriptorSetCount;
-        std::vector<VkDescriptorSet> vk_descriptor_set_list(descriptor_set_size);
+        TranslationArray<VkDescriptorSet, 8> vk_descriptor_set_list(descriptor_set_size);
         for (int i = 0; i < descriptor_set_size; ++i)
         {
             const auto& rhi_descriptor_set_element = pDescriptorSets[i];
@@ -1960,7 +2194,7 @@ namespace MiniEngine
 
         //offset
         int offset_size = dynamicOffsetCount;
-        std::vector<uint32_t> vk_offset_list(offset_size);
+        TranslationArray<uint32_t, 16> vk_offset_list(offset_size);
         for (int i = 0; i < offset_size; ++i)
         {
             const auto& rhi_offset_element = pDynamicOffsets[i];
@@ -1993,7 +2227,7 @@ namespace MiniEngine
     {
         //clear_attachment
         int clear_attachment_size = attachmentCount;
-        std::vector<VkClearAttachment> vk_clear_attachment_list(clear_attachment_size);
+        TranslationArray<VkClearAttachment, 8> vk_clear_attachment_list(clear_attachment_size);
         for (int i = 0; i < clear_attachment_size; ++i)
         {
             const auto& rhi_clear_attachment_element = pAttachments[i];
@@ -2025,7 +2259,7 @@ namespace MiniEngine
 
         //clear_rect
         int clear_rect_size = rectCount;
-        std::vector<VkClearRect> vk_clear_rect_list(clear_rect_size);
+        TranslationArray<VkClearRect, 8> vk_clear_rect_list(clear_rect_size);
         for (int i = 0; i < clear_rect_size; ++i)
         {
             const auto& rhi_clear_rect_element = pRects[i];
@@ -2053,6 +2287,19 @@ namespace MiniEngine
             vk_clear_rect_list.data());
     }
 
+    void VulkanRHI::CmdExecuteCommandsPFN(RHICommandBuffer*        commandBuffer,
+                                          uint32_t                 commandBufferCount,
+                                          RHICommandBuffer* const* pCommandBuffers)
+    {
+        TranslationArray<VkCommandBuffer, 16> vk_command_buffer_list(commandBufferCount);
+        for (uint32_t i = 0; i < commandBufferCount; ++i)
+        {
+            vk_command_buffer_list[i] = ((VulkanCommandBuffer*)pCommandBuffers[i])->GetResource();
+        }
+
+        pfnVkCmdExecuteCommands(((VulkanCommandBuffer*)commandBuffer)->GetResource(), commandBufferCount, vk_command_buffer_list.data());
+    }
+
     void VulkanRHI::UpdateDescriptorSets(
         uint32_t descriptorWriteCount,
         const RHIWriteDescriptorSet* pDescriptorWrites,
@@ -2061,7 +2308,7 @@ namespace MiniEngine
     {
         //write_descriptor_set
         int write_descriptor_set_size = descriptorWriteCount;
-        std::vector<VkWriteDescriptorSet> vk_write_descriptor_set_list(write_descriptor_set_size);
+        TranslationArray<VkWriteDescriptorSet, 16> vk_write_descriptor_set_list(write_descriptor_set_size);
         int image_info_count = 0;
         int buffer_info_count = 0;
         for (int i = 0; i < write_descriptor_set_size; ++i)
@@ -2076,8 +2323,8 @@ namespace MiniEngine
                 buffer_info_count++;
             }
         }
-        std::vector<VkDescriptorImageInfo> vk_descriptor_image_info_list(image_info_count);
-        std::vector<VkDescriptorBufferInfo> vk_descriptor_buffer_info_list(buffer_info_count);
+        TranslationArray<VkDescriptorImageInfo, 16> vk_descriptor_image_info_list(image_info_count);
+        TranslationArray<VkDescriptorBufferInfo, 16> vk_descriptor_buffer_info_list(buffer_info_count);
         int image_info_current = 0;
         int buffer_info_current = 0;
 
@@ -2138,7 +2385,7 @@ namespace MiniEngine
 
         //copy_descriptor_set
         int copy_descriptor_set_size = descriptorCopyCount;
-        std::vector<VkCopyDescriptorSet> vk_copy_descriptor_set_list(copy_descriptor_set_size);
+        TranslationArray<VkCopyDescriptorSet, 4> vk_copy_descriptor_set_list(copy_descriptor_set_size);
         for (int i = 0; i < copy_descriptor_set_size; ++i)
         {
             const auto& rhi_copy_descriptor_set_element = pDescriptorCopies[i];
@@ -2175,10 +2422,10 @@ namespace MiniEngine
             signal_semaphore_size_total += rhi_submit_info_element.signalSemaphoreCount;
             pipeline_stage_flags_size_total += rhi_submit_info_element.waitSemaphoreCount;
         }
-        std::vector<VkCommandBuffer> vk_command_buffer_list_external(command_buffer_size_total);
-        std::vector<VkSemaphore> vk_semaphore_list_external(semaphore_size_total);
-        std::vector<VkSemaphore> vk_signal_semaphore_list_external(signal_semaphore_size_total);
-        std::vector<VkPipelineStageFlags> vk_pipeline_stage_flags_list_external(pipeline_stage_flags_size_total);
+        TranslationArray<VkCommandBuffer, 8> vk_command_buffer_list_external(command_buffer_size_total);
+        TranslationArray<VkSemaphore, 8> vk_semaphore_list_external(semaphore_size_total);
+        TranslationArray<VkSemaphore, 8> vk_signal_semaphore_list_external(signal_semaphore_size_total);
+        TranslationArray<VkPipelineStageFlags, 8> vk_pipeline_stage_flags_list_external(pipeline_stage_flags_size_total);
 
         int command_buffer_size_current = 0;
         int semaphore_size_current = 0;
@@ -2186,7 +2433,7 @@ namespace MiniEngine
         int pipeline_stage_flags_size_current = 0;
 
 
-        std::vector<VkSubmitInfo> vk_submit_info_list(submit_info_size);
+        TranslationArray<VkSubmitInfo, 4> vk_submit_info_list(submit_info_size);
         for (int i = 0; i < submit_info_size; ++i)
         {
             const auto& rhi_submit_info_element = pSubmits[i];
@@ -2321,7 +2568,7 @@ namespace MiniEngine
 
         //memory_barrier
         int memory_barrier_size = memoryBarrierCount;
-        std::vector<VkMemoryBarrier> vk_memory_barrier_list(memory_barrier_size);
+        TranslationArray<VkMemoryBarrier, 4> vk_memory_barrier_list(memory_barrier_size);
         for (int i = 0; i < memory_barrier_size; ++i)
         {
             const auto& rhi_memory_barrier_element = pMemoryBarriers[i];
@@ -2336,7 +2583,7 @@ namespace MiniEngine
 
         //buffer_memory_barrier
         int buffer_memory_barrier_size = bufferMemoryBarrierCount;
-        std::vector<VkBufferMemoryBarrier> vk_buffer_memory_barrier_list(buffer_memory_barrier_size);
+        TranslationArray<VkBufferMemoryBarrier, 8> vk_buffer_memory_barrier_list(buffer_memory_barrier_size);
         for (int i = 0; i < buffer_memory_barrier_size; ++i)
         {
             const auto& rhi_buffer_memory_barrier_element = pBufferMemoryBarriers[i];
@@ -2355,7 +2602,7 @@ namespace MiniEngine
 
         //image_memory_barrier
         int image_memory_barrier_size = imageMemoryBarrierCount;
-        std::vector<VkImageMemoryBarrier> vk_image_memory_barrier_list(image_memory_barrier_size);
+        TranslationArray<VkImageMemoryBarrier, 8> vk_image_memory_barrier_list(image_memory_barrier_size);
         for (int i = 0; i < image_memory_barrier_size; ++i)
         {
             const auto& rhi_image_memory_barrier_element = pImageMemoryBarriers[i];
@@ -2418,7 +2665,7 @@ namespace MiniEngine
     {
         //buffer_image_copy
         int buffer_image_copy_size = regionCount;
-        std::vector<VkBufferImageCopy> vk_buffer_image_copy_list(buffer_image_copy_size);
+        TranslationArray<VkBufferImageCopy, 4> vk_buffer_image_copy_list(buffer_image_copy_size);
         for (int i = 0; i < buffer_image_copy_size; ++i)
         {
             const auto& rhi_buffer_image_copy_element = pRegions[i];
@@ -2520,32 +2767,17 @@ namespace MiniEngine
 
     void VulkanRHI::createDescriptorPool()
     {
-        // Since DescriptorSet should be treated as asset in Vulkan, DescriptorPool
-        // should be big enough, and thus we can sub-allocate DescriptorSet from
-        // DescriptorPool merely as we sub-allocate Buffer/Image from DeviceMemory.
-
-        VkDescriptorPoolSize pool_sizes[7];
-        pool_sizes[0].type            = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
-        pool_sizes[0].descriptorCount = 3 + 2 + 2 + 2 + 1 + 1 + 3 + 3;
-        pool_sizes[1].type            = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-        pool_sizes[1].descriptorCount = 1 + 1 + 1 * mMaxVertexBlendingMeshCount;
-        pool_sizes[2].type            = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-        pool_sizes[2].descriptorCount = 1 * mMaxMaterialCount;
-        pool_sizes[3].type            = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        pool_sizes[3].descriptorCount = 3 + 5 * mMaxMaterialCount + 1 + 1; // ImGui_ImplVulkan_CreateDeviceObjects
-        pool_sizes[4].type            = VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
-        pool_sizes[4].descriptorCount = 4 + 1 + 1 + 2;
-        pool_sizes[5].type            = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
-        pool_sizes[5].descriptorCount = 3;
-        pool_sizes[6].type            = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
-        pool_sizes[6].descriptorCount = 1;
+        // the sets of the passes and render resources come from mDescriptorAllocator,
+        // this pool only serves the sets imgui allocates itself
+        VkDescriptorPoolSize pool_sizes[1];
+        pool_sizes[0].type            = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        pool_sizes[0].descriptorCount = 1 + 1; // ImGui_ImplVulkan_CreateDeviceObjects
 
         VkDescriptorPoolCreateInfo pool_info {};
         pool_info.sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
         pool_info.poolSizeCount = sizeof(pool_sizes) / sizeof(pool_sizes[0]);
         pool_info.pPoolSizes    = pool_sizes;
-        pool_info.maxSets =
-            1 + 1 + 1 + mMaxMaterialCount + mMaxVertexBlendingMeshCount + 1 + 1; // +skybox + axis descriptor set
+        pool_info.maxSets       = 1 + 1;
         pool_info.flags = 0U;
 
         if (vkCreateDescriptorPool(mDevice, &pool_info, nullptr, &mVkDescPool) != VK_SUCCESS)
@@ -2976,11 +3208,7 @@ namespace MiniEngine
 
         pPipelines = new VulkanPipeline();
         VkPipeline vk_pipelines;
-        VkPipelineCache vk_pipeline_cache = VK_NULL_HANDLE;
-        if (pipelineCache != nullptr)
-        {
-            vk_pipeline_cache = ((VulkanPipelineCache*)pipelineCache)->GetResource();
-        }
+        VkPipelineCache vk_pipeline_cache = getPipelineCacheResource(pipelineCache);
         VkResult result = vkCreateGraphicsPipelines(mDevice, vk_pipeline_cache, createInfoCnt, &create_info, nullptr, &vk_pipelines);
         ((VulkanPipeline*)pPipelines)->SetResource(vk_pipelines);
 
@@ -3206,6 +3434,121 @@ namespace MiniEngine
         vmaCreateAllocator(&allocatorCreateInfo, &mAssetsAllocator);
     }
 
+    void VulkanRHI::createPipelineCache()
+    {
+        std::vector<char> cache_data;
+        if (!mPipelineCachePath.empty())
+        {
+            std::ifstream cache_file(mPipelineCachePath, std::ios::binary | std::ios::ate);
+            if (cache_file.is_open())
+            {
+                cache_data.resize(static_cast<size_t>(cache_file.tellg()));
+                cache_file.seekg(0);
+                cache_file.read(cache_data.data(), cache_data.size());
+            }
+        }
+
+        if (!cache_data.empty() && !isPipelineCacheDataCompatible(cache_data))
+        {
+            LOG_WARN("pipeline cache {} was built for another device or driver, discarding it", mPipelineCachePath.generic_string());
+            cache_data.clear();
+        }
+
+        VkPipelineCacheCreateInfo pipeline_cache_create_info {};
+        pipeline_cache_create_info.sType           = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        pipeline_cache_create_info.initialDataSize = cache_data.size();
+        pipeline_cache_create_info.pInitialData    = cache_data.empty() ? nullptr : cache_data.data();
+
+        VkPipelineCache vk_pipeline_cache;
+        if (vkCreatePipelineCache(mDevice, &pipeline_cache_create_info, nullptr, &vk_pipeline_cache) != VK_SUCCESS)
+        {
+            throw std::runtime_error("create pipeline cache");
+        }
+
+        mPipelineCache = new VulkanPipelineCache();
+        ((VulkanPipelineCache*)mPipelineCache)->SetResource(vk_pipeline_cache);
+        mbPipelineCacheWarm = !cache_data.empty();
+
+        LOG_INFO("pipeline cache created {} ({} bytes)", mbPipelineCacheWarm ? "warm" : "cold", cache_data.size());
+    }
+
+    bool VulkanRHI::isPipelineCacheDataCompatible(const std::vector<char>& cache_data)
+    {
+        // the driver would reject a foreign blob too, check the header ourselves to know whether we start cold
+        VkPipelineCacheHeaderVersionOne header;
+        if (cache_data.size() < sizeof(header))
+        {
+            return false;
+        }
+        memcpy(&header, cache_data.data(), sizeof(header));
+
+        VkPhysicalDeviceProperties physical_device_properties;
+        vkGetPhysicalDeviceProperties(mPhysicalDevice, &physical_device_properties);
+
+        return header.headerSize >= sizeof(header) &&
+               header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+               header.vendorID == physical_device_properties.vendorID &&
+               header.deviceID == physical_device_properties.deviceID &&
+               memcmp(header.pipelineCacheUUID, physical_device_properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+    }
+
+    VkPipelineCache VulkanRHI::getPipelineCacheResource(RHIPipelineCache* pipeline_cache) const
+    {
+        if (pipeline_cache == nullptr)
+        {
+            pipeline_cache = mPipelineCache;
+        }
+        return pipeline_cache != nullptr ? ((VulkanPipelineCache*)pipeline_cache)->GetResource() : VK_NULL_HANDLE;
+    }
+
+    RHIPipelineCache* VulkanRHI::GetPipelineCache() const
+    {
+        return mPipelineCache;
+    }
+
+    void VulkanRHI::SavePipelineCache()
+    {
+        if (mPipelineCache == nullptr || mPipelineCachePath.empty())
+        {
+            return;
+        }
+
+        VkPipelineCache vk_pipeline_cache = ((VulkanPipelineCache*)mPipelineCache)->GetResource();
+        size_t          data_size         = 0;
+        if (vkGetPipelineCacheData(mDevice, vk_pipeline_cache, &data_size, nullptr) != VK_SUCCESS || data_size == 0)
+        {
+            LOG_WARN("get pipeline cache data failed");
+            return;
+        }
+
+        std::vector<char> cache_data(data_size);
+        if (vkGetPipelineCacheData(mDevice, vk_pipeline_cache, &data_size, cache_data.data()) != VK_SUCCESS)
+        {
+            LOG_WARN("get pipeline cache data failed");
+            return;
+        }
+
+        // write beside the target and rename, a crash while writing must not leave a truncated cache
+        std::filesystem::path temp_path = mPipelineCachePath;
+        temp_path += ".tmp";
+        {
+            std::ofstream cache_file(temp_path, std::ios::binary | std::ios::trunc);
+            if (!cache_file.is_open())
+            {
+                LOG_WARN("open pipeline cache {} for writing failed", temp_path.generic_string());
+                return;
+            }
+            cache_file.write(cache_data.data(), data_size);
+        }
+
+        std::error_code error_code;
+        std::filesystem::rename(temp_path, mPipelineCachePath, error_code);
+        if (error_code)
+        {
+            LOG_WARN("save pipeline cache {} failed: {}", mPipelineCachePath.generic_string(), error_code.message());
+        }
+    }
+
     // todo : more descriptorSet
     bool VulkanRHI::AllocateDescriptorSets(const RHIDescriptorSetAllocateInfo* pAllocateInfo, RHIDescriptorSet* &pDescriptorSets)
     {
@@ -3247,6 +3590,23 @@ namespace MiniEngine
         }
     }
 
+    bool VulkanRHI::AllocateDescriptorSet(RHIDescriptorSetLayout* layout, RHIDescriptorSet* &pDescriptorSet)
+    {
+        pDescriptorSet = mDescriptorAllocator.Allocate(((VulkanDescriptorSetLayout*)layout)->GetResource());
+        return pDescriptorSet != nullptr;
+    }
+
+    void VulkanRHI::FreeDescriptorSet(RHIDescriptorSetLayout* layout, RHIDescriptorSet* descriptorSet)
+    {
+        mDescriptorAllocator.Free(((VulkanDescriptorSetLayout*)layout)->GetResource(), descriptorSet);
+    }
+
+    bool VulkanRHI::AllocateTransientDescriptorSet(RHIDescriptorSetLayout* layout, RHIDescriptorSet* &pDescriptorSet)
+    {
+        pDescriptorSet = mDescriptorAllocator.AllocateTransient(((VulkanDescriptorSetLayout*)layout)->GetResource());
+        return pDescriptorSet != nullptr;
+    }
+
     bool VulkanRHI::AllocateCommandBuffers(const RHICommandBufferAllocateInfo* pAllocateInfo, RHICommandBuffer* &pCommandBuffers)
     {
         VkCommandBufferAllocateInfo command_buffer_allocate_info{};
@@ -3274,6 +3634,12 @@ namespace MiniEngine
 
     void VulkanRHI::CreateSwapChain()
     {
+        if (mbHeadless)
+        {
+            createOffscreenImages();
+            return;
+        }
+
         // query all supports of this physical device
         SwapChainSupportDetails swapchain_support_details = querySwapChainSupport(mPhysicalDevice);
 
@@ -3346,9 +3712,52 @@ namespace MiniEngine
         {
             vkDestroyImageView(mDevice, ((VulkanImageView*)imageview)->GetResource(), NULL);
         }
+
+        if (mbHeadless)
+        {
+            for (size_t i = 0; i < mSwapChainImages.size(); ++i)
+            {
+                vkDestroyImage(mDevice, mSwapChainImages[i], NULL);
+                vkFreeMemory(mDevice, mOffscreenImageMemories[i], NULL);
+            }
+            mOffscreenImageMemories.clear();
+            return;
+        }
         vkDestroySwapchainKHR(mDevice, mSwapChain, NULL); // also swapchain images
     }
 
+    void VulkanRHI::createOffscreenImages()
+    {
+        // the fence of a frame is waited before it is recorded again, so its image is free to reuse
+        uint32_t image_count = mkMaxFramesInFlight;
+        VkFormat image_format = VK_FORMAT_B8G8R8A8_UNORM;
+
+        mSwapChainImageFormat   = (RHIFormat)image_format;
+        mSwapChainExtent.width  = static_cast<uint32_t>(mViewport.width);
+        mSwapChainExtent.height = static_cast<uint32_t>(mViewport.height);
+
+        mSwapChainImages.resize(image_count);
+        mOffscreenImageMemories.resize(image_count);
+        for (uint32_t i = 0; i < image_count; ++i)
+        {
+            VulkanUtil::CreateImage(mPhysicalDevice,
+                                    mDevice,
+                                    mSwapChainExtent.width,
+                                    mSwapChainExtent.height,
+                                    image_format,
+                                    VK_IMAGE_TILING_OPTIMAL,
+                                    VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+                                    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                    mSwapChainImages[i],
+                                    mOffscreenImageMemories[i],
+                                    0,
+                                    1,
+                                    1);
+        }
+
+        mScissor = {{0, 0}, {mSwapChainExtent.width, mSwapChainExtent.height}};
+    }
+
     void VulkanRHI::DestroyDefaultSampler(RHIDefaultSamplerType type)
     {
         switch (type)
@@ -3435,6 +3844,30 @@ namespace MiniEngine
         RHI_DELETE_PTR(buffer);
     }
 
+    void VulkanRHI::DestroyBufferVMA(VmaAllocator allocator, RHIBuffer* &buffer, VmaAllocation allocation)
+    {
+        if (buffer == nullptr)
+        {
+            return;
+        }
+        vmaDestroyBuffer(allocator, ((VulkanBuffer*)buffer)->GetResource(), allocation);
+        RHI_DELETE_PTR(buffer);
+    }
+
+    void VulkanRHI::DestroyImageVMA(VmaAllocator allocator, RHIImage* &image, RHIImageView* &imageView, VmaAllocation allocation)
+    {
+        if (imageView != nullptr)
+        {
+            vkDestroyImageView(mDevice, ((VulkanImageView*)imageView)->GetResource(), nullptr);
+            RHI_DELETE_PTR(imageView);
+        }
+        if (image != nullptr)
+        {
+            vmaDestroyImage(allocator, ((VulkanImage*)image)->GetResource(), allocation);
+            RHI_DELETE_PTR(image);
+        }
+    }
+
     void VulkanRHI::FreeCommandBuffers(RHICommandPool* commandPool, uint32_t commandBufferCount, RHICommandBuffer* pCommandBuffers)
     {
         VkCommandBuffer vk_command_buffer = ((VulkanCommandBuffer*)pCommandBuffers)->GetResource();
@@ -3577,14 +4010,22 @@ namespace MiniEngine
             }
 
 
-            VkBool32 is_present_support = false;
-            vkGetPhysicalDeviceSurfaceSupportKHR(physicalm_device,
-                                                 i,
-                                                 mSurface,
-                                                 &is_present_support); // if support surface presentation
-            if (is_present_support)
+            if (mbHeadless)
             {
-                indices.presentFamily = i;
+                // nothing is presented, the graphics queue stands in for the present queue
+                indices.presentFamily = indices.graphicsFamily;
+            }
+            else
+            {
+                VkBool32 is_present_support = false;
+                vkGetPhysicalDeviceSurfaceSupportKHR(physicalm_device,
+                                                     i,
+                                                     mSurface,
+                                                     &is_present_support); // if support surface presentation
+                if (is_present_support)
+                {
+                    indices.presentFamily = i;
+                }
             }
 
             if (indices.isComplete())
@@ -3617,8 +4058,8 @@ namespace MiniEngine
     {
         auto queue_indices           = findQueueFamilies(physicalm_device);
         bool is_extensions_supported = checkDeviceExtensionSupport(physicalm_device);
-        bool is_swapchain_adequate   = false;
-        if (is_extensions_supported)
+        bool is_swapchain_adequate   = mbHeadless;
+        if (is_extensions_supported && !mbHeadless)
         {
             SwapChainSupportDetails swapchain_support_details = querySwapChainSupport(physicalm_device);
             is_swapchain_adequate =
@@ -3636,6 +4077,57 @@ namespace MiniEngine
         return true;
     }
 
+    bool VulkanRHI::queryBindlessSupport(VkPhysicalDevice physical_device)
+    {
+        mMaxBindlessTextureCount = 0;
+
+        VkPhysicalDeviceProperties physical_device_properties;
+        vkGetPhysicalDeviceProperties(physical_device, &physical_device_properties);
+        if (physical_device_properties.apiVersion < VK_API_VERSION_1_1)
+        {
+            return false;
+        }
+
+        uint32_t extension_count;
+        vkEnumerateDeviceExtensionProperties(physical_device, nullptr, &extension_count, nullptr);
+        std::vector<VkExtensionProperties> available_extensions(extension_count);
+        vkEnumerateDeviceExtensionProperties(physical_device, nullptr, &extension_count, available_extensions.data());
+        if (std::none_of(available_extensions.begin(), available_extensions.end(), [](const VkExtensionProperties& extension) {
+                return strcmp(extension.extensionName, VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME) == 0;
+            }))
+        {
+            return false;
+        }
+
+        VkPhysicalDeviceDescriptorIndexingFeaturesEXT descriptor_indexing_features {};
+        descriptor_indexing_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+        VkPhysicalDeviceFeatures2 physical_device_features {};
+        physical_device_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        physical_device_features.pNext = &descriptor_indexing_features;
+        vkGetPhysicalDeviceFeatures2(physical_device, &physical_device_features);
+        if (!descriptor_indexing_features.shaderSampledImageArrayNonUniformIndexing ||
+            !descriptor_indexing_features.descriptorBindingSampledImageUpdateAfterBind ||
+            !descriptor_indexing_features.descriptorBindingPartiallyBound ||
+            !descriptor_indexing_features.runtimeDescriptorArray)
+        {
+            return false;
+        }
+
+        VkPhysicalDeviceDescriptorIndexingPropertiesEXT descriptor_indexing_properties {};
+        descriptor_indexing_properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT;
+        VkPhysicalDeviceProperties2 physical_device_properties2 {};
+        physical_device_properties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        physical_device_properties2.pNext = &descriptor_indexing_properties;
+        vkGetPhysicalDeviceProperties2(physical_device, &physical_device_properties2);
+
+        mMaxBindlessTextureCount = std::min({mkMaxBindlessTextureCount,
+                                             descriptor_indexing_properties.maxPerStageDescriptorUpdateAfterBindSamplers,
+                                             descriptor_indexing_properties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+                                             descriptor_indexing_properties.maxDescriptorSetUpdateAfterBindSamplers,
+                                             descriptor_indexing_properties.maxDescriptorSetUpdateAfterBindSampledImages});
+        return mMaxBindlessTextureCount > 0;
+    }
+
     MiniEngine::SwapChainSupportDetails VulkanRHI::querySwapChainSupport(VkPhysicalDevice physicalm_device)
     {
         SwapChainSupportDetails details_result;
@@ -3713,14 +4205,14 @@ namespace MiniEngine
 
     VkPresentModeKHR VulkanRHI::chooseSwapChainPresentModeFromDetails(const std::vector<VkPresentModeKHR>& available_present_modes)
     {
-        for (VkPresentModeKHR present_mode : available_present_modes)
+        // fifo is the only mode every surface has to support
+        if (std::find(available_present_modes.begin(), available_present_modes.end(), mPresentMode) !=
+            available_present_modes.end())
         {
-            if (VK_PRESENT_MODE_MAILBOX_KHR == present_mode)
-            {
-                return VK_PRESENT_MODE_MAILBOX_KHR;
-            }
+            return mPresentMode;
         }
 
+        LOG_WARN("present mode {} is not supported by the surface, falling back to fifo", static_cast<int>(mPresentMode));
         return VK_PRESENT_MODE_FIFO_KHR;
     }
 
@@ -3758,6 +4250,26 @@ namespace MiniEngine
                 label_info.color[i] = color[i];
             pfnVkCmdBeginDebugUtilsLabelEXT(((VulkanCommandBuffer*)commond_buffer)->GetResource(), &label_info);
         }
+
+        if (isGpuProfileCommandBuffer(commond_buffer))
+        {
+            uint32_t& query_count = mTimestampQueryCounts[mCurrentFrameIndex];
+            // keep one query for the matching pop, the stack entry is still pushed to keep pops balanced
+            if (query_count + 2 > mkMaxGpuProfileQueryCount)
+            {
+                mGpuProfileScopeStack.push_back(UINT32_MAX);
+                return;
+            }
+
+            std::vector<GpuProfileScope>& scopes = mGpuProfileScopes[mCurrentFrameIndex];
+            vkCmdWriteTimestamp(mVkCommandBuffers[mCurrentFrameIndex],
+                                VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                                mTimestampQueryPools[mCurrentFrameIndex],
+                                query_count);
+            mGpuProfileScopeStack.push_back(static_cast<uint32_t>(scopes.size()));
+            scopes.push_back({name, static_cast<uint32_t>(mGpuProfileScopeStack.size() - 1), query_count, UINT32_MAX});
+            ++query_count;
+        }
     }
 
     void VulkanRHI::PopEvent(RHICommandBuffer* commond_buffer)
@@ -3766,6 +4278,135 @@ namespace MiniEngine
         {
             pfnVkCmdEndDebugUtilsLabelEXT(((VulkanCommandBuffer*)commond_buffer)->GetResource());
         }
+
+        if (isGpuProfileCommandBuffer(commond_buffer) && !mGpuProfileScopeStack.empty())
+        {
+            uint32_t scope_index = mGpuProfileScopeStack.back();
+            mGpuProfileScopeStack.pop_back();
+            if (scope_index == UINT32_MAX)
+            {
+                return;
+            }
+
+            uint32_t& query_count = mTimestampQueryCounts[mCurrentFrameIndex];
+            vkCmdWriteTimestamp(mVkCommandBuffers[mCurrentFrameIndex],
+                                VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                                mTimestampQueryPools[mCurrentFrameIndex],
+                                query_count);
+            mGpuProfileScopes[mCurrentFrameIndex][scope_index].end_query = query_count;
+            ++query_count;
+        }
+    }
+
+    void VulkanRHI::createTimestampQueryPools()
+    {
+        VkPhysicalDeviceProperties physical_device_properties;
+        vkGetPhysicalDeviceProperties(mPhysicalDevice, &physical_device_properties);
+        if (!physical_device_properties.limits.timestampComputeAndGraphics)
+        {
+            LOG_WARN("timestamp queries are not supported, gpu profiling is disabled");
+            return;
+        }
+        mTimestampPeriod = physical_device_properties.limits.timestampPeriod;
+
+        VkQueryPoolCreateInfo query_pool_create_info {};
+        query_pool_create_info.sType      = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        query_pool_create_info.queryType  = VK_QUERY_TYPE_TIMESTAMP;
+        query_pool_create_info.queryCount = mkMaxGpuProfileQueryCount;
+
+        for (uint8_t i = 0; i < mkMaxFramesInFlight; ++i)
+        {
+            if (vkCreateQueryPool(mDevice, &query_pool_create_info, nullptr, &mTimestampQueryPools[i]) != VK_SUCCESS)
+            {
+                throw std::runtime_error("create timestamp query pool");
+            }
+            mGpuProfileScopes[i].reserve(mkMaxGpuProfileQueryCount / 2);
+        }
+    }
+
+    void VulkanRHI::beginGpuProfileFrame()
+    {
+        mbGpuProfileFrameActive = false;
+        mGpuProfileScopeStack.clear();
+
+        Profiler* profiler = gRuntimeGlobalContext.mProfiler.get();
+        if (mTimestampQueryPools[mCurrentFrameIndex] == VK_NULL_HANDLE || profiler == nullptr)
+        {
+            return;
+        }
+
+        // the fence of this frame has been waited, so the queries of its previous use are complete
+        collectGpuProfileScopes(mCurrentFrameIndex);
+
+        if (!profiler->IsEnabled())
+        {
+            return;
+        }
+
+        vkCmdResetQueryPool(mVkCommandBuffers[mCurrentFrameIndex],
+                            mTimestampQueryPools[mCurrentFrameIndex],
+                            0,
+                            mkMaxGpuProfileQueryCount);
+        mGpuProfileFrameBeginNs[mCurrentFrameIndex] = profiler->GetTimeNs();
+        mbGpuProfileFrameActive                     = true;
+    }
+
+    void VulkanRHI::collectGpuProfileScopes(uint8_t frame_index)
+    {
+        std::vector<GpuProfileScope>& scopes      = mGpuProfileScopes[frame_index];
+        uint32_t                      query_count = mTimestampQueryCounts[frame_index];
+        mTimestampQueryCounts[frame_index]        = 0;
+        if (scopes.empty() || query_count == 0)
+        {
+            scopes.clear();
+            return;
+        }
+
+        uint64_t timestamps[mkMaxGpuProfileQueryCount];
+        VkResult result = vkGetQueryPoolResults(mDevice,
+                                                mTimestampQueryPools[frame_index],
+                                                0,
+                                                query_count,
+                                                sizeof(timestamps),
+                                                timestamps,
+                                                sizeof(uint64_t),
+                                                VK_QUERY_RESULT_64_BIT);
+        if (result != VK_SUCCESS)
+        {
+            scopes.clear();
+            return;
+        }
+
+        // gpu and cpu clocks are not calibrated, the gpu frame is placed at the cpu time its recording began
+        uint64_t                  gpu_frame_begin = timestamps[scopes.front().begin_query];
+        std::vector<ProfileScope> profile_scopes;
+        profile_scopes.reserve(scopes.size());
+        for (const GpuProfileScope& scope : scopes)
+        {
+            if (scope.end_query == UINT32_MAX)
+            {
+                continue;
+            }
+
+            ProfileScope profile_scope;
+            profile_scope.name         = scope.name;
+            profile_scope.thread_index = s_profiler_gpu_thread_index;
+            profile_scope.depth        = scope.depth;
+            profile_scope.begin_ns     = mGpuProfileFrameBeginNs[frame_index] +
+                                     static_cast<uint64_t>((timestamps[scope.begin_query] - gpu_frame_begin) * mTimestampPeriod);
+            profile_scope.end_ns = mGpuProfileFrameBeginNs[frame_index] +
+                                   static_cast<uint64_t>((timestamps[scope.end_query] - gpu_frame_begin) * mTimestampPeriod);
+            profile_scopes.push_back(profile_scope);
+        }
+        scopes.clear();
+
+        gRuntimeGlobalContext.mProfiler->AddGpuScopes(profile_scopes);
+    }
+
+    bool VulkanRHI::isGpuProfileCommandBuffer(RHICommandBuffer* command_buffer) const
+    {
+        return mbGpuProfileFrameActive &&
+               ((VulkanCommandBuffer*)command_buffer)->GetResource() == mVkCommandBuffers[mCurrentFrameIndex];
     }
     // bool VulkanRHI::isPointLightShadowEnabled(){ return mbEnablePointLightShadow; }
 
@@ -3804,6 +4445,7 @@ namespace MiniEngine
     RHISwapChainDesc VulkanRHI::GetSwapChainInfo()
     {
         RHISwapChainDesc desc;
+        desc.presentLayout = mbHeadless ? RHI_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : RHI_IMAGE_LAYOUT_PRESENT_SRC_KHR;
         desc.imageFormat = mSwapChainImageFormat;
         desc.extent = mSwapChainExtent;
         desc.viewport = &mViewport;
@@ -3821,7 +4463,11 @@ namespace MiniEngine
     }
     uint8_t VulkanRHI::GetMaxFramesInFlight() const
     {
-        return mkMaxFramesInFlight;
+        return mFramesInFlight;
+    }
+    uint32_t VulkanRHI::GetMaxBindlessTextureCount() const
+    {
+        return mMaxBindlessTextureCount;
     }
     uint8_t VulkanRHI::GetCurrentFrameIndex() const
     {
@@ -4,11 +4,13 @@
 #include "Function/Render/Interface/RHIStruct.hpp"
 #include "Function/Render/RenderType.hpp"
 #include "Function/Render/Interface/Vulkan/VulkanRHIResource.hpp"
+#include "Function/Render/Interface/Vulkan/VulkanDescriptorAllocator.hpp"
 
 #include <cstring>
 #include <set>
 #include <vector>
 #include <map>
+#include <mutex>
 
 #include <vk_mem_alloc.h>
 #include <vulkan/vulkan.h>
@@ -24,6 +26,9 @@ namespace MiniEngine
         // allocate and create
         virtual bool AllocateCommandBuffers(const RHICommandBufferAllocateInfo* pAllocateInfo, RHICommandBuffer* &pCommandBuffers) override;
         virtual bool AllocateDescriptorSets(const RHIDescriptorSetAllocateInfo* pAllocateInfo, RHIDescriptorSet* &pDescriptorSets) override;
+        virtual bool AllocateDescriptorSet(RHIDescriptorSetLayout* layout, RHIDescriptorSet* &pDescriptorSet) override;
+        virtual void FreeDescriptorSet(RHIDescriptorSetLayout* layout, RHIDescriptorSet* descriptorSet) override;
+        virtual bool AllocateTransientDescriptorSet(RHIDescriptorSetLayout* layout, RHIDescriptorSet* &pDescriptorSet) override;
         virtual void CreateSwapChain()                                                      override;
         virtual void CreateSwapChainImageViews()                                            override;
         virtual RHIShader* CreateShaderModule(const std::vector<unsigned char>& shaderCode) override;
@@ -76,6 +81,7 @@ namespace MiniEngine
         virtual void CmdSetViewportPFN(RHICommandBuffer* commandBuffer,  uint32_t firstViewport,  uint32_t viewportCount,  const RHIViewport* pViewports) override;
         virtual void CmdSetScissorPFN(RHICommandBuffer* commandBuffer,  uint32_t firstScissor,  uint32_t scissorCount,  const RHIRect2D* pScissors) override;
         virtual void CmdClearAttachmentsPFN(RHICommandBuffer* commandBuffer, uint32_t attachmentCount, const RHIClearAttachment* pAttachments, uint32_t rectCount, const RHIClearRect* pRects) override;
+        virtual void CmdExecuteCommandsPFN(RHICommandBuffer* commandBuffer, uint32_t commandBufferCount, RHICommandBuffer* const* pCommandBuffers) override;
         
         virtual void CmdCopyImageToBuffer(RHICommandBuffer* commandBuffer, RHIImage* srcImage, RHIImageLayout srcImageLayout, RHIBuffer* dstBuffer, uint32_t regionCount, const RHIBufferImageCopy* pRegions) override;
         virtual void CmdCopyImageToImage(RHICommandBuffer* commandBuffer, RHIImage* srcImage, RHIImageAspectFlagBits srcFlag, RHIImage* dstImage, RHIImageAspectFlagBits dstFlag, uint32_t width, uint32_t height) override;
@@ -105,15 +111,22 @@ namespace MiniEngine
         virtual uint8_t GetMaxFramesInFlight() const override;
         virtual uint8_t GetCurrentFrameIndex() const override;
         virtual void SetCurrentFrameIndex(uint8_t index) override;
+        virtual uint32_t GetMaxBindlessTextureCount() const override;
 
         // command write
         virtual bool PrepareBeforePass(std::function<void()> passUpdateAfterRecreateSwapChain) override;
         virtual void SubmitRendering(std::function<void()> passUpdateAfterRecreateSwapChain)   override;
         virtual RHICommandBuffer* BeginSingleTimeCommand() override;
         virtual void EndSingleTimeCommand(RHICommandBuffer* cmdBuffer) override;
+        virtual uint32_t GetMaxSecondaryCommandRecorderCount() const override;
+        virtual RHICommandBuffer* BeginSecondaryCommandBuffer(uint32_t recorder_index, RHIRenderPass* render_pass, uint32_t subpass, RHIFrameBuffer* framebuffer) override;
         virtual void PushEvent(RHICommandBuffer* commond_buffer, const char* name, const float* color) override;
         virtual void PopEvent(RHICommandBuffer* commond_buffer) override;
 
+        // pipeline cache
+        virtual RHIPipelineCache* GetPipelineCache() const override;
+        virtual void SavePipelineCache() override;
+
         // Destroy
         virtual void Clear() override;
         virtual void ClearSwapchain() override;
@@ -130,6 +143,8 @@ namespace MiniEngine
         virtual void DestroyDevice() override;
         virtual void DestroyCommandPool(RHICommandPool* commandPool) override;
         virtual void DestroyBuffer(RHIBuffer* &buffer) override;
+        virtual void DestroyBufferVMA(VmaAllocator allocator, RHIBuffer* &buffer, VmaAllocation allocation) override;
+        virtual void DestroyImageVMA(VmaAllocator allocator, RHIImage* &image, RHIImageView* &imageView, VmaAllocation allocation) override;
         virtual void FreeCommandBuffers(RHICommandPool* commandPool, uint32_t commandBufferCount, RHICommandBuffer* pCommandBuffers) override;
 
         // Buffer Memory
@@ -152,6 +167,17 @@ namespace MiniEngine
         void createDescriptorPool();
         void createSyncPrimitives();
         void createAssetAllocator();
+        void createPipelineCache();
+        void createTimestampQueryPools();
+        void createOffscreenImages();
+        void submitHeadlessRendering();
+
+        void beginGpuProfileFrame();
+        void collectGpuProfileScopes(uint8_t frame_index);
+        bool isGpuProfileCommandBuffer(RHICommandBuffer* command_buffer) const;
+
+        bool isPipelineCacheDataCompatible(const std::vector<char>& cache_data);
+        VkPipelineCache getPipelineCacheResource(RHIPipelineCache* pipeline_cache) const;
 
         bool checkValidationLayersSupport();
         std::vector<const char*> getRequiredExtensions();
@@ -168,6 +194,7 @@ namespace MiniEngine
         bool checkDeviceExtensionSupport(VkPhysicalDevice physicalDevice);
         SwapChainSupportDetails querySwapChainSupport(VkPhysicalDevice physicalDevice);
         bool isDeviceSuitable(VkPhysicalDevice physicalDevice);
+        bool queryBindlessSupport(VkPhysicalDevice physicalDevice);
 
         VkFormat findDepthFormat();
         VkFormat findSupportedFormat(const std::vector<VkFormat>& candidates, VkImageTiling tiling, VkFormatFeatureFlags features);
@@ -196,9 +223,12 @@ namespace MiniEngine
         RHIFence* mRHIIsFrameInFlightFences[mkMaxFramesInFlight];
 
         RHIDescriptorPool* mDescPool = new VulkanDescriptorPool();
-        // global descriptor pool
+        // global descriptor pool, only holds what imgui allocates itself
         VkDescriptorPool mVkDescPool;
 
+        // the descriptor sets of the passes and render resources
+        VulkanDescriptorAllocator mDescriptorAllocator;
+
         RHICommandPool* mRHICommandPool;                            // 命令池
         RHICommandBuffer* mCurrentCommandBuffer = new VulkanCommandBuffer();
         RHICommandBuffer* mCommandBuffers[mkMaxFramesInFlight];
@@ -220,8 +250,16 @@ namespace MiniEngine
         // asset allocator use VMA library
         VmaAllocator mAssetsAllocator;
 
+        // shared by all pipelines, serialized to disk between runs
+        RHIPipelineCache*     mPipelineCache {nullptr};
+        std::filesystem::path mPipelineCachePath;
+        bool                  mbPipelineCacheWarm {false};
+
         // Command Pool and Buffers
         uint8_t             mCurrentFrameIndex {0};
+        // frames in flight actually used, the arrays below are sized for the maximum
+        uint8_t             mFramesInFlight {mkMaxFramesInFlight};
+        VkPresentModeKHR    mPresentMode {VK_PRESENT_MODE_MAILBOX_KHR};
         VkCommandPool       mCommandPools[mkMaxFramesInFlight];
         VkCommandBuffer     mVkCommandBuffers[mkMaxFramesInFlight];
         VkSemaphore         mImageAvailableForRenderSemaphores[mkMaxFramesInFlight];
@@ -253,12 +291,50 @@ namespace MiniEngine
         PFN_vkCmdBindDescriptorSets      pfnVkCmdBindDescriptorSets;
         PFN_vkCmdDrawIndexed             pfnVkCmdDrawIndexed;
         PFN_vkCmdClearAttachments        pfnVkCmdClearAttachments;
+        PFN_vkCmdExecuteCommands         pfnVkCmdExecuteCommands;
 
     private:
         bool mbEnableValidationLayers {true};                        // 启用验证层
         bool mbEnableDebugUtilsLabel {true};
         bool mbEnablePointLightShadow{ true };
 
+        // headless mode renders into one offscreen image per frame in flight instead of a swapchain
+        bool                        mbHeadless {false};
+        std::vector<VkDeviceMemory> mOffscreenImageMemories;
+
+        // timestamp queries around PushEvent/PopEvent, one pool per frame in flight
+        struct GpuProfileScope
+        {
+            const char* name;
+            uint32_t    depth;
+            uint32_t    begin_query;
+            uint32_t    end_query;
+        };
+        static uint32_t const        mkMaxGpuProfileQueryCount {256};
+        VkQueryPool                  mTimestampQueryPools[mkMaxFramesInFlight] {};
+        uint32_t                     mTimestampQueryCounts[mkMaxFramesInFlight] {};
+        uint64_t                     mGpuProfileFrameBeginNs[mkMaxFramesInFlight] {};
+        std::vector<GpuProfileScope> mGpuProfileScopes[mkMaxFramesInFlight];
+        std::vector<uint32_t>        mGpuProfileScopeStack;
+        float                        mTimestampPeriod {0.0f};
+        bool                         mbGpuProfileFrameActive {false};
+
+        // pools of the secondary command buffers, per frame in flight and recorder so recorders never share one.
+        // the buffers are kept and handed out again after the pool of their frame was reset
+        struct SecondaryCommandPool
+        {
+            VkCommandPool                  pool {VK_NULL_HANDLE};
+            std::vector<RHICommandBuffer*> command_buffers;
+            uint32_t                       used_count {0};
+        };
+        static uint32_t const mkMaxSecondaryCommandRecorderCount {16};
+        SecondaryCommandPool  mSecondaryCommandPools[mkMaxFramesInFlight][mkMaxSecondaryCommandRecorderCount];
+
+        // wrappers handed out by BeginSingleTimeCommand, reused once the command buffer is freed.
+        // locked, so reusing them is as thread safe as allocating a wrapper per call was
+        std::mutex                     mSingleTimeCommandBufferMutex;
+        std::vector<RHICommandBuffer*> mSingleTimeCommandBufferFreeList;
+
         VkDebugUtilsMessengerEXT mDebugMessenger {nullptr};
 
         const std::vector<char const*> mValidationLayers {"VK_LAYER_KHRONOS_validation"};
@@ -272,8 +348,8 @@ namespace MiniEngine
         RHISampler* mNearestSampler = nullptr;
         std::map<uint32_t, RHISampler*> mMipSamplerMap {};
 
-        // used in descriptor pool creation
-        uint32_t mMaxVertexBlendingMeshCount { 256 };
-        uint32_t mMaxMaterialCount{ 256 };
+        // texture array size of the bindless materials, clamped by the update after bind limits of the device
+        static uint32_t const mkMaxBindlessTextureCount {16384};
+        uint32_t              mMaxBindlessTextureCount {0};
     };
 }
\ No newline at end of file
@@ -37,6 +37,12 @@ namespace MiniEngine
     {
         Vector3 mDirection;
         Vector3 mColor;
+
+        // cascaded shadow map settings
+        uint32_t mCascadeCount {4};
+        float    mCascadeSplitLambda {0.75f};
+        float    mShadowDistance {200.0f};
+        uint32_t mShadowLodBias {1};
     };
 
     struct LightList
@@ -0,0 +1,235 @@
+#include "LightCluster.hpp"
+
+#include "MRuntime/Core/Base/Marco.hpp"
+#include "MRuntime/Core/Base/ThreadPool.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace MiniEngine
+{
+    void LightClusterBuilder::Build(const std::vector<PointLight>&  lights,
+                                    const LightClusterBuildInfo& build_info,
+                                    ThreadPool*                  thread_pool)
+    {
+        assert(build_info.z_near > 0.0f && build_info.z_near < build_info.z_far);
+
+        uint32_t light_count = static_cast<uint32_t>(lights.size());
+        if (light_count > s_max_clustered_point_light_count)
+        {
+            LOG_WARN("{} point lights exceed the clustered light limit {}, the rest are dropped",
+                     light_count,
+                     s_max_clustered_point_light_count);
+            light_count = s_max_clustered_point_light_count;
+        }
+
+        float log_depth_ratio = std::log(build_info.z_far / build_info.z_near);
+        mZSliceScale          = static_cast<float>(s_light_cluster_dimension_z) / log_depth_ratio;
+        mZSliceBias           = static_cast<float>(s_light_cluster_dimension_z) * std::log(build_info.z_near) / log_depth_ratio;
+
+        mPointLights.resize(light_count);
+        mLightViewX.resize(light_count);
+        mLightViewY.resize(light_count);
+        mLightViewZ.resize(light_count);
+        mLightRadius.resize(light_count);
+        mLightClusterMinX.resize(light_count);
+        mLightClusterMaxX.resize(light_count);
+        mLightClusterMinY.resize(light_count);
+        mLightClusterMaxY.resize(light_count);
+        mLightClusterMinZ.resize(light_count);
+        mLightClusterMaxZ.resize(light_count);
+
+        for (uint32_t i = 0; i < light_count; ++i)
+        {
+            const PointLight& light = lights[i];
+            float             radius = light.CalculateRadius();
+
+            mPointLights[i].position  = light.mPosition;
+            mPointLights[i].radius    = radius;
+            mPointLights[i].intensity = light.mFlux / (4.0f * MATH_PI);
+
+            mLightViewX[i]  = light.mPosition.x;
+            mLightViewY[i]  = light.mPosition.y;
+            mLightViewZ[i]  = light.mPosition.z;
+            mLightRadius[i] = radius;
+        }
+
+        auto calculate_bounds = [this, &build_info](uint32_t begin, uint32_t end) {
+            calculateLightBounds(begin, end, build_info);
+        };
+        auto assign_slices = [this](uint32_t begin, uint32_t end) { assignSlices(begin, end); };
+
+        mSliceLightIndices.resize(s_light_cluster_dimension_z);
+        mSliceClusterCounts.resize(s_light_cluster_count);
+
+        if (thread_pool)
+        {
+            thread_pool->ParallelFor(light_count, 256, calculate_bounds);
+            thread_pool->ParallelFor(s_light_cluster_dimension_z, 1, assign_slices);
+        }
+        else
+        {
+            calculate_bounds(0, light_count);
+            assign_slices(0, s_light_cluster_dimension_z);
+        }
+
+        // merge the slices into one index list
+        uint32_t const tile_count = s_light_cluster_dimension_x * s_light_cluster_dimension_y;
+
+        mClusterGrid.resize(s_light_cluster_count * 2);
+        mLightIndices.clear();
+
+        bool truncated = false;
+        for (uint32_t slice = 0; slice < s_light_cluster_dimension_z; ++slice)
+        {
+            const std::vector<uint32_t>& slice_indices = mSliceLightIndices[slice];
+
+            uint32_t slice_offset = static_cast<uint32_t>(mLightIndices.size());
+            uint32_t copy_count   = std::min(static_cast<uint32_t>(slice_indices.size()),
+                                           s_max_light_cluster_index_count - slice_offset);
+            truncated |= copy_count < slice_indices.size();
+            mLightIndices.insert(mLightIndices.end(), slice_indices.begin(), slice_indices.begin() + copy_count);
+
+            uint32_t local_offset = 0;
+            for (uint32_t tile = 0; tile < tile_count; ++tile)
+            {
+                uint32_t cluster_index = slice * tile_count + tile;
+                uint32_t count         = mSliceClusterCounts[cluster_index];
+                uint32_t offset        = slice_offset + std::min(local_offset, copy_count);
+
+                mClusterGrid[cluster_index * 2 + 0] = offset;
+                mClusterGrid[cluster_index * 2 + 1] = std::min(count, slice_offset + copy_count - offset);
+
+                local_offset += count;
+            }
+        }
+
+        if (truncated)
+        {
+            LOG_WARN("light cluster index list is full, some lights are missing from clusters");
+        }
+    }
+
+    void LightClusterBuilder::calculateLightBounds(uint32_t begin, uint32_t end, const LightClusterBuildInfo& build_info)
+    {
+        const Matrix4x4& view = build_info.view_matrix;
+
+        // transform to view space
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            float x = mLightViewX[i];
+            float y = mLightViewY[i];
+            float z = mLightViewZ[i];
+
+            mLightViewX[i] = view[0][0] * x + view[0][1] * y + view[0][2] * z + view[0][3];
+            mLightViewY[i] = view[1][0] * x + view[1][1] * y + view[1][2] * z + view[1][3];
+            mLightViewZ[i] = view[2][0] * x + view[2][1] * y + view[2][2] * z + view[2][3];
+        }
+
+        float const dimension_x = static_cast<float>(s_light_cluster_dimension_x);
+        float const dimension_y = static_cast<float>(s_light_cluster_dimension_y);
+
+        // project the view space bounds of the sphere, x / depth is monotonic in depth so the
+        // extremes are reached at the nearest or farthest depth
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            float radius      = mLightRadius[i];
+            float depth       = -mLightViewZ[i];
+            float depth_min   = std::max(depth - radius, build_info.z_near);
+            float depth_max   = std::min(depth + radius, build_info.z_far);
+            float x_min       = mLightViewX[i] - radius;
+            float x_max       = mLightViewX[i] + radius;
+            float y_min       = mLightViewY[i] - radius;
+            float y_max       = mLightViewY[i] + radius;
+
+            float u_min = std::min(x_min / depth_min, x_min / depth_max) * build_info.proj_scale_x;
+            float u_max = std::max(x_max / depth_min, x_max / depth_max) * build_info.proj_scale_x;
+            float v_min = std::min(y_min / depth_min, y_min / depth_max) * build_info.proj_scale_y;
+            float v_max = std::max(y_max / depth_min, y_max / depth_max) * build_info.proj_scale_y;
+
+            // the scale may be negative when the axis is flipped
+            float ndc_min_x = std::min(u_min, u_max);
+            float ndc_max_x = std::max(u_min, u_max);
+            float ndc_min_y = std::min(v_min, v_max);
+            float ndc_max_y = std::max(v_min, v_max);
+
+            bool outside = depth_min > depth_max || ndc_max_x < -1.0f || ndc_min_x > 1.0f || ndc_max_y < -1.0f ||
+                           ndc_min_y > 1.0f;
+            if (outside)
+            {
+                mLightClusterMinZ[i] = 1;
+                mLightClusterMaxZ[i] = 0;
+                continue;
+            }
+
+            int32_t const max_x = static_cast<int32_t>(s_light_cluster_dimension_x) - 1;
+            int32_t const max_y = static_cast<int32_t>(s_light_cluster_dimension_y) - 1;
+            int32_t const max_z = static_cast<int32_t>(s_light_cluster_dimension_z) - 1;
+
+            mLightClusterMinX[i] = std::clamp(static_cast<int32_t>(std::floor((ndc_min_x * 0.5f + 0.5f) * dimension_x)), 0, max_x);
+            mLightClusterMaxX[i] = std::clamp(static_cast<int32_t>(std::floor((ndc_max_x * 0.5f + 0.5f) * dimension_x)), 0, max_x);
+            mLightClusterMinY[i] = std::clamp(static_cast<int32_t>(std::floor((ndc_min_y * 0.5f + 0.5f) * dimension_y)), 0, max_y);
+            mLightClusterMaxY[i] = std::clamp(static_cast<int32_t>(std::floor((ndc_max_y * 0.5f + 0.5f) * dimension_y)), 0, max_y);
+            mLightClusterMinZ[i] = std::clamp(static_cast<int32_t>(std::floor(std::log(depth_min) * mZSliceScale - mZSliceBias)), 0, max_z);
+            mLightClusterMaxZ[i] = std::clamp(static_cast<int32_t>(std::floor(std::log(depth_max) * mZSliceScale - mZSliceBias)), 0, max_z);
+        }
+    }
+
+    void LightClusterBuilder::assignSlices(uint32_t slice_begin, uint32_t slice_end)
+    {
+        uint32_t const tile_count  = s_light_cluster_dimension_x * s_light_cluster_dimension_y;
+        uint32_t const light_count = static_cast<uint32_t>(mPointLights.size());
+
+        for (uint32_t slice = slice_begin; slice < slice_end; ++slice)
+        {
+            int32_t const slice_index = static_cast<int32_t>(slice);
+            uint32_t*     counts      = &mSliceClusterCounts[slice * tile_count];
+            std::fill(counts, counts + tile_count, 0u);
+
+            // count the lights of every tile first so that the list can be filled in place
+            uint32_t total_count = 0;
+            for (uint32_t i = 0; i < light_count; ++i)
+            {
+                if (slice_index < mLightClusterMinZ[i] || slice_index > mLightClusterMaxZ[i])
+                {
+                    continue;
+                }
+                for (int32_t y = mLightClusterMinY[i]; y <= mLightClusterMaxY[i]; ++y)
+                {
+                    for (int32_t x = mLightClusterMinX[i]; x <= mLightClusterMaxX[i]; ++x)
+                    {
+                        ++counts[y * s_light_cluster_dimension_x + x];
+                    }
+                }
+                total_count += (mLightClusterMaxY[i] - mLightClusterMinY[i] + 1) *
+                               (mLightClusterMaxX[i] - mLightClusterMinX[i] + 1);
+            }
+
+            uint32_t cursors[s_light_cluster_dimension_x * s_light_cluster_dimension_y];
+            uint32_t offset = 0;
+            for (uint32_t tile = 0; tile < tile_count; ++tile)
+            {
+                cursors[tile] = offset;
+                offset += counts[tile];
+            }
+
+            std::vector<uint32_t>& slice_indices = mSliceLightIndices[slice];
+            slice_indices.resize(total_count);
+            for (uint32_t i = 0; i < light_count; ++i)
+            {
+                if (slice_index < mLightClusterMinZ[i] || slice_index > mLightClusterMaxZ[i])
+                {
+                    continue;
+                }
+                for (int32_t y = mLightClusterMinY[i]; y <= mLightClusterMaxY[i]; ++y)
+                {
+                    for (int32_t x = mLightClusterMinX[i]; x <= mLightClusterMaxX[i]; ++x)
+                    {
+                        slice_indices[cursors[y * s_light_cluster_dimension_x + x]++] = i;
+                    }
+                }
+            }
+        }
+    }
+} // namespace MiniEngine
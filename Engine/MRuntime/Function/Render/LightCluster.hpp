@@ -0,0 +1,78 @@
+#pragma once
+
+#include "MRuntime/Core/Math/Matrix4.hpp"
+#include "MRuntime/Function/Render/Light.hpp"
+#include "MRuntime/Function/Render/RenderCommon.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace MiniEngine
+{
+    class ThreadPool;
+
+    // froxel grid in view space, x/y are screen tiles and z slices are distributed logarithmically
+    // should sync the macros in "Shader/Common/Constant.h"
+    static uint32_t const s_light_cluster_dimension_x      = 16;
+    static uint32_t const s_light_cluster_dimension_y      = 9;
+    static uint32_t const s_light_cluster_dimension_z      = 24;
+    static uint32_t const s_light_cluster_count            = s_light_cluster_dimension_x * s_light_cluster_dimension_y * s_light_cluster_dimension_z;
+    static uint32_t const s_max_clustered_point_light_count = 4096;
+    static uint32_t const s_max_light_cluster_index_count   = 256 * 1024;
+
+    struct LightClusterBuildInfo
+    {
+        Matrix4x4 view_matrix;
+        // signed scale factors of the projection, ndc.x = proj_scale_x * x / -z
+        float     proj_scale_x;
+        float     proj_scale_y;
+        float     z_near;
+        float     z_far;
+    };
+
+    // assign point lights to clusters on the cpu, output layout matches the storage buffers read by the shader
+    class LightClusterBuilder
+    {
+    public:
+        void Build(const std::vector<PointLight>& lights, const LightClusterBuildInfo& build_info, ThreadPool* thread_pool);
+
+        // z slice = log(view depth) * scale - bias
+        float GetZSliceScale() const { return mZSliceScale; }
+        float GetZSliceBias() const { return mZSliceBias; }
+
+        const std::vector<VulkanScenePointLight>& GetPointLights() const { return mPointLights; }
+        // (offset, count) into the light index list for every cluster
+        const std::vector<uint32_t>& GetClusterGrid() const { return mClusterGrid; }
+        const std::vector<uint32_t>& GetLightIndices() const { return mLightIndices; }
+
+    private:
+        void calculateLightBounds(uint32_t begin, uint32_t end, const LightClusterBuildInfo& build_info);
+        void assignSlices(uint32_t slice_begin, uint32_t slice_end);
+
+    private:
+        float mZSliceScale {0.0f};
+        float mZSliceBias {0.0f};
+
+        // light data in soa form so that the bound calculation can be vectorized
+        std::vector<float> mLightViewX;
+        std::vector<float> mLightViewY;
+        std::vector<float> mLightViewZ;
+        std::vector<float> mLightRadius;
+
+        // inclusive cluster ranges of each light, empty when min > max
+        std::vector<int32_t> mLightClusterMinX;
+        std::vector<int32_t> mLightClusterMaxX;
+        std::vector<int32_t> mLightClusterMinY;
+        std::vector<int32_t> mLightClusterMaxY;
+        std::vector<int32_t> mLightClusterMinZ;
+        std::vector<int32_t> mLightClusterMaxZ;
+
+        // per z slice light lists, merged after the parallel assignment
+        std::vector<std::vector<uint32_t>> mSliceLightIndices;
+        std::vector<uint32_t>              mSliceClusterCounts;
+
+        std::vector<VulkanScenePointLight> mPointLights;
+        std::vector<uint32_t>              mClusterGrid;
+        std::vector<uint32_t>              mLightIndices;
+    };
+} // namespace MiniEngine
@@ -0,0 +1,837 @@
+#include "MeshOptimizer.hpp"
+
+#include "MRuntime/Core/Base/Marco.hpp"
+#include "MRuntime/Core/Math/Vector3.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <unordered_set>
+
+namespace MiniEngine
+{
+    namespace
+    {
+        // scoring from "Linear-Speed Vertex Cache Optimisation", Tom Forsyth
+        const uint32_t s_vertex_cache_size   = 32;
+        const float    s_cache_decay_power   = 1.5f;
+        const float    s_last_triangle_score = 0.75f;
+        const float    s_valence_boost_scale = 2.0f;
+        const float    s_valence_boost_power = 0.5f;
+        const uint32_t s_overdraw_cache_size = 16;
+        const uint32_t s_invalid_index       = std::numeric_limits<uint32_t>::max();
+
+        // levels below this many triangles or that remove less than a fifth of the previous one aren't worth a range
+        const uint32_t s_lod_min_triangle_count  = 64;
+        const float    s_lod_min_reduction       = 0.8f;
+        // relative to the bounding box diagonal, beyond that the silhouette changes visibly at any distance
+        const float    s_lod_max_relative_error  = 0.05f;
+
+        // sum of squared distances to the planes of the adjacent triangles, weighted by their area
+        struct Quadric
+        {
+            double mA00 {0.0}, mA11 {0.0}, mA22 {0.0}, mA01 {0.0}, mA02 {0.0}, mA12 {0.0};
+            double mB0 {0.0}, mB1 {0.0}, mB2 {0.0};
+            double mC {0.0};
+            double mWeight {0.0};
+
+            void AddPlane(const Vector3& normal, float distance, float weight)
+            {
+                mA00 += weight * normal.x * normal.x;
+                mA11 += weight * normal.y * normal.y;
+                mA22 += weight * normal.z * normal.z;
+                mA01 += weight * normal.x * normal.y;
+                mA02 += weight * normal.x * normal.z;
+                mA12 += weight * normal.y * normal.z;
+                mB0 += weight * normal.x * distance;
+                mB1 += weight * normal.y * distance;
+                mB2 += weight * normal.z * distance;
+                mC += weight * distance * distance;
+                mWeight += weight;
+            }
+
+            Quadric& operator+=(const Quadric& rhs)
+            {
+                mA00 += rhs.mA00;
+                mA11 += rhs.mA11;
+                mA22 += rhs.mA22;
+                mA01 += rhs.mA01;
+                mA02 += rhs.mA02;
+                mA12 += rhs.mA12;
+                mB0 += rhs.mB0;
+                mB1 += rhs.mB1;
+                mB2 += rhs.mB2;
+                mC += rhs.mC;
+                mWeight += rhs.mWeight;
+                return *this;
+            }
+
+            // mean squared distance of the point to the planes
+            float Evaluate(const Vector3& point) const
+            {
+                double x = point.x, y = point.y, z = point.z;
+                double error = mA00 * x * x + mA11 * y * y + mA22 * z * z +
+                               2.0 * (mA01 * x * y + mA02 * x * z + mA12 * y * z) +
+                               2.0 * (mB0 * x + mB1 * y + mB2 * z) + mC;
+                return mWeight > 0.0 ? static_cast<float>(std::max(error, 0.0) / mWeight) : 0.0f;
+            }
+        };
+
+        struct EdgeCollapse
+        {
+            uint32_t mSource;
+            uint32_t mTarget;
+            float    mError;
+        };
+
+        struct WeldKey
+        {
+            float                           mAttributes[8];
+            MeshVertexBindingDataDefinition mBinding;
+        };
+
+        WeldKey makeWeldKey(const MeshVertexDataDefinition& vertex, const MeshVertexBindingDataDefinition* binding)
+        {
+            // + 0.0f folds -0 into 0, the keys are compared bitwise
+            WeldKey key {};
+            const float attributes[8] = {vertex.x, vertex.y, vertex.z, vertex.nx, vertex.ny, vertex.nz, vertex.u, vertex.v};
+            for (uint32_t index = 0; index < 8; ++index)
+            {
+                key.mAttributes[index] = attributes[index] + 0.0f;
+            }
+            if (binding != nullptr)
+            {
+                key.mBinding = *binding;
+            }
+            return key;
+        }
+
+        uint32_t hashWeldKey(const WeldKey& key)
+        {
+            uint32_t words[sizeof(WeldKey) / sizeof(uint32_t)];
+            memcpy(words, &key, sizeof(WeldKey));
+
+            uint32_t hash = 2166136261u;
+            for (uint32_t word : words)
+            {
+                hash = (hash ^ word) * 16777619u;
+                hash ^= hash >> 15;
+            }
+            return hash;
+        }
+
+        float vertexScore(int cache_position, uint32_t remaining_triangles)
+        {
+            if (remaining_triangles == 0)
+            {
+                return -1.0f;
+            }
+
+            float score = 0.0f;
+            if (cache_position >= 0)
+            {
+                // the three vertices of the last triangle score the same, whatever order they were added in
+                if (cache_position < 3)
+                {
+                    score = s_last_triangle_score;
+                }
+                else
+                {
+                    float scale = 1.0f / (s_vertex_cache_size - 3);
+                    score       = std::pow(1.0f - (cache_position - 3) * scale, s_cache_decay_power);
+                }
+            }
+
+            // vertices with few triangles left are finished first, they would become isolated otherwise
+            score += s_valence_boost_scale * std::pow(static_cast<float>(remaining_triangles), -s_valence_boost_power);
+            return score;
+        }
+
+        Vector3 vertexPosition(const MeshVertexDataDefinition& vertex) { return Vector3(vertex.x, vertex.y, vertex.z); }
+    } // namespace
+
+    MeshOptimizeStats MeshOptimizer::Optimize(std::vector<MeshVertexDataDefinition>&        vertices,
+                                              std::vector<uint32_t>&                        indices,
+                                              std::vector<MeshVertexBindingDataDefinition>* bindings)
+    {
+        ASSERT(indices.size() % 3 == 0);
+        ASSERT(bindings == nullptr || bindings->size() == vertices.size());
+
+        MeshOptimizeStats stats;
+        stats.mInputVertexCount = static_cast<uint32_t>(vertices.size());
+        stats.mACMRBefore       = ComputeACMR(indices, static_cast<uint32_t>(vertices.size()));
+
+        weldVertices(vertices, indices, bindings);
+        optimizeVertexCache(indices, static_cast<uint32_t>(vertices.size()));
+        optimizeOverdraw(vertices, indices);
+        optimizeVertexFetch(vertices, indices, bindings);
+
+        stats.mOutputVertexCount = static_cast<uint32_t>(vertices.size());
+        stats.mTriangleCount     = static_cast<uint32_t>(indices.size() / 3);
+        stats.mACMRAfter         = ComputeACMR(indices, static_cast<uint32_t>(vertices.size()));
+        return stats;
+    }
+
+    void MeshOptimizer::BuildLods(const std::vector<MeshVertexDataDefinition>& vertices,
+                                  std::vector<uint32_t>&                       indices,
+                                  std::vector<MeshLod>&                        lods)
+    {
+        lods.clear();
+
+        MeshLod full_lod;
+        full_lod.mIndexCount = static_cast<uint32_t>(indices.size());
+        lods.push_back(full_lod);
+
+        const float max_float = std::numeric_limits<float>::max();
+        Vector3     min_corner(max_float, max_float, max_float);
+        Vector3     max_corner(-max_float, -max_float, -max_float);
+        for (const MeshVertexDataDefinition& vertex : vertices)
+        {
+            min_corner.MakeFloor(vertexPosition(vertex));
+            max_corner.MakeCeil(vertexPosition(vertex));
+        }
+        float max_error = vertices.empty() ? 0.0f : (max_corner - min_corner).Length() * s_lod_max_relative_error;
+
+        // every level continues from the previous one, its error is at most the sum of the steps
+        std::vector<uint32_t> lod_indices(indices);
+        float                 lod_error = 0.0f;
+        for (uint32_t lod_index = 1; lod_index < s_mesh_max_lod_count; ++lod_index)
+        {
+            uint32_t target_index_count = static_cast<uint32_t>(lod_indices.size() / 6) * 3;
+            if (target_index_count < s_lod_min_triangle_count * 3)
+            {
+                break;
+            }
+
+            float                 step_error = 0.0f;
+            std::vector<uint32_t> simplified =
+                Simplify(vertices, lod_indices, target_index_count, max_error - lod_error, step_error);
+            if (simplified.empty() || simplified.size() > lod_indices.size() * s_lod_min_reduction)
+            {
+                break;
+            }
+            optimizeVertexCache(simplified, static_cast<uint32_t>(vertices.size()));
+
+            lod_error += step_error;
+            MeshLod lod;
+            lod.mIndexOffset = static_cast<uint32_t>(indices.size());
+            lod.mIndexCount  = static_cast<uint32_t>(simplified.size());
+            lod.mError       = lod_error;
+            lods.push_back(lod);
+
+            indices.insert(indices.end(), simplified.begin(), simplified.end());
+            lod_indices.swap(simplified);
+        }
+    }
+
+    std::vector<uint32_t> MeshOptimizer::Simplify(const std::vector<MeshVertexDataDefinition>& vertices,
+                                                  const std::vector<uint32_t>&                 indices,
+                                                  uint32_t                                     target_index_count,
+                                                  float                                        max_error,
+                                                  float&                                       result_error)
+    {
+        const uint32_t        vertex_count = static_cast<uint32_t>(vertices.size());
+        std::vector<uint32_t> result(indices);
+        result_error = 0.0f;
+
+        // a position used by more than one vertex is a uv or normal seam, moving one side would tear the surface
+        std::vector<bool> locked(vertex_count, false);
+        {
+            std::vector<uint32_t> sorted(vertex_count);
+            std::iota(sorted.begin(), sorted.end(), 0u);
+            auto position_less = [&](uint32_t lhs, uint32_t rhs) {
+                const MeshVertexDataDefinition& a = vertices[lhs];
+                const MeshVertexDataDefinition& b = vertices[rhs];
+                return a.x != b.x ? a.x < b.x : (a.y != b.y ? a.y < b.y : a.z < b.z);
+            };
+            std::sort(sorted.begin(), sorted.end(), position_less);
+            for (uint32_t index = 1; index < vertex_count; ++index)
+            {
+                if (!position_less(sorted[index - 1], sorted[index]))
+                {
+                    locked[sorted[index - 1]] = true;
+                    locked[sorted[index]]     = true;
+                }
+            }
+        }
+
+        // an edge without a twin running the other way is on the border of the mesh
+        {
+            std::unordered_set<uint64_t> edges;
+            edges.reserve(result.size());
+            for (size_t index = 0; index < result.size(); index += 3)
+            {
+                for (uint32_t corner = 0; corner < 3; ++corner)
+                {
+                    uint64_t a = result[index + corner];
+                    uint64_t b = result[index + (corner + 1) % 3];
+                    edges.insert((a << 32) | b);
+                }
+            }
+            for (size_t index = 0; index < result.size(); index += 3)
+            {
+                for (uint32_t corner = 0; corner < 3; ++corner)
+                {
+                    uint64_t a = result[index + corner];
+                    uint64_t b = result[index + (corner + 1) % 3];
+                    if (edges.find((b << 32) | a) == edges.end())
+                    {
+                        locked[a] = true;
+                        locked[b] = true;
+                    }
+                }
+            }
+        }
+
+        std::vector<Quadric> quadrics(vertex_count);
+        for (size_t index = 0; index < result.size(); index += 3)
+        {
+            Vector3 p0     = vertexPosition(vertices[result[index + 0]]);
+            Vector3 p1     = vertexPosition(vertices[result[index + 1]]);
+            Vector3 p2     = vertexPosition(vertices[result[index + 2]]);
+            Vector3 normal = (p1 - p0).CrossProduct(p2 - p0);
+            float   area   = normal.Length();
+            if (area <= 0.0f)
+            {
+                continue;
+            }
+            normal /= area;
+            for (uint32_t corner = 0; corner < 3; ++corner)
+            {
+                quadrics[result[index + corner]].AddPlane(normal, -normal.DotProduct(p0), area);
+            }
+        }
+
+        const float               max_squared_error = max_error * max_error;
+        std::vector<uint32_t>     remap(vertex_count);
+        std::vector<bool>         collapsed(vertex_count);
+        std::vector<uint32_t>     adjacency_offsets(vertex_count + 1);
+        std::vector<uint32_t>     adjacency;
+        std::vector<EdgeCollapse> collapses;
+        while (result.size() > target_index_count)
+        {
+            const uint32_t triangle_count = static_cast<uint32_t>(result.size() / 3);
+
+            std::fill(adjacency_offsets.begin(), adjacency_offsets.end(), 0);
+            for (uint32_t index : result)
+            {
+                ++adjacency_offsets[index + 1];
+            }
+            std::partial_sum(adjacency_offsets.begin(), adjacency_offsets.end(), adjacency_offsets.begin());
+            adjacency.resize(result.size());
+            {
+                std::vector<uint32_t> fill_offsets(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+                for (uint32_t triangle = 0; triangle < triangle_count; ++triangle)
+                {
+                    for (uint32_t corner = 0; corner < 3; ++corner)
+                    {
+                        adjacency[fill_offsets[result[triangle * 3 + corner]]++] = triangle;
+                    }
+                }
+            }
+
+            // interior edges show up once in each direction, the one with the smaller source stands for both
+            collapses.clear();
+            for (size_t index = 0; index < result.size(); index += 3)
+            {
+                for (uint32_t corner = 0; corner < 3; ++corner)
+                {
+                    uint32_t a = result[index + corner];
+                    uint32_t b = result[index + (corner + 1) % 3];
+                    if (a > b || (locked[a] && locked[b]))
+                    {
+                        continue;
+                    }
+
+                    Quadric quadric = quadrics[a];
+                    quadric += quadrics[b];
+                    float error_ab = locked[a] ? std::numeric_limits<float>::max() :
+                                                 quadric.Evaluate(vertexPosition(vertices[b]));
+                    float error_ba = locked[b] ? std::numeric_limits<float>::max() :
+                                                 quadric.Evaluate(vertexPosition(vertices[a]));
+                    collapses.push_back(error_ab <= error_ba ? EdgeCollapse {a, b, error_ab} :
+                                                               EdgeCollapse {b, a, error_ba});
+                }
+            }
+            std::sort(collapses.begin(), collapses.end(), [](const EdgeCollapse& lhs, const EdgeCollapse& rhs) {
+                return lhs.mError < rhs.mError;
+            });
+
+            // cheapest first, every vertex takes part in one collapse per pass so the adjacency stays valid
+            std::iota(remap.begin(), remap.end(), 0u);
+            std::fill(collapsed.begin(), collapsed.end(), false);
+            uint32_t removed_triangle_count = 0;
+            uint32_t collapse_count         = 0;
+            for (const EdgeCollapse& collapse : collapses)
+            {
+                if (collapse.mError > max_squared_error ||
+                    (triangle_count - removed_triangle_count) * 3 <= target_index_count)
+                {
+                    break;
+                }
+                if (collapsed[collapse.mSource] || collapsed[collapse.mTarget])
+                {
+                    continue;
+                }
+
+                // moving the source onto the target must not turn any of its other triangles over or on edge
+                Vector3 target_position = vertexPosition(vertices[collapse.mTarget]);
+                bool    flips           = false;
+                for (uint32_t slot = adjacency_offsets[collapse.mSource];
+                     slot < adjacency_offsets[collapse.mSource + 1] && !flips;
+                     ++slot)
+                {
+                    const uint32_t* corners = &result[adjacency[slot] * 3];
+                    uint32_t        a       = remap[corners[0]];
+                    uint32_t        b       = remap[corners[1]];
+                    uint32_t        c       = remap[corners[2]];
+                    if (a == collapse.mTarget || b == collapse.mTarget || c == collapse.mTarget)
+                    {
+                        continue;
+                    }
+
+                    Vector3 p0         = vertexPosition(vertices[a]);
+                    Vector3 p1         = vertexPosition(vertices[b]);
+                    Vector3 p2         = vertexPosition(vertices[c]);
+                    Vector3 old_normal = (p1 - p0).CrossProduct(p2 - p0);
+                    (a == collapse.mSource ? p0 : (b == collapse.mSource ? p1 : p2)) = target_position;
+                    Vector3 new_normal = (p1 - p0).CrossProduct(p2 - p0);
+                    flips = old_normal.DotProduct(new_normal) <= 0.25f * old_normal.Length() * new_normal.Length();
+                }
+                if (flips)
+                {
+                    continue;
+                }
+
+                remap[collapse.mSource]     = collapse.mTarget;
+                collapsed[collapse.mSource] = true;
+                collapsed[collapse.mTarget] = true;
+                quadrics[collapse.mTarget] += quadrics[collapse.mSource];
+                result_error = std::max(result_error, collapse.mError);
+
+                // the two triangles on the edge disappear
+                removed_triangle_count += 2;
+                ++collapse_count;
+            }
+            if (collapse_count == 0)
+            {
+                break;
+            }
+
+            size_t write_index = 0;
+            for (size_t read_index = 0; read_index < result.size(); read_index += 3)
+            {
+                uint32_t a = remap[result[read_index + 0]];
+                uint32_t b = remap[result[read_index + 1]];
+                uint32_t c = remap[result[read_index + 2]];
+                if (a == b || b == c || c == a)
+                {
+                    continue;
+                }
+                result[write_index++] = a;
+                result[write_index++] = b;
+                result[write_index++] = c;
+            }
+            result.resize(write_index);
+        }
+
+        result_error = std::sqrt(result_error);
+        return result;
+    }
+
+    void MeshOptimizer::BuildIndexBuffer(const std::vector<uint32_t>& indices,
+                                         uint32_t                     vertex_count,
+                                         StaticMeshData&              mesh_data)
+    {
+        if (vertex_count <= std::numeric_limits<uint16_t>::max())
+        {
+            mesh_data.mIndexType   = RHI_INDEX_TYPE_UINT16;
+            mesh_data.mIndexBuffer = std::make_shared<BufferData>(indices.size() * sizeof(uint16_t));
+
+            uint16_t* index_data = static_cast<uint16_t*>(mesh_data.mIndexBuffer->mData);
+            for (size_t index = 0; index < indices.size(); ++index)
+            {
+                index_data[index] = static_cast<uint16_t>(indices[index]);
+            }
+        }
+        else
+        {
+            mesh_data.mIndexType   = RHI_INDEX_TYPE_UINT32;
+            mesh_data.mIndexBuffer = std::make_shared<BufferData>(indices.size() * sizeof(uint32_t));
+            memcpy(mesh_data.mIndexBuffer->mData, indices.data(), indices.size() * sizeof(uint32_t));
+        }
+    }
+
+    float MeshOptimizer::ComputeACMR(const std::vector<uint32_t>& indices, uint32_t vertex_count, uint32_t cache_size)
+    {
+        if (indices.size() < 3)
+        {
+            return 0.0f;
+        }
+
+        // a vertex is in the fifo while fewer than cache_size misses happened since it was added
+        std::vector<uint32_t> cache_time(vertex_count, 0);
+        uint32_t              time       = cache_size + 1;
+        uint32_t              miss_count = 0;
+        for (uint32_t index : indices)
+        {
+            if (time - cache_time[index] > cache_size)
+            {
+                cache_time[index] = time++;
+                ++miss_count;
+            }
+        }
+        return static_cast<float>(miss_count) / static_cast<float>(indices.size() / 3);
+    }
+
+    void MeshOptimizer::weldVertices(std::vector<MeshVertexDataDefinition>&        vertices,
+                                     std::vector<uint32_t>&                        indices,
+                                     std::vector<MeshVertexBindingDataDefinition>* bindings)
+    {
+        uint32_t table_size = 1;
+        while (table_size < vertices.size() * 2)
+        {
+            table_size *= 2;
+        }
+
+        std::vector<WeldKey>  keys;
+        std::vector<uint32_t> table(table_size, s_invalid_index);
+        std::vector<uint32_t> remap(vertices.size());
+        std::vector<Vector3>  tangents;
+        keys.reserve(vertices.size());
+        tangents.reserve(vertices.size());
+
+        std::vector<MeshVertexDataDefinition>        welded_vertices;
+        std::vector<MeshVertexBindingDataDefinition> welded_bindings;
+        welded_vertices.reserve(vertices.size());
+        for (uint32_t vertex_index = 0; vertex_index < vertices.size(); ++vertex_index)
+        {
+            const MeshVertexDataDefinition&        vertex  = vertices[vertex_index];
+            const MeshVertexBindingDataDefinition* binding = bindings ? &(*bindings)[vertex_index] : nullptr;
+
+            WeldKey  key  = makeWeldKey(vertex, binding);
+            uint32_t slot = hashWeldKey(key) & (table_size - 1);
+            while (table[slot] != s_invalid_index && memcmp(&keys[table[slot]], &key, sizeof(WeldKey)) != 0)
+            {
+                slot = (slot + 1) & (table_size - 1);
+            }
+
+            Vector3 tangent(vertex.tx, vertex.ty, vertex.tz);
+            if (table[slot] == s_invalid_index)
+            {
+                table[slot] = static_cast<uint32_t>(welded_vertices.size());
+                keys.push_back(key);
+                tangents.push_back(tangent);
+                welded_vertices.push_back(vertex);
+                if (binding != nullptr)
+                {
+                    welded_bindings.push_back(*binding);
+                }
+            }
+            else
+            {
+                // obj faces carry their own tangent, shared corners get the average of the faces around them
+                tangents[table[slot]] += tangent;
+            }
+            remap[vertex_index] = table[slot];
+        }
+
+        for (uint32_t vertex_index = 0; vertex_index < welded_vertices.size(); ++vertex_index)
+        {
+            if (tangents[vertex_index].SquaredLength() > 1e-12f)
+            {
+                Vector3 tangent                   = tangents[vertex_index].NormalizedCopy();
+                welded_vertices[vertex_index].tx = tangent.x;
+                welded_vertices[vertex_index].ty = tangent.y;
+                welded_vertices[vertex_index].tz = tangent.z;
+            }
+        }
+
+        // corners that collapsed into the same vertex leave triangles without area
+        size_t write_index = 0;
+        for (size_t read_index = 0; read_index < indices.size(); read_index += 3)
+        {
+            uint32_t a = remap[indices[read_index + 0]];
+            uint32_t b = remap[indices[read_index + 1]];
+            uint32_t c = remap[indices[read_index + 2]];
+            if (a == b || b == c || c == a)
+            {
+                continue;
+            }
+            indices[write_index++] = a;
+            indices[write_index++] = b;
+            indices[write_index++] = c;
+        }
+        indices.resize(write_index);
+
+        vertices.swap(welded_vertices);
+        if (bindings != nullptr)
+        {
+            bindings->swap(welded_bindings);
+        }
+    }
+
+    void MeshOptimizer::optimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertex_count)
+    {
+        const uint32_t triangle_count = static_cast<uint32_t>(indices.size() / 3);
+        if (triangle_count == 0)
+        {
+            return;
+        }
+
+        // triangles around every vertex, the live ones are kept in front of each list
+        std::vector<uint32_t> live_triangles(vertex_count, 0);
+        for (uint32_t index : indices)
+        {
+            ++live_triangles[index];
+        }
+        std::vector<uint32_t> adjacency_offsets(vertex_count + 1, 0);
+        for (uint32_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
+        {
+            adjacency_offsets[vertex_index + 1] = adjacency_offsets[vertex_index] + live_triangles[vertex_index];
+        }
+        std::vector<uint32_t> adjacency(indices.size());
+        {
+            std::vector<uint32_t> fill_offsets(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+            for (uint32_t triangle = 0; triangle < triangle_count; ++triangle)
+            {
+                for (uint32_t corner = 0; corner < 3; ++corner)
+                {
+                    adjacency[fill_offsets[indices[triangle * 3 + corner]]++] = triangle;
+                }
+            }
+        }
+
+        std::vector<int>   cache_positions(vertex_count, -1);
+        std::vector<float> vertex_scores(vertex_count);
+        for (uint32_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
+        {
+            vertex_scores[vertex_index] = vertexScore(-1, live_triangles[vertex_index]);
+        }
+
+        std::vector<float> triangle_scores(triangle_count);
+        std::vector<bool>  emitted(triangle_count, false);
+        uint32_t           best_triangle = 0;
+        for (uint32_t triangle = 0; triangle < triangle_count; ++triangle)
+        {
+            triangle_scores[triangle] = vertex_scores[indices[triangle * 3 + 0]] +
+                                        vertex_scores[indices[triangle * 3 + 1]] +
+                                        vertex_scores[indices[triangle * 3 + 2]];
+            if (triangle_scores[triangle] > triangle_scores[best_triangle])
+            {
+                best_triangle = triangle;
+            }
+        }
+
+        std::vector<uint32_t> cache;
+        std::vector<uint32_t> new_cache;
+        cache.reserve(s_vertex_cache_size + 3);
+        new_cache.reserve(s_vertex_cache_size + 3);
+
+        std::vector<uint32_t> output;
+        output.reserve(indices.size());
+        uint32_t next_unemitted = 0;
+        for (uint32_t step = 0; step < triangle_count; ++step)
+        {
+            // nothing left around the cache, continue with the next triangle in input order
+            if (best_triangle == s_invalid_index)
+            {
+                while (emitted[next_unemitted])
+                {
+                    ++next_unemitted;
+                }
+                best_triangle = next_unemitted;
+            }
+
+            const uint32_t* corners = &indices[best_triangle * 3];
+            emitted[best_triangle]  = true;
+            new_cache.clear();
+            for (uint32_t corner = 0; corner < 3; ++corner)
+            {
+                uint32_t vertex_index = corners[corner];
+                output.push_back(vertex_index);
+                new_cache.push_back(vertex_index);
+
+                uint32_t* triangles = &adjacency[adjacency_offsets[vertex_index]];
+                uint32_t& live      = live_triangles[vertex_index];
+                for (uint32_t slot = 0; slot < live; ++slot)
+                {
+                    if (triangles[slot] == best_triangle)
+                    {
+                        std::swap(triangles[slot], triangles[live - 1]);
+                        --live;
+                        break;
+                    }
+                }
+            }
+            for (uint32_t vertex_index : cache)
+            {
+                if (vertex_index != corners[0] && vertex_index != corners[1] && vertex_index != corners[2])
+                {
+                    new_cache.push_back(vertex_index);
+                }
+            }
+            cache.swap(new_cache);
+
+            // rescore what moved in the cache and what fell out of it, then pick among the triangles of the cache
+            best_triangle    = s_invalid_index;
+            float best_score = 0.0f;
+            for (uint32_t position = 0; position < cache.size(); ++position)
+            {
+                uint32_t vertex_index = cache[position];
+                int cache_position    = position < s_vertex_cache_size ? static_cast<int>(position) : -1;
+                cache_positions[vertex_index] = cache_position;
+                float score                   = vertexScore(cache_position, live_triangles[vertex_index]);
+                float score_delta             = score - vertex_scores[vertex_index];
+                vertex_scores[vertex_index]   = score;
+
+                const uint32_t* triangles = &adjacency[adjacency_offsets[vertex_index]];
+                for (uint32_t slot = 0; slot < live_triangles[vertex_index]; ++slot)
+                {
+                    uint32_t triangle = triangles[slot];
+                    triangle_scores[triangle] += score_delta;
+                    if (cache_position >= 0 && triangle_scores[triangle] > best_score)
+                    {
+                        best_score    = triangle_scores[triangle];
+                        best_triangle = triangle;
+                    }
+                }
+            }
+            if (cache.size() > s_vertex_cache_size)
+            {
+                cache.resize(s_vertex_cache_size);
+            }
+        }
+
+        indices.swap(output);
+    }
+
+    void MeshOptimizer::optimizeOverdraw(const std::vector<MeshVertexDataDefinition>& vertices,
+                                         std::vector<uint32_t>&                       indices)
+    {
+        const uint32_t triangle_count = static_cast<uint32_t>(indices.size() / 3);
+        if (triangle_count == 0)
+        {
+            return;
+        }
+
+        // a triangle missing all three vertices starts with a cold cache anyway, the clusters are cut there and
+        // reordered without losing cache hits
+        std::vector<uint32_t> cluster_offsets;
+        {
+            std::vector<uint32_t> cache_time(vertices.size(), 0);
+            uint32_t              time = s_overdraw_cache_size + 1;
+            for (uint32_t triangle = 0; triangle < triangle_count; ++triangle)
+            {
+                uint32_t miss_count = 0;
+                for (uint32_t corner = 0; corner < 3; ++corner)
+                {
+                    uint32_t vertex_index = indices[triangle * 3 + corner];
+                    if (time - cache_time[vertex_index] > s_overdraw_cache_size)
+                    {
+                        cache_time[vertex_index] = time++;
+                        ++miss_count;
+                    }
+                }
+                if (triangle == 0 || miss_count == 3)
+                {
+                    cluster_offsets.push_back(triangle);
+                }
+            }
+        }
+        uint32_t cluster_count = static_cast<uint32_t>(cluster_offsets.size());
+        cluster_offsets.push_back(triangle_count);
+
+        // area weighted centroid and normal of every cluster and of the mesh
+        std::vector<Vector3> cluster_centroids(cluster_count, Vector3::ZERO);
+        std::vector<Vector3> cluster_normals(cluster_count, Vector3::ZERO);
+        Vector3              mesh_centroid = Vector3::ZERO;
+        float                mesh_area     = 0.0f;
+        for (uint32_t cluster = 0; cluster < cluster_count; ++cluster)
+        {
+            float cluster_area = 0.0f;
+            for (uint32_t triangle = cluster_offsets[cluster]; triangle < cluster_offsets[cluster + 1]; ++triangle)
+            {
+                Vector3 p0 = vertexPosition(vertices[indices[triangle * 3 + 0]]);
+                Vector3 p1 = vertexPosition(vertices[indices[triangle * 3 + 1]]);
+                Vector3 p2 = vertexPosition(vertices[indices[triangle * 3 + 2]]);
+
+                Vector3 normal = (p1 - p0).CrossProduct(p2 - p0);
+                float   area   = normal.Length();
+                cluster_centroids[cluster] += (p0 + p1 + p2) * (area / 3.0f);
+                cluster_normals[cluster] += normal;
+                cluster_area += area;
+            }
+
+            mesh_centroid += cluster_centroids[cluster];
+            mesh_area += cluster_area;
+            if (cluster_area > 0.0f)
+            {
+                cluster_centroids[cluster] /= cluster_area;
+            }
+        }
+        if (mesh_area > 0.0f)
+        {
+            mesh_centroid /= mesh_area;
+        }
+
+        // clusters far out along their normal are likely occluders, they go first
+        std::vector<float> cluster_keys(cluster_count);
+        for (uint32_t cluster = 0; cluster < cluster_count; ++cluster)
+        {
+            Vector3 normal        = cluster_normals[cluster].NormalizedCopy();
+            cluster_keys[cluster] = (cluster_centroids[cluster] - mesh_centroid).DotProduct(normal);
+        }
+
+        std::vector<uint32_t> cluster_order(cluster_count);
+        for (uint32_t cluster = 0; cluster < cluster_count; ++cluster)
+        {
+            cluster_order[cluster] = cluster;
+        }
+        std::stable_sort(cluster_order.begin(), cluster_order.end(), [&](uint32_t lhs, uint32_t rhs) {
+            return cluster_keys[lhs] > cluster_keys[rhs];
+        });
+
+        std::vector<uint32_t> output;
+        output.reserve(indices.size());
+        for (uint32_t cluster : cluster_order)
+        {
+            output.insert(output.end(),
+                          indices.begin() + cluster_offsets[cluster] * 3,
+                          indices.begin() + cluster_offsets[cluster + 1] * 3);
+        }
+        indices.swap(output);
+    }
+
+    void MeshOptimizer::optimizeVertexFetch(std::vector<MeshVertexDataDefinition>&        vertices,
+                                            std::vector<uint32_t>&                        indices,
+                                            std::vector<MeshVertexBindingDataDefinition>* bindings)
+    {
+        // vertices in the order the index buffer first reads them, unreferenced ones are dropped
+        std::vector<uint32_t>                        remap(vertices.size(), s_invalid_index);
+        std::vector<MeshVertexDataDefinition>        fetch_vertices;
+        std::vector<MeshVertexBindingDataDefinition> fetch_bindings;
+        fetch_vertices.reserve(vertices.size());
+        for (uint32_t& index : indices)
+        {
+            if (remap[index] == s_invalid_index)
+            {
+                remap[index] = static_cast<uint32_t>(fetch_vertices.size());
+                fetch_vertices.push_back(vertices[index]);
+                if (bindings != nullptr)
+                {
+                    fetch_bindings.push_back((*bindings)[index]);
+                }
+            }
+            index = remap[index];
+        }
+
+        vertices.swap(fetch_vertices);
+        if (bindings != nullptr)
+        {
+            bindings->swap(fetch_bindings);
+        }
+    }
+} // namespace MiniEngine
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "MRuntime/Function/Render/RenderType.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace MiniEngine
+{
+    struct MeshOptimizeStats
+    {
+        uint32_t mInputVertexCount {0};
+        uint32_t mOutputVertexCount {0};
+        uint32_t mTriangleCount {0};
+
+        // average cache miss ratio, vertex shader invocations per triangle
+        float mACMRBefore {0.0f};
+        float mACMRAfter {0.0f};
+    };
+
+    /// Import time processing of an indexed triangle list, run once per mesh and cached with the derived data.
+    /// Vertices with the same position, normal, uv and joint binding are welded and their tangents averaged.
+    /// Triangles are then ordered for the post transform cache and in clusters that draw outer surfaces first,
+    /// and the vertices are renumbered in the order the index buffer reads them.
+    /// The joint bindings are per vertex and permuted together with the vertices when given.
+    /// Levels of detail are simplified with edge collapses onto existing vertices, so they only add index ranges
+    class MeshOptimizer
+    {
+    public:
+        static MeshOptimizeStats Optimize(std::vector<MeshVertexDataDefinition>&        vertices,
+                                          std::vector<uint32_t>&                        indices,
+                                          std::vector<MeshVertexBindingDataDefinition>* bindings = nullptr);
+
+        // appends up to s_mesh_max_lod_count - 1 simplified copies of the triangles, each about half the previous
+        static void BuildLods(const std::vector<MeshVertexDataDefinition>& vertices,
+                              std::vector<uint32_t>&                       indices,
+                              std::vector<MeshLod>&                        lods);
+
+        // quadric error edge collapses until target_index_count or max_error is reached. vertices on borders and
+        // attribute seams stay where they are, the result error is an object space distance
+        static std::vector<uint32_t> Simplify(const std::vector<MeshVertexDataDefinition>& vertices,
+                                              const std::vector<uint32_t>&                 indices,
+                                              uint32_t                                     target_index_count,
+                                              float                                        max_error,
+                                              float&                                       result_error);
+
+        // 16 bit indices when every vertex fits, 32 bit otherwise
+        static void BuildIndexBuffer(const std::vector<uint32_t>& indices, uint32_t vertex_count, StaticMeshData& mesh_data);
+
+        // fifo simulation of the post transform cache
+        static float ComputeACMR(const std::vector<uint32_t>& indices, uint32_t vertex_count, uint32_t cache_size = 16);
+
+    private:
+        static void weldVertices(std::vector<MeshVertexDataDefinition>&        vertices,
+                                 std::vector<uint32_t>&                        indices,
+                                 std::vector<MeshVertexBindingDataDefinition>* bindings);
+        static void optimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertex_count);
+        static void optimizeOverdraw(const std::vector<MeshVertexDataDefinition>& vertices, std::vector<uint32_t>& indices);
+        static void optimizeVertexFetch(std::vector<MeshVertexDataDefinition>&        vertices,
+                                        std::vector<uint32_t>&                        indices,
+                                        std::vector<MeshVertexBindingDataDefinition>* bindings);
+    };
+} // namespace MiniEngine
@@ -2,6 +2,7 @@
 
 #include "MRuntime/Function/Render/Interface/Vulkan/VulkanRHI.hpp"
 #include "MRuntime/Function/Render/Interface/Vulkan/VulkanUtil.hpp"
+#include "MRuntime/Core/Profiler/Profiler.hpp"
 
 #include <ColorGradient_frag.h>
 #include <PostProcess_vert.h>
@@ -25,6 +26,8 @@ namespace MiniEngine
 
     void ColorGradientPass::Draw()
     {
+        PROFILE_SCOPE("ColorGradientPass::Draw");
+
         float color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
         mRHI->PushEvent(mRHI->GetCurrentCommandBuffer(), "Color Grading", color);
 
@@ -257,14 +260,7 @@ namespace MiniEngine
 
     void ColorGradientPass::setupDescriptorSet()
     {
-        RHIDescriptorSetAllocateInfo post_process_global_descriptor_set_alloc_info;
-        post_process_global_descriptor_set_alloc_info.sType          = RHI_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-        post_process_global_descriptor_set_alloc_info.pNext          = nullptr;
-        post_process_global_descriptor_set_alloc_info.descriptorPool = mRHI->GetDescriptorPool();
-        post_process_global_descriptor_set_alloc_info.descriptorSetCount = 1;
-        post_process_global_descriptor_set_alloc_info.pSetLayouts        = &mDescInfos[0].layout;
-
-        if (RHI_SUCCESS != mRHI->AllocateDescriptorSets(&post_process_global_descriptor_set_alloc_info, mDescInfos[0].descriptorSet))
+        if (RHI_SUCCESS != mRHI->AllocateDescriptorSet(mDescInfos[0].layout, mDescInfos[0].descriptorSet))
         {
             throw std::runtime_error("allocate post process global descriptor set");
         }
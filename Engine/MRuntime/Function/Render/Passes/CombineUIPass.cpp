@@ -2,6 +2,7 @@
 
 #include "MRuntime/Function/Render/Interface/Vulkan/VulkanRHI.hpp"
 #include "MRuntime/Function/Render/Interface/Vulkan/VulkanUtil.hpp"
+#include "MRuntime/Core/Profiler/Profiler.hpp"
 
 #include <CombineUI_frag.h>
 #include <PostProcess_vert.h>
@@ -25,6 +26,8 @@ namespace MiniEngine
 
     void CombineUIPass::Draw()
     {
+        PROFILE_SCOPE("CombineUIPass::Draw");
+
         float color[4] = {1.0f, 1.0f, 1.0f, 1.0f};
         mRHI->PushEvent(mRHI->GetCurrentCommandBuffer(), "Combine UI", color);
 
@@ -237,13 +240,7 @@ namespace MiniEngine
 
     void CombineUIPass::setupDescriptorSet()
     {
-        RHIDescriptorSetAllocateInfo ppGlobalDescSetAI {};
-        ppGlobalDescSetAI.pNext              = nullptr;
-        ppGlobalDescSetAI.descriptorPool     = mRHI->GetDescriptorPool();
-        ppGlobalDescSetAI.descriptorSetCount = 1;
-        ppGlobalDescSetAI.pSetLayouts        = &mDescInfos[0].layout;
-
-        if (RHI_SUCCESS != mRHI->AllocateDescriptorSets(&ppGlobalDescSetAI, mDescInfos[0].descriptorSet))
+        if (RHI_SUCCESS != mRHI->AllocateDescriptorSet(mDescInfos[0].layout, mDescInfos[0].descriptorSet))
         {
             throw std::runtime_error("allocate post process global descriptor set");
         }
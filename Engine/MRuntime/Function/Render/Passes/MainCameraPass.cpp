@@ -5,9 +5,19 @@
 
 #include "MRuntime/Function/Render/Interface/Vulkan/VulkanRHI.hpp"
 #include "MRuntime/Function/Render/Interface/Vulkan/VulkanUtil.hpp"
-
+#include "MRuntime/Function/Global/GlobalContext.hpp"
+#include "MRuntime/Core/Base/ThreadPool.hpp"
+#include "MRuntime/Core/Memory/FrameAllocator.hpp"
+#include "MRuntime/Core/Profiler/Profiler.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <functional>
 #include <map>
+#include <mutex>
 #include <stdexcept>
+#include <utility>
 
 #include <Axis_frag.h>
 #include <Axis_vert.h>
@@ -21,12 +31,20 @@
 
 namespace MiniEngine
 {
+    namespace
+    {
+        // fewer draws than this per recorder don't pay for the secondary command buffers and waking the workers
+        const uint32_t s_min_draw_count_per_recorder = 128;
+    } // namespace
+
     void MainCameraPass::Initialize(const RenderPassInitInfo *initInfo)
     {
         RenderPass::Initialize(nullptr);
 
         const MainCameraPassInitInfo* _init_info = static_cast<const MainCameraPassInitInfo*>(initInfo);
         mbEnableFXAA                            = _init_info->mbEnableFXAA;
+        mbEnableVertexQuantization              = _init_info->mbEnableVertexQuantization;
+        mbEnableBindlessMaterials               = _init_info->mbEnableBindlessMaterials;
 
         setupAttachments();
         setupRenderPass();
@@ -43,6 +61,7 @@ namespace MiniEngine
         if (resource)
         {
             mPerFrameStorageBufferObject = resource->mMeshPerFrameStorageBufferObject;
+            mLightClusterBuilder         = &resource->mLightClusterBuilder;
             mAxisStorageBufferObject     = resource->mAxisStorageBufferObject;
         }
     }
@@ -54,6 +73,16 @@ namespace MiniEngine
         CombineUIPass &combineUIPass, 
         uint32_t currentSwapChaingIndex)
     {
+        PROFILE_SCOPE("MainCameraPass::DrawDeferred");
+
+        uploadLightClusterData();
+        prepareMeshDrawCommands();
+
+        // draw heavy frames record the meshes into secondary command buffers on the workers
+        uint32_t           mesh_recorder_count   = getMeshRecorderCount();
+        RHISubpassContents mesh_subpass_contents = mesh_recorder_count > 0 ? RHI_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS :
+                                                                             RHI_SUBPASS_CONTENTS_INLINE;
+
         RHICommandBuffer* cmdBuffer = mRHI->GetCurrentCommandBuffer();
         {
             RHIRenderPassBeginInfo rpBI {};
@@ -75,13 +104,26 @@ namespace MiniEngine
             rpBI.clearValueCount                                        = (sizeof(clearValue) / sizeof(clearValue[0]));
             rpBI.pClearValues                                           = clearValue;
 
-            mRHI->CmdBeginRenderPassPFN(cmdBuffer, &rpBI, RHI_SUBPASS_CONTENTS_INLINE);
+            mRHI->CmdBeginRenderPassPFN(cmdBuffer, &rpBI, mesh_subpass_contents);
         }
 
         float color[4] = {1.0f, 1.0f, 1.0f, 1.0f};
-        mRHI->PushEvent(cmdBuffer, "BasePass", color);
-        drawMeshGBuffer();
-        mRHI->PopEvent(cmdBuffer);
+        if (mesh_recorder_count > 0)
+        {
+            // nothing but the secondaries may be recorded in the subpass, their labels replace the events
+            executeMeshDrawCommandsParallel(RenderPipelineType_MeshGBuffer,
+                                            MAIN_CAMERA_SUBPASS_BASEPASS,
+                                            "Mesh GBuffer",
+                                            mesh_recorder_count,
+                                            currentSwapChaingIndex,
+                                            false);
+        }
+        else
+        {
+            mRHI->PushEvent(cmdBuffer, "BasePass", color);
+            drawMeshGBuffer();
+            mRHI->PopEvent(cmdBuffer);
+        }
 
         mRHI->CmdNextSubpassPFN(cmdBuffer, RHI_SUBPASS_CONTENTS_INLINE);
         mRHI->PushEvent(cmdBuffer, "Deferred Lighting", color);
@@ -131,6 +173,16 @@ namespace MiniEngine
         CombineUIPass &combineUIPass, 
         uint32_t currentSwapChaingIndex)
     {
+        PROFILE_SCOPE("MainCameraPass::DrawForward");
+
+        uploadLightClusterData();
+        prepareMeshDrawCommands();
+
+        // draw heavy frames record the meshes into secondary command buffers on the workers
+        uint32_t           mesh_recorder_count   = getMeshRecorderCount();
+        RHISubpassContents mesh_subpass_contents = mesh_recorder_count > 0 ? RHI_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS :
+                                                                             RHI_SUBPASS_CONTENTS_INLINE;
+
         RHICommandBuffer* cmdBuffer = mRHI->GetCurrentCommandBuffer();
         {
             RHIRenderPassBeginInfo rpBI {};
@@ -155,12 +207,25 @@ namespace MiniEngine
             mRHI->CmdBeginRenderPassPFN(cmdBuffer, &rpBI, RHI_SUBPASS_CONTENTS_INLINE);
         }
 
-        mRHI->CmdNextSubpassPFN(cmdBuffer, RHI_SUBPASS_CONTENTS_INLINE);
+        mRHI->CmdNextSubpassPFN(cmdBuffer, mesh_subpass_contents);
         float color[4] = {1.0f, 1.0f, 1.0f, 1.0f};
-        mRHI->PushEvent(cmdBuffer, "Forward Lighting", color);
-        drawMeshLighting();
-        drawSkybox();
-        mRHI->PopEvent(cmdBuffer);
+        if (mesh_recorder_count > 0)
+        {
+            // nothing but the secondaries may be recorded in the subpass, the skybox follows in its own
+            executeMeshDrawCommandsParallel(RenderPipelineType_MeshLighting,
+                                            MAIN_CAMERA_SUBPASS_FORWARD_LIGHTING,
+                                            "Model",
+                                            mesh_recorder_count,
+                                            currentSwapChaingIndex,
+                                            true);
+        }
+        else
+        {
+            mRHI->PushEvent(cmdBuffer, "Forward Lighting", color);
+            drawMeshLighting();
+            drawSkybox(cmdBuffer);
+            mRHI->PopEvent(cmdBuffer);
+        }
 
         mRHI->CmdNextSubpassPFN(cmdBuffer, RHI_SUBPASS_CONTENTS_INLINE);
         toneMappingPass.Draw();
@@ -402,7 +467,7 @@ namespace MiniEngine
         swapChainAttachDesc.stencilLoadOp  = RHI_ATTACHMENT_LOAD_OP_DONT_CARE;
         swapChainAttachDesc.stencilStoreOp = RHI_ATTACHMENT_STORE_OP_DONT_CARE;
         swapChainAttachDesc.initialLayout  = RHI_IMAGE_LAYOUT_UNDEFINED;
-        swapChainAttachDesc.finalLayout    = RHI_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+        swapChainAttachDesc.finalLayout    = mRHI->GetSwapChainInfo().presentLayout;
 
         RHISubpassDescription subpasses[MAIN_CAMERA_SUBPASS_COUNT] {};
 
@@ -642,7 +707,7 @@ namespace MiniEngine
             }
         }
         {
-            RHIDescriptorSetLayoutBinding meshGlobalDescSetLayoutBinding[7];
+            RHIDescriptorSetLayoutBinding meshGlobalDescSetLayoutBinding[10];
 
             RHIDescriptorSetLayoutBinding& meshGlobalDescSetLayoutPerFrameBinding = meshGlobalDescSetLayoutBinding[0];
             meshGlobalDescSetLayoutPerFrameBinding.binding            = 0;
@@ -684,6 +749,21 @@ namespace MiniEngine
             meshGlobalDescSetLayoutDirectLightShadowBinding         = meshGlobalDescSetLayoutBrdfLutBinding;
             meshGlobalDescSetLayoutDirectLightShadowBinding.binding = 6;
 
+            RHIDescriptorSetLayoutBinding& meshGlobalDescSetLayoutPointLightBinding = meshGlobalDescSetLayoutBinding[7];
+            meshGlobalDescSetLayoutPointLightBinding.binding            = 7;
+            meshGlobalDescSetLayoutPointLightBinding.descriptorType     = RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+            meshGlobalDescSetLayoutPointLightBinding.descriptorCount    = 1;
+            meshGlobalDescSetLayoutPointLightBinding.stageFlags         = RHI_SHADER_STAGE_FRAGMENT_BIT;
+            meshGlobalDescSetLayoutPointLightBinding.pImmutableSamplers = nullptr;
+
+            RHIDescriptorSetLayoutBinding& meshGlobalDescSetLayoutLightClusterGridBinding = meshGlobalDescSetLayoutBinding[8];
+            meshGlobalDescSetLayoutLightClusterGridBinding         = meshGlobalDescSetLayoutPointLightBinding;
+            meshGlobalDescSetLayoutLightClusterGridBinding.binding = 8;
+
+            RHIDescriptorSetLayoutBinding& meshGlobalDescSetLayoutLightIndexBinding = meshGlobalDescSetLayoutBinding[9];
+            meshGlobalDescSetLayoutLightIndexBinding         = meshGlobalDescSetLayoutPointLightBinding;
+            meshGlobalDescSetLayoutLightIndexBinding.binding = 9;
+
             RHIDescriptorSetLayoutCreateInfo meshGlobalDescSetLayoutCI {};
             meshGlobalDescSetLayoutCI.sType = RHI_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
             meshGlobalDescSetLayoutCI.pNext = nullptr;
@@ -696,6 +776,49 @@ namespace MiniEngine
                 throw std::runtime_error("create mesh global layout");
             }
         }
+        if (mbEnableBindlessMaterials)
+        {
+            RHIDescriptorSetLayoutBinding meshMatDescSetLayoutBinding[2];
+
+            // (set = 2, binding = 0 in fragment shader) parameters of every material
+            RHIDescriptorSetLayoutBinding& meshMatDescSetLayoutMaterialsBinding = meshMatDescSetLayoutBinding[0];
+            meshMatDescSetLayoutMaterialsBinding.binding            = 0;
+            meshMatDescSetLayoutMaterialsBinding.descriptorType     = RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            meshMatDescSetLayoutMaterialsBinding.descriptorCount    = 1;
+            meshMatDescSetLayoutMaterialsBinding.stageFlags         = RHI_SHADER_STAGE_FRAGMENT_BIT;
+            meshMatDescSetLayoutMaterialsBinding.pImmutableSamplers = nullptr;
+
+            // (set = 2, binding = 1 in fragment shader) textures of every material, indexed by the material
+            RHIDescriptorSetLayoutBinding& meshMatDescSetLayoutTexturesBinding = meshMatDescSetLayoutBinding[1];
+            meshMatDescSetLayoutTexturesBinding.binding            = 1;
+            meshMatDescSetLayoutTexturesBinding.descriptorType     = RHI_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            meshMatDescSetLayoutTexturesBinding.descriptorCount    = mRHI->GetMaxBindlessTextureCount();
+            meshMatDescSetLayoutTexturesBinding.stageFlags         = RHI_SHADER_STAGE_FRAGMENT_BIT;
+            meshMatDescSetLayoutTexturesBinding.pImmutableSamplers = nullptr;
+
+            // textures are written while frames using the set are in flight, unused slots stay unwritten
+            RHIDescriptorBindingFlags meshMatDescSetLayoutBindingFlags[2] = {
+                0, RHI_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | RHI_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT};
+
+            RHIDescriptorSetLayoutBindingFlagsCreateInfo meshMatDescSetLayoutBindingFlagsCI {};
+            meshMatDescSetLayoutBindingFlagsCI.sType         = RHI_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+            meshMatDescSetLayoutBindingFlagsCI.pNext         = nullptr;
+            meshMatDescSetLayoutBindingFlagsCI.bindingCount  = 2;
+            meshMatDescSetLayoutBindingFlagsCI.pBindingFlags = meshMatDescSetLayoutBindingFlags;
+
+            RHIDescriptorSetLayoutCreateInfo meshMatDescSetLayoutCI {};
+            meshMatDescSetLayoutCI.sType        = RHI_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+            meshMatDescSetLayoutCI.pNext        = &meshMatDescSetLayoutBindingFlagsCI;
+            meshMatDescSetLayoutCI.flags        = RHI_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+            meshMatDescSetLayoutCI.bindingCount = 2;
+            meshMatDescSetLayoutCI.pBindings    = meshMatDescSetLayoutBinding;
+
+            if (mRHI->CreateDescriptorSetLayout(&meshMatDescSetLayoutCI, mDescInfos[LayoutType_MeshPerMaterial].layout) != RHI_SUCCESS)
+            {
+                throw std::runtime_error("create bindless mesh material layout");
+            }
+        }
+        else
         {
             RHIDescriptorSetLayoutBinding meshMatDescSetLayoutBinding[6];
 
@@ -847,8 +970,11 @@ namespace MiniEngine
     {
         mRenderPipelines.resize(RenderPipelineType_Count);
 
+        // every pipeline only writes its own slot, so they are compiled concurrently
+        std::vector<std::function<void()>> pipeline_setups;
+
         // mesh gbuffer
-        {
+        pipeline_setups.emplace_back([this]() {
             RHIDescriptorSetLayout*      descriptorset_layouts[3] = {mDescInfos[LayoutType_MeshGlobal].layout,
                                                               mDescInfos[LayoutType_PerMesh].layout,
                                                               mDescInfos[LayoutType_MeshPerMaterial].layout};
@@ -880,8 +1006,8 @@ namespace MiniEngine
             RHIPipelineShaderStageCreateInfo shader_stages[] = {vert_pipeline_shader_stage_create_info,
                                                                frag_pipeline_shader_stage_create_info};
 
-            auto vertex_binding_descriptions   = MeshVertex::GetBindingDescriptions();
-            auto vertex_attribute_descriptions = MeshVertex::GetAttributeDescriptions();
+            auto vertex_binding_descriptions   = MeshVertex::GetBindingDescriptions(mbEnableVertexQuantization);
+            auto vertex_attribute_descriptions = MeshVertex::GetAttributeDescriptions(mbEnableVertexQuantization);
             RHIPipelineVertexInputStateCreateInfo vertex_input_state_create_info {};
             vertex_input_state_create_info.sType = RHI_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
             vertex_input_state_create_info.vertexBindingDescriptionCount   = vertex_binding_descriptions.size();
@@ -1002,10 +1128,10 @@ namespace MiniEngine
 
             mRHI->DestroyShaderModule(vert_shader_module);
             mRHI->DestroyShaderModule(frag_shader_module);
-        }
+        });
 
         // deferred lighting
-        {
+        pipeline_setups.emplace_back([this]() {
             RHIDescriptorSetLayout* descriptorset_layouts[3] = {
                 mDescInfos[LayoutType_MeshGlobal].layout,
                 mDescInfos[LayoutType_DeferredLighting].layout,
@@ -1145,10 +1271,10 @@ namespace MiniEngine
 
             mRHI->DestroyShaderModule(vert_shader_module);
             mRHI->DestroyShaderModule(frag_shader_module);
-        }
+        });
 
         // mesh lighting
-        {
+        pipeline_setups.emplace_back([this]() {
             RHIDescriptorSetLayout*      descriptorset_layouts[3] = {mDescInfos[LayoutType_MeshGlobal].layout,
                                                                      mDescInfos[LayoutType_PerMesh].layout,
                                                                      mDescInfos[LayoutType_MeshPerMaterial].layout};
@@ -1180,8 +1306,8 @@ namespace MiniEngine
             RHIPipelineShaderStageCreateInfo shader_stages[] = {vert_pipeline_shader_stage_create_info,
                                                                frag_pipeline_shader_stage_create_info};
 
-            auto vertex_binding_descriptions   = MeshVertex::GetBindingDescriptions();
-            auto vertex_attribute_descriptions = MeshVertex::GetAttributeDescriptions();
+            auto vertex_binding_descriptions   = MeshVertex::GetBindingDescriptions(mbEnableVertexQuantization);
+            auto vertex_attribute_descriptions = MeshVertex::GetAttributeDescriptions(mbEnableVertexQuantization);
             RHIPipelineVertexInputStateCreateInfo vertex_input_state_create_info {};
             vertex_input_state_create_info.sType = RHI_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
             vertex_input_state_create_info.vertexBindingDescriptionCount   = vertex_binding_descriptions.size();
@@ -1284,10 +1410,10 @@ namespace MiniEngine
 
             mRHI->DestroyShaderModule(vert_shader_module);
             mRHI->DestroyShaderModule(frag_shader_module);
-        }
+        });
 
         // skybox
-        {
+        pipeline_setups.emplace_back([this]() {
             RHIDescriptorSetLayout*      descriptorset_layouts[1] = {mDescInfos[LayoutType_Skybox].layout};
             RHIPipelineLayoutCreateInfo pipeline_layout_create_info {};
             pipeline_layout_create_info.sType          = RHI_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
@@ -1421,10 +1547,10 @@ namespace MiniEngine
 
             mRHI->DestroyShaderModule(vert_shader_module);
             mRHI->DestroyShaderModule(frag_shader_module);
-        }
+        });
 
         // draw axis
-        {
+        pipeline_setups.emplace_back([this]() {
             RHIDescriptorSetLayout*     descriptorset_layouts[1] = {mDescInfos[LayoutType_Axis].layout};
             RHIPipelineLayoutCreateInfo pipeline_layout_create_info {};
             pipeline_layout_create_info.sType          = RHI_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
@@ -1455,8 +1581,8 @@ namespace MiniEngine
             RHIPipelineShaderStageCreateInfo shader_stages[] = {vert_pipeline_shader_stage_create_info,
                                                                frag_pipeline_shader_stage_create_info};
 
-            auto vertex_binding_descriptions   = MeshVertex::GetBindingDescriptions();
-            auto vertex_attribute_descriptions = MeshVertex::GetAttributeDescriptions();
+            auto vertex_binding_descriptions   = MeshVertex::GetBindingDescriptions(mbEnableVertexQuantization);
+            auto vertex_attribute_descriptions = MeshVertex::GetAttributeDescriptions(mbEnableVertexQuantization);
             RHIPipelineVertexInputStateCreateInfo vertex_input_state_create_info {};
             vertex_input_state_create_info.sType = RHI_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
             vertex_input_state_create_info.vertexBindingDescriptionCount   = vertex_binding_descriptions.size();
@@ -1541,7 +1667,7 @@ namespace MiniEngine
             pipelineInfo.pMultisampleState   = &multisample_state_create_info;
             pipelineInfo.pColorBlendState    = &color_blend_state_create_info;
             pipelineInfo.pDepthStencilState  = &depth_stencil_create_info;
-            pipelineInfo.layout              = mRenderPipelines[RenderPipelineType_Skybox].layout;
+            pipelineInfo.layout              = mRenderPipelines[RenderPipelineType_Axis].layout;
             pipelineInfo.renderPass          = mFrameBuffer.renderPass;
             pipelineInfo.subpass             = MAIN_CAMERA_SUBPASS_UI;
             pipelineInfo.basePipelineHandle  = RHI_NULL_HANDLE;
@@ -1550,13 +1676,40 @@ namespace MiniEngine
             if (RHI_SUCCESS != mRHI->CreateGraphicsPipelines(RHI_NULL_HANDLE,
                                                               1,
                                                               &pipelineInfo,
-                                                              mRenderPipelines[RenderPipelineType_Skybox].pipeline))
+                                                              mRenderPipelines[RenderPipelineType_Axis].pipeline))
             {
                 throw std::runtime_error("create axis graphics pipeline");
             }
 
             mRHI->DestroyShaderModule(vert_shader_module);
             mRHI->DestroyShaderModule(frag_shader_module);
+        });
+
+        std::exception_ptr setup_exception;
+        std::mutex         setup_exception_mutex;
+        gRuntimeGlobalContext.mThreadPool->ParallelFor(
+            static_cast<uint32_t>(pipeline_setups.size()), 1, [&](uint32_t begin, uint32_t end) {
+                for (uint32_t i = begin; i < end; ++i)
+                {
+                    try
+                    {
+                        pipeline_setups[i]();
+                    }
+                    catch (...)
+                    {
+                        std::lock_guard<std::mutex> lock(setup_exception_mutex);
+                        if (!setup_exception)
+                        {
+                            setup_exception = std::current_exception();
+                        }
+                    }
+                }
+            });
+
+        // rethrow on the calling thread, an exception escaping a worker would terminate
+        if (setup_exception)
+        {
+            std::rethrow_exception(setup_exception);
         }
     }
 
@@ -1690,258 +1843,300 @@ namespace MiniEngine
 
     void MainCameraPass::setupModelGlobalDescriptorSet()
     {
-        // update common model's global descriptor set
-        RHIDescriptorSetAllocateInfo mesh_global_descriptor_set_alloc_info;
-        mesh_global_descriptor_set_alloc_info.sType              = RHI_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-        mesh_global_descriptor_set_alloc_info.pNext              = nullptr;
-        mesh_global_descriptor_set_alloc_info.descriptorPool     = mRHI->GetDescriptorPool();
-        mesh_global_descriptor_set_alloc_info.descriptorSetCount = 1;
-        mesh_global_descriptor_set_alloc_info.pSetLayouts        = &mDescInfos[LayoutType_MeshGlobal].layout;
-
-        if (RHI_SUCCESS != mRHI->AllocateDescriptorSets(&mesh_global_descriptor_set_alloc_info, mDescInfos[LayoutType_MeshGlobal].descriptorSet))
-        {
-            throw std::runtime_error("allocate mesh global descriptor set");
-        }
-
-        RHIDescriptorBufferInfo mesh_perframe_storage_buffer_info = {};
-        // this offset plus dynamic_offset should not be greater than the size of the buffer
-        mesh_perframe_storage_buffer_info.offset = 0;
-        // the range means the size actually used by the shader per draw call
-        mesh_perframe_storage_buffer_info.range  = sizeof(MeshPerframeStorageBufferObject);
-        mesh_perframe_storage_buffer_info.buffer = mGlobalRenderResource->mStorageBuffer.mGlobalUploadRingbuffer;
-        assert(mesh_perframe_storage_buffer_info.range <
-               mGlobalRenderResource->mStorageBuffer.mMaxStorageBufferRange);
-
-        RHIDescriptorBufferInfo mesh_perdrawcall_storage_buffer_info = {};
-        mesh_perdrawcall_storage_buffer_info.offset                 = 0;
-        mesh_perdrawcall_storage_buffer_info.range                  = sizeof(MeshPerdrawcallStorageBufferObject);
-        mesh_perdrawcall_storage_buffer_info.buffer =
-            mGlobalRenderResource->mStorageBuffer.mGlobalUploadRingbuffer;
-        assert(mesh_perdrawcall_storage_buffer_info.range <
-               mGlobalRenderResource->mStorageBuffer.mMaxStorageBufferRange);
-
-        RHIDescriptorBufferInfo mesh_per_drawcall_vertex_blending_storage_buffer_info = {};
-        mesh_per_drawcall_vertex_blending_storage_buffer_info.offset                 = 0;
-        mesh_per_drawcall_vertex_blending_storage_buffer_info.range =
-            sizeof(MeshPerdrawcallVertexBlendingStorageBufferObject);
-        mesh_per_drawcall_vertex_blending_storage_buffer_info.buffer =
-            mGlobalRenderResource->mStorageBuffer.mGlobalUploadRingbuffer;
-        assert(mesh_per_drawcall_vertex_blending_storage_buffer_info.range <
-               mGlobalRenderResource->mStorageBuffer.mMaxStorageBufferRange);
-
-        RHIDescriptorImageInfo brdf_texture_image_info = {};
-        brdf_texture_image_info.sampler     = mGlobalRenderResource->mIBLResource.mBrdfLutTextureSampler;
-        brdf_texture_image_info.imageView   = mGlobalRenderResource->mIBLResource.mBrdfLutTextureImageView;
-        brdf_texture_image_info.imageLayout = RHI_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-        RHIDescriptorImageInfo irradiance_texture_image_info = {};
-        irradiance_texture_image_info.sampler = mGlobalRenderResource->mIBLResource.mIrradianceTextureSampler;
-        irradiance_texture_image_info.imageView =
-            mGlobalRenderResource->mIBLResource.mIrradianceTextureImageView;
-        irradiance_texture_image_info.imageLayout = RHI_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-        RHIDescriptorImageInfo specular_texture_image_info {};
-        specular_texture_image_info.sampler     = mGlobalRenderResource->mIBLResource.mSpecularTextureSampler;
-        specular_texture_image_info.imageView   = mGlobalRenderResource->mIBLResource.mSpecularTextureImageView;
-        specular_texture_image_info.imageLayout = RHI_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-        RHIDescriptorImageInfo directional_light_shadow_texture_image_info{};
-        directional_light_shadow_texture_image_info.sampler =
-            mRHI->GetOrCreateDefaultSampler(Default_Sampler_Nearest);
-        directional_light_shadow_texture_image_info.imageView = mDirectionalLightShadowColorImageView;
-        directional_light_shadow_texture_image_info.imageLayout = RHI_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-        RHIWriteDescriptorSet mesh_descriptor_writes_info[8];
-
-        mesh_descriptor_writes_info[0].sType           = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        mesh_descriptor_writes_info[0].pNext           = nullptr;
-        mesh_descriptor_writes_info[0].dstSet          = mDescInfos[LayoutType_MeshGlobal].descriptorSet;
-        mesh_descriptor_writes_info[0].dstBinding      = 0;
-        mesh_descriptor_writes_info[0].dstArrayElement = 0;
-        mesh_descriptor_writes_info[0].descriptorType  = RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
-        mesh_descriptor_writes_info[0].descriptorCount = 1;
-        mesh_descriptor_writes_info[0].pBufferInfo     = &mesh_perframe_storage_buffer_info;
-
-        mesh_descriptor_writes_info[1].sType           = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        mesh_descriptor_writes_info[1].pNext           = nullptr;
-        mesh_descriptor_writes_info[1].dstSet          = mDescInfos[LayoutType_MeshGlobal].descriptorSet;
-        mesh_descriptor_writes_info[1].dstBinding      = 1;
-        mesh_descriptor_writes_info[1].dstArrayElement = 0;
-        mesh_descriptor_writes_info[1].descriptorType  = RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
-        mesh_descriptor_writes_info[1].descriptorCount = 1;
-        mesh_descriptor_writes_info[1].pBufferInfo     = &mesh_perdrawcall_storage_buffer_info;
-
-        mesh_descriptor_writes_info[2].sType           = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        mesh_descriptor_writes_info[2].pNext           = nullptr;
-        mesh_descriptor_writes_info[2].dstSet          = mDescInfos[LayoutType_MeshGlobal].descriptorSet;
-        mesh_descriptor_writes_info[2].dstBinding      = 2;
-        mesh_descriptor_writes_info[2].dstArrayElement = 0;
-        mesh_descriptor_writes_info[2].descriptorType  = RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
-        mesh_descriptor_writes_info[2].descriptorCount = 1;
-        mesh_descriptor_writes_info[2].pBufferInfo     = &mesh_per_drawcall_vertex_blending_storage_buffer_info;
-
-        mesh_descriptor_writes_info[3].sType           = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        mesh_descriptor_writes_info[3].pNext           = nullptr;
-        mesh_descriptor_writes_info[3].dstSet          = mDescInfos[LayoutType_MeshGlobal].descriptorSet;
-        mesh_descriptor_writes_info[3].dstBinding      = 3;
-        mesh_descriptor_writes_info[3].dstArrayElement = 0;
-        mesh_descriptor_writes_info[3].descriptorType  = RHI_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        mesh_descriptor_writes_info[3].descriptorCount = 1;
-        mesh_descriptor_writes_info[3].pImageInfo      = &brdf_texture_image_info;
-
-        mesh_descriptor_writes_info[4]            = mesh_descriptor_writes_info[3];
-        mesh_descriptor_writes_info[4].dstBinding = 4;
-        mesh_descriptor_writes_info[4].pImageInfo = &irradiance_texture_image_info;
-
-        mesh_descriptor_writes_info[5]            = mesh_descriptor_writes_info[3];
-        mesh_descriptor_writes_info[5].dstBinding = 5;
-        mesh_descriptor_writes_info[5].pImageInfo = &specular_texture_image_info;
-
-        mesh_descriptor_writes_info[6]            = mesh_descriptor_writes_info[3];
-        mesh_descriptor_writes_info[6].dstBinding = 6;
-        mesh_descriptor_writes_info[6].pImageInfo = &directional_light_shadow_texture_image_info;
-
-        mRHI->UpdateDescriptorSets(sizeof(mesh_descriptor_writes_info) / sizeof(mesh_descriptor_writes_info[0]),
-                                    mesh_descriptor_writes_info,
-                                    0,
-                                    nullptr);
+        // the dynamic storage buffers point into the upload pages, the set is written once for every page
+        mMeshGlobalUploadDescriptorID = mGlobalRenderResource->mStorageBuffer.mGlobalUploadBuffer.RegisterDescriptorSet(
+            mDescInfos[LayoutType_MeshGlobal].layout, [this](RHIDescriptorSet* descriptor_set, RHIBuffer* page_buffer) {
+                RHIDescriptorBufferInfo mesh_perframe_storage_buffer_info = {};
+                // this offset plus dynamic_offset should not be greater than the size of the buffer
+                mesh_perframe_storage_buffer_info.offset = 0;
+                // the range means the size actually used by the shader per draw call
+                mesh_perframe_storage_buffer_info.range  = sizeof(MeshPerframeStorageBufferObject);
+                mesh_perframe_storage_buffer_info.buffer = page_buffer;
+                assert(mesh_perframe_storage_buffer_info.range <
+                       mGlobalRenderResource->mStorageBuffer.mMaxStorageBufferRange);
+
+                RHIDescriptorBufferInfo mesh_perdrawcall_storage_buffer_info = {};
+                mesh_perdrawcall_storage_buffer_info.offset                 = 0;
+                mesh_perdrawcall_storage_buffer_info.range                  = sizeof(MeshPerdrawcallStorageBufferObject);
+                mesh_perdrawcall_storage_buffer_info.buffer =
+                    page_buffer;
+                assert(mesh_perdrawcall_storage_buffer_info.range <
+                       mGlobalRenderResource->mStorageBuffer.mMaxStorageBufferRange);
+
+                RHIDescriptorBufferInfo mesh_per_drawcall_vertex_blending_storage_buffer_info = {};
+                mesh_per_drawcall_vertex_blending_storage_buffer_info.offset                 = 0;
+                mesh_per_drawcall_vertex_blending_storage_buffer_info.range =
+                    sizeof(MeshPerdrawcallVertexBlendingStorageBufferObject);
+                mesh_per_drawcall_vertex_blending_storage_buffer_info.buffer =
+                    page_buffer;
+                assert(mesh_per_drawcall_vertex_blending_storage_buffer_info.range <
+                       mGlobalRenderResource->mStorageBuffer.mMaxStorageBufferRange);
+
+                RHIDescriptorImageInfo brdf_texture_image_info = {};
+                brdf_texture_image_info.sampler     = mGlobalRenderResource->mIBLResource.mBrdfLutTextureSampler;
+                brdf_texture_image_info.imageView   = mGlobalRenderResource->mIBLResource.mBrdfLutTextureImageView;
+                brdf_texture_image_info.imageLayout = RHI_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+                RHIDescriptorImageInfo irradiance_texture_image_info = {};
+                irradiance_texture_image_info.sampler = mGlobalRenderResource->mIBLResource.mIrradianceTextureSampler;
+                irradiance_texture_image_info.imageView =
+                    mGlobalRenderResource->mIBLResource.mIrradianceTextureImageView;
+                irradiance_texture_image_info.imageLayout = RHI_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+                RHIDescriptorImageInfo specular_texture_image_info {};
+                specular_texture_image_info.sampler     = mGlobalRenderResource->mIBLResource.mSpecularTextureSampler;
+                specular_texture_image_info.imageView   = mGlobalRenderResource->mIBLResource.mSpecularTextureImageView;
+                specular_texture_image_info.imageLayout = RHI_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+                RHIDescriptorImageInfo directional_light_shadow_texture_image_info{};
+                directional_light_shadow_texture_image_info.sampler =
+                    mRHI->GetOrCreateDefaultSampler(Default_Sampler_Nearest);
+                directional_light_shadow_texture_image_info.imageView = mDirectionalLightShadowColorImageView;
+                directional_light_shadow_texture_image_info.imageLayout = RHI_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+                RHIDescriptorBufferInfo point_light_storage_buffer_info = {};
+                point_light_storage_buffer_info.offset = 0;
+                point_light_storage_buffer_info.range  = sizeof(VulkanScenePointLight) * s_max_clustered_point_light_count;
+                point_light_storage_buffer_info.buffer = page_buffer;
+                assert(point_light_storage_buffer_info.range <
+                       mGlobalRenderResource->mStorageBuffer.mMaxStorageBufferRange);
+
+                RHIDescriptorBufferInfo light_cluster_grid_storage_buffer_info = {};
+                light_cluster_grid_storage_buffer_info.offset = 0;
+                light_cluster_grid_storage_buffer_info.range  = sizeof(uint32_t) * 2 * s_light_cluster_count;
+                light_cluster_grid_storage_buffer_info.buffer = page_buffer;
+                assert(light_cluster_grid_storage_buffer_info.range <
+                       mGlobalRenderResource->mStorageBuffer.mMaxStorageBufferRange);
+
+                RHIDescriptorBufferInfo light_index_storage_buffer_info = {};
+                light_index_storage_buffer_info.offset = 0;
+                light_index_storage_buffer_info.range  = sizeof(uint32_t) * s_max_light_cluster_index_count;
+                light_index_storage_buffer_info.buffer = page_buffer;
+                assert(light_index_storage_buffer_info.range <
+                       mGlobalRenderResource->mStorageBuffer.mMaxStorageBufferRange);
+
+                RHIWriteDescriptorSet mesh_descriptor_writes_info[10];
+
+                mesh_descriptor_writes_info[0].sType           = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                mesh_descriptor_writes_info[0].pNext           = nullptr;
+                mesh_descriptor_writes_info[0].dstSet          = descriptor_set;
+                mesh_descriptor_writes_info[0].dstBinding      = 0;
+                mesh_descriptor_writes_info[0].dstArrayElement = 0;
+                mesh_descriptor_writes_info[0].descriptorType  = RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+                mesh_descriptor_writes_info[0].descriptorCount = 1;
+                mesh_descriptor_writes_info[0].pBufferInfo     = &mesh_perframe_storage_buffer_info;
+
+                mesh_descriptor_writes_info[1].sType           = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                mesh_descriptor_writes_info[1].pNext           = nullptr;
+                mesh_descriptor_writes_info[1].dstSet          = descriptor_set;
+                mesh_descriptor_writes_info[1].dstBinding      = 1;
+                mesh_descriptor_writes_info[1].dstArrayElement = 0;
+                mesh_descriptor_writes_info[1].descriptorType  = RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+                mesh_descriptor_writes_info[1].descriptorCount = 1;
+                mesh_descriptor_writes_info[1].pBufferInfo     = &mesh_perdrawcall_storage_buffer_info;
+
+                mesh_descriptor_writes_info[2].sType           = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                mesh_descriptor_writes_info[2].pNext           = nullptr;
+                mesh_descriptor_writes_info[2].dstSet          = descriptor_set;
+                mesh_descriptor_writes_info[2].dstBinding      = 2;
+                mesh_descriptor_writes_info[2].dstArrayElement = 0;
+                mesh_descriptor_writes_info[2].descriptorType  = RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+                mesh_descriptor_writes_info[2].descriptorCount = 1;
+                mesh_descriptor_writes_info[2].pBufferInfo     = &mesh_per_drawcall_vertex_blending_storage_buffer_info;
+
+                mesh_descriptor_writes_info[3].sType           = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                mesh_descriptor_writes_info[3].pNext           = nullptr;
+                mesh_descriptor_writes_info[3].dstSet          = descriptor_set;
+                mesh_descriptor_writes_info[3].dstBinding      = 3;
+                mesh_descriptor_writes_info[3].dstArrayElement = 0;
+                mesh_descriptor_writes_info[3].descriptorType  = RHI_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+                mesh_descriptor_writes_info[3].descriptorCount = 1;
+                mesh_descriptor_writes_info[3].pImageInfo      = &brdf_texture_image_info;
+
+                mesh_descriptor_writes_info[4]            = mesh_descriptor_writes_info[3];
+                mesh_descriptor_writes_info[4].dstBinding = 4;
+                mesh_descriptor_writes_info[4].pImageInfo = &irradiance_texture_image_info;
+
+                mesh_descriptor_writes_info[5]            = mesh_descriptor_writes_info[3];
+                mesh_descriptor_writes_info[5].dstBinding = 5;
+                mesh_descriptor_writes_info[5].pImageInfo = &specular_texture_image_info;
+
+                mesh_descriptor_writes_info[6]            = mesh_descriptor_writes_info[3];
+                mesh_descriptor_writes_info[6].dstBinding = 6;
+                mesh_descriptor_writes_info[6].pImageInfo = &directional_light_shadow_texture_image_info;
+
+                mesh_descriptor_writes_info[7]             = mesh_descriptor_writes_info[0];
+                mesh_descriptor_writes_info[7].dstBinding  = 7;
+                mesh_descriptor_writes_info[7].pBufferInfo = &point_light_storage_buffer_info;
+
+                mesh_descriptor_writes_info[8]             = mesh_descriptor_writes_info[0];
+                mesh_descriptor_writes_info[8].dstBinding  = 8;
+                mesh_descriptor_writes_info[8].pBufferInfo = &light_cluster_grid_storage_buffer_info;
+
+                mesh_descriptor_writes_info[9]             = mesh_descriptor_writes_info[0];
+                mesh_descriptor_writes_info[9].dstBinding  = 9;
+                mesh_descriptor_writes_info[9].pBufferInfo = &light_index_storage_buffer_info;
+
+                mRHI->UpdateDescriptorSets(sizeof(mesh_descriptor_writes_info) / sizeof(mesh_descriptor_writes_info[0]),
+                                            mesh_descriptor_writes_info,
+                                            0,
+                                            nullptr);
+            });
     }
 
     void MainCameraPass::setupSkyboxDescriptorSet()
     {
-        RHIDescriptorSetAllocateInfo skybox_descriptor_set_alloc_info;
-        skybox_descriptor_set_alloc_info.sType              = RHI_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-        skybox_descriptor_set_alloc_info.pNext              = nullptr;
-        skybox_descriptor_set_alloc_info.descriptorPool     = mRHI->GetDescriptorPool();
-        skybox_descriptor_set_alloc_info.descriptorSetCount = 1;
-        skybox_descriptor_set_alloc_info.pSetLayouts        = &mDescInfos[LayoutType_Skybox].layout;
-
-        if (RHI_SUCCESS != mRHI->AllocateDescriptorSets(&skybox_descriptor_set_alloc_info, mDescInfos[LayoutType_Skybox].descriptorSet))
-        {
-            throw std::runtime_error("allocate skybox descriptor set");
-        }
-
-        RHIDescriptorBufferInfo mesh_perframe_storage_buffer_info = {};
-        mesh_perframe_storage_buffer_info.offset                 = 0;
-        mesh_perframe_storage_buffer_info.range                  = sizeof(MeshPerframeStorageBufferObject);
-        mesh_perframe_storage_buffer_info.buffer = mGlobalRenderResource->mStorageBuffer.mGlobalUploadRingbuffer;
-        assert(mesh_perframe_storage_buffer_info.range <
-               mGlobalRenderResource->mStorageBuffer.mMaxStorageBufferRange);
-
-        RHIDescriptorImageInfo specular_texture_image_info = {};
-        specular_texture_image_info.sampler     = mGlobalRenderResource->mIBLResource.mSpecularTextureSampler;
-        specular_texture_image_info.imageView   = mGlobalRenderResource->mIBLResource.mSpecularTextureImageView;
-        specular_texture_image_info.imageLayout = RHI_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-        RHIWriteDescriptorSet skybox_descriptor_writes_info[2];
-
-        skybox_descriptor_writes_info[0].sType           = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        skybox_descriptor_writes_info[0].pNext           = nullptr;
-        skybox_descriptor_writes_info[0].dstSet          = mDescInfos[LayoutType_Skybox].descriptorSet;
-        skybox_descriptor_writes_info[0].dstBinding      = 0;
-        skybox_descriptor_writes_info[0].dstArrayElement = 0;
-        skybox_descriptor_writes_info[0].descriptorType  = RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
-        skybox_descriptor_writes_info[0].descriptorCount = 1;
-        skybox_descriptor_writes_info[0].pBufferInfo     = &mesh_perframe_storage_buffer_info;
-
-        skybox_descriptor_writes_info[1].sType           = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        skybox_descriptor_writes_info[1].pNext           = nullptr;
-        skybox_descriptor_writes_info[1].dstSet          = mDescInfos[LayoutType_Skybox].descriptorSet;
-        skybox_descriptor_writes_info[1].dstBinding      = 1;
-        skybox_descriptor_writes_info[1].dstArrayElement = 0;
-        skybox_descriptor_writes_info[1].descriptorType  = RHI_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-        skybox_descriptor_writes_info[1].descriptorCount = 1;
-        skybox_descriptor_writes_info[1].pImageInfo      = &specular_texture_image_info;
-
-        mRHI->UpdateDescriptorSets(2, skybox_descriptor_writes_info, 0, nullptr);
+        mSkyboxUploadDescriptorID = mGlobalRenderResource->mStorageBuffer.mGlobalUploadBuffer.RegisterDescriptorSet(
+            mDescInfos[LayoutType_Skybox].layout, [this](RHIDescriptorSet* descriptor_set, RHIBuffer* page_buffer) {
+                RHIDescriptorBufferInfo mesh_perframe_storage_buffer_info = {};
+                mesh_perframe_storage_buffer_info.offset                 = 0;
+                mesh_perframe_storage_buffer_info.range                  = sizeof(MeshPerframeStorageBufferObject);
+                mesh_perframe_storage_buffer_info.buffer = page_buffer;
+                assert(mesh_perframe_storage_buffer_info.range <
+                       mGlobalRenderResource->mStorageBuffer.mMaxStorageBufferRange);
+
+                RHIDescriptorImageInfo specular_texture_image_info = {};
+                specular_texture_image_info.sampler     = mGlobalRenderResource->mIBLResource.mSpecularTextureSampler;
+                specular_texture_image_info.imageView   = mGlobalRenderResource->mIBLResource.mSpecularTextureImageView;
+                specular_texture_image_info.imageLayout = RHI_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+                RHIWriteDescriptorSet skybox_descriptor_writes_info[2];
+
+                skybox_descriptor_writes_info[0].sType           = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                skybox_descriptor_writes_info[0].pNext           = nullptr;
+                skybox_descriptor_writes_info[0].dstSet          = descriptor_set;
+                skybox_descriptor_writes_info[0].dstBinding      = 0;
+                skybox_descriptor_writes_info[0].dstArrayElement = 0;
+                skybox_descriptor_writes_info[0].descriptorType  = RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+                skybox_descriptor_writes_info[0].descriptorCount = 1;
+                skybox_descriptor_writes_info[0].pBufferInfo     = &mesh_perframe_storage_buffer_info;
+
+                skybox_descriptor_writes_info[1].sType           = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                skybox_descriptor_writes_info[1].pNext           = nullptr;
+                skybox_descriptor_writes_info[1].dstSet          = descriptor_set;
+                skybox_descriptor_writes_info[1].dstBinding      = 1;
+                skybox_descriptor_writes_info[1].dstArrayElement = 0;
+                skybox_descriptor_writes_info[1].descriptorType  = RHI_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+                skybox_descriptor_writes_info[1].descriptorCount = 1;
+                skybox_descriptor_writes_info[1].pImageInfo      = &specular_texture_image_info;
+
+                mRHI->UpdateDescriptorSets(2, skybox_descriptor_writes_info, 0, nullptr);
+            });
     }
 
     void MainCameraPass::setupAxisDescriptorSet()
     {
-        RHIDescriptorSetAllocateInfo axis_descriptor_set_alloc_info;
-        axis_descriptor_set_alloc_info.sType              = RHI_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-        axis_descriptor_set_alloc_info.pNext              = nullptr;
-        axis_descriptor_set_alloc_info.descriptorPool     = mRHI->GetDescriptorPool();
-        axis_descriptor_set_alloc_info.descriptorSetCount = 1;
-        axis_descriptor_set_alloc_info.pSetLayouts        = &mDescInfos[LayoutType_Axis].layout;
-
-        if (RHI_SUCCESS != mRHI->AllocateDescriptorSets(&axis_descriptor_set_alloc_info, mDescInfos[LayoutType_Axis].descriptorSet))
-        {
-            throw std::runtime_error("allocate axis descriptor set");
-        }
-
-        RHIDescriptorBufferInfo mesh_perframe_storage_buffer_info = {};
-        mesh_perframe_storage_buffer_info.offset                 = 0;
-        mesh_perframe_storage_buffer_info.range                  = sizeof(MeshPerframeStorageBufferObject);
-        mesh_perframe_storage_buffer_info.buffer = mGlobalRenderResource->mStorageBuffer.mGlobalUploadRingbuffer;
-        assert(mesh_perframe_storage_buffer_info.range <
-               mGlobalRenderResource->mStorageBuffer.mMaxStorageBufferRange);
-
-        RHIDescriptorBufferInfo axis_storage_buffer_info = {};
-        axis_storage_buffer_info.offset                 = 0;
-        axis_storage_buffer_info.range                  = sizeof(AxisStorageBufferObject);
-        axis_storage_buffer_info.buffer = mGlobalRenderResource->mStorageBuffer.mAxisInefficientStorageBuffer;
-
-        RHIWriteDescriptorSet axis_descriptor_writes_info[2];
-
-        axis_descriptor_writes_info[0].sType           = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        axis_descriptor_writes_info[0].pNext           = nullptr;
-        axis_descriptor_writes_info[0].dstSet          = mDescInfos[LayoutType_Axis].descriptorSet;
-        axis_descriptor_writes_info[0].dstBinding      = 0;
-        axis_descriptor_writes_info[0].dstArrayElement = 0;
-        axis_descriptor_writes_info[0].descriptorType  = RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
-        axis_descriptor_writes_info[0].descriptorCount = 1;
-        axis_descriptor_writes_info[0].pBufferInfo     = &mesh_perframe_storage_buffer_info;
-
-        axis_descriptor_writes_info[1].sType           = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        axis_descriptor_writes_info[1].pNext           = nullptr;
-        axis_descriptor_writes_info[1].dstSet          = mDescInfos[LayoutType_Axis].descriptorSet;
-        axis_descriptor_writes_info[1].dstBinding      = 1;
-        axis_descriptor_writes_info[1].dstArrayElement = 0;
-        axis_descriptor_writes_info[1].descriptorType  = RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER;
-        axis_descriptor_writes_info[1].descriptorCount = 1;
-        axis_descriptor_writes_info[1].pBufferInfo     = &axis_storage_buffer_info;
-
-        mRHI->UpdateDescriptorSets((uint32_t)(sizeof(axis_descriptor_writes_info) / sizeof(axis_descriptor_writes_info[0])),
-                                    axis_descriptor_writes_info,
-                                    0,
-                                    nullptr);
+        mAxisUploadDescriptorID = mGlobalRenderResource->mStorageBuffer.mGlobalUploadBuffer.RegisterDescriptorSet(
+            mDescInfos[LayoutType_Axis].layout, [this](RHIDescriptorSet* descriptor_set, RHIBuffer* page_buffer) {
+                RHIDescriptorBufferInfo mesh_perframe_storage_buffer_info = {};
+                mesh_perframe_storage_buffer_info.offset                 = 0;
+                mesh_perframe_storage_buffer_info.range                  = sizeof(MeshPerframeStorageBufferObject);
+                mesh_perframe_storage_buffer_info.buffer = page_buffer;
+                assert(mesh_perframe_storage_buffer_info.range <
+                       mGlobalRenderResource->mStorageBuffer.mMaxStorageBufferRange);
+
+                RHIDescriptorBufferInfo axis_storage_buffer_info = {};
+                axis_storage_buffer_info.offset                 = 0;
+                axis_storage_buffer_info.range                  = sizeof(AxisStorageBufferObject);
+                axis_storage_buffer_info.buffer = mGlobalRenderResource->mStorageBuffer.mAxisInefficientStorageBuffer;
+
+                RHIWriteDescriptorSet axis_descriptor_writes_info[2];
+
+                axis_descriptor_writes_info[0].sType           = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                axis_descriptor_writes_info[0].pNext           = nullptr;
+                axis_descriptor_writes_info[0].dstSet          = descriptor_set;
+                axis_descriptor_writes_info[0].dstBinding      = 0;
+                axis_descriptor_writes_info[0].dstArrayElement = 0;
+                axis_descriptor_writes_info[0].descriptorType  = RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+                axis_descriptor_writes_info[0].descriptorCount = 1;
+                axis_descriptor_writes_info[0].pBufferInfo     = &mesh_perframe_storage_buffer_info;
+
+                axis_descriptor_writes_info[1].sType           = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                axis_descriptor_writes_info[1].pNext           = nullptr;
+                axis_descriptor_writes_info[1].dstSet          = descriptor_set;
+                axis_descriptor_writes_info[1].dstBinding      = 1;
+                axis_descriptor_writes_info[1].dstArrayElement = 0;
+                axis_descriptor_writes_info[1].descriptorType  = RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                axis_descriptor_writes_info[1].descriptorCount = 1;
+                axis_descriptor_writes_info[1].pBufferInfo     = &axis_storage_buffer_info;
+
+                mRHI->UpdateDescriptorSets((uint32_t)(sizeof(axis_descriptor_writes_info) / sizeof(axis_descriptor_writes_info[0])),
+                                            axis_descriptor_writes_info,
+                                            0,
+                                            nullptr);
+            });
     }
 
     void MainCameraPass::setupGBufferLightingDescriptorSet()
     {
-        RHIDescriptorSetAllocateInfo gbuffer_light_global_descriptor_set_alloc_info;
-        gbuffer_light_global_descriptor_set_alloc_info.sType          = RHI_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-        gbuffer_light_global_descriptor_set_alloc_info.pNext          = nullptr;
-        gbuffer_light_global_descriptor_set_alloc_info.descriptorPool = mRHI->GetDescriptorPool();
-        gbuffer_light_global_descriptor_set_alloc_info.descriptorSetCount = 1;
-        gbuffer_light_global_descriptor_set_alloc_info.pSetLayouts = &mDescInfos[LayoutType_DeferredLighting].layout;
-
-        if (RHI_SUCCESS != mRHI->AllocateDescriptorSets(&gbuffer_light_global_descriptor_set_alloc_info, mDescInfos[LayoutType_DeferredLighting].descriptorSet))
+        if (RHI_SUCCESS != mRHI->AllocateDescriptorSet(mDescInfos[LayoutType_DeferredLighting].layout,
+                                                       mDescInfos[LayoutType_DeferredLighting].descriptorSet))
         {
             throw std::runtime_error("allocate gbuffer light global descriptor set");
         }
     }
 
-    void MainCameraPass::drawMeshGBuffer()
+    void MainCameraPass::uploadLightClusterData()
+    {
+        if (!mLightClusterBuilder)
+        {
+            return;
+        }
+
+        const void* light_cluster_data[3] = {mLightClusterBuilder->GetPointLights().data(),
+                                             mLightClusterBuilder->GetClusterGrid().data(),
+                                             mLightClusterBuilder->GetLightIndices().data()};
+        uint32_t    light_cluster_data_size[3] = {
+            static_cast<uint32_t>(sizeof(VulkanScenePointLight) * mLightClusterBuilder->GetPointLights().size()),
+            static_cast<uint32_t>(sizeof(uint32_t) * mLightClusterBuilder->GetClusterGrid().size()),
+            static_cast<uint32_t>(sizeof(uint32_t) * mLightClusterBuilder->GetLightIndices().size())};
+
+        // the descriptor ranges cover the maximum counts and have to stay inside the page
+        uint32_t light_cluster_range_size[3] = {
+            static_cast<uint32_t>(sizeof(VulkanScenePointLight) * s_max_clustered_point_light_count),
+            static_cast<uint32_t>(sizeof(uint32_t) * 2 * s_light_cluster_count),
+            static_cast<uint32_t>(sizeof(uint32_t) * s_max_light_cluster_index_count)};
+
+        for (uint32_t i = 0; i < 3; ++i)
+        {
+            UploadAllocation allocation = mGlobalRenderResource->mStorageBuffer.mGlobalUploadBuffer.Allocate(
+                std::max(light_cluster_data_size[i], light_cluster_range_size[i]));
+            mLightClusterDynamicOffsets[i] = allocation.mOffset;
+
+            if (light_cluster_data_size[i] > 0)
+            {
+                memcpy(allocation.mData, light_cluster_data[i], light_cluster_data_size[i]);
+            }
+        }
+    }
+
+    void MainCameraPass::prepareMeshDrawCommands()
     {
         struct MeshNode
         {
             const Matrix4x4* model_matrix {nullptr};
             const Matrix4x4* joint_matrices {nullptr};
             uint32_t         joint_count {0};
+            uint32_t         material_index {0};
         };
 
-        std::map<VulkanPBRMaterial*, std::map<VulkanMesh*, std::vector<MeshNode>>> main_camera_mesh_drawcall_batch;
+        // frame memory, rebuilt every frame without touching the heap
+        std::pmr::map<VulkanPBRMaterial*, std::pmr::map<std::pair<VulkanMesh*, uint32_t>, std::pmr::vector<MeshNode>>>
+            main_camera_mesh_drawcall_batch(gRuntimeGlobalContext.mFrameAllocator->GetResource());
 
         // reorganize mesh
         for (RenderMeshNode& node : *(mVisibleNodes.mMainCameraVisibleMeshNodes))
         {
-            auto& mesh_instanced = main_camera_mesh_drawcall_batch[node.ref_material];
-            auto& mesh_nodes     = mesh_instanced[node.ref_mesh];
+            // bindless materials are read per instance, so every material falls into one batch
+            auto& mesh_instanced = main_camera_mesh_drawcall_batch[mbEnableBindlessMaterials ? nullptr : node.ref_material];
+            auto& mesh_nodes     = mesh_instanced[std::make_pair(node.ref_mesh, node.lod_index)];
 
             MeshNode temp;
             temp.model_matrix = node.model_matrix;
+            if (mbEnableBindlessMaterials)
+            {
+                temp.material_index = node.ref_material->bindless_material_index;
+            }
             if (node.enable_vertex_blending)
             {
                 temp.joint_matrices = node.joint_matrices;
@@ -1951,82 +2146,31 @@ namespace MiniEngine
             mesh_nodes.push_back(temp);
         }
 
-        float color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
-        mRHI->PushEvent(mRHI->GetCurrentCommandBuffer(), "Mesh GBuffer", color);
+        mMeshDrawCommands.clear();
 
-        mRHI->CmdBindPipelinePFN(mRHI->GetCurrentCommandBuffer(),
-                                  RHI_PIPELINE_BIND_POINT_GRAPHICS,
-                                  mRenderPipelines[RenderPipelineType_MeshGBuffer].pipeline);
-        mRHI->CmdSetViewportPFN(mRHI->GetCurrentCommandBuffer(), 0, 1, mRHI->GetSwapChainInfo().viewport);
-        mRHI->CmdSetScissorPFN(mRHI->GetCurrentCommandBuffer(), 0, 1, mRHI->GetSwapChainInfo().scissor);
+        UploadBufferAllocator& upload_buffer = mGlobalRenderResource->mStorageBuffer.mGlobalUploadBuffer;
 
         // perframe storage buffer
-        uint32_t perframe_dynamic_offset =
-            RoundUp(mGlobalRenderResource->mStorageBuffer
-                        .mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()],
-                    mGlobalRenderResource->mStorageBuffer.mMinStorageBufferOffsetAlignment);
-
-        mGlobalRenderResource->mStorageBuffer.mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()] =
-            perframe_dynamic_offset + sizeof(MeshPerframeStorageBufferObject);
-        assert(mGlobalRenderResource->mStorageBuffer
-                   .mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()] <=
-               (mGlobalRenderResource->mStorageBuffer
-                    .mGlobalUploadRingbuffersBegin[mRHI->GetCurrentFrameIndex()] +
-                mGlobalRenderResource->mStorageBuffer
-                    .mGlobalUploadRingbuffersSize[mRHI->GetCurrentFrameIndex()]));
-
-        (*reinterpret_cast<MeshPerframeStorageBufferObject*>(
-            reinterpret_cast<uintptr_t>(
-                mGlobalRenderResource->mStorageBuffer.mGlobalUploadRingbufferMemoryPointer) +
-            perframe_dynamic_offset)) = mPerFrameStorageBufferObject;
+        uint32_t perframe_dynamic_offset;
+        *upload_buffer.Allocate<MeshPerframeStorageBufferObject>(
+            perframe_dynamic_offset) = mPerFrameStorageBufferObject;
+
+        // TODO: render from near to far
 
         for (auto& pair1 : main_camera_mesh_drawcall_batch)
         {
-            VulkanPBRMaterial& material       = (*pair1.first);
+            VulkanPBRMaterial* material       = pair1.first;
             auto&              mesh_instanced = pair1.second;
 
-            // bind per material
-            mRHI->CmdBindDescriptorSetsPFN(mRHI->GetCurrentCommandBuffer(),
-                                            RHI_PIPELINE_BIND_POINT_GRAPHICS,
-                                            mRenderPipelines[RenderPipelineType_MeshGBuffer].layout,
-                                            2,
-                                            1,
-                                            &material.material_descriptor_set,
-                                            0,
-                                            nullptr);
-
-            // TODO: render from near to far
-
             for (auto& pair2 : mesh_instanced)
             {
-                VulkanMesh& mesh       = (*pair2.first);
-                auto&       mesh_nodes = pair2.second;
+                VulkanMesh&    mesh       = (*pair2.first.first);
+                const MeshLod& mesh_lod   = mesh.mesh_lods[pair2.first.second];
+                auto&          mesh_nodes = pair2.second;
 
                 uint32_t total_instance_count = static_cast<uint32_t>(mesh_nodes.size());
                 if (total_instance_count > 0)
                 {
-                    // bind per mesh
-                    mRHI->CmdBindDescriptorSetsPFN(mRHI->GetCurrentCommandBuffer(),
-                                                    RHI_PIPELINE_BIND_POINT_GRAPHICS,
-                                                    mRenderPipelines[RenderPipelineType_MeshGBuffer].layout,
-                                                    1,
-                                                    1,
-                                                    &mesh.mesh_vertex_blending_descriptor_set,
-                                                    0,
-                                                    nullptr);
-
-
-                    RHIBuffer* vertex_buffers[] = {mesh.mesh_vertex_position_buffer,
-                                                 mesh.mesh_vertex_varying_enable_blending_buffer,
-                                                 mesh.mesh_vertex_varying_buffer};
-                    RHIDeviceSize offsets[]        = {0, 0, 0};
-                    mRHI->CmdBindVertexBuffersPFN(mRHI->GetCurrentCommandBuffer(),
-                                                   0,
-                                                   (sizeof(vertex_buffers) / sizeof(vertex_buffers[0])),
-                                                   vertex_buffers,
-                                                   offsets);
-                    mRHI->CmdBindIndexBufferPFN(mRHI->GetCurrentCommandBuffer(), mesh.mesh_index_buffer, 0, RHI_INDEX_TYPE_UINT16);
-
                     uint32_t drawcall_max_instance_count =
                         (sizeof(MeshPerdrawcallStorageBufferObject::mesh_instances) /
                          sizeof(MeshPerdrawcallStorageBufferObject::mesh_instances[0]));
@@ -2042,25 +2186,10 @@ namespace MiniEngine
                                 drawcall_max_instance_count;
 
                         // per drawcall storage buffer
-                        uint32_t perdrawcall_dynamic_offset =
-                            RoundUp(mGlobalRenderResource->mStorageBuffer
-                                        .mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()],
-                                    mGlobalRenderResource->mStorageBuffer.mMinStorageBufferOffsetAlignment);
-                        mGlobalRenderResource->mStorageBuffer
-                            .mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()] =
-                            perdrawcall_dynamic_offset + sizeof(MeshPerdrawcallStorageBufferObject);
-                        assert(mGlobalRenderResource->mStorageBuffer
-                                   .mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()] <=
-                               (mGlobalRenderResource->mStorageBuffer
-                                    .mGlobalUploadRingbuffersBegin[mRHI->GetCurrentFrameIndex()] +
-                                mGlobalRenderResource->mStorageBuffer
-                                    .mGlobalUploadRingbuffersSize[mRHI->GetCurrentFrameIndex()]));
-
+                        uint32_t perdrawcall_dynamic_offset;
                         MeshPerdrawcallStorageBufferObject& perdrawcall_storage_buffer_object =
-                            (*reinterpret_cast<MeshPerdrawcallStorageBufferObject*>(
-                                reinterpret_cast<uintptr_t>(mGlobalRenderResource->mStorageBuffer
-                                                                .mGlobalUploadRingbufferMemoryPointer) +
-                                perdrawcall_dynamic_offset));
+                            *upload_buffer.Allocate<MeshPerdrawcallStorageBufferObject>(perdrawcall_dynamic_offset);
+                        perdrawcall_storage_buffer_object.mesh_vertex_decode = mesh.mesh_vertex_decode;
                         for (uint32_t i = 0; i < current_instance_count; ++i)
                         {
                             perdrawcall_storage_buffer_object.mesh_instances[i].model_matrix =
@@ -2068,6 +2197,8 @@ namespace MiniEngine
                             perdrawcall_storage_buffer_object.mesh_instances[i].enable_vertex_blending =
                                 mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices ? 1.0 :
                                                                                                               -1.0;
+                            perdrawcall_storage_buffer_object.mesh_instances[i].material_index =
+                                mesh_nodes[drawcall_max_instance_count * drawcall_index + i].material_index;
                         }
 
                         // per drawcall vertex blending storage buffer
@@ -2083,27 +2214,10 @@ namespace MiniEngine
                         }
                         if (least_one_enable_vertex_blending)
                         {
-                            per_drawcall_vertex_blending_dynamic_offset =
-                                RoundUp(mGlobalRenderResource->mStorageBuffer
-                                            .mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()],
-                                        mGlobalRenderResource->mStorageBuffer.mMinStorageBufferOffsetAlignment);
-                            mGlobalRenderResource->mStorageBuffer
-                                .mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()] =
-                                per_drawcall_vertex_blending_dynamic_offset +
-                                sizeof(MeshPerdrawcallVertexBlendingStorageBufferObject);
-                            assert(mGlobalRenderResource->mStorageBuffer
-                                       .mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()] <=
-                                   (mGlobalRenderResource->mStorageBuffer
-                                        .mGlobalUploadRingbuffersBegin[mRHI->GetCurrentFrameIndex()] +
-                                    mGlobalRenderResource->mStorageBuffer
-                                        .mGlobalUploadRingbuffersSize[mRHI->GetCurrentFrameIndex()]));
-
                             MeshPerdrawcallVertexBlendingStorageBufferObject&
                                 per_drawcall_vertex_blending_storage_buffer_object =
-                                    (*reinterpret_cast<MeshPerdrawcallVertexBlendingStorageBufferObject*>(
-                                        reinterpret_cast<uintptr_t>(mGlobalRenderResource->mStorageBuffer
-                                                                        .mGlobalUploadRingbufferMemoryPointer) +
-                                        per_drawcall_vertex_blending_dynamic_offset));
+                                    *upload_buffer.Allocate<MeshPerdrawcallVertexBlendingStorageBufferObject>(
+                                        per_drawcall_vertex_blending_dynamic_offset);
                             for (uint32_t i = 0; i < current_instance_count; ++i)
                             {
                                 if (mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices)
@@ -2125,343 +2239,286 @@ namespace MiniEngine
                             per_drawcall_vertex_blending_dynamic_offset = 0;
                         }
 
-                        // bind perdrawcall
-                        uint32_t dynamic_offsets[3] = {perframe_dynamic_offset,
-                                                       perdrawcall_dynamic_offset,
-                                                       per_drawcall_vertex_blending_dynamic_offset};
-                        mRHI->CmdBindDescriptorSetsPFN(mRHI->GetCurrentCommandBuffer(),
-                                                        RHI_PIPELINE_BIND_POINT_GRAPHICS,
-                                                        mRenderPipelines[RenderPipelineType_MeshGBuffer].layout,
-                                                        0,
-                                                        1,
-                                                        &mDescInfos[LayoutType_MeshGlobal].descriptorSet,
-                                                        3,
-                                                        dynamic_offsets);
-
-                        mRHI->CmdDrawIndexed(mRHI->GetCurrentCommandBuffer(),
-                                                 mesh.mesh_index_count,
-                                                 current_instance_count,
-                                                 0,
-                                                 0,
-                                                 0);
+                        MeshDrawCommand& draw_command = mMeshDrawCommands.emplace_back();
+                        draw_command.material           = material;
+                        draw_command.mesh               = &mesh;
+                        draw_command.mesh_lod           = &mesh_lod;
+                        draw_command.instance_count     = current_instance_count;
+                        draw_command.dynamic_offsets[0] = perframe_dynamic_offset;
+                        draw_command.dynamic_offsets[1] = perdrawcall_dynamic_offset;
+                        draw_command.dynamic_offsets[2] = per_drawcall_vertex_blending_dynamic_offset;
+                        draw_command.dynamic_offsets[3] = mLightClusterDynamicOffsets[0];
+                        draw_command.dynamic_offsets[4] = mLightClusterDynamicOffsets[1];
+                        draw_command.dynamic_offsets[5] = mLightClusterDynamicOffsets[2];
                     }
                 }
             }
         }
 
-        mRHI->PopEvent(mRHI->GetCurrentCommandBuffer());
+        // fetched after the allocations above, the page it points into holds every one of them
+        mMeshGlobalDescriptorSet = upload_buffer.GetDescriptorSet(mMeshGlobalUploadDescriptorID);
     }
 
-    void MainCameraPass::drawDeferredLighting()
+    uint32_t MainCameraPass::getMeshRecorderCount() const
     {
-        mRHI->CmdBindPipelinePFN(mRHI->GetCurrentCommandBuffer(),
-            RHI_PIPELINE_BIND_POINT_GRAPHICS,
-            mRenderPipelines[RenderPipelineType_DeferredLighting].pipeline);
-
-        mRHI->CmdSetViewportPFN(mRHI->GetCurrentCommandBuffer(), 0, 1, mRHI->GetSwapChainInfo().viewport);
-        mRHI->CmdSetScissorPFN(mRHI->GetCurrentCommandBuffer(), 0, 1, mRHI->GetSwapChainInfo().scissor);
-
-        uint32_t perframe_dynamic_offset =
-            RoundUp(mGlobalRenderResource->mStorageBuffer
-                        .mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()],
-                    mGlobalRenderResource->mStorageBuffer.mMinStorageBufferOffsetAlignment);
-
-        mGlobalRenderResource->mStorageBuffer.mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()] =
-            perframe_dynamic_offset + sizeof(MeshPerframeStorageBufferObject);
-        assert(mGlobalRenderResource->mStorageBuffer
-                   .mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()] <=
-               (mGlobalRenderResource->mStorageBuffer
-                    .mGlobalUploadRingbuffersBegin[mRHI->GetCurrentFrameIndex()] +
-                mGlobalRenderResource->mStorageBuffer
-                    .mGlobalUploadRingbuffersSize[mRHI->GetCurrentFrameIndex()]));
-
-        (*reinterpret_cast<MeshPerframeStorageBufferObject*>(
-            reinterpret_cast<uintptr_t>(
-                mGlobalRenderResource->mStorageBuffer.mGlobalUploadRingbufferMemoryPointer) +
-            perframe_dynamic_offset)) = mPerFrameStorageBufferObject;
-
-        RHIDescriptorSet* descriptor_sets[3] = {mDescInfos[LayoutType_MeshGlobal].descriptorSet,
-                                              mDescInfos[LayoutType_DeferredLighting].descriptorSet,
-                                              mDescInfos[LayoutType_Skybox].descriptorSet};
-        uint32_t        dynamic_offsets[4] = {perframe_dynamic_offset, perframe_dynamic_offset, 0, 0};
-        mRHI->CmdBindDescriptorSetsPFN(mRHI->GetCurrentCommandBuffer(),
-                                        RHI_PIPELINE_BIND_POINT_GRAPHICS,
-                                        mRenderPipelines[RenderPipelineType_DeferredLighting].layout,
-                                        0,
-                                        3,
-                                        descriptor_sets,
-                                        4,
-                                        dynamic_offsets);
-
-        mRHI->CmdDraw(mRHI->GetCurrentCommandBuffer(), 3, 1, 0, 0);
+        // one recorder is kept for the draws following the meshes in the same subpass
+        uint32_t max_recorder_count = std::min(gRuntimeGlobalContext.mThreadPool->GetThreadCount() + 1,
+                                               mRHI->GetMaxSecondaryCommandRecorderCount() - 1);
+        uint32_t recorder_count =
+            std::min(static_cast<uint32_t>(mMeshDrawCommands.size()) / s_min_draw_count_per_recorder, max_recorder_count);
+        return recorder_count > 1 ? recorder_count : 0;
     }
 
-    void MainCameraPass::drawMeshLighting()
+    void MainCameraPass::recordMeshDrawCommands(RHICommandBuffer*  command_buffer,
+                                                RenderPipelineType pipeline_type,
+                                                uint32_t           begin,
+                                                uint32_t           end,
+                                                const RHIViewport* viewport,
+                                                const RHIRect2D*   scissor)
     {
-        struct MeshNode
-        {
-            const Matrix4x4* model_matrix {nullptr};
-            const Matrix4x4* joint_matrices {nullptr};
-            uint32_t         joint_count {0};
-        };
+        const RenderPipelineBase& render_pipeline = mRenderPipelines[pipeline_type];
 
-        std::map<VulkanPBRMaterial*, std::map<VulkanMesh*, std::vector<MeshNode>>> main_camera_mesh_drawcall_batch;
+        mRHI->CmdBindPipelinePFN(command_buffer, RHI_PIPELINE_BIND_POINT_GRAPHICS, render_pipeline.pipeline);
+        mRHI->CmdSetViewportPFN(command_buffer, 0, 1, viewport);
+        mRHI->CmdSetScissorPFN(command_buffer, 0, 1, scissor);
 
-        // reorganize mesh
-        for (RenderMeshNode& node : *(mVisibleNodes.mMainCameraVisibleMeshNodes))
+        // the bindless set holds every material, it is bound once
+        if (mbEnableBindlessMaterials)
+        {
+            mRHI->CmdBindDescriptorSetsPFN(command_buffer,
+                                            RHI_PIPELINE_BIND_POINT_GRAPHICS,
+                                            render_pipeline.layout,
+                                            2,
+                                            1,
+                                            &mGlobalRenderResource->mBindlessMaterial.mDescriptorSet,
+                                            0,
+                                            nullptr);
+        }
+
+        // the commands are sorted by material then mesh, so these only change at batch boundaries
+        const VulkanPBRMaterial* bound_material = nullptr;
+        const VulkanMesh*        bound_mesh     = nullptr;
+        for (uint32_t draw_index = begin; draw_index < end; ++draw_index)
         {
-            auto& mesh_instanced = main_camera_mesh_drawcall_batch[node.ref_material];
-            auto& mesh_nodes     = mesh_instanced[node.ref_mesh];
+            const MeshDrawCommand& draw_command = mMeshDrawCommands[draw_index];
 
-            MeshNode temp;
-            temp.model_matrix = node.model_matrix;
-            if (node.enable_vertex_blending)
+            // bind per material
+            if (!mbEnableBindlessMaterials && draw_command.material != bound_material)
             {
-                temp.joint_matrices = node.joint_matrices;
-                temp.joint_count    = node.joint_count;
+                mRHI->CmdBindDescriptorSetsPFN(command_buffer,
+                                                RHI_PIPELINE_BIND_POINT_GRAPHICS,
+                                                render_pipeline.layout,
+                                                2,
+                                                1,
+                                                &draw_command.material->material_descriptor_set,
+                                                0,
+                                                nullptr);
+                bound_material = draw_command.material;
             }
 
-            mesh_nodes.push_back(temp);
+            // bind per mesh
+            if (draw_command.mesh != bound_mesh)
+            {
+                VulkanMesh& mesh = *draw_command.mesh;
+                mRHI->CmdBindDescriptorSetsPFN(command_buffer,
+                                                RHI_PIPELINE_BIND_POINT_GRAPHICS,
+                                                render_pipeline.layout,
+                                                1,
+                                                1,
+                                                &mesh.mesh_vertex_blending_descriptor_set,
+                                                0,
+                                                nullptr);
+
+                RHIBuffer*    vertex_buffers[3] = {mesh.mesh_vertex_position_buffer,
+                                                 mesh.mesh_vertex_varying_enable_blending_buffer,
+                                                 mesh.mesh_vertex_varying_buffer};
+                RHIDeviceSize offsets[3]        = {0, 0, 0};
+                mRHI->CmdBindVertexBuffersPFN(command_buffer,
+                                               0,
+                                               (sizeof(vertex_buffers) / sizeof(vertex_buffers[0])),
+                                               vertex_buffers,
+                                               offsets);
+                mRHI->CmdBindIndexBufferPFN(command_buffer, mesh.mesh_index_buffer, 0, mesh.mesh_index_type);
+                bound_mesh = draw_command.mesh;
+            }
+
+            // bind perdrawcall
+            mRHI->CmdBindDescriptorSetsPFN(command_buffer,
+                                            RHI_PIPELINE_BIND_POINT_GRAPHICS,
+                                            render_pipeline.layout,
+                                            0,
+                                            1,
+                                            &mMeshGlobalDescriptorSet,
+                                            6,
+                                            draw_command.dynamic_offsets);
+
+            mRHI->CmdDrawIndexed(command_buffer,
+                                 draw_command.mesh_lod->mIndexCount,
+                                 draw_command.instance_count,
+                                 draw_command.mesh_lod->mIndexOffset,
+                                 0,
+                                 0);
         }
+    }
 
-        float color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
-        mRHI->PushEvent(mRHI->GetCurrentCommandBuffer(), "Model", color);
+    void MainCameraPass::executeMeshDrawCommandsParallel(RenderPipelineType pipeline_type,
+                                                         uint32_t           subpass,
+                                                         const char*        event_name,
+                                                         uint32_t           recorder_count,
+                                                         uint32_t           swapchain_index,
+                                                         bool               draw_skybox)
+    {
+        PROFILE_SCOPE("MainCameraPass::executeMeshDrawCommandsParallel");
 
-        mRHI->CmdBindPipelinePFN(mRHI->GetCurrentCommandBuffer(),
-                                  RHI_PIPELINE_BIND_POINT_GRAPHICS,
-                                  mRenderPipelines[RenderPipelineType_MeshLighting].pipeline);
-        mRHI->CmdSetViewportPFN(mRHI->GetCurrentCommandBuffer(), 0, 1, mRHI->GetSwapChainInfo().viewport);
-        mRHI->CmdSetScissorPFN(mRHI->GetCurrentCommandBuffer(), 0, 1, mRHI->GetSwapChainInfo().scissor);
+        RHIFrameBuffer*  framebuffer    = mSwapChainFrameBuffers[swapchain_index];
+        RHISwapChainDesc swapchain_info = mRHI->GetSwapChainInfo();
 
-        // perframe storage buffer
-        uint32_t perframe_dynamic_offset =
-            RoundUp(mGlobalRenderResource->mStorageBuffer
-                        .mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()],
-                    mGlobalRenderResource->mStorageBuffer.mMinStorageBufferOffsetAlignment);
-
-        mGlobalRenderResource->mStorageBuffer.mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()] =
-            perframe_dynamic_offset + sizeof(MeshPerframeStorageBufferObject);
-        assert(mGlobalRenderResource->mStorageBuffer
-                   .mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()] <=
-               (mGlobalRenderResource->mStorageBuffer
-                    .mGlobalUploadRingbuffersBegin[mRHI->GetCurrentFrameIndex()] +
-                mGlobalRenderResource->mStorageBuffer
-                    .mGlobalUploadRingbuffersSize[mRHI->GetCurrentFrameIndex()]));
-
-        (*reinterpret_cast<MeshPerframeStorageBufferObject*>(
-            reinterpret_cast<uintptr_t>(
-                mGlobalRenderResource->mStorageBuffer.mGlobalUploadRingbufferMemoryPointer) +
-            perframe_dynamic_offset)) = mPerFrameStorageBufferObject;
+        std::pmr::vector<RHICommandBuffer*> secondary_command_buffers(
+            recorder_count, nullptr, gRuntimeGlobalContext.mFrameAllocator->GetResource());
 
-        for (auto& pair1 : main_camera_mesh_drawcall_batch)
+        // every recorder takes a contiguous range of the sorted commands, so each keeps most of its binds
+        uint32_t draw_count              = static_cast<uint32_t>(mMeshDrawCommands.size());
+        uint32_t draw_count_per_recorder = RoundUp(draw_count, recorder_count) / recorder_count;
+        gRuntimeGlobalContext.mThreadPool->ParallelFor(recorder_count, 1, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t recorder_index = begin; recorder_index < end; ++recorder_index)
+            {
+                RHICommandBuffer* command_buffer =
+                    mRHI->BeginSecondaryCommandBuffer(recorder_index, mFrameBuffer.renderPass, subpass, framebuffer);
+                if (command_buffer == nullptr)
+                {
+                    continue;
+                }
+
+                float color[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+                mRHI->PushEvent(command_buffer, event_name, color);
+                recordMeshDrawCommands(command_buffer,
+                                       pipeline_type,
+                                       std::min(recorder_index * draw_count_per_recorder, draw_count),
+                                       std::min((recorder_index + 1) * draw_count_per_recorder, draw_count),
+                                       swapchain_info.viewport,
+                                       swapchain_info.scissor);
+                mRHI->PopEvent(command_buffer);
+                mRHI->EndCommandBufferPFN(command_buffer);
+
+                secondary_command_buffers[recorder_index] = command_buffer;
+            }
+        });
+
+        if (draw_skybox)
         {
-            VulkanPBRMaterial& material       = (*pair1.first);
-            auto&              mesh_instanced = pair1.second;
+            RHICommandBuffer* command_buffer =
+                mRHI->BeginSecondaryCommandBuffer(recorder_count, mFrameBuffer.renderPass, subpass, framebuffer);
+            if (command_buffer != nullptr)
+            {
+                mRHI->CmdSetViewportPFN(command_buffer, 0, 1, swapchain_info.viewport);
+                mRHI->CmdSetScissorPFN(command_buffer, 0, 1, swapchain_info.scissor);
+                drawSkybox(command_buffer);
+                mRHI->EndCommandBufferPFN(command_buffer);
+                secondary_command_buffers.push_back(command_buffer);
+            }
+        }
 
-            // bind per material
-            mRHI->CmdBindDescriptorSetsPFN(mRHI->GetCurrentCommandBuffer(),
-                                            RHI_PIPELINE_BIND_POINT_GRAPHICS,
-                                            mRenderPipelines[RenderPipelineType_MeshLighting].layout,
-                                            2,
-                                            1,
-                                            &material.material_descriptor_set,
-                                            0,
-                                            nullptr);
+        secondary_command_buffers.erase(
+            std::remove(secondary_command_buffers.begin(), secondary_command_buffers.end(), nullptr),
+            secondary_command_buffers.end());
+        mRHI->CmdExecuteCommandsPFN(mRHI->GetCurrentCommandBuffer(),
+                                    static_cast<uint32_t>(secondary_command_buffers.size()),
+                                    secondary_command_buffers.data());
+    }
 
-            // TODO: render from near to far
+    void MainCameraPass::drawMeshGBuffer()
+    {
+        float color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+        mRHI->PushEvent(mRHI->GetCurrentCommandBuffer(), "Mesh GBuffer", color);
 
-            for (auto& pair2 : mesh_instanced)
-            {
-                VulkanMesh& mesh       = (*pair2.first);
-                auto&       mesh_nodes = pair2.second;
+        recordMeshDrawCommands(mRHI->GetCurrentCommandBuffer(),
+                               RenderPipelineType_MeshGBuffer,
+                               0,
+                               static_cast<uint32_t>(mMeshDrawCommands.size()),
+                               mRHI->GetSwapChainInfo().viewport,
+                               mRHI->GetSwapChainInfo().scissor);
 
-                uint32_t total_instance_count = static_cast<uint32_t>(mesh_nodes.size());
-                if (total_instance_count > 0)
-                {
-                    // bind per mesh
-                    mRHI->CmdBindDescriptorSetsPFN(mRHI->GetCurrentCommandBuffer(),
-                                                    RHI_PIPELINE_BIND_POINT_GRAPHICS,
-                                                    mRenderPipelines[RenderPipelineType_MeshLighting].layout,
-                                                    1,
-                                                    1,
-                                                    &mesh.mesh_vertex_blending_descriptor_set,
-                                                    0,
-                                                    nullptr);
-
-                    RHIBuffer*     vertex_buffers[3] = {mesh.mesh_vertex_position_buffer,
-                                                 mesh.mesh_vertex_varying_enable_blending_buffer,
-                                                 mesh.mesh_vertex_varying_buffer};
-                    RHIDeviceSize offsets[]        = {0, 0, 0};
-                    mRHI->CmdBindVertexBuffersPFN(mRHI->GetCurrentCommandBuffer(),
-                                                   0,
-                                                   (sizeof(vertex_buffers) / sizeof(vertex_buffers[0])),
-                                                   vertex_buffers,
-                                                   offsets);
-                    mRHI->CmdBindIndexBufferPFN(mRHI->GetCurrentCommandBuffer(), mesh.mesh_index_buffer, 0, RHI_INDEX_TYPE_UINT16);
+        mRHI->PopEvent(mRHI->GetCurrentCommandBuffer());
+    }
 
-                    uint32_t drawcall_max_instance_count =
-                        (sizeof(MeshPerdrawcallStorageBufferObject::mesh_instances) /
-                         sizeof(MeshPerdrawcallStorageBufferObject::mesh_instances[0]));
-                    uint32_t drawcall_count =
-                        RoundUp(total_instance_count, drawcall_max_instance_count) / drawcall_max_instance_count;
+    void MainCameraPass::drawDeferredLighting()
+    {
+        mRHI->CmdBindPipelinePFN(mRHI->GetCurrentCommandBuffer(),
+            RHI_PIPELINE_BIND_POINT_GRAPHICS,
+            mRenderPipelines[RenderPipelineType_DeferredLighting].pipeline);
 
-                    for (uint32_t drawcall_index = 0; drawcall_index < drawcall_count; ++drawcall_index)
-                    {
-                        uint32_t current_instance_count =
-                            ((total_instance_count - drawcall_max_instance_count * drawcall_index) <
-                             drawcall_max_instance_count) ?
-                                (total_instance_count - drawcall_max_instance_count * drawcall_index) :
-                                drawcall_max_instance_count;
+        mRHI->CmdSetViewportPFN(mRHI->GetCurrentCommandBuffer(), 0, 1, mRHI->GetSwapChainInfo().viewport);
+        mRHI->CmdSetScissorPFN(mRHI->GetCurrentCommandBuffer(), 0, 1, mRHI->GetSwapChainInfo().scissor);
 
-                        // per drawcall storage buffer
-                        uint32_t perdrawcall_dynamic_offset =
-                            RoundUp(mGlobalRenderResource->mStorageBuffer
-                                        .mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()],
-                                    mGlobalRenderResource->mStorageBuffer.mMinStorageBufferOffsetAlignment);
-                        mGlobalRenderResource->mStorageBuffer
-                            .mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()] =
-                            perdrawcall_dynamic_offset + sizeof(MeshPerdrawcallStorageBufferObject);
-                        assert(mGlobalRenderResource->mStorageBuffer
-                                   .mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()] <=
-                               (mGlobalRenderResource->mStorageBuffer
-                                    .mGlobalUploadRingbuffersBegin[mRHI->GetCurrentFrameIndex()] +
-                                mGlobalRenderResource->mStorageBuffer
-                                    .mGlobalUploadRingbuffersSize[mRHI->GetCurrentFrameIndex()]));
+        UploadBufferAllocator& upload_buffer = mGlobalRenderResource->mStorageBuffer.mGlobalUploadBuffer;
 
-                        MeshPerdrawcallStorageBufferObject& perdrawcall_storage_buffer_object =
-                            (*reinterpret_cast<MeshPerdrawcallStorageBufferObject*>(
-                                reinterpret_cast<uintptr_t>(mGlobalRenderResource->mStorageBuffer
-                                                                .mGlobalUploadRingbufferMemoryPointer) +
-                                perdrawcall_dynamic_offset));
-                        for (uint32_t i = 0; i < current_instance_count; ++i)
-                        {
-                            perdrawcall_storage_buffer_object.mesh_instances[i].model_matrix =
-                                *mesh_nodes[drawcall_max_instance_count * drawcall_index + i].model_matrix;
-                            perdrawcall_storage_buffer_object.mesh_instances[i].enable_vertex_blending =
-                                mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices ? 1.0 :
-                                                                                                              -1.0;
-                        }
+        uint32_t perframe_dynamic_offset;
+        *upload_buffer.Allocate<MeshPerframeStorageBufferObject>(
+            perframe_dynamic_offset) = mPerFrameStorageBufferObject;
 
-                        // per drawcall vertex blending storage buffer
-                        uint32_t per_drawcall_vertex_blending_dynamic_offset;
-                        bool     least_one_enable_vertex_blending = true;
-                        for (uint32_t i = 0; i < current_instance_count; ++i)
-                        {
-                            if (!mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices)
-                            {
-                                least_one_enable_vertex_blending = false;
-                                break;
-                            }
-                        }
-                        if (least_one_enable_vertex_blending)
-                        {
-                            per_drawcall_vertex_blending_dynamic_offset =
-                                RoundUp(mGlobalRenderResource->mStorageBuffer
-                                            .mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()],
-                                        mGlobalRenderResource->mStorageBuffer.mMinStorageBufferOffsetAlignment);
-                            mGlobalRenderResource->mStorageBuffer
-                                .mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()] =
-                                per_drawcall_vertex_blending_dynamic_offset +
-                                sizeof(MeshPerdrawcallVertexBlendingStorageBufferObject);
-                            assert(mGlobalRenderResource->mStorageBuffer
-                                       .mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()] <=
-                                   (mGlobalRenderResource->mStorageBuffer
-                                        .mGlobalUploadRingbuffersBegin[mRHI->GetCurrentFrameIndex()] +
-                                    mGlobalRenderResource->mStorageBuffer
-                                        .mGlobalUploadRingbuffersSize[mRHI->GetCurrentFrameIndex()]));
+        RHIDescriptorSet* descriptor_sets[3] = {upload_buffer.GetDescriptorSet(mMeshGlobalUploadDescriptorID),
+                                              mDescInfos[LayoutType_DeferredLighting].descriptorSet,
+                                              upload_buffer.GetDescriptorSet(mSkyboxUploadDescriptorID)};
+        uint32_t        dynamic_offsets[7] = {perframe_dynamic_offset,
+                                              perframe_dynamic_offset,
+                                              0,
+                                              mLightClusterDynamicOffsets[0],
+                                              mLightClusterDynamicOffsets[1],
+                                              mLightClusterDynamicOffsets[2],
+                                              0};
+        mRHI->CmdBindDescriptorSetsPFN(mRHI->GetCurrentCommandBuffer(),
+                                        RHI_PIPELINE_BIND_POINT_GRAPHICS,
+                                        mRenderPipelines[RenderPipelineType_DeferredLighting].layout,
+                                        0,
+                                        3,
+                                        descriptor_sets,
+                                        7,
+                                        dynamic_offsets);
 
-                            MeshPerdrawcallVertexBlendingStorageBufferObject&
-                                per_drawcall_vertex_blending_storage_buffer_object =
-                                    (*reinterpret_cast<MeshPerdrawcallVertexBlendingStorageBufferObject*>(
-                                        reinterpret_cast<uintptr_t>(mGlobalRenderResource->mStorageBuffer
-                                                                        .mGlobalUploadRingbufferMemoryPointer) +
-                                        per_drawcall_vertex_blending_dynamic_offset));
-                            for (uint32_t i = 0; i < current_instance_count; ++i)
-                            {
-                                if (mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_matrices)
-                                {
-                                    for (uint32_t j = 0;
-                                         j < mesh_nodes[drawcall_max_instance_count * drawcall_index + i].joint_count;
-                                         ++j)
-                                    {
-                                        per_drawcall_vertex_blending_storage_buffer_object
-                                            .joint_matrices[s_mesh_vertex_blending_max_joint_count * i + j] =
-                                            mesh_nodes[drawcall_max_instance_count * drawcall_index + i]
-                                                .joint_matrices[j];
-                                    }
-                                }
-                            }
-                        }
-                        else
-                        {
-                            per_drawcall_vertex_blending_dynamic_offset = 0;
-                        }
+        mRHI->CmdDraw(mRHI->GetCurrentCommandBuffer(), 3, 1, 0, 0);
+    }
 
-                        // bind perdrawcall
-                        uint32_t dynamic_offsets[3] = {perframe_dynamic_offset,
-                                                       perdrawcall_dynamic_offset,
-                                                       per_drawcall_vertex_blending_dynamic_offset};
-                        mRHI->CmdBindDescriptorSetsPFN(mRHI->GetCurrentCommandBuffer(),
-                                                        RHI_PIPELINE_BIND_POINT_GRAPHICS,
-                                                        mRenderPipelines[RenderPipelineType_MeshLighting].layout,
-                                                        0,
-                                                        1,
-                                                        &mDescInfos[LayoutType_MeshGlobal].descriptorSet,
-                                                        3,
-                                                        dynamic_offsets);
-
-                        mRHI->CmdDrawIndexed(mRHI->GetCurrentCommandBuffer(),
-                                                 mesh.mesh_index_count,
-                                                 current_instance_count,
-                                                 0,
-                                                 0,
-                                                 0);
-                    }
-                }
-            }
-        }
+    void MainCameraPass::drawMeshLighting()
+    {
+        float color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+        mRHI->PushEvent(mRHI->GetCurrentCommandBuffer(), "Model", color);
+
+        recordMeshDrawCommands(mRHI->GetCurrentCommandBuffer(),
+                               RenderPipelineType_MeshLighting,
+                               0,
+                               static_cast<uint32_t>(mMeshDrawCommands.size()),
+                               mRHI->GetSwapChainInfo().viewport,
+                               mRHI->GetSwapChainInfo().scissor);
 
         mRHI->PopEvent(mRHI->GetCurrentCommandBuffer());
     }
 
-    void MainCameraPass::drawSkybox()
+    void MainCameraPass::drawSkybox(RHICommandBuffer* command_buffer)
     {
-        uint32_t perframe_dynamic_offset =
-            RoundUp(mGlobalRenderResource->mStorageBuffer
-                        .mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()],
-                    mGlobalRenderResource->mStorageBuffer.mMinStorageBufferOffsetAlignment);
-
-        mGlobalRenderResource->mStorageBuffer.mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()] =
-            perframe_dynamic_offset + sizeof(MeshPerframeStorageBufferObject);
-        assert(mGlobalRenderResource->mStorageBuffer
-                   .mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()] <=
-               (mGlobalRenderResource->mStorageBuffer
-                    .mGlobalUploadRingbuffersBegin[mRHI->GetCurrentFrameIndex()] +
-                mGlobalRenderResource->mStorageBuffer
-                    .mGlobalUploadRingbuffersSize[mRHI->GetCurrentFrameIndex()]));
-
-        (*reinterpret_cast<MeshPerframeStorageBufferObject*>(
-            reinterpret_cast<uintptr_t>(
-                mGlobalRenderResource->mStorageBuffer.mGlobalUploadRingbufferMemoryPointer) +
-            perframe_dynamic_offset)) = mPerFrameStorageBufferObject;
+        UploadBufferAllocator& upload_buffer = mGlobalRenderResource->mStorageBuffer.mGlobalUploadBuffer;
+
+        uint32_t perframe_dynamic_offset;
+        *upload_buffer.Allocate<MeshPerframeStorageBufferObject>(
+            perframe_dynamic_offset) = mPerFrameStorageBufferObject;
 
         float color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
-        mRHI->PushEvent(mRHI->GetCurrentCommandBuffer(), "Skybox", color);
+        mRHI->PushEvent(command_buffer, "Skybox", color);
 
-        mRHI->CmdBindPipelinePFN(mRHI->GetCurrentCommandBuffer(),
+        mRHI->CmdBindPipelinePFN(command_buffer,
                                   RHI_PIPELINE_BIND_POINT_GRAPHICS,
                                   mRenderPipelines[RenderPipelineType_Skybox].pipeline);
-        mRHI->CmdBindDescriptorSetsPFN(mRHI->GetCurrentCommandBuffer(),
+        RHIDescriptorSet* skybox_descriptor_set = upload_buffer.GetDescriptorSet(mSkyboxUploadDescriptorID);
+        mRHI->CmdBindDescriptorSetsPFN(command_buffer,
                                         RHI_PIPELINE_BIND_POINT_GRAPHICS,
                                         mRenderPipelines[RenderPipelineType_Skybox].layout,
                                         0,
                                         1,
-                                        &mDescInfos[LayoutType_Skybox].descriptorSet,
+                                        &skybox_descriptor_set,
                                         1,
                                         &perframe_dynamic_offset);
-        mRHI->CmdDraw(mRHI->GetCurrentCommandBuffer(), 36, 1, 0, 0); // 2 triangles(6 vertex) each face, 6 faces
+        mRHI->CmdDraw(command_buffer, 36, 1, 0, 0); // 2 triangles(6 vertex) each face, 6 faces
 
-        mRHI->PopEvent(mRHI->GetCurrentCommandBuffer());
+        mRHI->PopEvent(command_buffer);
     }
 
     void MainCameraPass::drawAxis()
@@ -2469,24 +2526,11 @@ namespace MiniEngine
         if (!mbIsShowAxis)
             return;
 
-        uint32_t perframe_dynamic_offset =
-            RoundUp(mGlobalRenderResource->mStorageBuffer
-                        .mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()],
-                    mGlobalRenderResource->mStorageBuffer.mMinStorageBufferOffsetAlignment);
-
-        mGlobalRenderResource->mStorageBuffer.mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()] =
-            perframe_dynamic_offset + sizeof(MeshPerframeStorageBufferObject);
-        assert(mGlobalRenderResource->mStorageBuffer
-                   .mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()] <=
-               (mGlobalRenderResource->mStorageBuffer
-                    .mGlobalUploadRingbuffersBegin[mRHI->GetCurrentFrameIndex()] +
-                mGlobalRenderResource->mStorageBuffer
-                    .mGlobalUploadRingbuffersSize[mRHI->GetCurrentFrameIndex()]));
-
-        (*reinterpret_cast<MeshPerframeStorageBufferObject*>(
-            reinterpret_cast<uintptr_t>(
-                mGlobalRenderResource->mStorageBuffer.mGlobalUploadRingbufferMemoryPointer) +
-            perframe_dynamic_offset)) = mPerFrameStorageBufferObject;
+        UploadBufferAllocator& upload_buffer = mGlobalRenderResource->mStorageBuffer.mGlobalUploadBuffer;
+
+        uint32_t perframe_dynamic_offset;
+        *upload_buffer.Allocate<MeshPerframeStorageBufferObject>(
+            perframe_dynamic_offset) = mPerFrameStorageBufferObject;
 
         float color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
         mRHI->PushEvent(mRHI->GetCurrentCommandBuffer(), "Axis", color);
@@ -2496,17 +2540,19 @@ namespace MiniEngine
                                   mRenderPipelines[RenderPipelineType_Axis].pipeline);
         mRHI->CmdSetViewportPFN(mRHI->GetCurrentCommandBuffer(), 0, 1, mRHI->GetSwapChainInfo().viewport);
         mRHI->CmdSetScissorPFN(mRHI->GetCurrentCommandBuffer(), 0, 1, mRHI->GetSwapChainInfo().scissor);
+        RHIDescriptorSet* axis_descriptor_set = upload_buffer.GetDescriptorSet(mAxisUploadDescriptorID);
         mRHI->CmdBindDescriptorSetsPFN(mRHI->GetCurrentCommandBuffer(),
                                         RHI_PIPELINE_BIND_POINT_GRAPHICS,
                                         mRenderPipelines[RenderPipelineType_Axis].layout,
                                         0,
                                         1,
-                                        &mDescInfos[LayoutType_Axis].descriptorSet,
+                                        &axis_descriptor_set,
                                         1,
                                         &perframe_dynamic_offset);
 
-        mAxisStorageBufferObject.selected_axis = mSelectedAxis;
-        mAxisStorageBufferObject.model_matrix  = mVisibleNodes.mAxisNode->model_matrix;
+        mAxisStorageBufferObject.selected_axis      = mSelectedAxis;
+        mAxisStorageBufferObject.model_matrix       = mVisibleNodes.mAxisNode->model_matrix;
+        mAxisStorageBufferObject.mesh_vertex_decode = mVisibleNodes.mAxisNode->ref_mesh->mesh_vertex_decode;
 
         RHIBuffer*     vertex_buffers[3] = {mVisibleNodes.mAxisNode->ref_mesh->mesh_vertex_position_buffer,
                                      mVisibleNodes.mAxisNode->ref_mesh->mesh_vertex_varying_enable_blending_buffer,
@@ -2520,7 +2566,7 @@ namespace MiniEngine
         mRHI->CmdBindIndexBufferPFN(mRHI->GetCurrentCommandBuffer(),
                                      mVisibleNodes.mAxisNode->ref_mesh->mesh_index_buffer,
                                      0,
-                                     RHI_INDEX_TYPE_UINT16);
+                                     mVisibleNodes.mAxisNode->ref_mesh->mesh_index_type);
         (*reinterpret_cast<AxisStorageBufferObject*>(reinterpret_cast<uintptr_t>(
             mGlobalRenderResource->mStorageBuffer.mAxisInefficientStorageBufferMemoryPointer))) =
             mAxisStorageBufferObject;
@@ -14,6 +14,8 @@ namespace MiniEngine
     struct MainCameraPassInitInfo : RenderPassInitInfo
     {
         bool mbEnableFXAA;
+        bool mbEnableVertexQuantization;
+        bool mbEnableBindlessMaterials;
     };
 
     class MainCameraPass : public RenderPass
@@ -75,21 +77,61 @@ namespace MiniEngine
         void setupAxisDescriptorSet();
         void setupGBufferLightingDescriptorSet();
 
+        void uploadLightClusterData();
+        void prepareMeshDrawCommands();
+        // 0 when the meshes are recorded inline
+        uint32_t getMeshRecorderCount() const;
+        void recordMeshDrawCommands(RHICommandBuffer*  command_buffer,
+                                    RenderPipelineType pipeline_type,
+                                    uint32_t           begin,
+                                    uint32_t           end,
+                                    const RHIViewport* viewport,
+                                    const RHIRect2D*   scissor);
+        void executeMeshDrawCommandsParallel(RenderPipelineType pipeline_type,
+                                             uint32_t           subpass,
+                                             const char*        event_name,
+                                             uint32_t           recorder_count,
+                                             uint32_t           swapchain_index,
+                                             bool               draw_skybox);
         void drawMeshGBuffer();
         void drawDeferredLighting();
         void drawMeshLighting();
-        void drawSkybox();
+        void drawSkybox(RHICommandBuffer* command_buffer);
         void drawAxis();
 
     public:
         RHIImageView* mDirectionalLightShadowColorImageView;
         bool mbIsShowAxis{false};
         bool mbEnableFXAA{false};
+        bool mbEnableVertexQuantization{false};
+        // one material buffer and texture array at set 2, draws are only grouped by mesh
+        bool mbEnableBindlessMaterials{false};
         size_t mSelectedAxis{3};
         MeshPerframeStorageBufferObject mPerFrameStorageBufferObject;
         AxisStorageBufferObject mAxisStorageBufferObject;
 
     private:
         std::vector<RHIFrameBuffer*> mSwapChainFrameBuffers;
+
+        // one draw call of the main camera meshes, uploaded before recording so recorders only read them
+        struct MeshDrawCommand
+        {
+            // null on the bindless path
+            VulkanPBRMaterial* material {nullptr};
+            VulkanMesh*        mesh {nullptr};
+            const MeshLod*     mesh_lod {nullptr};
+            uint32_t           instance_count {0};
+            uint32_t           dynamic_offsets[6] {};
+        };
+        std::vector<MeshDrawCommand> mMeshDrawCommands;
+        RHIDescriptorSet*            mMeshGlobalDescriptorSet {nullptr};
+
+        const LightClusterBuilder* mLightClusterBuilder {nullptr};
+        uint32_t                   mLightClusterDynamicOffsets[3] {0, 0, 0};
+
+        // sets reading the upload buffer exist per upload page
+        uint32_t mMeshGlobalUploadDescriptorID {0};
+        uint32_t mSkyboxUploadDescriptorID {0};
+        uint32_t mAxisUploadDescriptorID {0};
     };
 }
\ No newline at end of file
@@ -4,6 +4,9 @@
 #include "MRuntime/Function/Render/RenderMesh.hpp"
 #include "MRuntime/Function/Render/Interface/Vulkan/VulkanRHI.hpp"
 #include "MRuntime/Function/Render/Interface/Vulkan/VulkanUtil.hpp"
+#include "MRuntime/Function/Global/GlobalContext.hpp"
+#include "MRuntime/Core/Memory/FrameAllocator.hpp"
+#include "MRuntime/Core/Profiler/Profiler.hpp"
 
 #include <map>
 #include <stdexcept>
@@ -19,6 +22,7 @@ namespace MiniEngine
 
         const PickPassInitInfo* pickPassInitInfo = static_cast<const PickPassInitInfo*>(initInfo);
         mPerMeshLayout = pickPassInitInfo->mPerMeshLayout;
+        mbEnableVertexQuantization = pickPassInitInfo->mbEnableVertexQuantization;
 
         setupAttachments();
         setupRenderPass();
@@ -49,6 +53,8 @@ namespace MiniEngine
 
     uint32_t PickPass::Pick(const Vector2 &pickedUV)
     {
+        PROFILE_SCOPE("PickPass::Pick");
+
         uint32_t pixel_x =
             static_cast<uint32_t>(pickedUV.x * mRHI->GetSwapChainInfo().viewport->width + mRHI->GetSwapChainInfo().viewport->x);
         uint32_t pixel_y =
@@ -65,7 +71,9 @@ namespace MiniEngine
             uint32_t         node_id;
         };
 
-        std::map<VulkanPBRMaterial*, std::map<VulkanMesh*, std::vector<MeshNode>>> main_camera_mesh_drawcall_batch;
+        // frame memory, rebuilt every frame without touching the heap
+        std::pmr::map<VulkanPBRMaterial*, std::pmr::map<VulkanMesh*, std::pmr::vector<MeshNode>>>
+            main_camera_mesh_drawcall_batch(gRuntimeGlobalContext.mFrameAllocator->GetResource());
 
         // reorganize mesh
         for (RenderMeshNode& node : *(mVisibleNodes.mMainCameraVisibleMeshNodes))
@@ -87,12 +95,10 @@ namespace MiniEngine
 
         mRHI->PrepareContext();
 
-        // reset storage buffer offset
-        mGlobalRenderResource->mStorageBuffer.mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()] =
-            mGlobalRenderResource->mStorageBuffer.mGlobalUploadRingbuffersBegin[mRHI->GetCurrentFrameIndex()];
-
         mRHI->WaitForFences();
 
+        mGlobalRenderResource->mStorageBuffer.mGlobalUploadBuffer.BeginFrame(mRHI->GetCurrentFrameIndex());
+
         mRHI->ResetCommandPool();
 
         RHICommandBufferBeginInfo command_buffer_begin_info {};
@@ -156,25 +162,12 @@ namespace MiniEngine
         mRHI->CmdSetViewportPFN(mRHI->GetCurrentCommandBuffer(), 0, 1, mRHI->GetSwapChainInfo().viewport);
         mRHI->CmdSetScissorPFN(mRHI->GetCurrentCommandBuffer(), 0, 1, mRHI->GetSwapChainInfo().scissor);
 
+        UploadBufferAllocator& upload_buffer = mGlobalRenderResource->mStorageBuffer.mGlobalUploadBuffer;
+
         // perframe storage buffer
-        uint32_t perframe_dynamic_offset =
-            RoundUp(mGlobalRenderResource->mStorageBuffer
-                        .mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()],
-                    mGlobalRenderResource->mStorageBuffer.mMinStorageBufferOffsetAlignment);
-        mGlobalRenderResource->mStorageBuffer
-            .mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()] =
-            perframe_dynamic_offset + sizeof(MeshInefficientPickPerFrameStorageBufferObject);
-        assert(mGlobalRenderResource->mStorageBuffer
-                   .mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()] <=
-               (mGlobalRenderResource->mStorageBuffer
-                    .mGlobalUploadRingbuffersBegin[mRHI->GetCurrentFrameIndex()] +
-                mGlobalRenderResource->mStorageBuffer
-                    .mGlobalUploadRingbuffersSize[mRHI->GetCurrentFrameIndex()]));
-
-        (*reinterpret_cast<MeshInefficientPickPerFrameStorageBufferObject*>(
-            reinterpret_cast<uintptr_t>(
-                mGlobalRenderResource->mStorageBuffer.mGlobalUploadRingbufferMemoryPointer) +
-            perframe_dynamic_offset)) = mMeshInefficientPickPerFrameStorageBufferObject;
+        uint32_t perframe_dynamic_offset;
+        *upload_buffer.Allocate<MeshInefficientPickPerFrameStorageBufferObject>(
+            perframe_dynamic_offset) = mMeshInefficientPickPerFrameStorageBufferObject;
 
         for (auto& pair1 : main_camera_mesh_drawcall_batch)
         {
@@ -211,7 +204,7 @@ namespace MiniEngine
                     mRHI->CmdBindIndexBufferPFN(mRHI->GetCurrentCommandBuffer(),
                                                  mesh.mesh_index_buffer,
                                                  0,
-                                                 RHI_INDEX_TYPE_UINT16);
+                                                 mesh.mesh_index_type);
 
                     uint32_t drawcall_max_instance_count =
                         (sizeof(MeshInefficientPickPerDrawcallStorageBufferObject::model_matrices) /
@@ -228,25 +221,11 @@ namespace MiniEngine
                                 drawcall_max_instance_count;
 
                         // perdrawcall storage buffer
-                        uint32_t perdrawcall_dynamic_offset =
-                            RoundUp(mGlobalRenderResource->mStorageBuffer
-                                        .mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()],
-                                    mGlobalRenderResource->mStorageBuffer.mMinStorageBufferOffsetAlignment);
-                        mGlobalRenderResource->mStorageBuffer
-                            .mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()] =
-                            perdrawcall_dynamic_offset + sizeof(MeshInefficientPickPerDrawcallStorageBufferObject);
-                        assert(mGlobalRenderResource->mStorageBuffer
-                                   .mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()] <=
-                               (mGlobalRenderResource->mStorageBuffer
-                                    .mGlobalUploadRingbuffersBegin[mRHI->GetCurrentFrameIndex()] +
-                                mGlobalRenderResource->mStorageBuffer
-                                    .mGlobalUploadRingbuffersSize[mRHI->GetCurrentFrameIndex()]));
-
+                        uint32_t perdrawcall_dynamic_offset;
                         MeshInefficientPickPerDrawcallStorageBufferObject& perdrawcall_storage_buffer_object =
-                            (*reinterpret_cast<MeshInefficientPickPerDrawcallStorageBufferObject*>(
-                                reinterpret_cast<uintptr_t>(mGlobalRenderResource->mStorageBuffer
-                                                                .mGlobalUploadRingbufferMemoryPointer) +
-                                perdrawcall_dynamic_offset));
+                            *upload_buffer.Allocate<MeshInefficientPickPerDrawcallStorageBufferObject>(
+                                perdrawcall_dynamic_offset);
+                        perdrawcall_storage_buffer_object.mesh_vertex_decode = mesh.mesh_vertex_decode;
                         for (uint32_t i = 0; i < current_instance_count; ++i)
                         {
                             perdrawcall_storage_buffer_object.model_matrices[i] =
@@ -259,28 +238,10 @@ namespace MiniEngine
                         uint32_t per_drawcall_vertex_blending_dynamic_offset;
                         if (mesh.enable_vertex_blending)
                         {
-                            per_drawcall_vertex_blending_dynamic_offset =
-                                RoundUp(mGlobalRenderResource->mStorageBuffer
-                                            .mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()],
-                                        mGlobalRenderResource->mStorageBuffer.mMinStorageBufferOffsetAlignment);
-                            mGlobalRenderResource->mStorageBuffer
-                                .mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()] =
-                                per_drawcall_vertex_blending_dynamic_offset +
-                                sizeof(MeshInefficientPickPerDrawcallVertexBlendingStorageBufferObject);
-                            assert(mGlobalRenderResource->mStorageBuffer
-                                       .mGlobalUploadRingbuffersEnd[mRHI->GetCurrentFrameIndex()] <=
-                                   (mGlobalRenderResource->mStorageBuffer
-                                        .mGlobalUploadRingbuffersBegin[mRHI->GetCurrentFrameIndex()] +
-                                    mGlobalRenderResource->mStorageBuffer
-                                        .mGlobalUploadRingbuffersSize[mRHI->GetCurrentFrameIndex()]));
-
                             MeshInefficientPickPerDrawcallVertexBlendingStorageBufferObject&
                                 per_drawcall_vertex_blending_storage_buffer_object =
-                                    (*reinterpret_cast<
-                                        MeshInefficientPickPerDrawcallVertexBlendingStorageBufferObject*>(
-                                        reinterpret_cast<uintptr_t>(mGlobalRenderResource->mStorageBuffer
-                                                                        .mGlobalUploadRingbufferMemoryPointer) +
-                                        per_drawcall_vertex_blending_dynamic_offset));
+                                    *upload_buffer.Allocate<MeshInefficientPickPerDrawcallVertexBlendingStorageBufferObject>(
+                                        per_drawcall_vertex_blending_dynamic_offset);
                             for (uint32_t i = 0; i < current_instance_count; ++i)
                             {
                                 for (uint32_t j = 0;
@@ -298,7 +259,8 @@ namespace MiniEngine
                             per_drawcall_vertex_blending_dynamic_offset = 0;
                         }
 
-                        // bind perdrawcall
+                        // bind perdrawcall, the set of the page the offsets above point into
+                        RHIDescriptorSet* pick_global_descriptor_set = upload_buffer.GetDescriptorSet(mUploadDescriptorID);
                         uint32_t dynamic_offsets[3] = {perframe_dynamic_offset,
                                                        perdrawcall_dynamic_offset,
                                                        per_drawcall_vertex_blending_dynamic_offset};
@@ -307,7 +269,7 @@ namespace MiniEngine
                                                         mRenderPipelines[0].layout,
                                                         0,
                                                         1,
-                                                        &mDescInfos[0].descriptorSet,
+                                                        &pick_global_descriptor_set,
                                                         sizeof(dynamic_offsets) / sizeof(dynamic_offsets[0]),
                                                         dynamic_offsets);
 
@@ -624,8 +586,8 @@ namespace MiniEngine
         RHIPipelineShaderStageCreateInfo shader_stages[] = {vert_pipeline_shader_stage_create_info,
                                                            frag_pipeline_shader_stage_create_info};
 
-        auto vertex_binding_descriptions = MeshVertex::GetBindingDescriptions();
-        auto vertex_attribute_descriptions = MeshVertex::GetAttributeDescriptions();
+        auto vertex_binding_descriptions = MeshVertex::GetBindingDescriptions(mbEnableVertexQuantization);
+        auto vertex_attribute_descriptions = MeshVertex::GetAttributeDescriptions(mbEnableVertexQuantization);
         RHIPipelineVertexInputStateCreateInfo vertex_input_state_create_info {};
         vertex_input_state_create_info.sType = RHI_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
         vertex_input_state_create_info.vertexBindingDescriptionCount   = 1;
@@ -726,80 +688,71 @@ namespace MiniEngine
 
     void PickPass::setupDescriptorSet()
     {
-        RHIDescriptorSetAllocateInfo mesh_inefficient_pick_global_descriptor_set_alloc_info;
-        mesh_inefficient_pick_global_descriptor_set_alloc_info.sType = RHI_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-        mesh_inefficient_pick_global_descriptor_set_alloc_info.pNext = nullptr;
-        mesh_inefficient_pick_global_descriptor_set_alloc_info.descriptorPool     = mRHI->GetDescriptorPool();
-        mesh_inefficient_pick_global_descriptor_set_alloc_info.descriptorSetCount = 1;
-        mesh_inefficient_pick_global_descriptor_set_alloc_info.pSetLayouts        = &mDescInfos[0].layout;
-
-        if (RHI_SUCCESS != mRHI->AllocateDescriptorSets(&mesh_inefficient_pick_global_descriptor_set_alloc_info, mDescInfos[0].descriptorSet))
-        {
-            throw std::runtime_error("allocate mesh inefficient pick global descriptor set");
-        }
-
-        RHIDescriptorBufferInfo mesh_inefficient_pick_perframe_storage_buffer_info = {};
-        // this offset plus dynamic_offset should not be greater than the size of
-        // the buffer
-        mesh_inefficient_pick_perframe_storage_buffer_info.offset = 0;
-        // the range means the size actually used by the shader per draw call
-        mesh_inefficient_pick_perframe_storage_buffer_info.range =
-            sizeof(MeshInefficientPickPerFrameStorageBufferObject);
-        mesh_inefficient_pick_perframe_storage_buffer_info.buffer =
-            mGlobalRenderResource->mStorageBuffer.mGlobalUploadRingbuffer;
-
-        RHIDescriptorBufferInfo mesh_inefficient_pick_perdrawcall_storage_buffer_info = {};
-        mesh_inefficient_pick_perdrawcall_storage_buffer_info.offset                 = 0;
-        mesh_inefficient_pick_perdrawcall_storage_buffer_info.range =
-            sizeof(MeshInefficientPickPerDrawcallStorageBufferObject);
-        mesh_inefficient_pick_perdrawcall_storage_buffer_info.buffer =
-            mGlobalRenderResource->mStorageBuffer.mGlobalUploadRingbuffer;
-        assert(mesh_inefficient_pick_perdrawcall_storage_buffer_info.range <
-               mGlobalRenderResource->mStorageBuffer.mMaxStorageBufferRange);
-
-        RHIDescriptorBufferInfo mesh_inefficient_pick_perdrawcall_vertex_blending_storage_buffer_info = {};
-        mesh_inefficient_pick_perdrawcall_vertex_blending_storage_buffer_info.offset                 = 0;
-        mesh_inefficient_pick_perdrawcall_vertex_blending_storage_buffer_info.range =
-            sizeof(MeshInefficientPickPerDrawcallVertexBlendingStorageBufferObject);
-        mesh_inefficient_pick_perdrawcall_vertex_blending_storage_buffer_info.buffer =
-            mGlobalRenderResource->mStorageBuffer.mGlobalUploadRingbuffer;
-        assert(mesh_inefficient_pick_perdrawcall_vertex_blending_storage_buffer_info.range <
-               mGlobalRenderResource->mStorageBuffer.mMaxStorageBufferRange);
-
-        RHIWriteDescriptorSet mesh_descriptor_writes_info[3];
-
-        mesh_descriptor_writes_info[0].sType           = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        mesh_descriptor_writes_info[0].pNext           = nullptr;
-        mesh_descriptor_writes_info[0].dstSet          = mDescInfos[0].descriptorSet;
-        mesh_descriptor_writes_info[0].dstBinding      = 0;
-        mesh_descriptor_writes_info[0].dstArrayElement = 0;
-        mesh_descriptor_writes_info[0].descriptorType  = RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
-        mesh_descriptor_writes_info[0].descriptorCount = 1;
-        mesh_descriptor_writes_info[0].pBufferInfo     = &mesh_inefficient_pick_perframe_storage_buffer_info;
-
-        mesh_descriptor_writes_info[1].sType           = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        mesh_descriptor_writes_info[1].pNext           = nullptr;
-        mesh_descriptor_writes_info[1].dstSet          = mDescInfos[0].descriptorSet;
-        mesh_descriptor_writes_info[1].dstBinding      = 1;
-        mesh_descriptor_writes_info[1].dstArrayElement = 0;
-        mesh_descriptor_writes_info[1].descriptorType  = RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
-        mesh_descriptor_writes_info[1].descriptorCount = 1;
-        mesh_descriptor_writes_info[1].pBufferInfo     = &mesh_inefficient_pick_perdrawcall_storage_buffer_info;
-
-        mesh_descriptor_writes_info[2].sType           = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        mesh_descriptor_writes_info[2].pNext           = nullptr;
-        mesh_descriptor_writes_info[2].dstSet          = mDescInfos[0].descriptorSet;
-        mesh_descriptor_writes_info[2].dstBinding      = 2;
-        mesh_descriptor_writes_info[2].dstArrayElement = 0;
-        mesh_descriptor_writes_info[2].descriptorType  = RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
-        mesh_descriptor_writes_info[2].descriptorCount = 1;
-        mesh_descriptor_writes_info[2].pBufferInfo =
-            &mesh_inefficient_pick_perdrawcall_vertex_blending_storage_buffer_info;
-
-        mRHI->UpdateDescriptorSets(sizeof(mesh_descriptor_writes_info) / sizeof(mesh_descriptor_writes_info[0]),
-                                    mesh_descriptor_writes_info,
-                                    0,
-                                    nullptr);
+        mUploadDescriptorID = mGlobalRenderResource->mStorageBuffer.mGlobalUploadBuffer.RegisterDescriptorSet(
+            mDescInfos[0].layout, [this](RHIDescriptorSet* descriptor_set, RHIBuffer* page_buffer) {
+                RHIDescriptorBufferInfo mesh_inefficient_pick_perframe_storage_buffer_info = {};
+                // this offset plus dynamic_offset should not be greater than the size of
+                // the buffer
+                mesh_inefficient_pick_perframe_storage_buffer_info.offset = 0;
+                // the range means the size actually used by the shader per draw call
+                mesh_inefficient_pick_perframe_storage_buffer_info.range =
+                    sizeof(MeshInefficientPickPerFrameStorageBufferObject);
+                mesh_inefficient_pick_perframe_storage_buffer_info.buffer =
+                    page_buffer;
+
+                RHIDescriptorBufferInfo mesh_inefficient_pick_perdrawcall_storage_buffer_info = {};
+                mesh_inefficient_pick_perdrawcall_storage_buffer_info.offset                 = 0;
+                mesh_inefficient_pick_perdrawcall_storage_buffer_info.range =
+                    sizeof(MeshInefficientPickPerDrawcallStorageBufferObject);
+                mesh_inefficient_pick_perdrawcall_storage_buffer_info.buffer =
+                    page_buffer;
+                assert(mesh_inefficient_pick_perdrawcall_storage_buffer_info.range <
+                       mGlobalRenderResource->mStorageBuffer.mMaxStorageBufferRange);
+
+                RHIDescriptorBufferInfo mesh_inefficient_pick_perdrawcall_vertex_blending_storage_buffer_info = {};
+                mesh_inefficient_pick_perdrawcall_vertex_blending_storage_buffer_info.offset                 = 0;
+                mesh_inefficient_pick_perdrawcall_vertex_blending_storage_buffer_info.range =
+                    sizeof(MeshInefficientPickPerDrawcallVertexBlendingStorageBufferObject);
+                mesh_inefficient_pick_perdrawcall_vertex_blending_storage_buffer_info.buffer =
+                    page_buffer;
+                assert(mesh_inefficient_pick_perdrawcall_vertex_blending_storage_buffer_info.range <
+                       mGlobalRenderResource->mStorageBuffer.mMaxStorageBufferRange);
+
+                RHIWriteDescriptorSet mesh_descriptor_writes_info[3];
+
+                mesh_descriptor_writes_info[0].sType           = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                mesh_descriptor_writes_info[0].pNext           = nullptr;
+                mesh_descriptor_writes_info[0].dstSet          = descriptor_set;
+                mesh_descriptor_writes_info[0].dstBinding      = 0;
+                mesh_descriptor_writes_info[0].dstArrayElement = 0;
+                mesh_descriptor_writes_info[0].descriptorType  = RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+                mesh_descriptor_writes_info[0].descriptorCount = 1;
+                mesh_descriptor_writes_info[0].pBufferInfo     = &mesh_inefficient_pick_perframe_storage_buffer_info;
+
+                mesh_descriptor_writes_info[1].sType           = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                mesh_descriptor_writes_info[1].pNext           = nullptr;
+                mesh_descriptor_writes_info[1].dstSet          = descriptor_set;
+                mesh_descriptor_writes_info[1].dstBinding      = 1;
+                mesh_descriptor_writes_info[1].dstArrayElement = 0;
+                mesh_descriptor_writes_info[1].descriptorType  = RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+                mesh_descriptor_writes_info[1].descriptorCount = 1;
+                mesh_descriptor_writes_info[1].pBufferInfo     = &mesh_inefficient_pick_perdrawcall_storage_buffer_info;
+
+                mesh_descriptor_writes_info[2].sType           = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                mesh_descriptor_writes_info[2].pNext           = nullptr;
+                mesh_descriptor_writes_info[2].dstSet          = descriptor_set;
+                mesh_descriptor_writes_info[2].dstBinding      = 2;
+                mesh_descriptor_writes_info[2].dstArrayElement = 0;
+                mesh_descriptor_writes_info[2].descriptorType  = RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+                mesh_descriptor_writes_info[2].descriptorCount = 1;
+                mesh_descriptor_writes_info[2].pBufferInfo =
+                    &mesh_inefficient_pick_perdrawcall_vertex_blending_storage_buffer_info;
+
+                mRHI->UpdateDescriptorSets(sizeof(mesh_descriptor_writes_info) / sizeof(mesh_descriptor_writes_info[0]),
+                                            mesh_descriptor_writes_info,
+                                            0,
+                                            nullptr);
+            });
     }
 
 } // namespace MiniEngine
\ No newline at end of file
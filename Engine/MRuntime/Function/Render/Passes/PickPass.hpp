@@ -10,6 +10,7 @@ namespace MiniEngine
     struct PickPassInitInfo : RenderPassInitInfo
     {
         RHIDescriptorSetLayout* mPerMeshLayout;
+        bool                    mbEnableVertexQuantization;
     };
 
     class PickPass : public RenderPass
@@ -40,5 +41,8 @@ namespace MiniEngine
         RHIImageView* mObjectIDImageView = nullptr;
 
         RHIDescriptorSetLayout* mPerMeshLayout = nullptr;
+        bool                    mbEnableVertexQuantization {false};
+
+        uint32_t mUploadDescriptorID = 0;
     };
 }
\ No newline at end of file
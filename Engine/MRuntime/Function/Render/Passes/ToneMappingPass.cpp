@@ -2,6 +2,7 @@
 
 #include "MRuntime/Function/Render/Interface/Vulkan/VulkanRHI.hpp"
 #include "MRuntime/Function/Render/Interface/Vulkan/VulkanUtil.hpp"
+#include "MRuntime/Core/Profiler/Profiler.hpp"
 
 #include <Tonemapping_frag.h>
 #include <PostProcess_vert.h>
@@ -25,6 +26,8 @@ namespace MiniEngine
 
     void ToneMappingPass::Draw()
     {
+        PROFILE_SCOPE("ToneMappingPass::Draw");
+
         float color[4] = {1.0f, 1.0f, 1.0f, 1.0f};
         mRHI->PushEvent(mRHI->GetCurrentCommandBuffer(), "Tone Mapping", color);
 
@@ -227,14 +230,7 @@ namespace MiniEngine
 
     void ToneMappingPass::setupDescriptorSet()
     {
-        RHIDescriptorSetAllocateInfo postProcessDescSetAI {};
-        postProcessDescSetAI.sType          = RHI_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-        postProcessDescSetAI.pNext          = nullptr;
-        postProcessDescSetAI.descriptorPool = mRHI->GetDescriptorPool();
-        postProcessDescSetAI.descriptorSetCount = 1;
-        postProcessDescSetAI.pSetLayouts        = &mDescInfos[0].layout;
-
-        if (RHI_SUCCESS != mRHI->AllocateDescriptorSets(&postProcessDescSetAI, mDescInfos[0].descriptorSet))
+        if (RHI_SUCCESS != mRHI->AllocateDescriptorSet(mDescInfos[0].layout, mDescInfos[0].descriptorSet))
         {
             throw std::runtime_error("allocate post process global descriptor set");
         }
@@ -5,6 +5,7 @@
 #include "MRuntime/Resource/ConfigManager/ConfigManager.hpp"
 
 #include "MRuntime/Function/UI/WindowUI.hpp"
+#include "MRuntime/Core/Profiler/Profiler.hpp"
 
 #include <backends/imgui_impl_glfw.h>
 #include <backends/imgui_impl_vulkan.h>
@@ -43,6 +44,8 @@ namespace MiniEngine
 
     void UIPass::Draw()
     {
+        PROFILE_SCOPE("UIPass::Draw");
+
         if (mWndUI)
         {
             ImGui_ImplVulkan_NewFrame();
@@ -14,11 +14,13 @@ namespace MiniEngine
 {
     static const uint32_t s_point_light_shadow_map_dimension       = 2048;
     static const uint32_t s_directional_light_shadow_map_dimension = 4096;
+    static const uint32_t s_max_directional_light_cascade_count    = 4;
 
     // TODO: 64 may not be the best
     static uint32_t const s_mesh_per_drawcall_max_instance_count = 64;
     static uint32_t const s_mesh_vertex_blending_max_joint_count = 1024;
     static uint32_t const s_max_point_light_count                = 15;
+    static uint32_t const s_max_bindless_material_count          = 4096;
     // should sync the macros in "shader_include/constants.h"
 
     struct VulkanSceneDirectionalLight
@@ -50,13 +52,34 @@ namespace MiniEngine
         uint32_t                    _padding_point_light_num_3;
         VulkanScenePointLight       scene_point_lights[s_max_point_light_count];
         VulkanSceneDirectionalLight scene_directional_light;
-        Matrix4x4                   directional_light_proj_view;
+        Matrix4x4                   directional_light_proj_view[s_max_directional_light_cascade_count];
+        // view space far distance of each cascade
+        float                       directional_light_cascade_splits[s_max_directional_light_cascade_count];
+        uint32_t                    directional_light_cascade_count;
+        uint32_t                    _padding_directional_light_cascade_count_1;
+        uint32_t                    _padding_directional_light_cascade_count_2;
+        uint32_t                    _padding_directional_light_cascade_count_3;
+        // clustered point lights, the per-cluster lists live in separate storage buffers
+        uint32_t                    clustered_point_light_num;
+        float                       light_cluster_z_slice_scale;
+        float                       light_cluster_z_slice_bias;
+        uint32_t                    _padding_light_cluster;
+    };
+
+    // how the vertex shader reads the streams of the mesh drawn, the identity for float streams
+    struct VulkanMeshVertexDecode
+    {
+        Vector3  position_scale {1.0f, 1.0f, 1.0f};
+        uint32_t enable_vertex_quantization {0};
+        Vector3  position_offset {0.0f, 0.0f, 0.0f};
+        float    _padding_position_offset {0.0f};
     };
 
     struct VulkanMeshInstance
     {
         float     enable_vertex_blending;
-        float     _padding_enable_vertex_blending_1;
+        // entry of the bindless material buffer, unused when materials are bound per draw
+        uint32_t  material_index;
         float     _padding_enable_vertex_blending_2;
         float     _padding_enable_vertex_blending_3;
         Matrix4x4 model_matrix;
@@ -64,7 +87,8 @@ namespace MiniEngine
 
     struct MeshPerdrawcallStorageBufferObject
     {
-        VulkanMeshInstance mesh_instances[s_mesh_per_drawcall_max_instance_count];
+        VulkanMeshVertexDecode mesh_vertex_decode;
+        VulkanMeshInstance     mesh_instances[s_mesh_per_drawcall_max_instance_count];
     };
 
     struct MeshPerdrawcallVertexBlendingStorageBufferObject
@@ -86,6 +110,30 @@ namespace MiniEngine
         uint32_t is_double_sided = 0;
     };
 
+    // one entry of the material buffer of the bindless path, the textures are indices into its texture array
+    struct VulkanBindlessMaterial
+    {
+        Vector4 baseColorFactor {0.0f, 0.0f, 0.0f, 0.0f};
+
+        float metallicFactor    = 0.0f;
+        float roughnessFactor   = 0.0f;
+        float normalScale       = 0.0f;
+        float occlusionStrength = 0.0f;
+
+        Vector3  emissiveFactor  = {0.0f, 0.0f, 0.0f};
+        uint32_t is_blend        = 0;
+        uint32_t is_double_sided = 0;
+
+        uint32_t base_color_texture_index         = 0;
+        uint32_t metallic_roughness_texture_index = 0;
+        uint32_t normal_texture_index             = 0;
+        uint32_t occlusion_texture_index          = 0;
+        uint32_t emissive_texture_index           = 0;
+        uint32_t _padding_texture_index_1         = 0;
+        uint32_t _padding_texture_index_2         = 0;
+    };
+    static_assert(sizeof(VulkanBindlessMaterial) == 80, "must match the std430 layout of BindlessMaterial");
+
     struct MeshPointLightShadowPerFrameStorageBufferObject
     {
         uint32_t point_light_num;
@@ -107,7 +155,11 @@ namespace MiniEngine
 
     struct MeshDirectionalLightShadowPerFrameStorageBufferObject
     {
-        Matrix4x4 light_proj_view;
+        Matrix4x4 light_proj_view[s_max_directional_light_cascade_count];
+        uint32_t  cascade_count;
+        uint32_t  _padding_cascade_count_1;
+        uint32_t  _padding_cascade_count_2;
+        uint32_t  _padding_cascade_count_3;
     };
 
     struct MeshDirectionalLightShadowPerDrawcallStorageBufferObject
@@ -122,8 +174,12 @@ namespace MiniEngine
 
     struct AxisStorageBufferObject
     {
-        Matrix4x4 model_matrix  = Matrix4x4::IDENTITY;
-        uint32_t  selected_axis = 3;
+        Matrix4x4              model_matrix  = Matrix4x4::IDENTITY;
+        uint32_t               selected_axis = 3;
+        uint32_t               _padding_selected_axis_1;
+        uint32_t               _padding_selected_axis_2;
+        uint32_t               _padding_selected_axis_3;
+        VulkanMeshVertexDecode mesh_vertex_decode;
     };
 
     struct MeshInefficientPickPerFrameStorageBufferObject
@@ -135,9 +191,10 @@ namespace MiniEngine
 
     struct MeshInefficientPickPerDrawcallStorageBufferObject
     {
-        Matrix4x4 model_matrices[s_mesh_per_drawcall_max_instance_count];
-        uint32_t  node_ids[s_mesh_per_drawcall_max_instance_count];
-        float     enable_vertex_blendings[s_mesh_per_drawcall_max_instance_count];
+        VulkanMeshVertexDecode mesh_vertex_decode;
+        Matrix4x4              model_matrices[s_mesh_per_drawcall_max_instance_count];
+        uint32_t               node_ids[s_mesh_per_drawcall_max_instance_count];
+        float                  enable_vertex_blendings[s_mesh_per_drawcall_max_instance_count];
     };
 
     struct MeshInefficientPickPerDrawcallVertexBlendingStorageBufferObject
@@ -166,7 +223,14 @@ namespace MiniEngine
         RHIBuffer*    mesh_vertex_varying_buffer;
         VmaAllocation mesh_vertex_varying_buffer_allocation;
 
-        uint32_t mesh_index_count;
+        VulkanMeshVertexDecode mesh_vertex_decode;
+
+        // index count of the finest level, the whole mesh
+        uint32_t     mesh_index_count;
+        RHIIndexType mesh_index_type;
+
+        uint32_t mesh_lod_count;
+        MeshLod  mesh_lods[s_mesh_max_lod_count];
 
         RHIBuffer*    mesh_index_buffer;
         VmaAllocation mesh_index_buffer_allocation;
@@ -199,6 +263,10 @@ namespace MiniEngine
         VmaAllocation   material_uniform_buffer_allocation;
 
         RHIDescriptorSet* material_descriptor_set;
+
+        // entry of the bindless material buffer and the texture array slots its textures were written to
+        uint32_t bindless_material_index;
+        uint32_t bindless_texture_indices[5];
     };
 
     // nodes
@@ -210,6 +278,7 @@ namespace MiniEngine
         VulkanMesh*        ref_mesh {nullptr};
         VulkanPBRMaterial* ref_material {nullptr};
         uint32_t           node_id;
+        uint32_t           lod_index {0};
         bool               enable_vertex_blending {false};
     };
 
@@ -3,6 +3,8 @@
 #include "MRuntime/Function/Render/RenderScene.hpp"
 #include "MRuntime/Core/Math/Matrix4.hpp"
 
+#include <cmath>
+
 namespace MiniEngine
 {
     ClusterFrustum CreateClusterFrustumFromMatrix(
@@ -262,93 +264,160 @@ namespace MiniEngine
         return true;
     }
 
-    Matrix4x4 CalculateDirectionalLightCamera(RenderScene& scene, RenderCamera& camera)
+    // corners in the space the inverse matrix maps clip space to
+    static void calculateFrustumSliceCorners(RenderCamera const& camera,
+                                             Matrix4x4 const&    inverse_proj_view_matrix,
+                                             float               split_near,
+                                             float               split_far,
+                                             Vector3*            out_corners)
     {
-        Matrix4x4 proj_view_matrix;
+        float const ndc_xy[4][2] = {{-1.0f, -1.0f}, {1.0f, -1.0f}, {1.0f, 1.0f}, {-1.0f, 1.0f}};
+
+        // the view depth is linear along each frustum edge, so the slice corners can be lerped
+        float const depth_range = camera.mZFar - camera.mZNear;
+        float const t_near      = (split_near - camera.mZNear) / depth_range;
+        float const t_far       = (split_far - camera.mZNear) / depth_range;
+
+        for (size_t i = 0; i < 4; ++i)
         {
-            Matrix4x4 view_matrix = camera.GetViewMatrix();
-            Matrix4x4 proj_matrix = camera.GetPersProjMatrix();
-            proj_view_matrix      = proj_matrix * view_matrix;
+            Vector4 near_with_w = inverse_proj_view_matrix * Vector4(ndc_xy[i][0], ndc_xy[i][1], 0.0f, 1.0f);
+            Vector4 far_with_w  = inverse_proj_view_matrix * Vector4(ndc_xy[i][0], ndc_xy[i][1], 1.0f, 1.0f);
+
+            Vector3 near_corner(near_with_w.x / near_with_w.w, near_with_w.y / near_with_w.w, near_with_w.z / near_with_w.w);
+            Vector3 far_corner(far_with_w.x / far_with_w.w, far_with_w.y / far_with_w.w, far_with_w.z / far_with_w.w);
+            Vector3 edge = far_corner - near_corner;
+
+            out_corners[i]     = near_corner + edge * t_near;
+            out_corners[i + 4] = near_corner + edge * t_far;
         }
+    }
+
+    void CalculateCascadeSplits(float    z_near,
+                                float    z_far,
+                                uint32_t cascade_count,
+                                float    split_lambda,
+                                float*   out_split_far)
+    {
+        assert(z_near > 0.0f && z_near < z_far);
+        assert(cascade_count > 0);
 
-        BoundingBox frustum_bounding_box;
-        // CascadedShadowMaps11 / CreateFrustumPointsFromCascadeInterval
+        // [Parallel-Split Shadow Maps on Programmable GPUs](https://developer.nvidia.com/gpugems/gpugems3/part-ii-light-and-shadows/chapter-10-parallel-split-shadow-maps-programmable-gpus)
+        float const ratio = z_far / z_near;
+        float const range = z_far - z_near;
+        for (uint32_t i = 0; i < cascade_count; ++i)
         {
-            Vector3 const g_frustum_points_ndc_space[8] = {
-                Vector3(-1.0f, -1.0f, 1.0f),
-                Vector3(1.0f, -1.0f, 1.0f),
-                Vector3(1.0f, 1.0f, 1.0f),
-                Vector3(-1.0f, 1.0f, 1.0f),
-                Vector3(-1.0f, -1.0f, 0.0f),
-                Vector3(1.0f, -1.0f, 0.0f),
-                Vector3(1.0f, 1.0f, 0.0f),
-                Vector3(-1.0f, 1.0f, 0.0f)};
-
-            Matrix4x4 inverse_proj_view_matrix = proj_view_matrix.Inverse();
-
-            frustum_bounding_box.mMinBound = Vector3(FLT_MAX, FLT_MAX, FLT_MAX);
-            frustum_bounding_box.mMaxBound = Vector3(FLT_MIN, FLT_MIN, FLT_MIN);
-
-            size_t const CORNER_COUNT = 8;
-            for (size_t i = 0; i < CORNER_COUNT; ++i)
-            {
-                Vector4 frustum_point_with_w = inverse_proj_view_matrix * Vector4(g_frustum_points_ndc_space[i].x,
-                                                                                      g_frustum_points_ndc_space[i].y,
-                                                                                      g_frustum_points_ndc_space[i].z,
-                                                                                      1.0);
-                Vector3   frustum_point        = Vector3(frustum_point_with_w.x / frustum_point_with_w.w,
-                                                frustum_point_with_w.y / frustum_point_with_w.w,
-                                                frustum_point_with_w.z / frustum_point_with_w.w);
-
-                frustum_bounding_box.Merge(frustum_point);
-            }
+            float p             = static_cast<float>(i + 1) / static_cast<float>(cascade_count);
+            float log_split     = z_near * std::pow(ratio, p);
+            float uniform_split = z_near + range * p;
+            out_split_far[i]    = split_lambda * log_split + (1.0f - split_lambda) * uniform_split;
         }
+        // avoid the float error on the last split
+        out_split_far[cascade_count - 1] = z_far;
+    }
 
+    BoundingBox CalculateSceneBoundingBox(RenderScene const& scene)
+    {
         BoundingBox scene_bounding_box;
+        scene_bounding_box.mMinBound = Vector3(FLT_MAX, FLT_MAX, FLT_MAX);
+        scene_bounding_box.mMaxBound = Vector3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+        for (const RenderEntity& entity : scene.mRenderEntities)
         {
-            scene_bounding_box.mMinBound = Vector3(FLT_MAX, FLT_MAX, FLT_MAX);
-            scene_bounding_box.mMaxBound = Vector3(FLT_MIN, FLT_MIN, FLT_MIN);
+            BoundingBox mesh_asset_bounding_box {entity.mBoundingBox.GetMinCorner(),
+                                                 entity.mBoundingBox.GetMaxCorner()};
 
-            for (const RenderEntity& entity : scene.mRenderEntities)
-            {
-                BoundingBox mesh_asset_bounding_box {entity.mBoundingBox.GetMinCorner(),
-                                                     entity.mBoundingBox.GetMaxCorner()};
+            BoundingBox mesh_bounding_box_world = BoundingBoxTransform(mesh_asset_bounding_box, entity.mModelMatrix);
+            scene_bounding_box.Merge(mesh_bounding_box_world);
+        }
+        return scene_bounding_box;
+    }
 
-                BoundingBox mesh_bounding_box_world =
-                    BoundingBoxTransform(mesh_asset_bounding_box, entity.mModelMatrix);
-                scene_bounding_box.Merge(mesh_bounding_box_world);
-            }
+    Matrix4x4 CalculateDirectionalLightCascadeCamera(RenderCamera&      camera,
+                                                     Vector3 const&     light_direction,
+                                                     BoundingBox const& scene_bounding_box,
+                                                     float              split_near,
+                                                     float              split_far,
+                                                     uint32_t           shadow_map_dimension)
+    {
+        // the bounding sphere keeps the projection size constant while the camera rotates.
+        // it is fitted in view space, world space corners would carry the float noise of the camera transform
+        // into the radius and flip its quantization step from one frame to the next
+        Vector3 slice_corners[8];
+        calculateFrustumSliceCorners(camera, camera.GetPersProjMatrix().Inverse(), split_near, split_far, slice_corners);
+
+        Vector3 sphere_center_view = Vector3::ZERO;
+        for (size_t i = 0; i < 8; ++i)
+        {
+            sphere_center_view += slice_corners[i];
         }
+        sphere_center_view /= 8.0f;
 
-        // CascadedShadowMaps11 / ComputeNearAndFar
-        Matrix4x4 light_view;
-        Matrix4x4 light_proj;
+        float sphere_radius = 0.0f;
+        for (size_t i = 0; i < 8; ++i)
         {
-            Vector3 box_center((frustum_bounding_box.mMaxBound.x + frustum_bounding_box.mMinBound.x) * 0.5,
-                                 (frustum_bounding_box.mMaxBound.y + frustum_bounding_box.mMinBound.y) * 0.5,
-                                 (frustum_bounding_box.mMaxBound.z + frustum_bounding_box.mMinBound.z));
-            Vector3 box_extents((frustum_bounding_box.mMaxBound.x - frustum_bounding_box.mMinBound.x) * 0.5,
-                                  (frustum_bounding_box.mMaxBound.y - frustum_bounding_box.mMinBound.y) * 0.5,
-                                  (frustum_bounding_box.mMaxBound.z - frustum_bounding_box.mMinBound.z) * 0.5);
-
-            Vector3 eye =
-                box_center + scene.mDirectionalLight.mDirection * box_extents.Length();
-            Vector3 center = box_center;
-            light_view       = Math::MakeLookAtMatrix(eye, center, Vector3(0.0, 0.0, 1.0));
-
-            BoundingBox frustum_bounding_box_light_view = BoundingBoxTransform(frustum_bounding_box, light_view);
-            BoundingBox scene_bounding_box_light_view   = BoundingBoxTransform(scene_bounding_box, light_view);
-            light_proj = Math::MakeOrthographicProjectionMatrix01(
-                std::max(frustum_bounding_box_light_view.mMinBound.x, scene_bounding_box_light_view.mMinBound.x),
-                std::min(frustum_bounding_box_light_view.mMaxBound.x, scene_bounding_box_light_view.mMaxBound.x),
-                std::max(frustum_bounding_box_light_view.mMinBound.y, scene_bounding_box_light_view.mMinBound.y),
-                std::min(frustum_bounding_box_light_view.mMaxBound.y, scene_bounding_box_light_view.mMaxBound.y),
-                -scene_bounding_box_light_view.mMaxBound
-                     .z, // the objects which are nearer than the frustum bounding box may caster shadow as well
-                -std::max(frustum_bounding_box_light_view.mMinBound.z, scene_bounding_box_light_view.mMinBound.z));
+            sphere_radius = std::max(sphere_radius, (slice_corners[i] - sphere_center_view).Length());
         }
+        // quantize the radius so that float noise doesn't change the texel size every frame
+        sphere_radius = std::ceil(sphere_radius * 16.0f) / 16.0f;
+
+        Vector4 sphere_center_with_w = camera.GetViewMatrix().Inverse() * Vector4(sphere_center_view, 1.0f);
+        Vector3 sphere_center(sphere_center_with_w.x, sphere_center_with_w.y, sphere_center_with_w.z);
+
+        // the light view has no translation, so the texel grid stays fixed in world space
+        Vector3   up         = Math::Abs(light_direction.z) > 0.99f ? Vector3::UNIT_Y : Vector3::UNIT_Z;
+        Matrix4x4 light_view = Math::MakeLookAtMatrix(Vector3::ZERO, -light_direction, up);
+
+        Vector4 center_light_view = light_view * Vector4(sphere_center, 1.0f);
+
+        // keep one texel of border so that the snapped projection still covers the whole sphere
+        float half_extent = sphere_radius * static_cast<float>(shadow_map_dimension) /
+                            static_cast<float>(shadow_map_dimension - 2);
+        float texel_size  = 2.0f * half_extent / static_cast<float>(shadow_map_dimension);
+        float center_x    = std::floor(center_light_view.x / texel_size) * texel_size;
+        float center_y    = std::floor(center_light_view.y / texel_size) * texel_size;
+
+        float z_near = -(center_light_view.z + sphere_radius);
+        float z_far  = -(center_light_view.z - sphere_radius);
+
+        bool scene_bounding_box_valid = scene_bounding_box.mMinBound.x <= scene_bounding_box.mMaxBound.x;
+        if (scene_bounding_box_valid)
+        {
+            // the objects which are nearer than the slice may cast shadow into it as well
+            BoundingBox scene_bounding_box_light_view = BoundingBoxTransform(scene_bounding_box, light_view);
+            z_near = std::min(z_near, -scene_bounding_box_light_view.mMaxBound.z);
+        }
+
+        Matrix4x4 light_proj = Math::MakeOrthographicProjectionMatrix01(center_x - half_extent,
+                                                                        center_x + half_extent,
+                                                                        center_y - half_extent,
+                                                                        center_y + half_extent,
+                                                                        z_near,
+                                                                        z_far);
 
         Matrix4x4 light_proj_view = (light_proj * light_view);
         return light_proj_view;
     }
+
+    bool CascadeContainsFrustumSlice(RenderCamera&    camera,
+                                     Matrix4x4 const& cascade_proj_view,
+                                     float            split_near,
+                                     float            split_far)
+    {
+        Matrix4x4 proj_view_matrix = camera.GetPersProjMatrix() * camera.GetViewMatrix();
+        Vector3   slice_corners[8];
+        calculateFrustumSliceCorners(camera, proj_view_matrix.Inverse(), split_near, split_far, slice_corners);
+
+        float const epsilon = 1e-3f;
+        for (size_t i = 0; i < 8; ++i)
+        {
+            // orthographic projection, w stays 1
+            Vector4 corner_clip = cascade_proj_view * Vector4(slice_corners[i], 1.0f);
+            if (Math::Abs(corner_clip.x) > 1.0f + epsilon || Math::Abs(corner_clip.y) > 1.0f + epsilon ||
+                corner_clip.z < -epsilon || corner_clip.z > 1.0f + epsilon)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
 } // namespace MiniEngine
@@ -83,5 +83,29 @@ namespace MiniEngine
 
     bool BoxIntersectsWithSphere(BoundingBox const& b, BoundingSphere const& s);
 
-    Matrix4x4 CalculateDirectionalLightCamera(RenderScene& scene, RenderCamera& camera);
+    // practical split scheme, blends logarithmic and uniform splits by lambda
+    // out_split_far receives the view-space far distance of each cascade
+    void CalculateCascadeSplits(float    z_near,
+                                float    z_far,
+                                uint32_t cascade_count,
+                                float    split_lambda,
+                                float*   out_split_far);
+
+    // merged world space bounds of all render entities
+    BoundingBox CalculateSceneBoundingBox(RenderScene const& scene);
+
+    // fit an orthographic light camera to the camera frustum slice [split_near, split_far],
+    // the projection is bounded by a sphere and snapped to shadow map texels to avoid shimmering
+    Matrix4x4 CalculateDirectionalLightCascadeCamera(RenderCamera&      camera,
+                                                     Vector3 const&     light_direction,
+                                                     BoundingBox const& scene_bounding_box,
+                                                     float              split_near,
+                                                     float              split_far,
+                                                     uint32_t           shadow_map_dimension);
+
+    // returns false if any corner of the frustum slice falls outside the cascade clip volume
+    bool CascadeContainsFrustumSlice(RenderCamera&    camera,
+                                     Matrix4x4 const& cascade_proj_view,
+                                     float            split_near,
+                                     float            split_far);
 }
\ No newline at end of file
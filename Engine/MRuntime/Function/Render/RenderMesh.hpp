@@ -6,6 +6,7 @@
 #include "MRuntime/Function/Render/Interface/RHI.hpp"
 
 #include <array>
+#include <cstdint>
 
 namespace MiniEngine
 {
@@ -33,29 +34,77 @@ namespace MiniEngine
             Vector4  weights;
         };
 
-        static std::array<RHIVertexInputBindingDescription, 3> GetBindingDescriptions()
+        // quantized streams, 20 instead of 44 bytes a vertex. the position is unorm within the mesh bounds and
+        // decoded with VulkanMeshVertexDecode, normal and tangent are octahedral, the texcoord is half float
+        struct VulkanMeshVertexPositionQuantized
+        {
+            uint16_t position[4];
+        };
+
+        struct VulkanMeshVertexVaryingEnableBlendingQuantized
+        {
+            int16_t normal[2];
+            int16_t tangent[2];
+        };
+
+        struct VulkanMeshVertexVaryingQuantized
+        {
+            uint16_t texcoord[2];
+        };
+
+        static std::array<RHIVertexInputBindingDescription, 3>
+        GetBindingDescriptions(bool enable_vertex_quantization = false)
         {
             std::array<RHIVertexInputBindingDescription, 3> binding_descriptions {};
 
             // position
             binding_descriptions[0].binding   = 0;
-            binding_descriptions[0].stride    = sizeof(VulkanMeshVertexPostition);
+            binding_descriptions[0].stride    = enable_vertex_quantization ? sizeof(VulkanMeshVertexPositionQuantized) :
+                                                                             sizeof(VulkanMeshVertexPostition);
             binding_descriptions[0].inputRate = RHI_VERTEX_INPUT_RATE_VERTEX;
             // varying blending
             binding_descriptions[1].binding   = 1;
-            binding_descriptions[1].stride    = sizeof(VulkanMeshVertexVaryingEnableBlending);
+            binding_descriptions[1].stride    = enable_vertex_quantization ?
+                                                    sizeof(VulkanMeshVertexVaryingEnableBlendingQuantized) :
+                                                    sizeof(VulkanMeshVertexVaryingEnableBlending);
             binding_descriptions[1].inputRate = RHI_VERTEX_INPUT_RATE_VERTEX;
             // varying
             binding_descriptions[2].binding   = 2;
-            binding_descriptions[2].stride    = sizeof(VulkanMeshVertexVarying);
+            binding_descriptions[2].stride    = enable_vertex_quantization ? sizeof(VulkanMeshVertexVaryingQuantized) :
+                                                                             sizeof(VulkanMeshVertexVarying);
             binding_descriptions[2].inputRate = RHI_VERTEX_INPUT_RATE_VERTEX;
             return binding_descriptions;
         }
 
-        static std::array<RHIVertexInputAttributeDescription, 4> GetAttributeDescriptions()
+        static std::array<RHIVertexInputAttributeDescription, 4>
+        GetAttributeDescriptions(bool enable_vertex_quantization = false)
         {
             std::array<RHIVertexInputAttributeDescription, 4> attribute_descriptions {};
 
+            if (enable_vertex_quantization)
+            {
+                attribute_descriptions[0].binding  = 0;
+                attribute_descriptions[0].location = 0;
+                attribute_descriptions[0].format   = RHI_FORMAT_R16G16B16A16_UNORM;
+                attribute_descriptions[0].offset   = offsetof(VulkanMeshVertexPositionQuantized, position);
+
+                attribute_descriptions[1].binding  = 1;
+                attribute_descriptions[1].location = 1;
+                attribute_descriptions[1].format   = RHI_FORMAT_R16G16_SNORM;
+                attribute_descriptions[1].offset   = offsetof(VulkanMeshVertexVaryingEnableBlendingQuantized, normal);
+                attribute_descriptions[2].binding  = 1;
+                attribute_descriptions[2].location = 2;
+                attribute_descriptions[2].format   = RHI_FORMAT_R16G16_SNORM;
+                attribute_descriptions[2].offset   = offsetof(VulkanMeshVertexVaryingEnableBlendingQuantized, tangent);
+
+                attribute_descriptions[3].binding  = 2;
+                attribute_descriptions[3].location = 3;
+                attribute_descriptions[3].format   = RHI_FORMAT_R16G16_SFLOAT;
+                attribute_descriptions[3].offset   = offsetof(VulkanMeshVertexVaryingQuantized, texcoord);
+
+                return attribute_descriptions;
+            }
+
             // position
             attribute_descriptions[0].binding  = 0;
             attribute_descriptions[0].location = 0;
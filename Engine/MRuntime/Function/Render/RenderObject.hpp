@@ -87,6 +87,13 @@ namespace MiniEngine
             mGOID(go_id), mObjectParts(parts)
         {}
 
+        // copy assignment, the part vector and its strings keep their capacity
+        void Assign(GObjectID go_id, const std::vector<GameObjectPartDesc>& parts)
+        {
+            mGOID        = go_id;
+            mObjectParts = parts;
+        }
+
         GObjectID                              GetID() const { return mGOID; }
         const std::vector<GameObjectPartDesc>& GetObjectParts() const { return mObjectParts; }
 
@@ -6,6 +6,7 @@
 
 #include <vulkan/vulkan.h>
 
+#include <array>
 #include <memory>
 #include <vector>
 
@@ -44,7 +45,7 @@ namespace MiniEngine
 
     struct VisiableNodes
     {
-        std::vector<RenderMeshNode>*              mDirectionalLightVisibleMeshNodes {nullptr};
+        std::array<std::vector<RenderMeshNode>, s_max_directional_light_cascade_count>* mDirectionalLightVisibleMeshNodes {nullptr};
         std::vector<RenderMeshNode>*              mPointLightVisibleMeshNodes {nullptr};
         std::vector<RenderMeshNode>*              mMainCameraVisibleMeshNodes {nullptr};
         RenderAxisNode*                           mAxisNode {nullptr};
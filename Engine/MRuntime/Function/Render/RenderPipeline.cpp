@@ -10,6 +10,7 @@
 #include "MRuntime/Function/Render/Passes/PickPass.hpp"
 #include "MRuntime/Function/Render/Passes/ToneMappingPass.hpp"
 #include "MRuntime/Function/Render/Passes/UIPass.hpp"
+#include "MRuntime/Core/Profiler/Profiler.hpp"
 
 namespace MiniEngine
 {
@@ -45,6 +46,8 @@ namespace MiniEngine
 
         MainCameraPassInitInfo main_camera_init_info;
         main_camera_init_info.mbEnableFXAA = init_info.mbEnableFXAA;
+        main_camera_init_info.mbEnableVertexQuantization = init_info.mbEnableVertexQuantization;
+        main_camera_init_info.mbEnableBindlessMaterials = init_info.mbEnableBindlessMaterials;
         mMainCameraPass->Initialize(&main_camera_init_info);
 
         std::vector<RHIDescriptorSetLayout*> descriptor_layouts = _main_camera_pass->GetDescriptorSetLayouts();
@@ -79,17 +82,20 @@ namespace MiniEngine
 
         PickPassInitInfo pick_init_info;
         pick_init_info.mPerMeshLayout = descriptor_layouts[MainCameraPass::LayoutType::LayoutType_PerMesh];
+        pick_init_info.mbEnableVertexQuantization = init_info.mbEnableVertexQuantization;
         mPickPass->Initialize(&pick_init_info);
     }
 
     void RenderPipeline::ForwardRender(std::shared_ptr<RHI> rhi, std::shared_ptr<RenderResourceBase> renderResource)
     {
+        PROFILE_SCOPE("RenderPipeline::ForwardRender");
+
         VulkanRHI*      vulkan_rhi      = static_cast<VulkanRHI*>(rhi.get());
         RenderResource* vulkan_resource = static_cast<RenderResource*>(renderResource.get());
 
-        vulkan_resource->ResetRingBufferOffset(vulkan_rhi->mCurrentFrameIndex);
-
-        vulkan_rhi->WaitForFences();
+        // MEngine::BeginFrame already waited for the fence of this frame before the input was sampled,
+        // so the frame's upload pages are free
+        vulkan_resource->BeginUploadFrame(rhi, vulkan_rhi->mCurrentFrameIndex);
 
         vulkan_rhi->ResetCommandPool();
 
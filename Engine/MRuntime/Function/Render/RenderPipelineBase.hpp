@@ -18,6 +18,8 @@ namespace MiniEngine
     struct RenderPipelineInitInfo
     {
         bool mbEnableFXAA = false;
+        bool mbEnableVertexQuantization = false;
+        bool mbEnableBindlessMaterials = false;
         std::shared_ptr<RenderResourceBase> mRenderResource;
     };
     class RenderPipelineBase
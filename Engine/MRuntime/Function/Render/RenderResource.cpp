@@ -3,17 +3,40 @@
 #include "MRuntime/Function/Render/RenderCamera.hpp"
 #include "MRuntime/Function/Render/RenderHelper.hpp"
 #include "MRuntime/Function/Render/RenderMesh.hpp"
+#include "MRuntime/Function/Render/VertexQuantization.hpp"
 #include "MRuntime/Function/Render/Interface/Vulkan/VulkanRHI.hpp"
 #include "MRuntime/Function/Render/Interface/Vulkan/VulkanUtil.hpp"
 #include "MRuntime/Function/Render/Passes/MainCameraPass.hpp"
 #include "MRuntime/Core/Base/Marco.hpp"
+#include "MRuntime/Core/Base/ThreadPool.hpp"
+#include "MRuntime/Core/Profiler/Profiler.hpp"
 
+#include <algorithm>
+#include <limits>
 #include <stdexcept>
 
 namespace MiniEngine
 {
+    // initial size of the upload page of every frame in flight
+    static uint32_t const s_upload_page_size = 16 * 1024 * 1024;
+
+    namespace
+    {
+        uint64_t allocationSize(VmaAllocator allocator, VmaAllocation allocation)
+        {
+            if (allocator == nullptr || allocation == nullptr)
+            {
+                return 0;
+            }
+            VmaAllocationInfo allocation_info;
+            vmaGetAllocationInfo(allocator, allocation, &allocation_info);
+            return allocation_info.size;
+        }
+    } // namespace
+
     void RenderResource::Clear()
     {
+        mGlobalRenderResource.mStorageBuffer.mGlobalUploadBuffer.Clear();
     }
 
     void RenderResource::UploadGlobalRenderResource(std::shared_ptr<RHI> rhi, SceneResourceDesc level_resource_desc)
@@ -87,27 +110,56 @@ namespace MiniEngine
         RenderMeshData       mesh_data,
         RenderMaterialData   material_data)
     {
-        getOrCreateVulkanMesh(rhi, render_entity, mesh_data);
-        getOrCreateVulkanMaterial(rhi, render_entity, material_data);
+        UploadGameObjectRenderResource(rhi, render_entity, mesh_data);
+        UploadGameObjectRenderResource(rhi, render_entity, material_data);
     }
 
     void RenderResource::UploadGameObjectRenderResource(std::shared_ptr<RHI> rhi,
         RenderEntity         render_entity,
         RenderMeshData       mesh_data)
     {
-        getOrCreateVulkanMesh(rhi, render_entity, mesh_data);
+        VulkanMesh& mesh = getOrCreateVulkanMesh(rhi, render_entity, mesh_data);
+        mMeshResidency.SetSize(render_entity.mMeshAssetID, getMeshSize(mesh));
     }
 
     void RenderResource::UploadGameObjectRenderResource(std::shared_ptr<RHI> rhi,
         RenderEntity         render_entity,
         RenderMaterialData   material_data)
     {
-        getOrCreateVulkanMaterial(rhi, render_entity, material_data);
+        VulkanPBRMaterial& material = getOrCreateVulkanMaterial(rhi, render_entity, material_data);
+        mMaterialResidency.SetSize(render_entity.mMaterialAssetID, getMaterialSize(material));
+    }
+
+    void RenderResource::ReloadGameObjectRenderResource(std::shared_ptr<RHI> rhi,
+        RenderEntity         render_entity,
+        RenderMeshData       mesh_data)
+    {
+        auto it = mVulkanMesh.find(render_entity.mMeshAssetID);
+        if (it != mVulkanMesh.end())
+        {
+            // frames in flight may still read the old buffers
+            deferReleaseVulkanMesh(it);
+        }
+        UploadGameObjectRenderResource(rhi, render_entity, mesh_data);
+    }
+
+    void RenderResource::ReloadGameObjectRenderResource(std::shared_ptr<RHI> rhi,
+        RenderEntity         render_entity,
+        RenderMaterialData   material_data)
+    {
+        auto it = mVulkanPBRMaterial.find(render_entity.mMaterialAssetID);
+        if (it != mVulkanPBRMaterial.end())
+        {
+            deferReleaseVulkanMaterial(it);
+        }
+        UploadGameObjectRenderResource(rhi, render_entity, material_data);
     }
 
     void RenderResource::UpdatePerFrameBuffer(std::shared_ptr<RenderScene>  render_scene,
         std::shared_ptr<RenderCamera> camera)
     {
+        PROFILE_SCOPE("RenderResource::UpdatePerFrameBuffer");
+
         Matrix4x4 view_matrix = camera->GetViewMatrix();
         Matrix4x4 proj_matrix = camera->GetPersProjMatrix();
         Vector3   camera_position = camera->Position();
@@ -115,7 +167,9 @@ namespace MiniEngine
 
         // ambient light
         Vector3  ambient_light = render_scene->mAmbientLight.mIrradiance;
-        uint32_t point_light_num = static_cast<uint32_t>(render_scene->mPointLightList.mLights.size());
+        // only the first lights are shadowed, the rest are shaded through the clusters
+        uint32_t point_light_num = std::min(static_cast<uint32_t>(render_scene->mPointLightList.mLights.size()),
+                                            s_max_point_light_count);
 
         mMeshPerFrameStorageBufferObject.proj_view_matrix = proj_view_matrix;
         mMeshPerFrameStorageBufferObject.camera_position = camera_position;
@@ -145,6 +199,22 @@ namespace MiniEngine
             render_scene->mDirectionalLight.mDirection.NormalizedCopy();
         mMeshPerFrameStorageBufferObject.scene_directional_light.color = render_scene->mDirectionalLight.mColor;
 
+        // clustered point lights
+        LightClusterBuildInfo light_cluster_build_info;
+        light_cluster_build_info.view_matrix  = view_matrix;
+        light_cluster_build_info.proj_scale_x = proj_matrix[0][0];
+        light_cluster_build_info.proj_scale_y = proj_matrix[1][1];
+        light_cluster_build_info.z_near       = camera->mZNear;
+        light_cluster_build_info.z_far        = camera->mZFar;
+        mLightClusterBuilder.Build(render_scene->mPointLightList.mLights,
+                                   light_cluster_build_info,
+                                   gRuntimeGlobalContext.mThreadPool.get());
+
+        mMeshPerFrameStorageBufferObject.clustered_point_light_num =
+            static_cast<uint32_t>(mLightClusterBuilder.GetPointLights().size());
+        mMeshPerFrameStorageBufferObject.light_cluster_z_slice_scale = mLightClusterBuilder.GetZSliceScale();
+        mMeshPerFrameStorageBufferObject.light_cluster_z_slice_bias  = mLightClusterBuilder.GetZSliceBias();
+
         // pick pass view projection matrix
         mMeshInEffPickPerFrameStorageBufferObject.proj_view_matrix = proj_view_matrix;
     }
@@ -254,7 +324,7 @@ namespace MiniEngine
     VulkanMesh&
         RenderResource::getOrCreateVulkanMesh(std::shared_ptr<RHI> rhi, RenderEntity entity, RenderMeshData mesh_data)
     {
-        size_t assetid = entity.mMaterialAssetID;
+        size_t assetid = entity.mMeshAssetID;
 
         auto it = mVulkanMesh.find(assetid);
         if (it != mVulkanMesh.end())
@@ -263,7 +333,7 @@ namespace MiniEngine
         }
         else
         {
-            VulkanMesh temp;
+            VulkanMesh temp {};
             auto       res = mVulkanMesh.insert(std::make_pair(assetid, std::move(temp)));
             assert(res.second);
 
@@ -285,6 +355,8 @@ namespace MiniEngine
                                true,
                                index_buffer_size,
                                index_buffer_data,
+                               mesh_data.mStaticMeshData.mIndexType,
+                               mesh_data.mStaticMeshData.mLods,
                                vertex_buffer_size,
                                vertex_buffer_data,
                                joint_binding_buffer_size,
@@ -297,6 +369,8 @@ namespace MiniEngine
                                false,
                                index_buffer_size,
                                index_buffer_data,
+                               mesh_data.mStaticMeshData.mIndexType,
+                               mesh_data.mStaticMeshData.mLods,
                                vertex_buffer_size,
                                vertex_buffer_data,
                                0,
@@ -323,7 +397,7 @@ namespace MiniEngine
         }
         else
         {
-            VulkanPBRMaterial temp;
+            VulkanPBRMaterial temp {};
             auto              res = mVulkanPBRMaterial.insert(std::make_pair(assetid, std::move(temp)));
             assert(res.second);
 
@@ -393,7 +467,8 @@ namespace MiniEngine
 
             // similiarly to the vertex/index buffer, we should allocate the uniform
             // buffer in DEVICE_LOCAL memory and use the temp stage buffer to copy the
-            // data
+            // data. the bindless path keeps the factors in the material buffer instead
+            if (!mbEnableBindlessMaterials)
             {
                 // temporary staging buffer
 
@@ -481,25 +556,6 @@ namespace MiniEngine
 
             updateTextureImageData(rhi, update_texture_data);
 
-            RHIDescriptorSetAllocateInfo material_descriptor_set_alloc_info;
-            material_descriptor_set_alloc_info.sType = RHI_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-            material_descriptor_set_alloc_info.pNext = NULL;
-            material_descriptor_set_alloc_info.descriptorPool = vulkan_context->mDescPool;
-            material_descriptor_set_alloc_info.descriptorSetCount = 1;
-            material_descriptor_set_alloc_info.pSetLayouts        = mMaterialDescLayout;
-
-            if (RHI_SUCCESS != rhi->AllocateDescriptorSets(
-                &material_descriptor_set_alloc_info,
-                now_material.material_descriptor_set))
-            {
-                throw std::runtime_error("allocate material descriptor set");
-            }
-
-            RHIDescriptorBufferInfo material_uniform_buffer_info = {};
-            material_uniform_buffer_info.offset = 0;
-            material_uniform_buffer_info.range = sizeof(MeshPerMaterialUniformBufferObject);
-            material_uniform_buffer_info.buffer = now_material.material_uniform_buffer;
-
             RHIDescriptorImageInfo base_color_image_info = {};
             base_color_image_info.imageLayout = RHI_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
             base_color_image_info.imageView = now_material.base_color_image_view;
@@ -528,6 +584,27 @@ namespace MiniEngine
             emissive_image_info.imageView = now_material.emissive_image_view;
             emissive_image_info.sampler = rhi->GetOrCreateMipmapSampler(emissive_image_width, emissive_image_height);
 
+            if (mbEnableBindlessMaterials)
+            {
+                RHIDescriptorImageInfo image_infos[5] = {base_color_image_info,
+                                                               metallic_roughness_image_info,
+                                                               normal_roughness_image_info,
+                                                               occlusion_image_info,
+                                                               emissive_image_info};
+                writeBindlessMaterial(rhi, entity, image_infos, now_material);
+                return now_material;
+            }
+
+            if (RHI_SUCCESS != rhi->AllocateDescriptorSet(*mMaterialDescLayout, now_material.material_descriptor_set))
+            {
+                throw std::runtime_error("allocate material descriptor set");
+            }
+
+            RHIDescriptorBufferInfo material_uniform_buffer_info = {};
+            material_uniform_buffer_info.offset = 0;
+            material_uniform_buffer_info.range = sizeof(MeshPerMaterialUniformBufferObject);
+            material_uniform_buffer_info.buffer = now_material.material_uniform_buffer;
+
             RHIWriteDescriptorSet mesh_descriptor_writes_info[6];
 
             mesh_descriptor_writes_info[0].sType = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
@@ -574,6 +651,8 @@ namespace MiniEngine
                                         bool                                   enable_vertex_blending,
                                         uint32_t                               index_buffer_size,
                                         void*                                  index_buffer_data,
+                                        RHIIndexType                           index_type,
+                                        const std::vector<MeshLod>&            lods,
                                         uint32_t                               vertex_buffer_size,
                                         MeshVertexDataDefinition const*        vertex_buffer_data,
                                         uint32_t                               joint_binding_buffer_size,
@@ -589,11 +668,25 @@ namespace MiniEngine
                            vertex_buffer_data,
                            joint_binding_buffer_size,
                            joint_binding_buffer_data,
-                           index_buffer_size,
-                           reinterpret_cast<uint16_t*>(index_buffer_data),
                            now_mesh);
-        assert(0 == (index_buffer_size % sizeof(uint16_t)));
-        now_mesh.mesh_index_count = index_buffer_size / sizeof(uint16_t);
+
+        uint32_t index_size = index_type == RHI_INDEX_TYPE_UINT32 ? sizeof(uint32_t) : sizeof(uint16_t);
+        assert(0 == (index_buffer_size % index_size));
+        now_mesh.mesh_index_type = index_type;
+
+        // without generated levels the whole index buffer is the only one
+        assert(lods.size() <= s_mesh_max_lod_count);
+        if (lods.empty())
+        {
+            now_mesh.mesh_lod_count = 1;
+            now_mesh.mesh_lods[0]   = MeshLod {0, index_buffer_size / index_size, 0.0f};
+        }
+        else
+        {
+            now_mesh.mesh_lod_count = static_cast<uint32_t>(lods.size());
+            std::copy(lods.begin(), lods.end(), now_mesh.mesh_lods);
+        }
+        now_mesh.mesh_index_count = now_mesh.mesh_lods[0].mIndexCount;
         updateIndexBuffer(rhi, index_buffer_size, index_buffer_data, now_mesh);
     }
 
@@ -603,8 +696,6 @@ namespace MiniEngine
                                             MeshVertexDataDefinition const*        vertex_buffer_data,
                                             uint32_t                               joint_binding_buffer_size,
                                             MeshVertexBindingDataDefinition const* joint_binding_buffer_data,
-                                            uint32_t                               index_buffer_size,
-                                            uint16_t*                              index_buffer_data,
                                             VulkanMesh&                            now_mesh)
     {
         VulkanRHI* vulkan_context = static_cast<VulkanRHI*>(rhi.get());
@@ -613,15 +704,16 @@ namespace MiniEngine
         {
             assert(0 == (vertex_buffer_size % sizeof(MeshVertexDataDefinition)));
             uint32_t vertex_count = vertex_buffer_size / sizeof(MeshVertexDataDefinition);
-            assert(0 == (index_buffer_size % sizeof(uint16_t)));
-            uint32_t index_count = index_buffer_size / sizeof(uint16_t);
+            // the bindings are read with the vertex index, the importer keeps them in vertex order
+            assert(joint_binding_buffer_size == vertex_count * sizeof(MeshVertexBindingDataDefinition));
 
-            RHIDeviceSize vertex_position_buffer_size = sizeof(MeshVertex::VulkanMeshVertexPostition) * vertex_count;
+            auto          vertex_binding_descriptions = MeshVertex::GetBindingDescriptions(mbEnableVertexQuantization);
+            RHIDeviceSize vertex_position_buffer_size = vertex_binding_descriptions[0].stride * vertex_count;
             RHIDeviceSize vertex_varying_enable_blending_buffer_size =
-                sizeof(MeshVertex::VulkanMeshVertexVaryingEnableBlending) * vertex_count;
-            RHIDeviceSize vertex_varying_buffer_size = sizeof(MeshVertex::VulkanMeshVertexVarying) * vertex_count;
+                vertex_binding_descriptions[1].stride * vertex_count;
+            RHIDeviceSize vertex_varying_buffer_size = vertex_binding_descriptions[2].stride * vertex_count;
             RHIDeviceSize vertex_joint_binding_buffer_size =
-                sizeof(MeshVertex::VulkanMeshVertexJointBinding) * index_count;
+                sizeof(MeshVertex::VulkanMeshVertexJointBinding) * vertex_count;
 
             RHIDeviceSize vertex_position_buffer_offset = 0;
             RHIDeviceSize vertex_varying_enable_blending_buffer_offset =
@@ -649,63 +741,36 @@ namespace MiniEngine
                            0,
                            &inefficient_staging_buffer_data);
 
-            MeshVertex::VulkanMeshVertexPostition* mesh_vertex_positions =
-                reinterpret_cast<MeshVertex::VulkanMeshVertexPostition*>(
-                    reinterpret_cast<uintptr_t>(inefficient_staging_buffer_data) + vertex_position_buffer_offset);
-            MeshVertex::VulkanMeshVertexVaryingEnableBlending* mesh_vertex_blending_varyings =
-                reinterpret_cast<MeshVertex::VulkanMeshVertexVaryingEnableBlending*>(
-                    reinterpret_cast<uintptr_t>(inefficient_staging_buffer_data) +
-                    vertex_varying_enable_blending_buffer_offset);
-            MeshVertex::VulkanMeshVertexVarying* mesh_vertex_varyings =
-                reinterpret_cast<MeshVertex::VulkanMeshVertexVarying*>(
-                    reinterpret_cast<uintptr_t>(inefficient_staging_buffer_data) + vertex_varying_buffer_offset);
+            writeVertexStreams(vertex_count,
+                               vertex_buffer_data,
+                               static_cast<uint8_t*>(inefficient_staging_buffer_data) + vertex_position_buffer_offset,
+                               static_cast<uint8_t*>(inefficient_staging_buffer_data) +
+                                   vertex_varying_enable_blending_buffer_offset,
+                               static_cast<uint8_t*>(inefficient_staging_buffer_data) + vertex_varying_buffer_offset,
+                               now_mesh);
             MeshVertex::VulkanMeshVertexJointBinding* mesh_vertex_joint_binding =
                 reinterpret_cast<MeshVertex::VulkanMeshVertexJointBinding*>(
                     reinterpret_cast<uintptr_t>(inefficient_staging_buffer_data) + vertex_joint_binding_buffer_offset);
 
             for (uint32_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
             {
-                Vector3 normal = Vector3(vertex_buffer_data[vertex_index].nx,
-                    vertex_buffer_data[vertex_index].ny,
-                    vertex_buffer_data[vertex_index].nz);
-                Vector3 tangent = Vector3(vertex_buffer_data[vertex_index].tx,
-                    vertex_buffer_data[vertex_index].ty,
-                    vertex_buffer_data[vertex_index].tz);
-
-                mesh_vertex_positions[vertex_index].position = Vector3(vertex_buffer_data[vertex_index].x,
-                    vertex_buffer_data[vertex_index].y,
-                    vertex_buffer_data[vertex_index].z);
-
-                mesh_vertex_blending_varyings[vertex_index].normal = normal;
-                mesh_vertex_blending_varyings[vertex_index].tangent = tangent;
-
-                mesh_vertex_varyings[vertex_index].texcoord =
-                    Vector2(vertex_buffer_data[vertex_index].u, vertex_buffer_data[vertex_index].v);
-            }
-
-            for (uint32_t index_index = 0; index_index < index_count; ++index_index)
-            {
-                uint32_t vertex_buffer_index = index_buffer_data[index_index];
-
-                // TODO: move to assets loading process
-
-                mesh_vertex_joint_binding[index_index].indices[0] = joint_binding_buffer_data[vertex_buffer_index].mIndex0;
-                mesh_vertex_joint_binding[index_index].indices[1] = joint_binding_buffer_data[vertex_buffer_index].mIndex1;
-                mesh_vertex_joint_binding[index_index].indices[2] = joint_binding_buffer_data[vertex_buffer_index].mIndex2;
-                mesh_vertex_joint_binding[index_index].indices[3] = joint_binding_buffer_data[vertex_buffer_index].mIndex3;
+                mesh_vertex_joint_binding[vertex_index].indices[0] = joint_binding_buffer_data[vertex_index].mIndex0;
+                mesh_vertex_joint_binding[vertex_index].indices[1] = joint_binding_buffer_data[vertex_index].mIndex1;
+                mesh_vertex_joint_binding[vertex_index].indices[2] = joint_binding_buffer_data[vertex_index].mIndex2;
+                mesh_vertex_joint_binding[vertex_index].indices[3] = joint_binding_buffer_data[vertex_index].mIndex3;
 
-                float inv_total_weight = joint_binding_buffer_data[vertex_buffer_index].mWeight0 +
-                                         joint_binding_buffer_data[vertex_buffer_index].mWeight1 +
-                                         joint_binding_buffer_data[vertex_buffer_index].mWeight2 +
-                                         joint_binding_buffer_data[vertex_buffer_index].mWeight3;
+                float inv_total_weight = joint_binding_buffer_data[vertex_index].mWeight0 +
+                                         joint_binding_buffer_data[vertex_index].mWeight1 +
+                                         joint_binding_buffer_data[vertex_index].mWeight2 +
+                                         joint_binding_buffer_data[vertex_index].mWeight3;
 
                 inv_total_weight = (inv_total_weight != 0.0) ? 1 / inv_total_weight : 1.0;
 
-                mesh_vertex_joint_binding[index_index].weights =
-                    Vector4(joint_binding_buffer_data[vertex_buffer_index].mWeight0 * inv_total_weight,
-                        joint_binding_buffer_data[vertex_buffer_index].mWeight1 * inv_total_weight,
-                        joint_binding_buffer_data[vertex_buffer_index].mWeight2 * inv_total_weight,
-                        joint_binding_buffer_data[vertex_buffer_index].mWeight3 * inv_total_weight);
+                mesh_vertex_joint_binding[vertex_index].weights =
+                    Vector4(joint_binding_buffer_data[vertex_index].mWeight0 * inv_total_weight,
+                        joint_binding_buffer_data[vertex_index].mWeight1 * inv_total_weight,
+                        joint_binding_buffer_data[vertex_index].mWeight2 * inv_total_weight,
+                        joint_binding_buffer_data[vertex_index].mWeight3 * inv_total_weight);
             }
 
             rhi->UnmapMemory(inefficient_staging_buffer_memory);
@@ -775,17 +840,7 @@ namespace MiniEngine
             rhi->FreeMemory(inefficient_staging_buffer_memory);
 
             // update descriptor set
-            RHIDescriptorSetAllocateInfo mesh_vertex_blending_per_mesh_descriptor_set_alloc_info;
-            mesh_vertex_blending_per_mesh_descriptor_set_alloc_info.sType =
-                RHI_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-            mesh_vertex_blending_per_mesh_descriptor_set_alloc_info.pNext = NULL;
-            mesh_vertex_blending_per_mesh_descriptor_set_alloc_info.descriptorPool = vulkan_context->mDescPool;
-            mesh_vertex_blending_per_mesh_descriptor_set_alloc_info.descriptorSetCount = 1;
-            mesh_vertex_blending_per_mesh_descriptor_set_alloc_info.pSetLayouts        = mMeshDescLayout;
-
-            if (RHI_SUCCESS != rhi->AllocateDescriptorSets(
-                &mesh_vertex_blending_per_mesh_descriptor_set_alloc_info,
-                now_mesh.mesh_vertex_blending_descriptor_set))
+            if (RHI_SUCCESS != rhi->AllocateDescriptorSet(*mMeshDescLayout, now_mesh.mesh_vertex_blending_descriptor_set))
             {
                 throw std::runtime_error("allocate mesh vertex blending per mesh descriptor set");
             }
@@ -825,10 +880,11 @@ namespace MiniEngine
             assert(0 == (vertex_buffer_size % sizeof(MeshVertexDataDefinition)));
             uint32_t vertex_count = vertex_buffer_size / sizeof(MeshVertexDataDefinition);
 
-            RHIDeviceSize vertex_position_buffer_size = sizeof(MeshVertex::VulkanMeshVertexPostition) * vertex_count;
+            auto          vertex_binding_descriptions = MeshVertex::GetBindingDescriptions(mbEnableVertexQuantization);
+            RHIDeviceSize vertex_position_buffer_size = vertex_binding_descriptions[0].stride * vertex_count;
             RHIDeviceSize vertex_varying_enable_blending_buffer_size =
-                sizeof(MeshVertex::VulkanMeshVertexVaryingEnableBlending) * vertex_count;
-            RHIDeviceSize vertex_varying_buffer_size = sizeof(MeshVertex::VulkanMeshVertexVarying) * vertex_count;
+                vertex_binding_descriptions[1].stride * vertex_count;
+            RHIDeviceSize vertex_varying_buffer_size = vertex_binding_descriptions[2].stride * vertex_count;
 
             RHIDeviceSize vertex_position_buffer_offset = 0;
             RHIDeviceSize vertex_varying_enable_blending_buffer_offset =
@@ -854,36 +910,13 @@ namespace MiniEngine
                            0,
                            &inefficient_staging_buffer_data);
 
-            MeshVertex::VulkanMeshVertexPostition* mesh_vertex_positions =
-                reinterpret_cast<MeshVertex::VulkanMeshVertexPostition*>(
-                    reinterpret_cast<uintptr_t>(inefficient_staging_buffer_data) + vertex_position_buffer_offset);
-            MeshVertex::VulkanMeshVertexVaryingEnableBlending* mesh_vertex_blending_varyings =
-                reinterpret_cast<MeshVertex::VulkanMeshVertexVaryingEnableBlending*>(
-                    reinterpret_cast<uintptr_t>(inefficient_staging_buffer_data) +
-                    vertex_varying_enable_blending_buffer_offset);
-            MeshVertex::VulkanMeshVertexVarying* mesh_vertex_varyings =
-                reinterpret_cast<MeshVertex::VulkanMeshVertexVarying*>(
-                    reinterpret_cast<uintptr_t>(inefficient_staging_buffer_data) + vertex_varying_buffer_offset);
-
-            for (uint32_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
-            {
-                Vector3 normal = Vector3(vertex_buffer_data[vertex_index].nx,
-                    vertex_buffer_data[vertex_index].ny,
-                    vertex_buffer_data[vertex_index].nz);
-                Vector3 tangent = Vector3(vertex_buffer_data[vertex_index].tx,
-                    vertex_buffer_data[vertex_index].ty,
-                    vertex_buffer_data[vertex_index].tz);
-
-                mesh_vertex_positions[vertex_index].position = Vector3(vertex_buffer_data[vertex_index].x,
-                    vertex_buffer_data[vertex_index].y,
-                    vertex_buffer_data[vertex_index].z);
-
-                mesh_vertex_blending_varyings[vertex_index].normal = normal;
-                mesh_vertex_blending_varyings[vertex_index].tangent = tangent;
-
-                mesh_vertex_varyings[vertex_index].texcoord =
-                    Vector2(vertex_buffer_data[vertex_index].u, vertex_buffer_data[vertex_index].v);
-            }
+            writeVertexStreams(vertex_count,
+                               vertex_buffer_data,
+                               static_cast<uint8_t*>(inefficient_staging_buffer_data) + vertex_position_buffer_offset,
+                               static_cast<uint8_t*>(inefficient_staging_buffer_data) +
+                                   vertex_varying_enable_blending_buffer_offset,
+                               static_cast<uint8_t*>(inefficient_staging_buffer_data) + vertex_varying_buffer_offset,
+                               now_mesh);
 
             rhi->UnmapMemory(inefficient_staging_buffer_memory);
 
@@ -938,17 +971,7 @@ namespace MiniEngine
             rhi->FreeMemory(inefficient_staging_buffer_memory);
 
             // update descriptor set
-            RHIDescriptorSetAllocateInfo mesh_vertex_blending_per_mesh_descriptor_set_alloc_info;
-            mesh_vertex_blending_per_mesh_descriptor_set_alloc_info.sType =
-                RHI_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-            mesh_vertex_blending_per_mesh_descriptor_set_alloc_info.pNext = NULL;
-            mesh_vertex_blending_per_mesh_descriptor_set_alloc_info.descriptorPool = vulkan_context->mDescPool;
-            mesh_vertex_blending_per_mesh_descriptor_set_alloc_info.descriptorSetCount = 1;
-            mesh_vertex_blending_per_mesh_descriptor_set_alloc_info.pSetLayouts        = mMeshDescLayout;
-
-            if (RHI_SUCCESS != rhi->AllocateDescriptorSets(
-                &mesh_vertex_blending_per_mesh_descriptor_set_alloc_info,
-                now_mesh.mesh_vertex_blending_descriptor_set))
+            if (RHI_SUCCESS != rhi->AllocateDescriptorSet(*mMeshDescLayout, now_mesh.mesh_vertex_blending_descriptor_set))
             {
                 throw std::runtime_error("allocate mesh vertex blending per mesh descriptor set");
             }
@@ -986,6 +1009,79 @@ namespace MiniEngine
         }
     }
 
+    void RenderResource::writeVertexStreams(uint32_t                        vertex_count,
+                                            MeshVertexDataDefinition const* vertex_buffer_data,
+                                            void*                           position_data,
+                                            void*                           varying_enable_blending_data,
+                                            void*                           varying_data,
+                                            VulkanMesh&                     now_mesh)
+    {
+        now_mesh.mesh_vertex_decode = VulkanMeshVertexDecode {};
+        if (!mbEnableVertexQuantization)
+        {
+            auto* mesh_vertex_positions = static_cast<MeshVertex::VulkanMeshVertexPostition*>(position_data);
+            auto* mesh_vertex_blending_varyings =
+                static_cast<MeshVertex::VulkanMeshVertexVaryingEnableBlending*>(varying_enable_blending_data);
+            auto* mesh_vertex_varyings = static_cast<MeshVertex::VulkanMeshVertexVarying*>(varying_data);
+
+            for (uint32_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
+            {
+                const MeshVertexDataDefinition& vertex = vertex_buffer_data[vertex_index];
+
+                mesh_vertex_positions[vertex_index].position        = Vector3(vertex.x, vertex.y, vertex.z);
+                mesh_vertex_blending_varyings[vertex_index].normal  = Vector3(vertex.nx, vertex.ny, vertex.nz);
+                mesh_vertex_blending_varyings[vertex_index].tangent = Vector3(vertex.tx, vertex.ty, vertex.tz);
+                mesh_vertex_varyings[vertex_index].texcoord         = Vector2(vertex.u, vertex.v);
+            }
+            return;
+        }
+
+        // positions are stored relative to the bounds, a flat axis keeps a zero scale
+        const float max_float = std::numeric_limits<float>::max();
+        Vector3     min_corner(max_float, max_float, max_float);
+        Vector3     max_corner(-max_float, -max_float, -max_float);
+        for (uint32_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
+        {
+            const MeshVertexDataDefinition& vertex = vertex_buffer_data[vertex_index];
+            min_corner.MakeFloor(Vector3(vertex.x, vertex.y, vertex.z));
+            max_corner.MakeCeil(Vector3(vertex.x, vertex.y, vertex.z));
+        }
+        if (vertex_count == 0)
+        {
+            min_corner = max_corner = Vector3(0.0f, 0.0f, 0.0f);
+        }
+        Vector3 extent = max_corner - min_corner;
+        Vector3 inv_extent(extent.x > 0.0f ? 1.0f / extent.x : 0.0f,
+                           extent.y > 0.0f ? 1.0f / extent.y : 0.0f,
+                           extent.z > 0.0f ? 1.0f / extent.z : 0.0f);
+
+        now_mesh.mesh_vertex_decode.position_scale             = extent;
+        now_mesh.mesh_vertex_decode.position_offset            = min_corner;
+        now_mesh.mesh_vertex_decode.enable_vertex_quantization = 1;
+
+        auto* mesh_vertex_positions = static_cast<MeshVertex::VulkanMeshVertexPositionQuantized*>(position_data);
+        auto* mesh_vertex_blending_varyings =
+            static_cast<MeshVertex::VulkanMeshVertexVaryingEnableBlendingQuantized*>(varying_enable_blending_data);
+        auto* mesh_vertex_varyings = static_cast<MeshVertex::VulkanMeshVertexVaryingQuantized*>(varying_data);
+
+        for (uint32_t vertex_index = 0; vertex_index < vertex_count; ++vertex_index)
+        {
+            const MeshVertexDataDefinition& vertex = vertex_buffer_data[vertex_index];
+
+            uint16_t* position = mesh_vertex_positions[vertex_index].position;
+            position[0]        = QuantizeUnorm16((vertex.x - min_corner.x) * inv_extent.x);
+            position[1]        = QuantizeUnorm16((vertex.y - min_corner.y) * inv_extent.y);
+            position[2]        = QuantizeUnorm16((vertex.z - min_corner.z) * inv_extent.z);
+            position[3]        = 0;
+
+            EncodeOctahedron(Vector3(vertex.nx, vertex.ny, vertex.nz), mesh_vertex_blending_varyings[vertex_index].normal);
+            EncodeOctahedron(Vector3(vertex.tx, vertex.ty, vertex.tz), mesh_vertex_blending_varyings[vertex_index].tangent);
+
+            mesh_vertex_varyings[vertex_index].texcoord[0] = FloatToHalf(vertex.u);
+            mesh_vertex_varyings[vertex_index].texcoord[1] = FloatToHalf(vertex.v);
+        }
+    }
+
     void RenderResource::updateIndexBuffer(std::shared_ptr<RHI> rhi,
                                            uint32_t             index_buffer_size,
                                            void*                index_buffer_data,
@@ -1080,6 +1176,177 @@ namespace MiniEngine
             texture_data.emissive_image_format);
     }
 
+    void RenderResource::releaseVulkanMesh(std::shared_ptr<RHI> rhi, VulkanMesh& mesh)
+    {
+        VmaAllocator allocator = static_cast<VulkanRHI*>(rhi.get())->mAssetsAllocator;
+
+        rhi->DestroyBufferVMA(allocator, mesh.mesh_vertex_position_buffer, mesh.mesh_vertex_position_buffer_allocation);
+        rhi->DestroyBufferVMA(allocator,
+                              mesh.mesh_vertex_varying_enable_blending_buffer,
+                              mesh.mesh_vertex_varying_enable_blending_buffer_allocation);
+        rhi->DestroyBufferVMA(allocator,
+                              mesh.mesh_vertex_joint_binding_buffer,
+                              mesh.mesh_vertex_joint_binding_buffer_allocation);
+        rhi->DestroyBufferVMA(allocator, mesh.mesh_vertex_varying_buffer, mesh.mesh_vertex_varying_buffer_allocation);
+        rhi->DestroyBufferVMA(allocator, mesh.mesh_index_buffer, mesh.mesh_index_buffer_allocation);
+
+        rhi->FreeDescriptorSet(*mMeshDescLayout, mesh.mesh_vertex_blending_descriptor_set);
+        mesh.mesh_vertex_blending_descriptor_set = nullptr;
+    }
+
+    void RenderResource::releaseVulkanMaterial(std::shared_ptr<RHI> rhi, VulkanPBRMaterial& material)
+    {
+        VmaAllocator allocator = static_cast<VulkanRHI*>(rhi.get())->mAssetsAllocator;
+
+        rhi->DestroyImageVMA(allocator,
+                             material.base_color_texture_image,
+                             material.base_color_image_view,
+                             material.base_color_image_allocation);
+        rhi->DestroyImageVMA(allocator,
+                             material.metallic_roughness_texture_image,
+                             material.metallic_roughness_image_view,
+                             material.metallic_roughness_image_allocation);
+        rhi->DestroyImageVMA(allocator,
+                             material.normal_texture_image,
+                             material.normal_image_view,
+                             material.normal_image_allocation);
+        rhi->DestroyImageVMA(allocator,
+                             material.occlusion_texture_image,
+                             material.occlusion_image_view,
+                             material.occlusion_image_allocation);
+        rhi->DestroyImageVMA(allocator,
+                             material.emissive_texture_image,
+                             material.emissive_image_view,
+                             material.emissive_image_allocation);
+        rhi->DestroyBufferVMA(allocator, material.material_uniform_buffer, material.material_uniform_buffer_allocation);
+
+        if (mbEnableBindlessMaterials)
+        {
+            releaseBindlessMaterial(material);
+            return;
+        }
+        rhi->FreeDescriptorSet(*mMaterialDescLayout, material.material_descriptor_set);
+        material.material_descriptor_set = nullptr;
+    }
+
+    void RenderResource::createBindlessMaterialResource(std::shared_ptr<RHI> rhi)
+    {
+        BindlessMaterialResource& bindless = mGlobalRenderResource.mBindlessMaterial;
+        bindless.mMaxTextureCount          = rhi->GetMaxBindlessTextureCount();
+
+        // written by the cpu only when a material is created, so it stays in host visible memory
+        RHIDeviceSize buffer_size = sizeof(VulkanBindlessMaterial) * s_max_bindless_material_count;
+        rhi->CreateBuffer(buffer_size,
+                          RHI_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                          RHI_MEMORY_PROPERTY_HOST_VISIBLE_BIT | RHI_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                          bindless.mMaterialBuffer,
+                          bindless.mMaterialBufferMemory);
+        void* material_buffer_pointer = nullptr;
+        rhi->MapMemory(bindless.mMaterialBufferMemory, 0, RHI_WHOLE_SIZE, 0, &material_buffer_pointer);
+        bindless.mMaterialBufferPointer = static_cast<VulkanBindlessMaterial*>(material_buffer_pointer);
+
+        if (RHI_SUCCESS != rhi->AllocateDescriptorSet(*mMaterialDescLayout, bindless.mDescriptorSet))
+        {
+            throw std::runtime_error("allocate bindless material descriptor set");
+        }
+
+        RHIDescriptorBufferInfo material_buffer_info = {};
+        material_buffer_info.offset                  = 0;
+        material_buffer_info.range                   = buffer_size;
+        material_buffer_info.buffer                  = bindless.mMaterialBuffer;
+
+        RHIWriteDescriptorSet material_buffer_write = {};
+        material_buffer_write.sType                 = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        material_buffer_write.pNext                 = NULL;
+        material_buffer_write.dstSet                = bindless.mDescriptorSet;
+        material_buffer_write.dstBinding            = 0;
+        material_buffer_write.dstArrayElement       = 0;
+        material_buffer_write.descriptorType        = RHI_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        material_buffer_write.descriptorCount       = 1;
+        material_buffer_write.pBufferInfo           = &material_buffer_info;
+
+        rhi->UpdateDescriptorSets(1, &material_buffer_write, 0, nullptr);
+    }
+
+    void RenderResource::writeBindlessMaterial(std::shared_ptr<RHI>         rhi,
+                                               const RenderEntity&          entity,
+                                               RHIDescriptorImageInfo (&image_infos)[5],
+                                               VulkanPBRMaterial&           now_material)
+    {
+        BindlessMaterialResource& bindless = mGlobalRenderResource.mBindlessMaterial;
+        if (bindless.mDescriptorSet == nullptr)
+        {
+            createBindlessMaterialResource(rhi);
+        }
+
+        auto take_index = [](std::vector<uint32_t>& free_indices, uint32_t& count, uint32_t max_count, const char* what) {
+            if (!free_indices.empty())
+            {
+                uint32_t index = free_indices.back();
+                free_indices.pop_back();
+                return index;
+            }
+            if (count == max_count)
+            {
+                throw std::runtime_error(what);
+            }
+            return count++;
+        };
+
+        now_material.bindless_material_index = take_index(bindless.mFreeMaterialIndices,
+                                                          bindless.mMaterialCount,
+                                                          s_max_bindless_material_count,
+                                                          "bindless material buffer is full");
+
+        // the texture array binding is update after bind, frames in flight keep using the slots they read
+        RHIWriteDescriptorSet texture_writes[5];
+        for (uint32_t i = 0; i < 5; ++i)
+        {
+            now_material.bindless_texture_indices[i] = take_index(bindless.mFreeTextureIndices,
+                                                                  bindless.mTextureCount,
+                                                                  bindless.mMaxTextureCount,
+                                                                  "bindless texture array is full");
+
+            texture_writes[i]                 = {};
+            texture_writes[i].sType           = RHI_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            texture_writes[i].pNext           = NULL;
+            texture_writes[i].dstSet          = bindless.mDescriptorSet;
+            texture_writes[i].dstBinding      = 1;
+            texture_writes[i].dstArrayElement = now_material.bindless_texture_indices[i];
+            texture_writes[i].descriptorType  = RHI_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            texture_writes[i].descriptorCount = 1;
+            texture_writes[i].pImageInfo      = &image_infos[i];
+        }
+        rhi->UpdateDescriptorSets(5, texture_writes, 0, nullptr);
+
+        VulkanBindlessMaterial& material_info =
+            bindless.mMaterialBufferPointer[now_material.bindless_material_index];
+        material_info.baseColorFactor                  = entity.mBaseColorFactor;
+        material_info.metallicFactor                   = entity.mMetalicFactor;
+        material_info.roughnessFactor                  = entity.mRoughnessFactor;
+        material_info.normalScale                      = entity.mNormalScale;
+        material_info.occlusionStrength                = entity.mOcclusionStrength;
+        material_info.emissiveFactor                   = entity.mEmissiveFactor;
+        material_info.is_blend                         = entity.mBlend;
+        material_info.is_double_sided                  = entity.mDoubleSided;
+        material_info.base_color_texture_index         = now_material.bindless_texture_indices[0];
+        material_info.metallic_roughness_texture_index = now_material.bindless_texture_indices[1];
+        material_info.normal_texture_index             = now_material.bindless_texture_indices[2];
+        material_info.occlusion_texture_index          = now_material.bindless_texture_indices[3];
+        material_info.emissive_texture_index           = now_material.bindless_texture_indices[4];
+    }
+
+    void RenderResource::releaseBindlessMaterial(VulkanPBRMaterial& material)
+    {
+        // materials are only released once no frame in flight reads them, so the slots are free right away
+        BindlessMaterialResource& bindless = mGlobalRenderResource.mBindlessMaterial;
+        bindless.mFreeMaterialIndices.push_back(material.bindless_material_index);
+        for (uint32_t texture_index : material.bindless_texture_indices)
+        {
+            bindless.mFreeTextureIndices.push_back(texture_index);
+        }
+    }
+
     VulkanMesh& RenderResource::GetEntityMesh(RenderEntity entity)
     {
         size_t assetid = entity.mMeshAssetID;
@@ -1110,17 +1377,145 @@ namespace MiniEngine
         }
     }
 
-    void RenderResource::ResetRingBufferOffset(uint8_t current_frame_index)
+    void RenderResource::BeginUploadFrame(std::shared_ptr<RHI> rhi, uint8_t current_frame_index)
     {
-        mGlobalRenderResource.mStorageBuffer.mGlobalUploadRingbuffersEnd[current_frame_index] =
-            mGlobalRenderResource.mStorageBuffer.mGlobalUploadRingbuffersBegin[current_frame_index];
+        mGlobalRenderResource.mStorageBuffer.mGlobalUploadBuffer.BeginFrame(current_frame_index);
+
+        // the fence covers every frame submitted before these assets were released
+        PendingAssetRelease& pending = mPendingAssetReleases[current_frame_index];
+        for (VulkanMesh& mesh : pending.mMeshes)
+        {
+            releaseVulkanMesh(rhi, mesh);
+        }
+        for (VulkanPBRMaterial& material : pending.mMaterials)
+        {
+            releaseVulkanMaterial(rhi, material);
+        }
+        pending.mMeshes.clear();
+        pending.mMaterials.clear();
+
+        // released while recording frames that are still in flight, so they wait for this frame's fence
+        std::swap(pending, mReleasedAssets);
+    }
+
+    void RenderResource::EvictUnusedAssets(RenderScene& render_scene)
+    {
+        // the budget is split evenly between meshes and materials
+        std::vector<size_t>& evicted_asset_ids = mEvictedAssetIDs;
+
+        evicted_asset_ids.clear();
+        mMeshResidency.CollectEvictions(mUnusedAssetBudget / 2, evicted_asset_ids);
+        for (size_t mesh_asset_id : evicted_asset_ids)
+        {
+            auto mesh_iter = mVulkanMesh.find(mesh_asset_id);
+            if (mesh_iter != mVulkanMesh.end())
+            {
+                deferReleaseVulkanMesh(mesh_iter);
+            }
+
+            // the source is loaded from disk again when an entity asks for it
+            MeshSourceDesc mesh_source;
+            if (render_scene.GetMeshAssetIDAllocator().GetGuidRelatedElement(mesh_asset_id, mesh_source))
+            {
+                EraseCachedBoundingBox(mesh_source);
+            }
+            render_scene.GetMeshAssetIDAllocator().FreeGuid(mesh_asset_id);
+        }
+
+        evicted_asset_ids.clear();
+        mMaterialResidency.CollectEvictions(mUnusedAssetBudget / 2, evicted_asset_ids);
+        for (size_t material_asset_id : evicted_asset_ids)
+        {
+            auto material_iter = mVulkanPBRMaterial.find(material_asset_id);
+            if (material_iter != mVulkanPBRMaterial.end())
+            {
+                deferReleaseVulkanMaterial(material_iter);
+            }
+            render_scene.GetMaterialAssetdAllocator().FreeGuid(material_asset_id);
+        }
+    }
+
+    RenderMemoryReport RenderResource::GetMemoryReport() const
+    {
+        RenderMemoryReport report;
+
+        for (const auto& [asset_id, mesh] : mVulkanMesh)
+        {
+            ++report.mMeshCount;
+            report.mMeshSize += getMeshSize(mesh);
+        }
+        report.mUnusedMeshCount = mMeshResidency.GetUnusedCount();
+        report.mUnusedMeshSize  = mMeshResidency.GetUnusedSize();
+
+        for (const auto& [asset_id, material] : mVulkanPBRMaterial)
+        {
+            ++report.mMaterialCount;
+            report.mMaterialSize += getMaterialSize(material);
+        }
+        report.mUnusedMaterialCount = mMaterialResidency.GetUnusedCount();
+        report.mUnusedMaterialSize  = mMaterialResidency.GetUnusedSize();
+
+        auto add_pending = [&](const PendingAssetRelease& pending) {
+            report.mPendingReleaseCount += static_cast<uint32_t>(pending.mMeshes.size() + pending.mMaterials.size());
+            for (const VulkanMesh& mesh : pending.mMeshes)
+            {
+                report.mPendingReleaseSize += getMeshSize(mesh);
+            }
+            for (const VulkanPBRMaterial& material : pending.mMaterials)
+            {
+                report.mPendingReleaseSize += getMaterialSize(material);
+            }
+        };
+        add_pending(mReleasedAssets);
+        for (const PendingAssetRelease& pending : mPendingAssetReleases)
+        {
+            add_pending(pending);
+        }
+
+        // every frame in flight holds one page of at least this size
+        report.mUploadBufferSize = static_cast<uint64_t>(mGlobalRenderResource.mStorageBuffer.mGlobalUploadBuffer.GetPageSize()) *
+                                   mPendingAssetReleases.size();
+        return report;
+    }
+
+    void RenderResource::deferReleaseVulkanMesh(std::map<size_t, VulkanMesh>::iterator mesh_iter)
+    {
+        mReleasedAssets.mMeshes.push_back(mesh_iter->second);
+        mVulkanMesh.erase(mesh_iter);
+    }
+
+    void RenderResource::deferReleaseVulkanMaterial(std::map<size_t, VulkanPBRMaterial>::iterator material_iter)
+    {
+        mReleasedAssets.mMaterials.push_back(material_iter->second);
+        mVulkanPBRMaterial.erase(material_iter);
+    }
+
+    uint64_t RenderResource::getMeshSize(const VulkanMesh& mesh) const
+    {
+        return allocationSize(mAssetsAllocator, mesh.mesh_vertex_position_buffer_allocation) +
+               allocationSize(mAssetsAllocator, mesh.mesh_vertex_varying_enable_blending_buffer_allocation) +
+               allocationSize(mAssetsAllocator, mesh.mesh_vertex_joint_binding_buffer_allocation) +
+               allocationSize(mAssetsAllocator, mesh.mesh_vertex_varying_buffer_allocation) +
+               allocationSize(mAssetsAllocator, mesh.mesh_index_buffer_allocation);
+    }
+
+    uint64_t RenderResource::getMaterialSize(const VulkanPBRMaterial& material) const
+    {
+        return allocationSize(mAssetsAllocator, material.base_color_image_allocation) +
+               allocationSize(mAssetsAllocator, material.metallic_roughness_image_allocation) +
+               allocationSize(mAssetsAllocator, material.normal_image_allocation) +
+               allocationSize(mAssetsAllocator, material.occlusion_image_allocation) +
+               allocationSize(mAssetsAllocator, material.emissive_image_allocation) +
+               allocationSize(mAssetsAllocator, material.material_uniform_buffer_allocation);
     }
 
     void RenderResource::createAndMapStorageBuffer(std::shared_ptr<RHI> rhi)
     {
         VulkanRHI* raw_rhi = static_cast<VulkanRHI*>(rhi.get());
         StorageBuffer& _storage_buffer = mGlobalRenderResource.mStorageBuffer;
-        uint32_t       frames_in_flight = raw_rhi->mkMaxFramesInFlight;
+        uint32_t       frames_in_flight = raw_rhi->GetMaxFramesInFlight();
+        mAssetsAllocator                = raw_rhi->mAssetsAllocator;
+        mPendingAssetReleases.resize(frames_in_flight);
         RHIPhysicalDeviceProperties properties;
         rhi->GetPhysicalDeviceProperties(&properties);
 
@@ -1131,26 +1526,11 @@ namespace MiniEngine
         _storage_buffer.mMaxStorageBufferRange = properties.limits.maxStorageBufferRange;
         _storage_buffer.mNonCoherentAtomSize = properties.limits.nonCoherentAtomSize;
 
-        // In Vulkan, the storage buffer should be pre-allocated.
-        // The size is 128MB in NVIDIA D3D11
-        // driver(https://developer.nvidia.com/content/constant-buffers-without-constant-pain-0).
-        uint32_t global_storage_buffer_size = 1024 * 1024 * 128;
-        rhi->CreateBuffer(global_storage_buffer_size,
-                          RHI_BUFFER_USAGE_STORAGE_BUFFER_BIT,
-                          RHI_MEMORY_PROPERTY_HOST_VISIBLE_BIT | RHI_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                          _storage_buffer.mGlobalUploadRingbuffer,
-                          _storage_buffer.mGlobalUploadRingbufferMemory);
-
-        _storage_buffer.mGlobalUploadRingbuffersBegin.resize(frames_in_flight);
-        _storage_buffer.mGlobalUploadRingbuffersEnd.resize(frames_in_flight);
-        _storage_buffer.mGlobalUploadRingbuffersSize.resize(frames_in_flight);
-        for (uint32_t i = 0; i < frames_in_flight; ++i)
-        {
-            _storage_buffer.mGlobalUploadRingbuffersBegin[i] = (global_storage_buffer_size * i) / frames_in_flight;
-            _storage_buffer.mGlobalUploadRingbuffersSize[i] =
-                (global_storage_buffer_size * (i + 1)) / frames_in_flight -
-                (global_storage_buffer_size * i) / frames_in_flight;
-        }
+        // one page per frame in flight, pages grow when a frame writes more.
+        // a page has to hold the largest descriptor range read from offset zero (vertex blending)
+        static_assert(sizeof(MeshPerdrawcallVertexBlendingStorageBufferObject) <= s_upload_page_size, "");
+        _storage_buffer.mGlobalUploadBuffer.Initialize(
+            rhi, frames_in_flight, s_upload_page_size, _storage_buffer.mMinStorageBufferOffsetAlignment);
 
         // axis
         rhi->CreateBuffer(sizeof(AxisStorageBufferObject),
@@ -1166,13 +1546,6 @@ namespace MiniEngine
                           _storage_buffer.mGlobalNullDescStorageBuffer,
                           _storage_buffer.mGlobalNullDescStorageBufferMemory);
 
-        // TODO: Unmap when program terminates
-        rhi->MapMemory(_storage_buffer.mGlobalUploadRingbufferMemory,
-                       0,
-                       RHI_WHOLE_SIZE,
-                       0,
-                       &_storage_buffer.mGlobalUploadRingbufferMemoryPointer);
-
         rhi->MapMemory(_storage_buffer.mAxisInefficientStorageBufferMemory,
                        0,
                        RHI_WHOLE_SIZE,
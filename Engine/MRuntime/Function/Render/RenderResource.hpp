@@ -1,7 +1,10 @@
 #pragma once
 
 #include "MRuntime/Function/Render/RenderResourceBase.hpp"
+#include "MRuntime/Function/Render/AssetResidency.hpp"
+#include "MRuntime/Function/Render/LightCluster.hpp"
 #include "MRuntime/Function/Render/RenderType.hpp"
+#include "MRuntime/Function/Render/UploadBufferAllocator.hpp"
 #include "MRuntime/Function/Render/Interface/RHI.hpp"
 
 #include <vk_mem_alloc.h>
@@ -76,12 +79,7 @@ namespace MiniEngine
         uint32_t                mMaxStorageBufferRange{ 1 << 27 };
         uint32_t                mNonCoherentAtomSize{ 256 };
 
-        RHIBuffer*              mGlobalUploadRingbuffer;
-        RHIDeviceMemory*        mGlobalUploadRingbufferMemory;
-        void*                   mGlobalUploadRingbufferMemoryPointer;
-        std::vector<uint32_t>   mGlobalUploadRingbuffersBegin;
-        std::vector<uint32_t>   mGlobalUploadRingbuffersEnd;
-        std::vector<uint32_t>   mGlobalUploadRingbuffersSize;
+        UploadBufferAllocator   mGlobalUploadBuffer;
 
         RHIBuffer*              mGlobalNullDescStorageBuffer;
         RHIDeviceMemory*        mGlobalNullDescStorageBufferMemory;
@@ -92,11 +90,44 @@ namespace MiniEngine
         void*                   mAxisInefficientStorageBufferMemoryPointer;
     };
 
+    // material buffer and texture array shared by all materials on the bindless path,
+    // slots of released materials are handed out again
+    struct BindlessMaterialResource
+    {
+        RHIDescriptorSet*       mDescriptorSet {nullptr};
+        RHIBuffer*              mMaterialBuffer {nullptr};
+        RHIDeviceMemory*        mMaterialBufferMemory {nullptr};
+        VulkanBindlessMaterial* mMaterialBufferPointer {nullptr};
+
+        uint32_t              mMaterialCount {0};
+        std::vector<uint32_t> mFreeMaterialIndices;
+        uint32_t              mTextureCount {0};
+        uint32_t              mMaxTextureCount {0};
+        std::vector<uint32_t> mFreeTextureIndices;
+    };
+
     struct GlobalRenderResource
     {
-        IBLResource          mIBLResource;
-        ColorGradingResource mColorGradientResource;
-        StorageBuffer        mStorageBuffer;
+        IBLResource              mIBLResource;
+        ColorGradingResource     mColorGradientResource;
+        StorageBuffer            mStorageBuffer;
+        BindlessMaterialResource mBindlessMaterial;
+    };
+
+    // gpu memory of the render resources by category, in bytes
+    struct RenderMemoryReport
+    {
+        uint32_t mMeshCount {0};
+        uint64_t mMeshSize {0};
+        uint32_t mUnusedMeshCount {0};
+        uint64_t mUnusedMeshSize {0};
+        uint32_t mMaterialCount {0};
+        uint64_t mMaterialSize {0};
+        uint32_t mUnusedMaterialCount {0};
+        uint64_t mUnusedMaterialSize {0};
+        uint32_t mPendingReleaseCount {0};
+        uint64_t mPendingReleaseSize {0};
+        uint64_t mUploadBufferSize {0};
     };
 
     class RenderResource : public RenderResourceBase
@@ -120,6 +151,14 @@ namespace MiniEngine
             RenderEntity         render_entity,
             RenderMaterialData   material_data) override final;
 
+        virtual void ReloadGameObjectRenderResource(std::shared_ptr<RHI> rhi,
+            RenderEntity         render_entity,
+            RenderMeshData       mesh_data) override final;
+
+        virtual void ReloadGameObjectRenderResource(std::shared_ptr<RHI> rhi,
+            RenderEntity         render_entity,
+            RenderMaterialData   material_data) override final;
+
         virtual void UpdatePerFrameBuffer(std::shared_ptr<RenderScene>  render_scene,
             std::shared_ptr<RenderCamera> camera) override final;
 
@@ -127,7 +166,14 @@ namespace MiniEngine
 
         VulkanPBRMaterial& GetEntityMaterial(RenderEntity entity);
 
-        void ResetRingBufferOffset(uint8_t current_frame_index);
+        // also destroys the assets evicted before the fence of the frame was waited on
+        void BeginUploadFrame(std::shared_ptr<RHI> rhi, uint8_t current_frame_index);
+
+        // unreferenced meshes and materials beyond the unused budget lose their asset ids now,
+        // their gpu resources are destroyed once no frame in flight can read them
+        void EvictUnusedAssets(RenderScene& render_scene);
+
+        RenderMemoryReport GetMemoryReport() const;
 
     private:
         void createAndMapStorageBuffer(std::shared_ptr<RHI> rhi);
@@ -144,6 +190,8 @@ namespace MiniEngine
                             bool                                          enable_vertex_blending,
                             uint32_t                                      index_buffer_size,
                             void*                                         index_buffer_data,
+                            RHIIndexType                                  index_type,
+                            const std::vector<MeshLod>&                   lods,
                             uint32_t                                      vertex_buffer_size,
                             struct MeshVertexDataDefinition const*        vertex_buffer_data,
                             uint32_t                                      joint_binding_buffer_size,
@@ -155,15 +203,40 @@ namespace MiniEngine
                                 struct MeshVertexDataDefinition const*        vertex_buffer_data,
                                 uint32_t                                      joint_binding_buffer_size,
                                 struct MeshVertexBindingDataDefinition const* joint_binding_buffer_data,
-                                uint32_t                                      index_buffer_size,
-                                uint16_t*                                     index_buffer_data,
                                 VulkanMesh&                                   now_mesh);
+        void writeVertexStreams(uint32_t                               vertex_count,
+                                struct MeshVertexDataDefinition const* vertex_buffer_data,
+                                void*                                  position_data,
+                                void*                                  varying_enable_blending_data,
+                                void*                                  varying_data,
+                                VulkanMesh&                            now_mesh);
         void updateIndexBuffer(std::shared_ptr<RHI> rhi,
                                uint32_t             index_buffer_size,
                                void*                index_buffer_data,
                                VulkanMesh&          now_mesh);
         void updateTextureImageData(std::shared_ptr<RHI> rhi, const TextureDataToUpdate& texture_data);
 
+        void createBindlessMaterialResource(std::shared_ptr<RHI> rhi);
+        void writeBindlessMaterial(std::shared_ptr<RHI>         rhi,
+                                   const RenderEntity&          entity,
+                                   RHIDescriptorImageInfo (&image_infos)[5],
+                                   VulkanPBRMaterial&           now_material);
+        void releaseBindlessMaterial(VulkanPBRMaterial& material);
+
+        void releaseVulkanMesh(std::shared_ptr<RHI> rhi, VulkanMesh& mesh);
+        void releaseVulkanMaterial(std::shared_ptr<RHI> rhi, VulkanPBRMaterial& material);
+        void deferReleaseVulkanMesh(std::map<size_t, VulkanMesh>::iterator mesh_iter);
+        void deferReleaseVulkanMaterial(std::map<size_t, VulkanPBRMaterial>::iterator material_iter);
+
+        uint64_t getMeshSize(const VulkanMesh& mesh) const;
+        uint64_t getMaterialSize(const VulkanPBRMaterial& material) const;
+
+        struct PendingAssetRelease
+        {
+            std::vector<VulkanMesh>        mMeshes;
+            std::vector<VulkanPBRMaterial> mMaterials;
+        };
+
     public:
         // global rendering resource, include IBL data, global storage buffer
         GlobalRenderResource mGlobalRenderResource;
@@ -175,12 +248,35 @@ namespace MiniEngine
         AxisStorageBufferObject                        mAxisStorageBufferObject;
         MeshInefficientPickPerFrameStorageBufferObject mMeshInEffPickPerFrameStorageBufferObject;
 
+        // per-cluster point light lists, rebuilt every frame
+        LightClusterBuilder mLightClusterBuilder;
+
         // cached mesh and material
         std::map<size_t, VulkanMesh>        mVulkanMesh;
         std::map<size_t, VulkanPBRMaterial> mVulkanPBRMaterial;
 
+        // reference counts of the cached meshes and materials, taken by the render entities using them
+        AssetResidency mMeshResidency;
+        AssetResidency mMaterialResidency;
+        // size of the unreferenced meshes and materials kept loaded
+        uint64_t mUnusedAssetBudget {256ull * 1024 * 1024};
+
         // descriptor set layout in main camera pass will be used when uploading resource
         RHIDescriptorSetLayout* const* mMeshDescLayout {nullptr};
         RHIDescriptorSetLayout* const* mMaterialDescLayout {nullptr};
+
+        // meshes uploaded afterwards use the quantized vertex streams, has to match the mesh pipelines
+        bool mbEnableVertexQuantization {false};
+        // materials go into the bindless material buffer and texture array instead of a descriptor set each,
+        // mMaterialDescLayout is then the layout of the bindless set
+        bool mbEnableBindlessMaterials {false};
+
+    private:
+        VmaAllocator mAssetsAllocator {nullptr};
+
+        // released since the last BeginUploadFrame, then parked with the frame until its fence comes around again
+        PendingAssetRelease              mReleasedAssets;
+        std::vector<PendingAssetRelease> mPendingAssetReleases;
+        std::vector<size_t>              mEvictedAssetIDs;
     };
 } // namespace MiniEngine
@@ -3,9 +3,11 @@
 
 #include "MRuntime/Resource/AssetManager/AssetManager.hpp"
 #include "MRuntime/Resource/ConfigManager/ConfigManager.hpp"
+#include "MRuntime/Resource/DerivedDataCache/DerivedDataCache.hpp"
 #include "MRuntime/Resource/ResourceType/Data/MeshData.hpp"
 
 #include "MRuntime/Function/Global/GlobalContext.hpp"
+#include "MRuntime/Function/Render/MeshOptimizer.hpp"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
@@ -14,27 +16,208 @@
 #include <tiny_obj_loader.h>
 
 #include <algorithm>
+#include <cstring>
 #include <filesystem>
+#include <numeric>
 #include <vector>
 
 namespace MiniEngine
 {
+    namespace
+    {
+        // bump when the import code below changes, entries written by older importers are ignored
+        const uint32_t s_mesh_importer_version    = 3;
+        const uint32_t s_texture_importer_version = 1;
+
+        void writeBufferData(DerivedDataWriter& writer, const std::shared_ptr<BufferData>& buffer)
+        {
+            writer.Write<uint8_t>(buffer ? 1 : 0);
+            if (buffer)
+            {
+                writer.Write<uint64_t>(buffer->mSize);
+                writer.WriteBytes(buffer->mData, buffer->mSize);
+            }
+        }
+
+        bool readBufferData(DerivedDataReader& reader, std::shared_ptr<BufferData>& buffer)
+        {
+            uint8_t has_buffer = 0;
+            if (!reader.Read(has_buffer))
+                return false;
+            if (has_buffer == 0)
+            {
+                buffer.reset();
+                return true;
+            }
+
+            uint64_t size = 0;
+            if (!reader.Read(size))
+                return false;
+            buffer = std::make_shared<BufferData>(static_cast<size_t>(size));
+            return reader.ReadBytes(buffer->mData, buffer->mSize);
+        }
+
+        std::vector<uint8_t> writeMeshData(const RenderMeshData& mesh_data, const AxisAlignedBox& bounding_box)
+        {
+            DerivedDataWriter writer;
+            const Vector3&    min_corner = bounding_box.GetMinCorner();
+            const Vector3&    max_corner = bounding_box.GetMaxCorner();
+            for (float value : {min_corner.x, min_corner.y, min_corner.z, max_corner.x, max_corner.y, max_corner.z})
+            {
+                writer.Write(value);
+            }
+            writeBufferData(writer, mesh_data.mStaticMeshData.mVertexBuffer);
+            writeBufferData(writer, mesh_data.mStaticMeshData.mIndexBuffer);
+            writer.Write<uint32_t>(mesh_data.mStaticMeshData.mIndexType);
+            writer.Write<uint32_t>(static_cast<uint32_t>(mesh_data.mStaticMeshData.mLods.size()));
+            for (const MeshLod& lod : mesh_data.mStaticMeshData.mLods)
+            {
+                writer.Write(lod.mIndexOffset);
+                writer.Write(lod.mIndexCount);
+                writer.Write(lod.mError);
+            }
+            writeBufferData(writer, mesh_data.mSkeletonBindingBuffer);
+            return writer.GetData();
+        }
+
+        bool readMeshData(const std::vector<uint8_t>& data, RenderMeshData& mesh_data, AxisAlignedBox& bounding_box)
+        {
+            DerivedDataReader reader(data);
+            Vector3           min_corner;
+            Vector3           max_corner;
+            RenderMeshData    cached_mesh_data;
+            uint32_t          index_type = RHI_INDEX_TYPE_UINT16;
+            uint32_t          lod_count  = 0;
+            if (!reader.Read(min_corner.x) || !reader.Read(min_corner.y) || !reader.Read(min_corner.z) ||
+                !reader.Read(max_corner.x) || !reader.Read(max_corner.y) || !reader.Read(max_corner.z) ||
+                !readBufferData(reader, cached_mesh_data.mStaticMeshData.mVertexBuffer) ||
+                !readBufferData(reader, cached_mesh_data.mStaticMeshData.mIndexBuffer) || !reader.Read(index_type) ||
+                !reader.Read(lod_count) || lod_count > s_mesh_max_lod_count)
+            {
+                return false;
+            }
+            if (index_type != RHI_INDEX_TYPE_UINT16 && index_type != RHI_INDEX_TYPE_UINT32)
+            {
+                return false;
+            }
+
+            // every level has to lie inside the index buffer
+            const std::shared_ptr<BufferData>& index_buffer = cached_mesh_data.mStaticMeshData.mIndexBuffer;
+            uint64_t index_count = index_buffer ? index_buffer->mSize / (index_type == RHI_INDEX_TYPE_UINT16 ? 2 : 4) : 0;
+            cached_mesh_data.mStaticMeshData.mLods.resize(lod_count);
+            for (MeshLod& lod : cached_mesh_data.mStaticMeshData.mLods)
+            {
+                if (!reader.Read(lod.mIndexOffset) || !reader.Read(lod.mIndexCount) || !reader.Read(lod.mError) ||
+                    static_cast<uint64_t>(lod.mIndexOffset) + lod.mIndexCount > index_count)
+                {
+                    return false;
+                }
+            }
+            if (!readBufferData(reader, cached_mesh_data.mSkeletonBindingBuffer) || !reader.IsEnd())
+            {
+                return false;
+            }
+            cached_mesh_data.mStaticMeshData.mIndexType = static_cast<RHIIndexType>(index_type);
+
+            mesh_data = cached_mesh_data;
+            bounding_box.Merge(min_corner);
+            bounding_box.Merge(max_corner);
+            return true;
+        }
+
+        void optimizeMesh(const std::string&                            mesh_file,
+                          std::vector<MeshVertexDataDefinition>&        vertices,
+                          std::vector<uint32_t>&                        indices,
+                          std::vector<MeshVertexBindingDataDefinition>* bindings,
+                          StaticMeshData&                               mesh_data)
+        {
+            MeshOptimizeStats stats = MeshOptimizer::Optimize(vertices, indices, bindings);
+            LOG_INFO("optimized mesh {}: {} -> {} vertices, {} triangles, acmr {:.2f} -> {:.2f}, {} bit indices",
+                     mesh_file,
+                     stats.mInputVertexCount,
+                     stats.mOutputVertexCount,
+                     stats.mTriangleCount,
+                     stats.mACMRBefore,
+                     stats.mACMRAfter,
+                     vertices.size() <= std::numeric_limits<uint16_t>::max() ? 16 : 32);
+
+            MeshOptimizer::BuildLods(vertices, indices, mesh_data.mLods);
+            for (size_t lod_index = 1; lod_index < mesh_data.mLods.size(); ++lod_index)
+            {
+                LOG_INFO("mesh {} lod {}: {} triangles, error {}",
+                         mesh_file,
+                         lod_index,
+                         mesh_data.mLods[lod_index].mIndexCount / 3,
+                         mesh_data.mLods[lod_index].mError);
+            }
+
+            mesh_data.mVertexBuffer = std::make_shared<BufferData>(vertices.size() * sizeof(MeshVertexDataDefinition));
+            memcpy(mesh_data.mVertexBuffer->mData, vertices.data(), mesh_data.mVertexBuffer->mSize);
+            MeshOptimizer::BuildIndexBuffer(indices, static_cast<uint32_t>(vertices.size()), mesh_data);
+        }
+
+        std::vector<uint8_t> writeTextureData(const TextureData& texture, size_t pixel_size)
+        {
+            DerivedDataWriter writer;
+            writer.Write(texture.mWidth);
+            writer.Write(texture.mHeight);
+            writer.WriteBytes(texture.mPixels, size_t(texture.mWidth) * texture.mHeight * pixel_size);
+            return writer.GetData();
+        }
+
+        bool readTextureData(const std::vector<uint8_t>& data, TextureData& texture, size_t pixel_size)
+        {
+            DerivedDataReader reader(data);
+            uint32_t          width  = 0;
+            uint32_t          height = 0;
+            if (!reader.Read(width) || !reader.Read(height))
+                return false;
+
+            // same allocator as stbi, the texture frees its pixels with free()
+            size_t size   = size_t(width) * height * pixel_size;
+            void*  pixels = malloc(size);
+            if (pixels == nullptr || !reader.ReadBytes(pixels, size) || !reader.IsEnd())
+            {
+                free(pixels);
+                return false;
+            }
+
+            texture.mPixels = pixels;
+            texture.mWidth  = width;
+            texture.mHeight = height;
+            return true;
+        }
+    } // namespace
+
     std::shared_ptr<TextureData> RenderResourceBase::LoadTextureHDR(std::string file, int desired_channels)
     {
         std::shared_ptr<AssetManager> asset_manager = gRuntimeGlobalContext.mAssetManager;
         ASSERT(asset_manager);
 
+        std::shared_ptr<DerivedDataCache> derived_data_cache = gRuntimeGlobalContext.mDerivedDataCache;
+        ASSERT(derived_data_cache);
+
         std::shared_ptr<TextureData> texture = std::make_shared<TextureData>();
 
-        int iw, ih, n;
-        texture->mPixels =
-            stbi_loadf(asset_manager->GetFullPath(file).generic_string().c_str(), &iw, &ih, &n, desired_channels);
+        std::filesystem::path texture_path = asset_manager->GetFullPath(file);
+        const size_t          pixel_size   = sizeof(float) * desired_channels;
+        uint64_t              cache_key    = derived_data_cache->BuildKey(
+            texture_path, "texture_hdr", s_texture_importer_version, std::to_string(desired_channels));
+
+        std::vector<uint8_t> cached_data;
+        if (!derived_data_cache->Load(cache_key, cached_data) || !readTextureData(cached_data, *texture, pixel_size))
+        {
+            int iw, ih, n;
+            texture->mPixels = stbi_loadf(texture_path.generic_string().c_str(), &iw, &ih, &n, desired_channels);
 
-        if (!texture->mPixels)
-            return nullptr;
+            if (!texture->mPixels)
+                return nullptr;
+
+            texture->mWidth  = iw;
+            texture->mHeight = ih;
+            derived_data_cache->Save(cache_key, writeTextureData(*texture, pixel_size));
+        }
 
-        texture->mWidth  = iw;
-        texture->mHeight = ih;
         switch (desired_channels)
         {
             case 2:
@@ -61,16 +244,29 @@ namespace MiniEngine
         std::shared_ptr<AssetManager> asset_manager = gRuntimeGlobalContext.mAssetManager;
         ASSERT(asset_manager);
 
+        std::shared_ptr<DerivedDataCache> derived_data_cache = gRuntimeGlobalContext.mDerivedDataCache;
+        ASSERT(derived_data_cache);
+
         std::shared_ptr<TextureData> texture = std::make_shared<TextureData>();
 
-        int iw, ih, n;
-        texture->mPixels = stbi_load(asset_manager->GetFullPath(file).generic_string().c_str(), &iw, &ih, &n, 4);
+        // decoded rgba8 pixels, the srgb flag only changes the format
+        std::filesystem::path texture_path = asset_manager->GetFullPath(file);
+        uint64_t cache_key = derived_data_cache->BuildKey(texture_path, "texture_rgba8", s_texture_importer_version);
+
+        std::vector<uint8_t> cached_data;
+        if (!derived_data_cache->Load(cache_key, cached_data) || !readTextureData(cached_data, *texture, 4))
+        {
+            int iw, ih, n;
+            texture->mPixels = stbi_load(texture_path.generic_string().c_str(), &iw, &ih, &n, 4);
+
+            if (!texture->mPixels)
+                return nullptr;
 
-        if (!texture->mPixels)
-            return nullptr;
+            texture->mWidth  = iw;
+            texture->mHeight = ih;
+            derived_data_cache->Save(cache_key, writeTextureData(*texture, 4));
+        }
 
-        texture->mWidth        = iw;
-        texture->mHeight       = ih;
         texture->mFormat       = (is_srgb) ? RHIFormat::RHI_FORMAT_R8G8B8A8_SRGB :
                                               RHIFormat::RHI_FORMAT_R8G8B8A8_UNORM;
         texture->mDepth        = 1;
@@ -82,12 +278,34 @@ namespace MiniEngine
     }
 
     RenderMeshData RenderResourceBase::LoadMeshData(const MeshSourceDesc& source, AxisAlignedBox& bounding_box)
+    {
+        RenderMeshData ret = DecodeMeshData(source, bounding_box);
+
+        // overwrite, the mesh may have been reloaded from disk
+        CacheBoundingBox(source, bounding_box);
+        return ret;
+    }
+
+    RenderMeshData RenderResourceBase::DecodeMeshData(const MeshSourceDesc& source, AxisAlignedBox& bounding_box)
     {
         std::shared_ptr<AssetManager> asset_manager = gRuntimeGlobalContext.mAssetManager;
         ASSERT(asset_manager);
 
+        std::shared_ptr<DerivedDataCache> derived_data_cache = gRuntimeGlobalContext.mDerivedDataCache;
+        ASSERT(derived_data_cache);
+
         RenderMeshData ret;
 
+        // a hit skips the obj or json parsing and the tangent generation
+        uint64_t cache_key =
+            derived_data_cache->BuildKey(asset_manager->GetFullPath(source.mMeshFile), "mesh", s_mesh_importer_version);
+
+        std::vector<uint8_t> cached_data;
+        if (derived_data_cache->Load(cache_key, cached_data) && readMeshData(cached_data, ret, bounding_box))
+        {
+            return ret;
+        }
+
         if (std::filesystem::path(source.mMeshFile).extension() == ".obj")
         {
             ret.mStaticMeshData = loadStaticMesh(source.mMeshFile, bounding_box);
@@ -97,56 +315,70 @@ namespace MiniEngine
             std::shared_ptr<MeshData> bind_data = std::make_shared<MeshData>();
             asset_manager->LoadAsset<MeshData>(source.mMeshFile, *bind_data);
 
-            // vertex buffer
-            size_t vertex_size                     = bind_data->mVertexBuffer.size() * sizeof(MeshVertexDataDefinition);
-            ret.mStaticMeshData.mVertexBuffer = std::make_shared<BufferData>(vertex_size);
-            MeshVertexDataDefinition* vertex =
-                (MeshVertexDataDefinition*)ret.mStaticMeshData.mVertexBuffer->mData;
+            std::vector<MeshVertexDataDefinition> vertices(bind_data->mVertexBuffer.size());
             for (size_t i = 0; i < bind_data->mVertexBuffer.size(); i++)
             {
-                vertex[i].x  = bind_data->mVertexBuffer[i].px;
-                vertex[i].y  = bind_data->mVertexBuffer[i].py;
-                vertex[i].z  = bind_data->mVertexBuffer[i].pz;
-                vertex[i].nx = bind_data->mVertexBuffer[i].nx;
-                vertex[i].ny = bind_data->mVertexBuffer[i].ny;
-                vertex[i].nz = bind_data->mVertexBuffer[i].nz;
-                vertex[i].tx = bind_data->mVertexBuffer[i].tx;
-                vertex[i].ty = bind_data->mVertexBuffer[i].ty;
-                vertex[i].tz = bind_data->mVertexBuffer[i].tz;
-                vertex[i].u  = bind_data->mVertexBuffer[i].u;
-                vertex[i].v  = bind_data->mVertexBuffer[i].v;
-
-                bounding_box.Merge(Vector3(vertex[i].x, vertex[i].y, vertex[i].z));
+                vertices[i].x  = bind_data->mVertexBuffer[i].px;
+                vertices[i].y  = bind_data->mVertexBuffer[i].py;
+                vertices[i].z  = bind_data->mVertexBuffer[i].pz;
+                vertices[i].nx = bind_data->mVertexBuffer[i].nx;
+                vertices[i].ny = bind_data->mVertexBuffer[i].ny;
+                vertices[i].nz = bind_data->mVertexBuffer[i].nz;
+                vertices[i].tx = bind_data->mVertexBuffer[i].tx;
+                vertices[i].ty = bind_data->mVertexBuffer[i].ty;
+                vertices[i].tz = bind_data->mVertexBuffer[i].tz;
+                vertices[i].u  = bind_data->mVertexBuffer[i].u;
+                vertices[i].v  = bind_data->mVertexBuffer[i].v;
+
+                bounding_box.Merge(Vector3(vertices[i].x, vertices[i].y, vertices[i].z));
             }
 
-            // index buffer
-            size_t index_size                     = bind_data->mIndexBuffer.size() * sizeof(uint16_t);
-            ret.mStaticMeshData.mIndexBuffer = std::make_shared<BufferData>(index_size);
-            uint16_t* index                       = (uint16_t*)ret.mStaticMeshData.mIndexBuffer->mData;
-            for (size_t i = 0; i < bind_data->mIndexBuffer.size(); i++)
+            std::vector<uint32_t> indices(bind_data->mIndexBuffer.begin(), bind_data->mIndexBuffer.end());
+            if (indices.size() % 3 != 0 || std::any_of(indices.begin(), indices.end(), [&](uint32_t index) {
+                    return index >= vertices.size();
+                }))
             {
-                index[i] = static_cast<uint16_t>(bind_data->mIndexBuffer[i]);
+                LOG_ERROR("mesh {} has indices outside of its {} vertices", source.mMeshFile, vertices.size());
+                vertices.clear();
+                indices.clear();
             }
 
-            // skeleton binding buffer
-            size_t data_size              = bind_data->mBind.size() * sizeof(MeshVertexBindingDataDefinition);
-            ret.mSkeletonBindingBuffer = std::make_shared<BufferData>(data_size);
-            MeshVertexBindingDataDefinition* binding_data =
-                reinterpret_cast<MeshVertexBindingDataDefinition*>(ret.mSkeletonBindingBuffer->mData);
+            // one skeleton binding per vertex, welded and reordered together with the vertices
+            std::vector<MeshVertexBindingDataDefinition> bindings(bind_data->mBind.size());
             for (size_t i = 0; i < bind_data->mBind.size(); i++)
             {
-                binding_data[i].mIndex0  = bind_data->mBind[i].index0;
-                binding_data[i].mIndex1  = bind_data->mBind[i].index1;
-                binding_data[i].mIndex2  = bind_data->mBind[i].index2;
-                binding_data[i].mIndex3  = bind_data->mBind[i].index3;
-                binding_data[i].mWeight0 = bind_data->mBind[i].weight0;
-                binding_data[i].mWeight1 = bind_data->mBind[i].weight1;
-                binding_data[i].mWeight2 = bind_data->mBind[i].weight2;
-                binding_data[i].mWeight3 = bind_data->mBind[i].weight3;
+                bindings[i].mIndex0  = bind_data->mBind[i].index0;
+                bindings[i].mIndex1  = bind_data->mBind[i].index1;
+                bindings[i].mIndex2  = bind_data->mBind[i].index2;
+                bindings[i].mIndex3  = bind_data->mBind[i].index3;
+                bindings[i].mWeight0 = bind_data->mBind[i].weight0;
+                bindings[i].mWeight1 = bind_data->mBind[i].weight1;
+                bindings[i].mWeight2 = bind_data->mBind[i].weight2;
+                bindings[i].mWeight3 = bind_data->mBind[i].weight3;
+            }
+            if (!bindings.empty() && bindings.size() != vertices.size())
+            {
+                LOG_ERROR("mesh {} has {} skeleton bindings for {} vertices, ignoring them",
+                          source.mMeshFile,
+                          bindings.size(),
+                          vertices.size());
+                bindings.clear();
+            }
+
+            optimizeMesh(source.mMeshFile, vertices, indices, bindings.empty() ? nullptr : &bindings, ret.mStaticMeshData);
+
+            if (!bindings.empty())
+            {
+                ret.mSkeletonBindingBuffer =
+                    std::make_shared<BufferData>(bindings.size() * sizeof(MeshVertexBindingDataDefinition));
+                memcpy(ret.mSkeletonBindingBuffer->mData, bindings.data(), ret.mSkeletonBindingBuffer->mSize);
             }
         }
 
-        mBoundingBoxCacheMap.insert(std::make_pair(source, bounding_box));
+        if (ret.mStaticMeshData.mVertexBuffer && ret.mStaticMeshData.mVertexBuffer->mSize > 0)
+        {
+            derived_data_cache->Save(cache_key, writeMeshData(ret, bounding_box));
+        }
 
         return ret;
     }
@@ -172,6 +404,16 @@ namespace MiniEngine
         return AxisAlignedBox();
     }
 
+    void RenderResourceBase::CacheBoundingBox(const MeshSourceDesc& source, const AxisAlignedBox& bounding_box)
+    {
+        mBoundingBoxCacheMap[source] = bounding_box;
+    }
+
+    void RenderResourceBase::EraseCachedBoundingBox(const MeshSourceDesc& source)
+    {
+        mBoundingBoxCacheMap.erase(source);
+    }
+
     StaticMeshData RenderResourceBase::loadStaticMesh(std::string filename, AxisAlignedBox& bounding_box)
     {
         StaticMeshData mesh_data;
@@ -218,7 +460,7 @@ namespace MiniEngine
                     continue;
                 }
 
-                // expanding vertex data is not efficient and is for testing purposes only
+                // every corner is expanded here, the shared ones are welded again by the optimizer
                 for (size_t v = 0; v < fv; v++)
                 {
                     auto idx = shapes[s].mesh.indices[index_offset + v];
@@ -322,20 +564,10 @@ namespace MiniEngine
             }
         }
 
-        uint32_t stride           = sizeof(MeshVertexDataDefinition);
-        mesh_data.mVertexBuffer = std::make_shared<BufferData>(mesh_vertices.size() * stride);
-        mesh_data.mIndexBuffer  = std::make_shared<BufferData>(mesh_vertices.size() * sizeof(uint16_t));
-
-        assert(mesh_vertices.size() <= std::numeric_limits<uint16_t>::max()); // take care of the index range, should be
-                                                                              // consistent with the index range used by
-                                                                              // vulkan
-
-        uint16_t* indices = (uint16_t*)mesh_data.mIndexBuffer->mData;
-        for (size_t i = 0; i < mesh_vertices.size(); i++)
-        {
-            ((MeshVertexDataDefinition*)(mesh_data.mVertexBuffer->mData))[i] = mesh_vertices[i];
-            indices[i]                                                          = static_cast<uint16_t>(i);
-        }
+        // the faces come in as separate corners, the optimizer welds the shared ones
+        std::vector<uint32_t> indices(mesh_vertices.size());
+        std::iota(indices.begin(), indices.end(), 0u);
+        optimizeMesh(filename, mesh_vertices, indices, nullptr, mesh_data);
 
         return mesh_data;
     }
@@ -41,6 +41,19 @@ namespace MiniEngine
             RenderMaterialData   material_data
         ) = 0;
 
+        // replace the gpu resources of an asset that changed on disk
+        virtual void ReloadGameObjectRenderResource(
+            std::shared_ptr<RHI> rhi,
+            RenderEntity         render_entity,
+            RenderMeshData       mesh_data
+        ) = 0;
+
+        virtual void ReloadGameObjectRenderResource(
+            std::shared_ptr<RHI> rhi,
+            RenderEntity         render_entity,
+            RenderMaterialData   material_data
+        ) = 0;
+
         virtual void UpdatePerFrameBuffer(
             std::shared_ptr<RenderScene>  render_scene,
             std::shared_ptr<RenderCamera> camera
@@ -52,6 +65,11 @@ namespace MiniEngine
         RenderMeshData               LoadMeshData(const MeshSourceDesc& source, AxisAlignedBox& bounding_box);
         RenderMaterialData           LoadMaterialData(const MaterialSourceDesc& source);
         AxisAlignedBox               GetCachedBoudingBox(const MeshSourceDesc& source) const;
+        void                         CacheBoundingBox(const MeshSourceDesc& source, const AxisAlignedBox& bounding_box);
+        void                         EraseCachedBoundingBox(const MeshSourceDesc& source);
+
+        // LoadMeshData without caching the bounding box, this and LoadMaterialData can run on any thread
+        RenderMeshData DecodeMeshData(const MeshSourceDesc& source, AxisAlignedBox& bounding_box);
 
     private:
         StaticMeshData loadStaticMesh(std::string mesh_file, AxisAlignedBox& bounding_box);
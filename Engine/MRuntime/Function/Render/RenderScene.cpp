@@ -2,17 +2,55 @@
 #include "MRuntime/Function/Render/RenderPass.hpp"
 #include "MRuntime/Function/Render/RenderHelper.hpp"
 #include "MRuntime/Function/Render/RenderResource.hpp"
+#include "MRuntime/Function/Render/RenderCamera.hpp"
+#include "MRuntime/Core/Profiler/Profiler.hpp"
+
+#include <algorithm>
+#include <cmath>
 
 namespace MiniEngine
 {
+    namespace
+    {
+        // largest axis scale of the model matrix, the errors of the levels are in object space
+        float modelMatrixScale(const Matrix4x4& model_matrix)
+        {
+            float max_squared_scale = 0.0f;
+            for (uint32_t column = 0; column < 3; ++column)
+            {
+                float squared_scale = model_matrix[0][column] * model_matrix[0][column] +
+                                      model_matrix[1][column] * model_matrix[1][column] +
+                                      model_matrix[2][column] * model_matrix[2][column];
+                max_squared_scale   = std::max(max_squared_scale, squared_scale);
+            }
+            return std::sqrt(max_squared_scale);
+        }
+
+        // coarsest level whose object space error stays within the allowed world space error
+        uint32_t selectMeshLod(const VulkanMesh& mesh, const Matrix4x4& model_matrix, float max_world_error)
+        {
+            float    max_object_error = max_world_error / std::max(modelMatrixScale(model_matrix), 1e-6f);
+            uint32_t lod_index        = 0;
+            while (lod_index + 1 < mesh.mesh_lod_count && mesh.mesh_lods[lod_index + 1].mError <= max_object_error)
+            {
+                ++lod_index;
+            }
+            return lod_index;
+        }
+    } // namespace
+
     void RenderScene::Clear()
     {
     }
 
-    void RenderScene::UpdateVisibleObjects(std::shared_ptr<RenderResource> render_resource, std::shared_ptr<RenderCamera> camera)
+    void RenderScene::UpdateVisibleObjects(std::shared_ptr<RenderResource> render_resource,
+                                           std::shared_ptr<RenderCamera>   camera,
+                                           float                           viewport_height)
     {
+        PROFILE_SCOPE("RenderScene::UpdateVisibleObjects");
+
         updateVisibleObjectsDirectionalLight(render_resource, camera);
-        updateVisibleObjectsMainCamera(render_resource, camera);
+        updateVisibleObjectsMainCamera(render_resource, camera, viewport_height);
         updateVisibleObjectsAxis(render_resource);
     }
 
@@ -54,28 +92,29 @@ namespace MiniEngine
         return GObjectID();
     }
 
-    void RenderScene::DeleteEntityByGObjectID(GObjectID go_id)
+    void RenderScene::DeleteEntityByGObjectID(GObjectID go_id, std::vector<RenderEntity>& deleted_entities)
     {
-        for (auto it = mMeshObjectIDMap.begin(); it != mMeshObjectIDMap.end(); it++)
+        // one entity per mesh part, the instance ids are freed so a reloaded object is added again
+        for (auto it = mMeshObjectIDMap.begin(); it != mMeshObjectIDMap.end();)
         {
             if (it->second == go_id)
-            {
-                mMeshObjectIDMap.erase(it);
-                break;
-            }
+                it = mMeshObjectIDMap.erase(it);
+            else
+                ++it;
         }
 
-        GameObjectPartId part_id = {go_id, 0};
-        size_t           find_guid;
-        if (mInstanceIDAllocator.GetElementGuid(part_id, find_guid))
+        for (auto it = mRenderEntities.begin(); it != mRenderEntities.end();)
         {
-            for (auto it = mRenderEntities.begin(); it != mRenderEntities.end(); it++)
+            GameObjectPartId part_id;
+            if (mInstanceIDAllocator.GetGuidRelatedElement(it->mInstanceID, part_id) && part_id.mGOID == go_id)
             {
-                if (it->mInstanceID == find_guid)
-                {
-                    mRenderEntities.erase(it);
-                    break;
-                }
+                mInstanceIDAllocator.FreeGuid(it->mInstanceID);
+                deleted_entities.push_back(std::move(*it));
+                it = mRenderEntities.erase(it);
+            }
+            else
+            {
+                ++it;
             }
         }
     }
@@ -89,27 +128,67 @@ namespace MiniEngine
 
     void RenderScene::updateVisibleObjectsDirectionalLight(std::shared_ptr<RenderResource> render_resource, std::shared_ptr<RenderCamera> camera)
     {
-        Matrix4x4 directional_light_proj_view = CalculateDirectionalLightCamera(*this, *camera);
+        uint32_t cascade_count =
+            std::clamp(mDirectionalLight.mCascadeCount, 1u, s_max_directional_light_cascade_count);
 
-        render_resource->mMeshPerFrameStorageBufferObject.directional_light_proj_view =
-            directional_light_proj_view;
-        render_resource->mMeshDirectionalLightShadowPerFrameStorageBufferObject.light_proj_view =
-            directional_light_proj_view;
+        float shadow_distance = std::clamp(mDirectionalLight.mShadowDistance, camera->mZNear + 0.01f, camera->mZFar);
+        float split_far[s_max_directional_light_cascade_count];
+        CalculateCascadeSplits(camera->mZNear, shadow_distance, cascade_count, mDirectionalLight.mCascadeSplitLambda, split_far);
 
-        mDirectionalLightVisibleMeshNodes.clear();
+        Vector3     light_direction    = mDirectionalLight.mDirection.NormalizedCopy();
+        BoundingBox scene_bounding_box = CalculateSceneBoundingBox(*this);
 
-        ClusterFrustum frustum =
-            CreateClusterFrustumFromMatrix(directional_light_proj_view, -1.0, 1.0, -1.0, 1.0, 0.0, 1.0);
+        ClusterFrustum cascade_frustums[s_max_directional_light_cascade_count];
+        float          cascade_texel_sizes[s_max_directional_light_cascade_count];
+        for (uint32_t cascade_index = 0; cascade_index < cascade_count; ++cascade_index)
+        {
+            float split_near = (cascade_index == 0) ? camera->mZNear : split_far[cascade_index - 1];
+
+            Matrix4x4 cascade_proj_view = CalculateDirectionalLightCascadeCamera(*camera,
+                                                                                 light_direction,
+                                                                                 scene_bounding_box,
+                                                                                 split_near,
+                                                                                 split_far[cascade_index],
+                                                                                 s_directional_light_shadow_map_dimension);
+
+            render_resource->mMeshPerFrameStorageBufferObject.directional_light_proj_view[cascade_index] = cascade_proj_view;
+            render_resource->mMeshPerFrameStorageBufferObject.directional_light_cascade_splits[cascade_index] =
+                split_far[cascade_index];
+            render_resource->mMeshDirectionalLightShadowPerFrameStorageBufferObject.light_proj_view[cascade_index] =
+                cascade_proj_view;
+
+            cascade_frustums[cascade_index] =
+                CreateClusterFrustumFromMatrix(cascade_proj_view, -1.0, 1.0, -1.0, 1.0, 0.0, 1.0);
+
+            // the projection is orthographic, a row maps the cascade width onto the two units of clip space
+            Vector3 cascade_axis(cascade_proj_view[0][0], cascade_proj_view[0][1], cascade_proj_view[0][2]);
+            cascade_texel_sizes[cascade_index] =
+                2.0f / std::max(cascade_axis.Length() * s_directional_light_shadow_map_dimension, 1e-6f);
+        }
+        render_resource->mMeshPerFrameStorageBufferObject.directional_light_cascade_count = cascade_count;
+        render_resource->mMeshDirectionalLightShadowPerFrameStorageBufferObject.cascade_count   = cascade_count;
+
+        for (auto& cascade_nodes : mDirectionalLightVisibleMeshNodes)
+        {
+            cascade_nodes.clear();
+        }
 
         for (const RenderEntity& entity : mRenderEntities)
         {
             BoundingBox mesh_asset_bounding_box {entity.mBoundingBox.GetMinCorner(),
                                                  entity.mBoundingBox.GetMaxCorner()};
+            BoundingBox mesh_bounding_box_world = BoundingBoxTransform(mesh_asset_bounding_box, entity.mModelMatrix);
 
-            if (TiledFrustumIntersectBox(frustum, BoundingBoxTransform(mesh_asset_bounding_box, entity.mModelMatrix)))
+            // each caster is only drawn into the cascades it overlaps
+            for (uint32_t cascade_index = 0; cascade_index < cascade_count; ++cascade_index)
             {
-                mDirectionalLightVisibleMeshNodes.emplace_back();
-                RenderMeshNode& temp_node = mDirectionalLightVisibleMeshNodes.back();
+                if (!TiledFrustumIntersectBox(cascade_frustums[cascade_index], mesh_bounding_box_world))
+                {
+                    continue;
+                }
+
+                mDirectionalLightVisibleMeshNodes[cascade_index].emplace_back();
+                RenderMeshNode& temp_node = mDirectionalLightVisibleMeshNodes[cascade_index].back();
 
                 temp_node.model_matrix = &entity.mModelMatrix;
 
@@ -125,13 +204,21 @@ namespace MiniEngine
                 temp_node.ref_mesh               = &mesh_asset;
                 temp_node.enable_vertex_blending = entity.mbEnableVertexBlending;
 
+                // shadows are soft and small on screen, the bias trades a little of their shape for fewer triangles
+                uint32_t lod_index = selectMeshLod(
+                    mesh_asset, entity.mModelMatrix, mLodErrorThreshold * cascade_texel_sizes[cascade_index]);
+                temp_node.lod_index =
+                    std::min(lod_index + mDirectionalLight.mShadowLodBias, mesh_asset.mesh_lod_count - 1);
+
                 VulkanPBRMaterial& material_asset = render_resource->GetEntityMaterial(entity);
                 temp_node.ref_material            = &material_asset;
             }
         }
     }
 
-    void RenderScene::updateVisibleObjectsMainCamera(std::shared_ptr<RenderResource> render_resource, std::shared_ptr<RenderCamera> camera)
+    void RenderScene::updateVisibleObjectsMainCamera(std::shared_ptr<RenderResource> render_resource,
+                                                     std::shared_ptr<RenderCamera>   camera,
+                                                     float                           viewport_height)
     {
         mMainCameraVisibleMeshNodes.clear();
 
@@ -141,12 +228,17 @@ namespace MiniEngine
 
         ClusterFrustum f = CreateClusterFrustumFromMatrix(proj_view_matrix, -1.0, 1.0, -1.0, 1.0, 0.0, 1.0);
 
+        // pixels covered by one world unit at unit distance from the camera
+        float   pixels_per_unit = std::fabs(proj_matrix[1][1]) * 0.5f * viewport_height;
+        Vector3 camera_position = camera->Position();
+
         for (const RenderEntity& entity : mRenderEntities)
         {
             BoundingBox mesh_asset_bounding_box {entity.mBoundingBox.GetMinCorner(),
                                                  entity.mBoundingBox.GetMaxCorner()};
+            BoundingBox mesh_bounding_box_world = BoundingBoxTransform(mesh_asset_bounding_box, entity.mModelMatrix);
 
-            if (TiledFrustumIntersectBox(f, BoundingBoxTransform(mesh_asset_bounding_box, entity.mModelMatrix)))
+            if (TiledFrustumIntersectBox(f, mesh_bounding_box_world))
             {
                 mMainCameraVisibleMeshNodes.emplace_back();
                 RenderMeshNode& temp_node = mMainCameraVisibleMeshNodes.back();
@@ -164,6 +256,14 @@ namespace MiniEngine
                 temp_node.ref_mesh               = &mesh_asset;
                 temp_node.enable_vertex_blending = entity.mbEnableVertexBlending;
 
+                // the closest point of the bounds decides, so no part of the mesh shows more than the threshold
+                Vector3 closest_point = camera_position;
+                closest_point.MakeCeil(mesh_bounding_box_world.mMinBound);
+                closest_point.MakeFloor(mesh_bounding_box_world.mMaxBound);
+                float distance      = std::max((closest_point - camera_position).Length(), camera->mZNear);
+                temp_node.lod_index = selectMeshLod(
+                    mesh_asset, entity.mModelMatrix, mLodErrorThreshold * distance / pixels_per_unit);
+
                 VulkanPBRMaterial& material_asset = render_resource->GetEntityMaterial(entity);
                 temp_node.ref_material            = &material_asset;
             }
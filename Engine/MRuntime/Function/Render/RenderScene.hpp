@@ -7,6 +7,7 @@
 #include "MRuntime/Function/Render/RenderObject.hpp"
 #include "MRuntime/Function/Render/Light.hpp"
 
+#include <array>
 #include <optional>
 #include <vector>
 
@@ -23,7 +24,8 @@ namespace MiniEngine
 
         // update visible objects in each frame
         void UpdateVisibleObjects(std::shared_ptr<RenderResource> render_resource,
-                                  std::shared_ptr<RenderCamera>   camera);
+                                  std::shared_ptr<RenderCamera>   camera,
+                                  float                           viewport_height);
 
         // set visible nodes ptr in render pass
         void SetVisibleNodesReference();
@@ -34,7 +36,8 @@ namespace MiniEngine
 
         void      AddInstanceIDToMap(uint32_t instance_id, GObjectID go_id);
         GObjectID GetGObjectIDByMeshID(uint32_t mesh_id) const;
-        void      DeleteEntityByGObjectID(GObjectID go_id);
+        // the entities removed are appended to deleted_entities
+        void      DeleteEntityByGObjectID(GObjectID go_id, std::vector<RenderEntity>& deleted_entities);
 
         void ClearForLevelReloading();
 
@@ -46,7 +49,8 @@ namespace MiniEngine
 
         void updateVisibleObjectsMainCamera(
             std::shared_ptr<RenderResource> render_resource,
-            std::shared_ptr<RenderCamera>   camera
+            std::shared_ptr<RenderCamera>   camera,
+            float                           viewport_height
         );
         void updateVisibleObjectsAxis(std::shared_ptr<RenderResource> render_resource);
 
@@ -55,6 +59,10 @@ namespace MiniEngine
         AmbientLight      mAmbientLight;
         PDirectionalLight mDirectionalLight;
         PointLightList    mPointLightList;
+
+        // mesh levels of detail are picked so their error stays below this many pixels, or shadow map texels
+        float mLodErrorThreshold {1.0f};
+
         // render entities
         std::vector<RenderEntity> mRenderEntities;
 
@@ -62,7 +70,7 @@ namespace MiniEngine
         std::optional<RenderEntity> mRenderAxis;
 
         // visible objects (updated per frame)
-        std::vector<RenderMeshNode> mDirectionalLightVisibleMeshNodes;
+        std::array<std::vector<RenderMeshNode>, s_max_directional_light_cascade_count> mDirectionalLightVisibleMeshNodes;
         std::vector<RenderMeshNode> mPointLightsVisibleMeshNodes;
         std::vector<RenderMeshNode> mMainCameraVisibleMeshNodes;
         RenderAxisNode              mAxisNode;
@@ -4,13 +4,43 @@
 
 namespace MiniEngine
 {
-    void GameObjectResourceDesc::Add(GameObjectDesc& desc) { mGameObjectDesc.push_back(desc); }
+    void GameObjectResourceDesc::Add(const GameObjectDesc& desc)
+    {
+        if (mCount == mGameObjectDesc.size())
+        {
+            mGameObjectDesc.push_back(desc);
+        }
+        else
+        {
+            mGameObjectDesc[mCount] = desc;
+        }
+        ++mCount;
+    }
 
-    bool GameObjectResourceDesc::IsEmpty() const { return mGameObjectDesc.empty(); }
+    void GameObjectResourceDesc::Add(GObjectID go_id, const std::vector<GameObjectPartDesc>& parts)
+    {
+        if (mCount == mGameObjectDesc.size())
+        {
+            mGameObjectDesc.emplace_back();
+        }
+        mGameObjectDesc[mCount].Assign(go_id, parts);
+        ++mCount;
+    }
+
+    void GameObjectResourceDesc::Pop() { ++mProcessIndex; }
+
+    void GameObjectResourceDesc::Clear()
+    {
+        mCount        = 0;
+        mProcessIndex = 0;
+    }
 
-    GameObjectDesc& GameObjectResourceDesc::GetNextProcessObject() { return mGameObjectDesc.front(); }
+    bool GameObjectResourceDesc::IsEmpty() const { return mProcessIndex == mCount; }
 
-    void GameObjectResourceDesc::Pop() { mGameObjectDesc.pop_front(); }
+    const GameObjectDesc& GameObjectResourceDesc::GetNextProcessObject() const
+    {
+        return mGameObjectDesc[mProcessIndex];
+    }
 
     RenderSwapData& RenderSwapContext::GetLogicSwapData() { return mSwapData[mLogicSwapDataIndex]; }
 
@@ -28,9 +58,11 @@ namespace MiniEngine
     {
         // return false;
         return !(mSwapData[mRenderSwapDataIndex].mSceneResourceDesc.has_value() ||
-                 mSwapData[mRenderSwapDataIndex].mGameObjectResourceDesc.has_value() ||
-                 mSwapData[mRenderSwapDataIndex].mGameObjectToDelete.has_value() ||
-                 mSwapData[mRenderSwapDataIndex].mCameraSwapData.has_value());
+                 !mSwapData[mRenderSwapDataIndex].mGameObjectResourceDesc.IsEmpty() ||
+                 !mSwapData[mRenderSwapDataIndex].mGameObjectToDelete.IsEmpty() ||
+                 mSwapData[mRenderSwapDataIndex].mCameraSwapData.has_value() ||
+                 mSwapData[mRenderSwapDataIndex].mPointLights.has_value() ||
+                 mSwapData[mRenderSwapDataIndex].mReloadedAssetFiles.has_value());
     }
 
     void RenderSwapContext::ResetSceneResourceSwapData()
@@ -40,12 +72,12 @@ namespace MiniEngine
 
     void RenderSwapContext::ResetGameObjectResourceSwapData()
     {
-        mSwapData[mRenderSwapDataIndex].mGameObjectResourceDesc.reset();
+        mSwapData[mRenderSwapDataIndex].mGameObjectResourceDesc.Clear();
     }
 
     void RenderSwapContext::ResetGameObjectToDelete()
     {
-        mSwapData[mRenderSwapDataIndex].mGameObjectToDelete.reset();
+        mSwapData[mRenderSwapDataIndex].mGameObjectToDelete.Clear();
     }
 
     void RenderSwapContext::ResetCameraSwapData() 
@@ -53,40 +85,42 @@ namespace MiniEngine
         mSwapData[mRenderSwapDataIndex].mCameraSwapData.reset();
     }
 
+    void RenderSwapContext::ResetPointLightSwapData()
+    {
+        mSwapData[mRenderSwapDataIndex].mPointLights.reset();
+    }
+
+    void RenderSwapContext::ResetReloadedAssetFiles()
+    {
+        mSwapData[mRenderSwapDataIndex].mReloadedAssetFiles.reset();
+    }
+
     void RenderSwapContext::swap()
     {
         ResetSceneResourceSwapData();
         ResetGameObjectResourceSwapData();
         ResetGameObjectToDelete();
         ResetCameraSwapData();
+        ResetPointLightSwapData();
+        ResetReloadedAssetFiles();
         std::swap(mLogicSwapDataIndex, mRenderSwapDataIndex);
     }
 
-    void RenderSwapData::AddDirtyGameObject(GameObjectDesc&& desc)
+    void RenderSwapData::AddDirtyGameObject(GameObjectDesc&& desc) { mGameObjectResourceDesc.Add(desc); }
+
+    void RenderSwapData::AddDirtyGameObject(GObjectID go_id, const std::vector<GameObjectPartDesc>& parts)
     {
-        if (mGameObjectResourceDesc.has_value())
-        {
-            mGameObjectResourceDesc->Add(desc);
-        }
-        else
-        {
-            GameObjectResourceDesc go_descs;
-            go_descs.Add(desc);
-            mGameObjectResourceDesc = go_descs;
-        }
+        mGameObjectResourceDesc.Add(go_id, parts);
     }
 
-    void RenderSwapData::AddDeleteGameObject(GameObjectDesc&& desc)
+    void RenderSwapData::AddDeleteGameObject(GameObjectDesc&& desc) { mGameObjectToDelete.Add(desc); }
+
+    void RenderSwapData::AddReloadedAssetFile(const std::string& file)
     {
-        if (mGameObjectToDelete.has_value())
-        {
-            mGameObjectToDelete->Add(desc);
-        }
-        else
+        if (!mReloadedAssetFiles.has_value())
         {
-            GameObjectResourceDesc go_descs;
-            go_descs.Add(desc);
-            mGameObjectToDelete = go_descs;
+            mReloadedAssetFiles = std::vector<std::string>();
         }
+        mReloadedAssetFiles->push_back(file);
     }
 }
\ No newline at end of file
@@ -1,15 +1,16 @@
 #pragma once
 
 
+#include "MRuntime/Function/Render/Light.hpp"
 #include "MRuntime/Function/Render/RenderCamera.hpp"
 #include "MRuntime/Function/Render/RenderObject.hpp"
 
 #include "MRuntime/Resource/ResourceType/Global/GlobalRendering.hpp"
 
 #include <cstdint>
-#include <deque>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace MiniEngine
 {
@@ -38,27 +39,39 @@ namespace MiniEngine
         std::optional<Matrix4x4>        mViewMatrix;
     };
 
+    // queue of game objects, slots are overwritten instead of freed so a steady stream of
+    // dirty objects reuses the part vectors and strings of earlier frames
     struct GameObjectResourceDesc
     {
-        void Add(GameObjectDesc& desc);
+        void Add(const GameObjectDesc& desc);
+        void Add(GObjectID go_id, const std::vector<GameObjectPartDesc>& parts);
         void Pop();
+        void Clear();
 
         bool IsEmpty() const;
 
-        GameObjectDesc& GetNextProcessObject();
+        const GameObjectDesc& GetNextProcessObject() const;
 
-        std::deque<GameObjectDesc> mGameObjectDesc;
+        std::vector<GameObjectDesc> mGameObjectDesc;
+        size_t                      mCount {0};
+        size_t                      mProcessIndex {0};
     };
 
     struct RenderSwapData
     {
         void AddDirtyGameObject(GameObjectDesc&& desc);
+        void AddDirtyGameObject(GObjectID go_id, const std::vector<GameObjectPartDesc>& parts);
         void AddDeleteGameObject(GameObjectDesc&& desc);
+        void AddReloadedAssetFile(const std::string& file);
 
         std::optional<SceneResourceDesc>       mSceneResourceDesc;
-        std::optional<GameObjectResourceDesc>  mGameObjectResourceDesc;
-        std::optional<GameObjectResourceDesc>  mGameObjectToDelete;
+        GameObjectResourceDesc                 mGameObjectResourceDesc;
+        GameObjectResourceDesc                 mGameObjectToDelete;
         std::optional<CameraSwapData>          mCameraSwapData;
+        // replaces all point lights of the render scene
+        std::optional<std::vector<PointLight>> mPointLights;
+        // full paths of mesh and texture files changed on disk
+        std::optional<std::vector<std::string>> mReloadedAssetFiles;
     };
 
     enum SwapDataType : uint8_t
@@ -78,6 +91,8 @@ namespace MiniEngine
         void            ResetGameObjectResourceSwapData();
         void            ResetGameObjectToDelete();
         void            ResetCameraSwapData();
+        void            ResetPointLightSwapData();
+        void            ResetReloadedAssetFiles();
     
     private:
         bool isReadyToSwap() const;
@@ -18,9 +18,34 @@
 #include "MRuntime/Function/Render/DebugDraw/DebugDrawManager.hpp"
 
 #include "MRuntime/Function/Render/Passes/MainCameraPass.hpp"
+#include "MRuntime/Core/Base/ThreadPool.hpp"
+#include "MRuntime/Core/Profiler/Profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <unordered_set>
 
 namespace MiniEngine
 {
+    namespace
+    {
+        RHIPresentModeKHR parsePresentMode(const std::string& present_mode)
+        {
+            if (present_mode == "Fifo")
+                return RHI_PRESENT_MODE_FIFO_KHR;
+            if (present_mode == "FifoRelaxed")
+                return RHI_PRESENT_MODE_FIFO_RELAXED_KHR;
+            if (present_mode == "Mailbox")
+                return RHI_PRESENT_MODE_MAILBOX_KHR;
+            if (present_mode == "Immediate")
+                return RHI_PRESENT_MODE_IMMEDIATE_KHR;
+
+            LOG_WARN("unknown present mode {}, using Mailbox", present_mode);
+            return RHI_PRESENT_MODE_MAILBOX_KHR;
+        }
+    } // namespace
+
     RenderSystem::~RenderSystem()
     {
         Clear();
@@ -35,10 +60,21 @@ namespace MiniEngine
 
         RHIInitInfo rhiInitInfo;
         rhiInitInfo.windowSystem = initInfo.mWindowSystem;
+        rhiInitInfo.pipelineCachePath = configManager->GetRootFolder() / "PipelineCache.bin";
+        rhiInitInfo.framesInFlight    = static_cast<uint8_t>(std::min(configManager->GetFramesInFlight(), 255u));
+        rhiInitInfo.presentMode       = parsePresentMode(configManager->GetPresentMode());
 
         mRHI = std::make_shared<VulkanRHI>();
         mRHI->Initialize(rhiInitInfo);
 
+        // TODO: move to default material definition json file
+        mDefaultMaterialSource.mBaseColorFile =
+            assetManager->GetFullPath("Asset/Textures/default/albedo.jpg").generic_string();
+        mDefaultMaterialSource.mMetallicRoughnessFile =
+            assetManager->GetFullPath("Asset/Textures/default/mr.jpg").generic_string();
+        mDefaultMaterialSource.mNormalFile =
+            assetManager->GetFullPath("Asset/Textures/default/normal.jpg").generic_string();
+
         // global rendering resource
         GlobalRenderingRes global_rendering_res;
         const std::string& global_rendering_res_url = configManager->GetGlobalRenderingResURL();
@@ -64,20 +100,64 @@ namespace MiniEngine
         mRenderScene->mDirectionalLight.mDirection =
             global_rendering_res.mDirectionalLight.mDirection.NormalizedCopy();
         mRenderScene->mDirectionalLight.mColor = global_rendering_res.mDirectionalLight.mColor.ToVector3();
+        mRenderScene->mDirectionalLight.mCascadeCount       = global_rendering_res.mDirectionalLight.mCascadeCount;
+        mRenderScene->mDirectionalLight.mCascadeSplitLambda = global_rendering_res.mDirectionalLight.mCascadeSplitLambda;
+        mRenderScene->mDirectionalLight.mShadowDistance     = global_rendering_res.mDirectionalLight.mShadowDistance;
+        mRenderScene->mDirectionalLight.mShadowLodBias      = global_rendering_res.mDirectionalLight.mShadowLodBias;
+        mRenderScene->mLodErrorThreshold                    = global_rendering_res.mLodErrorThreshold;
+        mRenderScene->mPointLightList.mLights.reserve(global_rendering_res.mPointLights.size());
+        for (const PointLightRes& point_light : global_rendering_res.mPointLights)
+        {
+            mRenderScene->mPointLightList.mLights.push_back({point_light.mPosition, point_light.mFlux});
+        }
         mRenderScene->SetVisibleNodesReference();
 
+        bool enable_bindless_materials = global_rendering_res.mbEnableBindlessMaterials;
+        if (enable_bindless_materials && mRHI->GetMaxBindlessTextureCount() == 0)
+        {
+            LOG_WARN("descriptor indexing is not supported, materials are bound per draw");
+            enable_bindless_materials = false;
+        }
+
         // initialize render pipeline
         RenderPipelineInitInfo pipeline_init_info;
-        pipeline_init_info.mbEnableFXAA     = global_rendering_res.mbEnableFXAA;
-        pipeline_init_info.mRenderResource = mRenderResource;
+        pipeline_init_info.mbEnableFXAA               = global_rendering_res.mbEnableFXAA;
+        pipeline_init_info.mbEnableVertexQuantization = global_rendering_res.mbEnableVertexQuantization;
+        pipeline_init_info.mbEnableBindlessMaterials  = enable_bindless_materials;
+        pipeline_init_info.mRenderResource            = mRenderResource;
+
+        auto pipeline_init_begin = std::chrono::steady_clock::now();
 
         mRenderPipeline        = std::make_shared<RenderPipeline>();
         mRenderPipeline->mRHI = mRHI;
         mRenderPipeline->Initialize(pipeline_init_info);
 
+        // compare the cold and warm numbers to see what the pipeline cache saves at startup
+        float pipeline_init_ms =
+            std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - pipeline_init_begin).count();
+        LOG_INFO("render pipeline initialized in {:.2f} ms with a {} pipeline cache",
+                 pipeline_init_ms,
+                 std::static_pointer_cast<VulkanRHI>(mRHI)->mbPipelineCacheWarm ? "warm" : "cold");
+        mRHI->SavePipelineCache();
+
         // descriptor set layout in main camera pass will be used when uploading resource
         std::static_pointer_cast<RenderResource>(mRenderResource)->mMeshDescLayout = &static_cast<RenderPass*>(mRenderPipeline->mMainCameraPass.get())->mDescInfos[MainCameraPass::LayoutType::LayoutType_PerMesh].layout;
         std::static_pointer_cast<RenderResource>(mRenderResource)->mMaterialDescLayout = &static_cast<RenderPass*>(mRenderPipeline->mMainCameraPass.get())->mDescInfos[MainCameraPass::LayoutType::LayoutType_MeshPerMaterial].layout;
+        std::static_pointer_cast<RenderResource>(mRenderResource)->mbEnableVertexQuantization = global_rendering_res.mbEnableVertexQuantization;
+        std::static_pointer_cast<RenderResource>(mRenderResource)->mbEnableBindlessMaterials = enable_bindless_materials;
+        std::static_pointer_cast<RenderResource>(mRenderResource)->mUnusedAssetBudget =
+            static_cast<uint64_t>(global_rendering_res.mUnusedAssetCacheSizeMB) * 1024 * 1024;
+
+        // changed meshes and textures are matched against the loaded assets when the swap data is processed
+        gRuntimeGlobalContext.mAssetManager->AddFileChangeCallback([this](const std::vector<FileChange>& changes) {
+            for (const FileChange& change : changes)
+            {
+                if (change.mType != FileChangeType::Removed)
+                {
+                    mSwapContext.GetLogicSwapData().AddReloadedAssetFile(change.mPath.generic_string());
+                }
+            }
+        });
     }
 
     void RenderSystem::Tick(float DeltaTime) 
@@ -94,7 +174,8 @@ namespace MiniEngine
         // update per-frame visible objects
         mRenderScene->UpdateVisibleObjects(
             std::static_pointer_cast<RenderResource>(mRenderResource),
-            mRenderCamera);
+            mRenderCamera,
+            mRHI->GetSwapChainInfo().viewport->height);
 
         // prepare pipeline's render passes data
         mRenderPipeline->PreparePassData(mRenderResource);
@@ -112,10 +193,15 @@ namespace MiniEngine
         // }
         else
         {
-            LOG_ERROR(__FUNCTION__, "unsupported render pipeline type");
+            LOG_ERROR("unsupported render pipeline type");
         }
     }
 
+    void RenderSystem::WaitForFrame()
+    {
+        mRHI->WaitForFences();
+    }
+
     void RenderSystem::Clear()
     {
         if (mRHI)
@@ -243,15 +329,54 @@ namespace MiniEngine
 
     void RenderSystem::ClearForLevelReloading()
     {
+        // the assets of the old level stay warm within the unused budget for the level loaded next
+        for (const RenderEntity& entity : mRenderScene->mRenderEntities)
+        {
+            releaseEntityReferences(entity);
+        }
         mRenderScene->ClearForLevelReloading();
+        std::static_pointer_cast<RenderResource>(mRenderResource)->EvictUnusedAssets(*mRenderScene);
+
+        RenderMemoryReport report = GetMemoryReport();
+        LOG_INFO("render memory: meshes {} KB in {} ({} KB in {} unused), materials {} KB in {} ({} KB in {} unused), "
+                 "pending release {} KB in {}, upload buffer {} KB",
+                 report.mMeshSize / 1024,
+                 report.mMeshCount,
+                 report.mUnusedMeshSize / 1024,
+                 report.mUnusedMeshCount,
+                 report.mMaterialSize / 1024,
+                 report.mMaterialCount,
+                 report.mUnusedMaterialSize / 1024,
+                 report.mUnusedMaterialCount,
+                 report.mPendingReleaseSize / 1024,
+                 report.mPendingReleaseCount,
+                 report.mUploadBufferSize / 1024);
+    }
+
+    RenderMemoryReport RenderSystem::GetMemoryReport() const
+    {
+        return std::static_pointer_cast<RenderResource>(mRenderResource)->GetMemoryReport();
+    }
+
+    void RenderSystem::addEntityReferences(const RenderEntity& entity)
+    {
+        RenderResource* render_resource = static_cast<RenderResource*>(mRenderResource.get());
+        render_resource->mMeshResidency.AddReference(entity.mMeshAssetID);
+        render_resource->mMaterialResidency.AddReference(entity.mMaterialAssetID);
+    }
+
+    void RenderSystem::releaseEntityReferences(const RenderEntity& entity)
+    {
+        RenderResource* render_resource = static_cast<RenderResource*>(mRenderResource.get());
+        render_resource->mMeshResidency.ReleaseReference(entity.mMeshAssetID);
+        render_resource->mMaterialResidency.ReleaseReference(entity.mMaterialAssetID);
     }
 
     void RenderSystem::processSwapData()
     {
-        RenderSwapData& swap_data = mSwapContext.GetRenderSwapData();
+        PROFILE_SCOPE("RenderSystem::processSwapData");
 
-        std::shared_ptr<AssetManager> asset_manager = gRuntimeGlobalContext.mAssetManager;
-        ASSERT(asset_manager);
+        RenderSwapData& swap_data = mSwapContext.GetRenderSwapData();
 
         // TODO: update global resources if needed
         if (swap_data.mSceneResourceDesc.has_value())
@@ -262,12 +387,46 @@ namespace MiniEngine
             mSwapContext.ResetSceneResourceSwapData();
         }
 
+        // remove deleted objects first, a reloaded object is deleted and added in the same frame
+        if (!swap_data.mGameObjectToDelete.IsEmpty())
+        {
+            while (!swap_data.mGameObjectToDelete.IsEmpty())
+            {
+                const GameObjectDesc& gobject = swap_data.mGameObjectToDelete.GetNextProcessObject();
+                mRenderScene->DeleteEntityByGObjectID(gobject.GetID(), mSwapDeletedEntities);
+                swap_data.mGameObjectToDelete.Pop();
+            }
+
+            // unreferenced assets wait in the unused list, an object added again this frame picks them up
+            for (const RenderEntity& entity : mSwapDeletedEntities)
+            {
+                releaseEntityReferences(entity);
+            }
+            mSwapDeletedEntities.clear();
+
+            mSwapContext.ResetGameObjectToDelete();
+        }
+
+        // replace the gpu resources of meshes and textures changed on disk
+        if (swap_data.mReloadedAssetFiles.has_value())
+        {
+            processReloadedAssets(*swap_data.mReloadedAssetFiles);
+            mSwapContext.ResetReloadedAssetFiles();
+        }
+
         // update game object if needed
-        if (swap_data.mGameObjectResourceDesc.has_value())
+        if (!swap_data.mGameObjectResourceDesc.IsEmpty())
         {
-            while (!swap_data.mGameObjectResourceDesc->IsEmpty())
+            // reused for every part, the strings and joint matrices keep their capacity between frames
+            RenderEntity&       render_entity   = mSwapRenderEntity;
+            MeshSourceDesc&     mesh_source     = mSwapMeshSource;
+            MaterialSourceDesc& material_source = mSwapMaterialSource;
+
+            prefetchSwapAssets(swap_data.mGameObjectResourceDesc);
+
+            while (!swap_data.mGameObjectResourceDesc.IsEmpty())
             {
-                GameObjectDesc gobject = swap_data.mGameObjectResourceDesc->GetNextProcessObject();
+                const GameObjectDesc& gobject = swap_data.mGameObjectResourceDesc.GetNextProcessObject();
 
                 for (size_t part_index = 0; part_index < gobject.GetObjectParts().size(); part_index++)
                 {
@@ -276,7 +435,8 @@ namespace MiniEngine
 
                     bool is_entity_in_scene = mRenderScene->GetInstanceIDAllocator().HasElement(part_id);
 
-                    RenderEntity render_entity;
+                    // the other fields are all written below
+                    render_entity.mBoundingBox = AxisAlignedBox();
                     render_entity.mInstanceID =
                         static_cast<uint32_t>(mRenderScene->GetInstanceIDAllocator().AllocateGuid(part_id));
                     render_entity.mModelMatrix = game_object_part.mTransformDesc.mTransformMatrix;
@@ -284,13 +444,24 @@ namespace MiniEngine
                     mRenderScene->AddInstanceIDToMap(render_entity.mInstanceID, gobject.GetID());
 
                     // mesh properties
-                    MeshSourceDesc mesh_source    = {game_object_part.mMeshDesc.mMeshFile};
-                    bool           is_mesh_loaded = mRenderScene->GetMeshAssetIDAllocator().HasElement(mesh_source);
+                    mesh_source.mMeshFile = game_object_part.mMeshDesc.mMeshFile;
+                    bool is_mesh_loaded = mRenderScene->GetMeshAssetIDAllocator().HasElement(mesh_source);
 
                     RenderMeshData mesh_data;
                     if (!is_mesh_loaded)
                     {
-                        mesh_data = mRenderResource->LoadMeshData(mesh_source, render_entity.mBoundingBox);
+                        auto prefetched_mesh = mPrefetchedMeshes.find(mesh_source);
+                        if (prefetched_mesh != mPrefetchedMeshes.end())
+                        {
+                            mesh_data                  = std::move(prefetched_mesh->second.mData);
+                            render_entity.mBoundingBox = prefetched_mesh->second.mBoundingBox;
+                            mRenderResource->CacheBoundingBox(mesh_source, render_entity.mBoundingBox);
+                            mPrefetchedMeshes.erase(prefetched_mesh);
+                        }
+                        else
+                        {
+                            mesh_data = mRenderResource->LoadMeshData(mesh_source, render_entity.mBoundingBox);
+                        }
                     }
                     else
                     {
@@ -309,31 +480,34 @@ namespace MiniEngine
                     }
 
                     // material properties
-                    MaterialSourceDesc material_source;
                     if (game_object_part.mMaterialDesc.mbWithTexture)
                     {
-                        material_source = {game_object_part.mMaterialDesc.mBaseColorTextureFile,
-                                           game_object_part.mMaterialDesc.mMetallicRoughnessTextureFile,
-                                           game_object_part.mMaterialDesc.mNormalTextureFile,
-                                           game_object_part.mMaterialDesc.mOcclusionTextureFile,
-                                           game_object_part.mMaterialDesc.mEmissiveTextureFile};
+                        material_source.mBaseColorFile = game_object_part.mMaterialDesc.mBaseColorTextureFile;
+                        material_source.mMetallicRoughnessFile =
+                            game_object_part.mMaterialDesc.mMetallicRoughnessTextureFile;
+                        material_source.mNormalFile    = game_object_part.mMaterialDesc.mNormalTextureFile;
+                        material_source.mOcclusionFile = game_object_part.mMaterialDesc.mOcclusionTextureFile;
+                        material_source.mEmissiveFile  = game_object_part.mMaterialDesc.mEmissiveTextureFile;
                     }
                     else
                     {
-                        // TODO: move to default material definition json file
-                        material_source = {
-                            asset_manager->GetFullPath("Asset/Textures/default/albedo.jpg").generic_string(),
-                            asset_manager->GetFullPath("Asset/Textures/default/mr.jpg").generic_string(),
-                            asset_manager->GetFullPath("Asset/Textures/default/normal.jpg").generic_string(),
-                            "",
-                            ""};
+                        material_source = mDefaultMaterialSource;
                     }
                     bool is_material_loaded = mRenderScene->GetMaterialAssetdAllocator().HasElement(material_source);
 
                     RenderMaterialData material_data;
                     if (!is_material_loaded)
                     {
-                        material_data = mRenderResource->LoadMaterialData(material_source);
+                        auto prefetched_material = mPrefetchedMaterials.find(material_source);
+                        if (prefetched_material != mPrefetchedMaterials.end())
+                        {
+                            material_data = std::move(prefetched_material->second);
+                            mPrefetchedMaterials.erase(prefetched_material);
+                        }
+                        else
+                        {
+                            material_data = mRenderResource->LoadMaterialData(material_source);
+                        }
                     }
 
                     render_entity.mMaterialAssetID =
@@ -350,7 +524,8 @@ namespace MiniEngine
                         mRenderResource->UploadGameObjectRenderResource(mRHI, render_entity, material_data);
                     }
 
-                    // add object to render scene if needed
+                    // add object to render scene if needed, the new assets are referenced before the old ones are released
+                    addEntityReferences(render_entity);
                     if (!is_entity_in_scene)
                     {
                         mRenderScene->mRenderEntities.push_back(render_entity);
@@ -361,6 +536,7 @@ namespace MiniEngine
                         {
                             if (entity.mInstanceID == render_entity.mInstanceID)
                             {
+                                releaseEntityReferences(entity);
                                 entity = render_entity;
                                 break;
                             }
@@ -368,25 +544,16 @@ namespace MiniEngine
                     }
                 }
                 // after finished processing, pop this game object
-                swap_data.mGameObjectResourceDesc->Pop();
+                swap_data.mGameObjectResourceDesc.Pop();
             }
 
             // reset game object swap data to a clean state
             mSwapContext.ResetGameObjectResourceSwapData();
+            mPrefetchedMeshes.clear();
+            mPrefetchedMaterials.clear();
         }
 
-        // remove deleted objects
-        if (swap_data.mGameObjectToDelete.has_value())
-        {
-            while (!swap_data.mGameObjectToDelete->IsEmpty())
-            {
-                GameObjectDesc gobject = swap_data.mGameObjectToDelete->GetNextProcessObject();
-                mRenderScene->DeleteEntityByGObjectID(gobject.GetID());
-                swap_data.mGameObjectToDelete->Pop();
-            }
-
-            mSwapContext.ResetGameObjectToDelete();
-        }
+        std::static_pointer_cast<RenderResource>(mRenderResource)->EvictUnusedAssets(*mRenderScene);
 
         // process camera swap data
         if (swap_data.mCameraSwapData.has_value())
@@ -408,5 +575,154 @@ namespace MiniEngine
 
             mSwapContext.ResetCameraSwapData();
         }
+
+        // process point light swap data, the lights stay in the scene until replaced again
+        if (swap_data.mPointLights.has_value())
+        {
+            mRenderScene->mPointLightList.mLights = std::move(*swap_data.mPointLights);
+            mSwapContext.ResetPointLightSwapData();
+        }
+    }
+
+    void RenderSystem::prefetchSwapAssets(const GameObjectResourceDesc& objects)
+    {
+        PROFILE_SCOPE("RenderSystem::prefetchSwapAssets");
+
+        // every asset is decoded once, no matter how many queued parts use it
+        // element pointers stay valid while the maps grow, the workers only write through them
+        std::vector<std::pair<const MeshSourceDesc, PrefetchedMesh>*>         meshes;
+        std::vector<std::pair<const MaterialSourceDesc, RenderMaterialData>*> materials;
+        MeshSourceDesc                                                        mesh_source;
+        MaterialSourceDesc                                                    material_source;
+        for (size_t object_index = objects.mProcessIndex; object_index < objects.mCount; ++object_index)
+        {
+            for (const GameObjectPartDesc& part : objects.mGameObjectDesc[object_index].GetObjectParts())
+            {
+                mesh_source.mMeshFile = part.mMeshDesc.mMeshFile;
+                if (!mRenderScene->GetMeshAssetIDAllocator().HasElement(mesh_source))
+                {
+                    auto result = mPrefetchedMeshes.try_emplace(mesh_source);
+                    if (result.second)
+                    {
+                        meshes.push_back(&*result.first);
+                    }
+                }
+
+                if (part.mMaterialDesc.mbWithTexture)
+                {
+                    material_source.mBaseColorFile         = part.mMaterialDesc.mBaseColorTextureFile;
+                    material_source.mMetallicRoughnessFile = part.mMaterialDesc.mMetallicRoughnessTextureFile;
+                    material_source.mNormalFile            = part.mMaterialDesc.mNormalTextureFile;
+                    material_source.mOcclusionFile         = part.mMaterialDesc.mOcclusionTextureFile;
+                    material_source.mEmissiveFile          = part.mMaterialDesc.mEmissiveTextureFile;
+                }
+                else
+                {
+                    material_source = mDefaultMaterialSource;
+                }
+                if (!mRenderScene->GetMaterialAssetdAllocator().HasElement(material_source))
+                {
+                    auto result = mPrefetchedMaterials.try_emplace(material_source);
+                    if (result.second)
+                    {
+                        materials.push_back(&*result.first);
+                    }
+                }
+            }
+        }
+
+        // a single asset is loaded where it is used
+        const uint32_t asset_count = static_cast<uint32_t>(meshes.size() + materials.size());
+        if (asset_count < 2)
+        {
+            mPrefetchedMeshes.clear();
+            mPrefetchedMaterials.clear();
+            return;
+        }
+
+        gRuntimeGlobalContext.mThreadPool->ParallelFor(asset_count, 1, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t asset_index = begin; asset_index < end; ++asset_index)
+            {
+                if (asset_index < meshes.size())
+                {
+                    auto& mesh        = *meshes[asset_index];
+                    mesh.second.mData = mRenderResource->DecodeMeshData(mesh.first, mesh.second.mBoundingBox);
+                }
+                else
+                {
+                    auto& material  = *materials[asset_index - meshes.size()];
+                    material.second = mRenderResource->LoadMaterialData(material.first);
+                }
+            }
+        });
+    }
+
+    void RenderSystem::processReloadedAssets(const std::vector<std::string>& files)
+    {
+        std::unordered_set<std::string> changed_files;
+        for (const std::string& file : files)
+        {
+            changed_files.insert(std::filesystem::path(file).lexically_normal().generic_string());
+        }
+        auto is_changed = [&changed_files](const std::string& file) {
+            return !file.empty() &&
+                   changed_files.find(std::filesystem::path(file).lexically_normal().generic_string()) !=
+                       changed_files.end();
+        };
+
+        GuidAllocator<MeshSourceDesc>& mesh_allocator = mRenderScene->GetMeshAssetIDAllocator();
+        for (size_t mesh_asset_id : mesh_allocator.GetAllocatedGuids())
+        {
+            MeshSourceDesc mesh_source;
+            if (!mesh_allocator.GetGuidRelatedElement(mesh_asset_id, mesh_source) || !is_changed(mesh_source.mMeshFile))
+                continue;
+
+            RenderEntity render_entity;
+            render_entity.mMeshAssetID = mesh_asset_id;
+            RenderMeshData mesh_data   = mRenderResource->LoadMeshData(mesh_source, render_entity.mBoundingBox);
+            if (!mesh_data.mStaticMeshData.mVertexBuffer || mesh_data.mStaticMeshData.mVertexBuffer->mSize == 0)
+            {
+                LOG_WARN("reload mesh {} failed, keep the old one", mesh_source.mMeshFile);
+                continue;
+            }
+
+            mRenderResource->ReloadGameObjectRenderResource(mRHI, render_entity, mesh_data);
+            for (RenderEntity& entity : mRenderScene->mRenderEntities)
+            {
+                if (entity.mMeshAssetID == mesh_asset_id)
+                {
+                    entity.mBoundingBox = render_entity.mBoundingBox;
+                }
+            }
+            LOG_INFO("reloaded mesh {}", mesh_source.mMeshFile);
+        }
+
+        GuidAllocator<MaterialSourceDesc>& material_allocator = mRenderScene->GetMaterialAssetdAllocator();
+        for (size_t material_asset_id : material_allocator.GetAllocatedGuids())
+        {
+            MaterialSourceDesc material_source;
+            if (!material_allocator.GetGuidRelatedElement(material_asset_id, material_source))
+                continue;
+            if (!is_changed(material_source.mBaseColorFile) && !is_changed(material_source.mMetallicRoughnessFile) &&
+                !is_changed(material_source.mNormalFile) && !is_changed(material_source.mOcclusionFile) &&
+                !is_changed(material_source.mEmissiveFile))
+                continue;
+
+            // the material uniform buffer is filled from the entity factors
+            RenderEntity render_entity;
+            render_entity.mMaterialAssetID = material_asset_id;
+            for (const RenderEntity& entity : mRenderScene->mRenderEntities)
+            {
+                if (entity.mMaterialAssetID == material_asset_id)
+                {
+                    render_entity = entity;
+                    break;
+                }
+            }
+
+            RenderMaterialData material_data = mRenderResource->LoadMaterialData(material_source);
+            mRenderResource->ReloadGameObjectRenderResource(mRHI, render_entity, material_data);
+            LOG_INFO("reloaded material with base color {}", material_source.mBaseColorFile);
+        }
     }
 }
\ No newline at end of file
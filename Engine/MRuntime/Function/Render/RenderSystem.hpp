@@ -1,6 +1,9 @@
 #pragma once
 
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "MRuntime/Function/Render/Interface/RHI.hpp"
 #include "MRuntime/Function/Render/WindowSystem.hpp"
@@ -20,6 +23,7 @@ namespace MiniEngine
     class RenderCamera;
     class WindowUI;
     class DebugDrawManager;
+    struct RenderMemoryReport;
 
     struct RenderSystemInitInfo
     {
@@ -45,6 +49,9 @@ namespace MiniEngine
         void Tick(float DeltaTime);
         void Clear();
 
+        // blocks until the gpu is done with the frame in flight the next tick records into
+        void WaitForFrame();
+
         void                          SwapLogicRenderData();
         RenderSwapContext&            GetSwapContext();
         std::shared_ptr<RenderCamera> GetRenderCamera() const;
@@ -65,9 +72,15 @@ namespace MiniEngine
         GuidAllocator<MeshSourceDesc>&   GetMeshAssetIDAllocator();
 
         void ClearForLevelReloading();
+
+        RenderMemoryReport GetMemoryReport() const;
     
     private:
         void processSwapData();
+        void addEntityReferences(const RenderEntity& entity);
+        void releaseEntityReferences(const RenderEntity& entity);
+        void processReloadedAssets(const std::vector<std::string>& files);
+        void prefetchSwapAssets(const GameObjectResourceDesc& objects);
 
     private:
         RENDER_PIPELINE_TYPE mRenderPipelineType{RENDER_PIPELINE_TYPE::FORWARD_PIPELINE};
@@ -79,5 +92,23 @@ namespace MiniEngine
         std::shared_ptr<RenderScene>        mRenderScene;
         std::shared_ptr<RenderResourceBase> mRenderResource;
         std::shared_ptr<RenderPipelineBase> mRenderPipeline;
+
+        MaterialSourceDesc mDefaultMaterialSource;
+
+        // scratch of processSwapData
+        RenderEntity       mSwapRenderEntity;
+        MeshSourceDesc     mSwapMeshSource;
+        MaterialSourceDesc mSwapMaterialSource;
+        std::vector<RenderEntity> mSwapDeletedEntities;
+
+        struct PrefetchedMesh
+        {
+            RenderMeshData mData;
+            AxisAlignedBox mBoundingBox;
+        };
+
+        // meshes and materials first used by the queued objects, decoded together on the workers
+        std::unordered_map<MeshSourceDesc, PrefetchedMesh>         mPrefetchedMeshes;
+        std::unordered_map<MaterialSourceDesc, RenderMaterialData> mPrefetchedMaterials;
     };
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 /// <summary>
 /// RHI Type
@@ -1126,6 +1127,15 @@ namespace MiniEngine
         RHI_IMAGE_LAYOUT_MAX_ENUM                       = 0x7FFFFFFF
     };
 
+    enum RHIPresentModeKHR : int
+    {
+        RHI_PRESENT_MODE_IMMEDIATE_KHR    = 0,
+        RHI_PRESENT_MODE_MAILBOX_KHR      = 1,
+        RHI_PRESENT_MODE_FIFO_KHR         = 2,
+        RHI_PRESENT_MODE_FIFO_RELAXED_KHR = 3,
+        RHI_PRESENT_MODE_MAX_ENUM_KHR     = 0x7FFFFFFF
+    };
+
     enum RHIImageViewType : int
     {
         RHI_IMAGE_VIEW_TYPE_1D         = 0,
@@ -1705,6 +1715,21 @@ namespace MiniEngine
         RHI_DEPENDENCY_FLAG_BITS_MAX_ENUM   = 0x7FFFFFFF
     };
 
+    enum RHIDescriptorSetLayoutCreateFlagBits
+    {
+        RHI_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT = 0x00000002,
+        RHI_DESCRIPTOR_SET_LAYOUT_CREATE_FLAG_BITS_MAX_ENUM         = 0x7FFFFFFF
+    };
+
+    enum RHIDescriptorBindingFlagBits
+    {
+        RHI_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT           = 0x00000001,
+        RHI_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT = 0x00000002,
+        RHI_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT             = 0x00000004,
+        RHI_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT   = 0x00000008,
+        RHI_DESCRIPTOR_BINDING_FLAG_BITS_MAX_ENUM              = 0x7FFFFFFF
+    };
+
     typedef uint32_t RHIAccessFlags;
     typedef uint32_t RHIImageAspectFlags;
     typedef uint32_t RHIFormatFeatureFlags;
@@ -1752,6 +1777,7 @@ namespace MiniEngine
     typedef uint32_t RHIDescriptorPoolCreateFlags;
     typedef uint32_t RHIDescriptorPoolResetFlags;
     typedef uint32_t RHIDescriptorSetLayoutCreateFlags;
+    typedef uint32_t RHIDescriptorBindingFlags;
     typedef uint32_t RHIAttachmentDescriptionFlags;
     typedef uint32_t RHIDependencyFlags;
     typedef uint32_t RHIFramebufferCreateFlags;
@@ -1884,10 +1910,24 @@ namespace MiniEngine
         }
     };
 
+    static const uint32_t s_mesh_max_lod_count = 4;
+
+    // a range of the index buffer, all levels of detail share the vertices
+    struct MeshLod
+    {
+        uint32_t mIndexOffset {0};
+        uint32_t mIndexCount {0};
+        // object space distance the simplified surface may be away from the full one
+        float mError {0.0f};
+    };
+
     struct StaticMeshData
     {
         std::shared_ptr<BufferData> mVertexBuffer;
         std::shared_ptr<BufferData> mIndexBuffer;
+        RHIIndexType                mIndexType {RHI_INDEX_TYPE_UINT16};
+        // finest first, empty when the whole index buffer is one level
+        std::vector<MeshLod> mLods;
     };
 
     struct RenderMeshData
@@ -0,0 +1,198 @@
+#include "UploadBufferAllocator.hpp"
+
+#include "MRuntime/Core/Base/Marco.hpp"
+#include "MRuntime/Function/Render/RenderHelper.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace MiniEngine
+{
+    void UploadBufferAllocator::Initialize(std::shared_ptr<RHI> rhi,
+                                           uint32_t             frame_count,
+                                           uint32_t             page_size,
+                                           uint32_t             alignment)
+    {
+        ASSERT(rhi && frame_count > 0 && page_size > 0);
+        Clear();
+
+        mRHI       = rhi;
+        mAlignment = std::max(alignment, 1u);
+        mPageSize  = page_size;
+        mFrames.resize(frame_count);
+        for (FrameUpload& frame : mFrames)
+        {
+            frame.mPage = createPage(mPageSize);
+        }
+    }
+
+    void UploadBufferAllocator::Clear()
+    {
+        if (!mRHI)
+        {
+            return;
+        }
+
+        // every frame in flight may still read its pages
+        mRHI->WaitForFencesPFN(mRHI->GetMaxFramesInFlight(), mRHI->GetFenceList(), RHI_TRUE, UINT64_MAX);
+        for (FrameUpload& frame : mFrames)
+        {
+            for (UploadPage& page : frame.mRetiredPages)
+            {
+                destroyPage(page);
+            }
+            destroyPage(frame.mPage);
+        }
+        mFrames.clear();
+        mDescriptors.clear();
+
+        LOG_INFO("upload buffer: {} KB pages, peak {} KB per frame, grown {} times",
+                 mPageSize / 1024,
+                 mPeakUsedSize / 1024,
+                 mGrowCount);
+        mRHI.reset();
+    }
+
+    void UploadBufferAllocator::BeginFrame(uint8_t frame_index)
+    {
+        ASSERT(frame_index < mFrames.size());
+
+        mLastFrameUsedSize = mFrames[mFrameIndex].mUsedSize;
+        mPeakUsedSize      = std::max(mPeakUsedSize, mLastFrameUsedSize);
+
+        // the fence of this frame was waited on, nothing reads its pages anymore
+        mFrameIndex        = frame_index;
+        FrameUpload& frame = mFrames[frame_index];
+        for (UploadPage& page : frame.mRetiredPages)
+        {
+            destroyPage(page);
+        }
+        frame.mRetiredPages.clear();
+
+        // another frame had to grow, catch up before this one runs out as well
+        if (frame.mPage.mSize < mPageSize)
+        {
+            destroyPage(frame.mPage);
+            frame.mPage = createPage(mPageSize);
+        }
+        frame.mUsedSize = 0;
+    }
+
+    UploadAllocation UploadBufferAllocator::Allocate(uint32_t size)
+    {
+        FrameUpload& frame  = mFrames[mFrameIndex];
+        uint32_t     offset = RoundUp(frame.mUsedSize, mAlignment);
+        if (static_cast<uint64_t>(offset) + size > frame.mPage.mSize)
+        {
+            growPage(frame, static_cast<uint64_t>(offset) + size);
+        }
+        frame.mUsedSize = offset + size;
+
+        UploadAllocation allocation;
+        allocation.mOffset = offset;
+        allocation.mData   = static_cast<uint8_t*>(frame.mPage.mData) + offset;
+        return allocation;
+    }
+
+    uint32_t UploadBufferAllocator::RegisterDescriptorSet(RHIDescriptorSetLayout* layout, UploadDescriptorWriter writer)
+    {
+        UploadDescriptor descriptor;
+        descriptor.mLayout = layout;
+        descriptor.mWriter = std::move(writer);
+        mDescriptors.push_back(std::move(descriptor));
+        return static_cast<uint32_t>(mDescriptors.size() - 1);
+    }
+
+    RHIDescriptorSet* UploadBufferAllocator::GetDescriptorSet(uint32_t descriptor_id)
+    {
+        ASSERT(descriptor_id < mDescriptors.size());
+
+        UploadPage& page = mFrames[mFrameIndex].mPage;
+        if (page.mDescriptorSets.size() <= descriptor_id)
+        {
+            page.mDescriptorSets.resize(mDescriptors.size(), nullptr);
+        }
+
+        RHIDescriptorSet*& descriptor_set = page.mDescriptorSets[descriptor_id];
+        if (descriptor_set != nullptr)
+        {
+            return descriptor_set;
+        }
+
+        // the pool can't free sets, the ones of released pages are written again
+        UploadDescriptor& descriptor = mDescriptors[descriptor_id];
+        if (!descriptor.mFreeDescriptorSets.empty())
+        {
+            descriptor_set = descriptor.mFreeDescriptorSets.back();
+            descriptor.mFreeDescriptorSets.pop_back();
+        }
+        else
+        {
+            if (RHI_SUCCESS != mRHI->AllocateDescriptorSet(descriptor.mLayout, descriptor_set))
+            {
+                throw std::runtime_error("allocate upload buffer descriptor set");
+            }
+        }
+        descriptor.mWriter(descriptor_set, page.mBuffer);
+        return descriptor_set;
+    }
+
+    UploadBufferAllocator::UploadPage UploadBufferAllocator::createPage(uint32_t size)
+    {
+        UploadPage page;
+        page.mSize = size;
+        mRHI->CreateBuffer(size,
+                           RHI_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                           RHI_MEMORY_PROPERTY_HOST_VISIBLE_BIT | RHI_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                           page.mBuffer,
+                           page.mMemory);
+        mRHI->MapMemory(page.mMemory, 0, RHI_WHOLE_SIZE, 0, &page.mData);
+        return page;
+    }
+
+    void UploadBufferAllocator::destroyPage(UploadPage& page)
+    {
+        for (uint32_t descriptor_id = 0; descriptor_id < page.mDescriptorSets.size(); ++descriptor_id)
+        {
+            if (page.mDescriptorSets[descriptor_id] != nullptr)
+            {
+                mDescriptors[descriptor_id].mFreeDescriptorSets.push_back(page.mDescriptorSets[descriptor_id]);
+            }
+        }
+        page.mDescriptorSets.clear();
+
+        if (page.mMemory != nullptr)
+        {
+            mRHI->UnmapMemory(page.mMemory);
+            mRHI->DestroyBuffer(page.mBuffer);
+            mRHI->FreeMemory(page.mMemory);
+        }
+        page.mData = nullptr;
+        page.mSize = 0;
+    }
+
+    void UploadBufferAllocator::growPage(FrameUpload& frame, uint64_t required_size)
+    {
+        uint64_t page_size = std::max<uint64_t>(frame.mPage.mSize, 1);
+        while (page_size < required_size)
+        {
+            page_size *= 2;
+        }
+        if (page_size > UINT32_MAX)
+        {
+            throw std::runtime_error("upload buffer page exceeds 4 GB");
+        }
+
+        // the offsets of this frame are bound together with the new ones, keep them valid in the new page.
+        // the old page stays alive until the fence of the frame, draws recorded so far still read it
+        UploadPage page = createPage(static_cast<uint32_t>(page_size));
+        memcpy(page.mData, frame.mPage.mData, frame.mUsedSize);
+        frame.mRetiredPages.push_back(std::move(frame.mPage));
+        frame.mPage = std::move(page);
+
+        ++mGrowCount;
+        mPageSize = std::max(mPageSize, frame.mPage.mSize);
+        LOG_WARN("upload buffer page of frame {} is full, grown to {} KB", mFrameIndex, frame.mPage.mSize / 1024);
+    }
+} // namespace MiniEngine
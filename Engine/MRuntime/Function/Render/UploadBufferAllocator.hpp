@@ -0,0 +1,97 @@
+#pragma once
+
+#include "MRuntime/Function/Render/Interface/RHI.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace MiniEngine
+{
+    // fills the descriptors of a set whose dynamic storage buffers point into an upload page
+    using UploadDescriptorWriter = std::function<void(RHIDescriptorSet* descriptor_set, RHIBuffer* page_buffer)>;
+
+    struct UploadAllocation
+    {
+        // dynamic offset into the current page of the frame
+        uint32_t mOffset {0};
+        void*    mData {nullptr};
+    };
+
+    /// Host visible memory for the per frame, per draw call and light data read through dynamic offsets.
+    /// Every frame in flight writes its own page. A full page is replaced during the frame by one twice the size
+    /// and the data written so far is copied over, so offsets handed out earlier stay valid in the new page.
+    /// Replaced pages are released once the fence of their frame has been waited on
+    class UploadBufferAllocator
+    {
+    public:
+        void Initialize(std::shared_ptr<RHI> rhi, uint32_t frame_count, uint32_t page_size, uint32_t alignment);
+        void Clear();
+
+        // call after the fence of the frame was waited on, its pages are reused from the start
+        void BeginFrame(uint8_t frame_index);
+
+        // the pointer is only valid until the next allocation, a growing page moves the data
+        UploadAllocation Allocate(uint32_t size);
+
+        template<typename T>
+        T* Allocate(uint32_t& offset)
+        {
+            UploadAllocation allocation = Allocate(static_cast<uint32_t>(sizeof(T)));
+            offset                      = allocation.mOffset;
+            return static_cast<T*>(allocation.mData);
+        }
+
+        // sets pointing into the pages exist once per page, fetch them after the allocations they are bound with
+        uint32_t          RegisterDescriptorSet(RHIDescriptorSetLayout* layout, UploadDescriptorWriter writer);
+        RHIDescriptorSet* GetDescriptorSet(uint32_t descriptor_id);
+
+        uint32_t GetPageSize() const { return mPageSize; }
+        uint32_t GetLastFrameUsedSize() const { return mLastFrameUsedSize; }
+        uint32_t GetPeakUsedSize() const { return mPeakUsedSize; }
+
+    private:
+        struct UploadPage
+        {
+            RHIBuffer*                     mBuffer {nullptr};
+            RHIDeviceMemory*               mMemory {nullptr};
+            void*                          mData {nullptr};
+            uint32_t                       mSize {0};
+            std::vector<RHIDescriptorSet*> mDescriptorSets;
+        };
+
+        struct FrameUpload
+        {
+            UploadPage              mPage;
+            std::vector<UploadPage> mRetiredPages;
+            uint32_t                mUsedSize {0};
+        };
+
+        struct UploadDescriptor
+        {
+            RHIDescriptorSetLayout*        mLayout {nullptr};
+            UploadDescriptorWriter         mWriter;
+            std::vector<RHIDescriptorSet*> mFreeDescriptorSets;
+        };
+
+        UploadPage createPage(uint32_t size);
+        void       destroyPage(UploadPage& page);
+        void       growPage(FrameUpload& frame, uint64_t required_size);
+
+    private:
+        std::shared_ptr<RHI> mRHI;
+
+        std::vector<FrameUpload>      mFrames;
+        std::vector<UploadDescriptor> mDescriptors;
+        uint8_t                       mFrameIndex {0};
+        uint32_t                      mAlignment {256};
+
+        // pages below this size are replaced when their frame begins, it only grows
+        uint32_t mPageSize {0};
+
+        uint32_t mLastFrameUsedSize {0};
+        uint32_t mPeakUsedSize {0};
+        uint32_t mGrowCount {0};
+    };
+} // namespace MiniEngine
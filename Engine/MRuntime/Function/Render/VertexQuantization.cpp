@@ -0,0 +1,158 @@
+#include "VertexQuantization.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace MiniEngine
+{
+    uint16_t QuantizeUnorm16(float value)
+    {
+        return static_cast<uint16_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 65535.0f));
+    }
+
+    int16_t QuantizeSnorm16(float value)
+    {
+        return static_cast<int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+    }
+
+    float DequantizeUnorm16(uint16_t value) { return value / 65535.0f; }
+
+    float DequantizeSnorm16(int16_t value) { return std::max(value / 32767.0f, -1.0f); }
+
+    uint16_t FloatToHalf(float value)
+    {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+
+        uint16_t sign     = static_cast<uint16_t>((bits >> 16) & 0x8000);
+        uint32_t exponent = (bits >> 23) & 0xff;
+        uint32_t mantissa = bits & 0x7fffff;
+
+        // nan stays nan, everything too large for a half becomes the largest finite one
+        if (exponent == 0xff && mantissa != 0)
+        {
+            return sign | 0x7e00;
+        }
+        int32_t half_exponent = static_cast<int32_t>(exponent) - 127 + 15;
+        if (half_exponent >= 0x1f)
+        {
+            return sign | 0x7bff;
+        }
+
+        if (half_exponent <= 0)
+        {
+            // subnormal half, the implicit bit moves into the mantissa
+            if (half_exponent < -10)
+            {
+                return sign;
+            }
+            mantissa |= 0x800000;
+            uint32_t shift     = static_cast<uint32_t>(14 - half_exponent);
+            uint32_t half_bits = mantissa >> shift;
+            uint32_t remainder = mantissa & ((1u << shift) - 1);
+            uint32_t halfway   = 1u << (shift - 1);
+            if (remainder > halfway || (remainder == halfway && (half_bits & 1)))
+            {
+                ++half_bits;
+            }
+            return static_cast<uint16_t>(sign | half_bits);
+        }
+
+        uint32_t half_bits = (static_cast<uint32_t>(half_exponent) << 10) | (mantissa >> 13);
+        uint32_t remainder = mantissa & 0x1fff;
+        if (remainder > 0x1000 || (remainder == 0x1000 && (half_bits & 1)))
+        {
+            // a carry out of the mantissa correctly bumps the exponent
+            ++half_bits;
+        }
+        return static_cast<uint16_t>(sign | std::min(half_bits, 0x7bffu));
+    }
+
+    float HalfToFloat(uint16_t value)
+    {
+        uint32_t sign     = static_cast<uint32_t>(value & 0x8000) << 16;
+        uint32_t exponent = (value >> 10) & 0x1f;
+        uint32_t mantissa = value & 0x3ff;
+
+        uint32_t bits;
+        if (exponent == 0x1f)
+        {
+            bits = sign | 0x7f800000 | (mantissa << 13);
+        }
+        else if (exponent != 0)
+        {
+            bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+        }
+        else if (mantissa != 0)
+        {
+            // normalize the subnormal half
+            exponent = 127 - 15 + 1;
+            while ((mantissa & 0x400) == 0)
+            {
+                mantissa <<= 1;
+                --exponent;
+            }
+            bits = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+        }
+        else
+        {
+            bits = sign;
+        }
+
+        float result;
+        memcpy(&result, &bits, sizeof(result));
+        return result;
+    }
+
+    void EncodeOctahedron(const Vector3& direction, int16_t encoded[2])
+    {
+        float length = std::fabs(direction.x) + std::fabs(direction.y) + std::fabs(direction.z);
+        if (length <= 0.0f)
+        {
+            encoded[0] = 0;
+            encoded[1] = QuantizeSnorm16(1.0f);
+            return;
+        }
+
+        float x = direction.x / length;
+        float y = direction.y / length;
+        if (direction.z < 0.0f)
+        {
+            float folded_x = (1.0f - std::fabs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+            float folded_y = (1.0f - std::fabs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+            x              = folded_x;
+            y              = folded_y;
+        }
+
+        Vector3 unit_direction = direction.NormalizedCopy();
+        float   best_cosine    = -2.0f;
+        float   floor_x        = std::floor(std::clamp(x, -1.0f, 1.0f) * 32767.0f);
+        float   floor_y        = std::floor(std::clamp(y, -1.0f, 1.0f) * 32767.0f);
+        for (uint32_t candidate = 0; candidate < 4; ++candidate)
+        {
+            int16_t code[2] = {static_cast<int16_t>(std::min(floor_x + (candidate & 1), 32767.0f)),
+                               static_cast<int16_t>(std::min(floor_y + (candidate >> 1), 32767.0f))};
+            float   cosine  = DecodeOctahedron(code).DotProduct(unit_direction);
+            if (cosine > best_cosine)
+            {
+                best_cosine = cosine;
+                encoded[0]  = code[0];
+                encoded[1]  = code[1];
+            }
+        }
+    }
+
+    Vector3 DecodeOctahedron(const int16_t encoded[2])
+    {
+        float   x = DequantizeSnorm16(encoded[0]);
+        float   y = DequantizeSnorm16(encoded[1]);
+        Vector3 direction(x, y, 1.0f - std::fabs(x) - std::fabs(y));
+
+        // the lower half was folded over the diagonals
+        float fold = std::max(-direction.z, 0.0f);
+        direction.x += direction.x >= 0.0f ? -fold : fold;
+        direction.y += direction.y >= 0.0f ? -fold : fold;
+        return direction.NormalizedCopy();
+    }
+} // namespace MiniEngine
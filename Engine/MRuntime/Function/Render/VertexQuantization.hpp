@@ -0,0 +1,24 @@
+#pragma once
+
+#include "MRuntime/Core/Math/Vector3.hpp"
+
+#include <cstdint>
+
+namespace MiniEngine
+{
+    // conversions the quantized vertex streams are written with, the vertex fetch reads them back as
+    // unorm16, snorm16 and half float so only the octahedral normals need decoding in the shader
+
+    uint16_t QuantizeUnorm16(float value);
+    int16_t  QuantizeSnorm16(float value);
+    float    DequantizeUnorm16(uint16_t value);
+    float    DequantizeSnorm16(int16_t value);
+
+    // round to nearest even, out of range values saturate to the largest finite half
+    uint16_t FloatToHalf(float value);
+    float    HalfToFloat(uint16_t value);
+
+    // unit vector folded onto the octahedron, of the four nearest snorm16 codes the one decoding closest is kept
+    void    EncodeOctahedron(const Vector3& direction, int16_t encoded[2]);
+    Vector3 DecodeOctahedron(const int16_t encoded[2]);
+} // namespace MiniEngine
@@ -9,15 +9,27 @@ namespace MiniEngine
 {
     WindowSystem::~WindowSystem()
     {
+        if (mbIsHeadless)
+        {
+            return;
+        }
         glfwDestroyWindow(mWindow);
         glfwTerminate();
     }
 
     void WindowSystem::Initialize(WindowCreateInfo& create_info)
     {
+        if (create_info.IsHeadless)
+        {
+            mbIsHeadless = true;
+            mWidth       = create_info.Width;
+            mHeight      = create_info.Height;
+            return;
+        }
+
         if (!glfwInit())
         {
-            LOG_FATAL(__FUNCTION__, "failed to initialize GLFW");
+            LOG_FATAL("failed to initialize GLFW");
             return;
         }
 
@@ -28,7 +40,7 @@ namespace MiniEngine
         mWindow = glfwCreateWindow(create_info.Width, create_info.Height, create_info.Title, nullptr, nullptr);
         if (!mWindow)
         {
-            LOG_FATAL(__FUNCTION__, "failed to create window");
+            LOG_FATAL("failed to create window");
             glfwTerminate();
             return;
         }
@@ -52,6 +64,7 @@ namespace MiniEngine
     void WindowSystem::SetFocusMode(bool mode)
     {
         mbIsFocusMode = mode;
-        glfwSetInputMode(mWindow, GLFW_CURSOR, mbIsFocusMode ? GLFW_CURSOR_DISABLED : GLFW_CURSOR_NORMAL);
+        if (mWindow)
+            glfwSetInputMode(mWindow, GLFW_CURSOR, mbIsFocusMode ? GLFW_CURSOR_DISABLED : GLFW_CURSOR_NORMAL);
     }
 }
\ No newline at end of file
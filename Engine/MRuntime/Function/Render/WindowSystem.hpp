@@ -15,6 +15,8 @@ namespace MiniEngine
         int         Height        = 720;
         const char* Title         = "MiniEngine";
         bool        IsFullscreen  = false;
+        // no glfw window is created, the renderer draws into offscreen images
+        bool        IsHeadless    = false;
     };
 
     class WindowSystem
@@ -23,9 +25,10 @@ namespace MiniEngine
         WindowSystem() = default;
         ~WindowSystem();
         void Initialize(WindowCreateInfo& createInfo);
-        void SetTitle(const char* title) { glfwSetWindowTitle(mWindow, title); }
-        static void PollEvents() { glfwPollEvents(); }
-        bool ShouldClose() { return glfwWindowShouldClose(mWindow); }
+        void SetTitle(const char* title) { if (mWindow) glfwSetWindowTitle(mWindow, title); }
+        void PollEvents() const { if (mWindow) glfwPollEvents(); }
+        bool ShouldClose() { return mWindow ? glfwWindowShouldClose(mWindow) : false; }
+        bool IsHeadless() const { return mbIsHeadless; }
 
         GLFWwindow* GetWindow() const { return mWindow; };
         std::array<int, 2> GetWindowSize() const { return std::array<int, 2>({mWidth, mHeight}); }
@@ -56,7 +59,7 @@ namespace MiniEngine
 
         bool IsMouseButtonDown(int button) const
         {
-            if (button < GLFW_MOUSE_BUTTON_1 || button > GLFW_MOUSE_BUTTON_LAST)
+            if (!mWindow || button < GLFW_MOUSE_BUTTON_1 || button > GLFW_MOUSE_BUTTON_LAST)
             {
                 return false;
             }
@@ -199,6 +202,7 @@ namespace MiniEngine
         int mHeight = 0;
 
         bool mbIsFocusMode {false};
+        bool mbIsHeadless {false};
 
         std::vector<OnResetFunc>       mOnResetFunc;
         std::vector<OnKeyFunc>         mOnKeyFunc;
@@ -1,4 +1,11 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <numeric>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "MEngine.hpp"
 #include "MRuntime/Core/Base/Marco.hpp"
@@ -11,6 +18,11 @@
 #include "MRuntime/Function/Render/WindowSystem.hpp"
 #include "MRuntime/Function/Render/RenderSystem.hpp"
 #include "MRuntime/Function/Render/DebugDraw/DebugDrawManager.hpp"
+#include "MRuntime/Core/Profiler/Profiler.hpp"
+#include "MRuntime/Core/Memory/FrameAllocator.hpp"
+#include "MRuntime/Core/Memory/HeapStats.hpp"
+#include "MRuntime/Resource/AssetManager/AssetManager.hpp"
+#include "MRuntime/Resource/ConfigManager/ConfigManager.hpp"
 
 
 namespace MiniEngine
@@ -18,6 +30,8 @@ namespace MiniEngine
     bool                            gbIsEditorMode;
     std::unordered_set<std::string> gEditorTickComponentTypes;
     const float MiniEngine::MEngine::msFPSAlpha = 1.0f / 100;
+    // longer than a scheduler tick on most systems, shorter than any sensible frame
+    const std::chrono::microseconds MiniEngine::MEngine::msFrameLimiterSpinTime {2000};
 
     void MEngine::StartEngine(const std::string &configFilePath)
     {
@@ -41,24 +55,85 @@ namespace MiniEngine
     {
         std::shared_ptr<WindowSystem> wndSystem = gRuntimeGlobalContext.mWindowSystem;
         ASSERT(wndSystem);
+        if (wndSystem->IsHeadless())
+        {
+            runHeadless();
+            return;
+        }
         while (!wndSystem->ShouldClose())
         {
+            BeginFrame();
             const float deltaTime = CalculateDeltaTime();
             TickOneFrame(deltaTime);
         }
     }
 
+    void MEngine::BeginFrame()
+    {
+        // waiting before the frame begins keeps the limiter out of the measured frame and the input latency
+        waitForFrameRateLimit();
+
+        gRuntimeGlobalContext.mProfiler->BeginFrame();
+        {
+            PROFILE_SCOPE("MEngine::BeginFrame");
+
+            // the fence of the frame in flight would otherwise be waited on in the render tick,
+            // after the input was already sampled
+            gRuntimeGlobalContext.mRenderSystem->WaitForFrame();
+            gRuntimeGlobalContext.mWindowSystem->PollEvents();
+        }
+        gRuntimeGlobalContext.mProfiler->MarkInputSampled();
+        mbIsFrameBegun = true;
+    }
+
     bool MEngine::TickOneFrame(float DeltaTime)
     {
-        LogicalTick(DeltaTime);
+        if (!mbIsFrameBegun)
+        {
+            BeginFrame();
+        }
+        mbIsFrameBegun = false;
+        PROFILE_SCOPE("MEngine::TickOneFrame");
+
+        gRuntimeGlobalContext.mFrameAllocator->BeginFrame(
+            gRuntimeGlobalContext.mRenderSystem->GetRHI()->GetCurrentFrameIndex());
+
+        // fixed logic steps cover the elapsed time, rendering blends the last two logic states by the remainder
+        float          interpolation_alpha = 1.0f;
+        const uint32_t logic_tick_rate     = gRuntimeGlobalContext.mConfigManager->GetLogicTickRate();
+        if (logic_tick_rate == 0)
+        {
+            LogicalTick(DeltaTime);
+        }
+        else
+        {
+            const float    step_time      = 1.0f / logic_tick_rate;
+            const uint32_t max_step_count = gRuntimeGlobalContext.mConfigManager->GetMaxLogicStepsPerFrame();
+
+            mLogicTimeAccumulator += DeltaTime;
+            uint32_t step_count = 0;
+            while (mLogicTimeAccumulator >= step_time && step_count < max_step_count)
+            {
+                LogicalTick(step_time);
+                mLogicTimeAccumulator -= step_time;
+                ++step_count;
+            }
+
+            // logic slower than real time drops the whole steps it is behind instead of taking more every frame
+            mLogicTimeAccumulator = std::fmod(mLogicTimeAccumulator, step_time);
+            interpolation_alpha   = mLogicTimeAccumulator / step_time;
+        }
+        gRuntimeGlobalContext.mWorldManager->Interpolate(interpolation_alpha);
+
         CalculateFPS(DeltaTime);
 
         gRuntimeGlobalContext.mRenderSystem->SwapLogicRenderData();
 
         RendererTick(DeltaTime);
 
-        gRuntimeGlobalContext.mWindowSystem->PollEvents();
-        gRuntimeGlobalContext.mWindowSystem->SetTitle(std::string("MiniEngine - " + std::to_string(GetFPS()) + " FPS").c_str());
+        char title[64];
+        snprintf(title, sizeof(title), "MiniEngine - %d FPS", GetFPS());
+        gRuntimeGlobalContext.mWindowSystem->SetTitle(title);
         const bool shouldWndClose = gRuntimeGlobalContext.mWindowSystem->ShouldClose();
 
         return !shouldWndClose;
@@ -66,12 +141,18 @@ namespace MiniEngine
 
     void MEngine::LogicalTick(float DeltaTime)
     {
+        PROFILE_SCOPE("MEngine::LogicalTick");
+
+        // changed assets are reloaded before the world ticks so the new data goes out with this frame
+        gRuntimeGlobalContext.mAssetManager->Tick();
         gRuntimeGlobalContext.mWorldManager->Tick(DeltaTime);
         gRuntimeGlobalContext.mInputSystem->Tick();
     }
 
     bool MEngine::RendererTick(float DeltaTime)
     {
+        PROFILE_SCOPE("MEngine::RendererTick");
+
         gRuntimeGlobalContext.mRenderSystem->Tick(DeltaTime);
         return true;
     }
@@ -104,6 +185,109 @@ namespace MiniEngine
 
         return deltaTime;
     }
+
+    void MEngine::waitForFrameRateLimit()
+    {
+        using namespace std::chrono;
+
+        const uint32_t frame_rate_limit = gRuntimeGlobalContext.mConfigManager->GetFrameRateLimit();
+        if (frame_rate_limit == 0 || gRuntimeGlobalContext.mWindowSystem->IsHeadless())
+        {
+            return;
+        }
+
+        steady_clock::time_point now = steady_clock::now();
+        if (now + msFrameLimiterSpinTime < mNextFrameTimePoint)
+        {
+            std::this_thread::sleep_until(mNextFrameTimePoint - msFrameLimiterSpinTime);
+        }
+        while ((now = steady_clock::now()) < mNextFrameTimePoint)
+        {
+            std::this_thread::yield();
+        }
+
+        // frames are scheduled from the last deadline so the rate does not drift,
+        // a frame that ran a whole frame late starts the schedule over instead of rushing the next ones
+        const steady_clock::duration frame_time =
+            duration_cast<steady_clock::duration>(duration<double>(1.0 / frame_rate_limit));
+        mNextFrameTimePoint += frame_time;
+        if (mNextFrameTimePoint < now)
+        {
+            mNextFrameTimePoint = now + frame_time;
+        }
+    }
+
+    void MEngine::runHeadless()
+    {
+        std::shared_ptr<ConfigManager> config_manager = gRuntimeGlobalContext.mConfigManager;
+        ASSERT(config_manager);
+
+        const std::filesystem::path& timing_path = config_manager->GetHeadlessTimingPath();
+        std::ofstream                timing_file(timing_path, std::ios::trunc);
+        if (!timing_file.is_open())
+        {
+            LOG_ERROR("open headless timing file {} failed", timing_path.generic_string());
+            return;
+        }
+        timing_file << "frame,cpu_ms,gpu_ms,latency_ms,heap_allocations\n";
+
+        // a fixed delta time keeps the simulated work identical between runs on different machines
+        const float    delta_time  = 1.0f / 60.0f;
+        const uint32_t frame_count = config_manager->GetHeadlessFrameCount();
+
+        std::vector<float> cpu_frame_times;
+        cpu_frame_times.reserve(frame_count);
+        uint64_t last_heap_allocations = 0;
+        for (uint32_t frame_index = 0; frame_index < frame_count; ++frame_index)
+        {
+            std::chrono::steady_clock::time_point frame_begin = std::chrono::steady_clock::now();
+            uint64_t                              heap_begin  = GetHeapAllocationCount();
+            TickOneFrame(delta_time);
+            uint64_t heap_allocations = GetHeapAllocationCount() - heap_begin;
+            float    cpu_ms =
+                std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - frame_begin).count();
+
+            // gpu scopes arrive frames in flight later, report the latest ones that were read back
+            ProfileFrame profile_frame = gRuntimeGlobalContext.mProfiler->GetLastFrame();
+            double       gpu_ms        = 0.0;
+            for (const ProfileScope& scope : profile_frame.gpu_scopes)
+            {
+                if (scope.depth == 0)
+                {
+                    gpu_ms += (scope.end_ns - scope.begin_ns) / 1000000.0;
+                }
+            }
+
+            timing_file << frame_index << "," << cpu_ms << "," << gpu_ms << "," << profile_frame.GetInputLatencyMs() << ",";
+            if (IsHeapStatsAvailable())
+            {
+                timing_file << heap_allocations;
+            }
+            timing_file << "\n";
+            cpu_frame_times.push_back(cpu_ms);
+            last_heap_allocations = heap_allocations;
+        }
+
+        if (cpu_frame_times.empty())
+        {
+            return;
+        }
+
+        float total_ms = std::accumulate(cpu_frame_times.begin(), cpu_frame_times.end(), 0.0f);
+        std::sort(cpu_frame_times.begin(), cpu_frame_times.end());
+        float p95_ms = cpu_frame_times[std::min(cpu_frame_times.size() - 1, cpu_frame_times.size() * 95 / 100)];
+        // heap allocations are only counted in builds with MINIENGINE_HEAP_STATS
+        std::string heap_allocation_report =
+            IsHeapStatsAvailable() ? std::to_string(last_heap_allocations) : std::string("unavailable");
+        LOG_INFO("headless run finished: {} frames, cpu avg {:.3f} ms, p95 {:.3f} ms, max {:.3f} ms, "
+                 "heap allocations in the last frame {}, timings written to {}",
+                 frame_count,
+                 total_ms / cpu_frame_times.size(),
+                 p95_ms,
+                 cpu_frame_times.back(),
+                 heap_allocation_report,
+                 timing_path.generic_string());
+    }
 }
 
 
@@ -15,6 +15,7 @@ namespace MiniEngine
     {
         friend class MEditor;
         static const float msFPSAlpha;
+        static const std::chrono::microseconds msFrameLimiterSpinTime;
     public:
         void StartEngine(const std::string& configFilePath);
         void ShutdownEngine();
@@ -24,6 +25,9 @@ namespace MiniEngine
 
         bool IsQuit() const { return mbIsQuit; }
         void Run();
+        // frame rate limit, wait for the frame in flight and input sampling, as late as possible before the logic.
+        // TickOneFrame calls it when the loop did not
+        void BeginFrame();
         bool TickOneFrame(float DeltaTime);
 
         int GetFPS() const { return mFPS; }
@@ -35,11 +39,23 @@ namespace MiniEngine
         void CalculateFPS(float DeltaTime);
         float CalculateDeltaTime();
 
+        // sleeps most of the remaining frame time and spins the rest, sleeping alone wakes up too late
+        void waitForFrameRateLimit();
+
+        // fixed frame count without a window, timings are written for performance tracking
+        void runHeadless();
+
     protected:
         bool mbIsQuit {false};
         std::chrono::steady_clock::time_point mLastTickTimePoint = std::chrono::steady_clock::now();    // 上个时间点
         float mAvgDuration {0.0f};
         uint32_t mFrameCount {0};
         uint32_t mFPS {0};
+
+        // frame time not yet taken by fixed logic steps
+        float mLogicTimeAccumulator {0.0f};
+
+        bool                                  mbIsFrameBegun {false};
+        std::chrono::steady_clock::time_point mNextFrameTimePoint = std::chrono::steady_clock::now();
     };
 } // namespace MiniEngine
\ No newline at end of file
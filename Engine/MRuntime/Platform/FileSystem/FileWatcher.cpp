@@ -0,0 +1,290 @@
+#include "FileWatcher.hpp"
+
+#include "MRuntime/Core/Base/Marco.hpp"
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include <system_error>
+
+namespace MiniEngine
+{
+    FileWatcher::~FileWatcher() { Clear(); }
+
+    bool FileWatcher::Initialize(const std::filesystem::path& directory)
+    {
+        Clear();
+
+        std::error_code error;
+        if (!std::filesystem::is_directory(directory, error))
+        {
+            LOG_WARN("can't watch {}, not a directory", directory.generic_string());
+            return false;
+        }
+        mDirectory = directory;
+
+#if defined(__linux__)
+        mInotifyFD = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (mInotifyFD < 0)
+        {
+            LOG_WARN("inotify_init1 failed, file changes in {} are not watched", directory.generic_string());
+            return false;
+        }
+        addWatch(mDirectory, false);
+#else
+        scanFiles(false);
+#endif
+        return true;
+    }
+
+    void FileWatcher::Clear()
+    {
+#if defined(__linux__)
+        if (mInotifyFD >= 0)
+        {
+            close(mInotifyFD);
+            mInotifyFD = -1;
+        }
+        mWatchDirectories.clear();
+        mCreatedFiles.clear();
+#else
+        mFileTimes.clear();
+#endif
+        mPendingChanges.clear();
+        mPendingChangeIndices.clear();
+        mDirectory.clear();
+    }
+
+    void FileWatcher::PollChanges(std::vector<FileChange>& changes)
+    {
+        if (mDirectory.empty())
+        {
+            return;
+        }
+
+#if defined(__linux__)
+        readEvents();
+#else
+        if (std::chrono::steady_clock::now() - mLastScanTime >= std::chrono::seconds(1))
+        {
+            scanFiles(true);
+        }
+#endif
+
+        changes.insert(changes.end(), mPendingChanges.begin(), mPendingChanges.end());
+        mPendingChanges.clear();
+        mPendingChangeIndices.clear();
+    }
+
+    void FileWatcher::addChange(const std::filesystem::path& path, FileChangeType type)
+    {
+        const std::string key  = path.generic_string();
+        auto              iter = mPendingChangeIndices.find(key);
+        if (iter == mPendingChangeIndices.end())
+        {
+            mPendingChangeIndices.emplace(key, mPendingChanges.size());
+            mPendingChanges.push_back({path, type});
+            return;
+        }
+
+        FileChangeType& pending_type = mPendingChanges[iter->second].mType;
+        if (pending_type == FileChangeType::Added && type == FileChangeType::Modified)
+            return;
+        if (pending_type == FileChangeType::Added && type == FileChangeType::Removed)
+        {
+            // temporary file, e.g. written and then renamed by an editor
+            mPendingChanges.erase(mPendingChanges.begin() + iter->second);
+            mPendingChangeIndices.clear();
+            for (size_t index = 0; index < mPendingChanges.size(); ++index)
+            {
+                mPendingChangeIndices.emplace(mPendingChanges[index].mPath.generic_string(), index);
+            }
+            return;
+        }
+        if (pending_type == FileChangeType::Removed && type == FileChangeType::Added)
+            pending_type = FileChangeType::Modified;
+        else
+            pending_type = type;
+    }
+
+#if defined(__linux__)
+    void FileWatcher::addWatch(const std::filesystem::path& directory, bool report_files)
+    {
+        // inotify is not recursive, every directory needs its own watch
+        const uint32_t mask =
+            IN_CREATE | IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE | IN_DELETE_SELF | IN_MOVE_SELF;
+        int            watch = inotify_add_watch(mInotifyFD, directory.c_str(), mask);
+        if (watch < 0)
+        {
+            LOG_WARN("inotify_add_watch failed for {}", directory.generic_string());
+            return;
+        }
+        mWatchDirectories[watch] = directory;
+
+        std::error_code error;
+        for (auto iter = std::filesystem::directory_iterator(directory, error);
+             !error && iter != std::filesystem::directory_iterator();
+             iter.increment(error))
+        {
+            if (iter->is_directory(error))
+            {
+                addWatch(iter->path(), report_files);
+            }
+            else if (report_files)
+            {
+                // files moved in or written before the watch of a new directory existed
+                addChange(iter->path(), FileChangeType::Added);
+            }
+        }
+    }
+
+    void FileWatcher::removeWatch(const std::filesystem::path& directory)
+    {
+        // the watches of a moved directory keep reporting from its new place, so they are removed with it
+        const std::string directory_key = directory.generic_string();
+        for (auto iter = mWatchDirectories.begin(); iter != mWatchDirectories.end();)
+        {
+            const std::string key = iter->second.generic_string();
+            if (key.compare(0, directory_key.size(), directory_key) == 0 &&
+                (key.size() == directory_key.size() || key[directory_key.size()] == '/'))
+            {
+                // fails harmlessly for a deleted directory whose watch is already gone
+                inotify_rm_watch(mInotifyFD, iter->first);
+                iter = mWatchDirectories.erase(iter);
+            }
+            else
+            {
+                ++iter;
+            }
+        }
+    }
+
+    void FileWatcher::readEvents()
+    {
+        alignas(inotify_event) char buffer[4096];
+        while (true)
+        {
+            ssize_t length = read(mInotifyFD, buffer, sizeof(buffer));
+            if (length <= 0)
+            {
+                // EAGAIN, no more events
+                break;
+            }
+
+            for (char* pointer = buffer; pointer < buffer + length;)
+            {
+                const inotify_event* event = reinterpret_cast<const inotify_event*>(pointer);
+                pointer += sizeof(inotify_event) + event->len;
+
+                if (event->mask & IN_Q_OVERFLOW)
+                {
+                    LOG_WARN("file watcher queue overflow in {}, some changes are lost", mDirectory.generic_string());
+                    continue;
+                }
+
+                auto directory_iter = mWatchDirectories.find(event->wd);
+                if (directory_iter == mWatchDirectories.end())
+                {
+                    continue;
+                }
+                if (event->mask & IN_IGNORED)
+                {
+                    mWatchDirectories.erase(directory_iter);
+                    continue;
+                }
+                if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF))
+                {
+                    // other directories are handled through the event of their parent
+                    if (directory_iter->second == mDirectory)
+                    {
+                        LOG_WARN("watched directory {} was removed or moved, file changes are no longer reported",
+                                 mDirectory.generic_string());
+                        removeWatch(mDirectory);
+                    }
+                    continue;
+                }
+                if (event->len == 0)
+                {
+                    continue;
+                }
+
+                const std::filesystem::path path = directory_iter->second / event->name;
+                if (event->mask & IN_ISDIR)
+                {
+                    if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                    {
+                        addWatch(path, true);
+                    }
+                    else if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+                    {
+                        removeWatch(path);
+                        addChange(path, FileChangeType::Removed);
+                    }
+                    continue;
+                }
+
+                if (event->mask & IN_CREATE)
+                {
+                    mCreatedFiles.insert(path.generic_string());
+                }
+                else if (event->mask & IN_CLOSE_WRITE)
+                {
+                    bool is_created = mCreatedFiles.erase(path.generic_string()) > 0;
+                    addChange(path, is_created ? FileChangeType::Added : FileChangeType::Modified);
+                }
+                else if (event->mask & IN_MOVED_TO)
+                {
+                    addChange(path, FileChangeType::Added);
+                }
+                else if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+                {
+                    mCreatedFiles.erase(path.generic_string());
+                    addChange(path, FileChangeType::Removed);
+                }
+            }
+        }
+    }
+#else
+    void FileWatcher::scanFiles(bool report_changes)
+    {
+        mLastScanTime = std::chrono::steady_clock::now();
+
+        std::unordered_map<std::string, std::filesystem::file_time_type> file_times;
+        std::error_code                                                  error;
+        for (auto iter = std::filesystem::recursive_directory_iterator(mDirectory, error);
+             !error && iter != std::filesystem::recursive_directory_iterator();
+             iter.increment(error))
+        {
+            if (!iter->is_regular_file(error))
+                continue;
+
+            const std::string key        = iter->path().generic_string();
+            auto              write_time = iter->last_write_time(error);
+            file_times.emplace(key, write_time);
+
+            if (!report_changes)
+                continue;
+
+            auto old_iter = mFileTimes.find(key);
+            if (old_iter == mFileTimes.end())
+                addChange(iter->path(), FileChangeType::Added);
+            else if (old_iter->second != write_time)
+                addChange(iter->path(), FileChangeType::Modified);
+        }
+
+        if (report_changes)
+        {
+            for (auto& file_time : mFileTimes)
+            {
+                if (file_times.find(file_time.first) == file_times.end())
+                {
+                    addChange(file_time.first, FileChangeType::Removed);
+                }
+            }
+        }
+        mFileTimes = std::move(file_times);
+    }
+#endif
+} // namespace MiniEngine
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace MiniEngine
+{
+    enum class FileChangeType : uint8_t
+    {
+        Added,
+        Modified,
+        Removed
+    };
+
+    // a removed or moved away directory is reported as one removed change of the directory itself
+    struct FileChange
+    {
+        std::filesystem::path mPath;
+        FileChangeType        mType {FileChangeType::Modified};
+    };
+
+    /// Watch a directory tree for changed files.
+    /// Uses inotify on linux, other platforms compare file times at most once per second
+    class FileWatcher
+    {
+    public:
+        FileWatcher() = default;
+        ~FileWatcher();
+
+        FileWatcher(const FileWatcher&)            = delete;
+        FileWatcher& operator=(const FileWatcher&) = delete;
+
+        bool Initialize(const std::filesystem::path& directory);
+        void Clear();
+
+        // non-blocking, several events of one file since the last call are merged into one change
+        void PollChanges(std::vector<FileChange>& changes);
+
+    private:
+        void addChange(const std::filesystem::path& path, FileChangeType type);
+
+#if defined(__linux__)
+        void addWatch(const std::filesystem::path& directory, bool report_files);
+        void removeWatch(const std::filesystem::path& directory);
+        void readEvents();
+#else
+        void scanFiles(bool report_changes);
+#endif
+
+    private:
+        std::filesystem::path mDirectory;
+
+        std::vector<FileChange>                 mPendingChanges;
+        std::unordered_map<std::string, size_t> mPendingChangeIndices;
+
+#if defined(__linux__)
+        int                                            mInotifyFD {-1};
+        std::unordered_map<int, std::filesystem::path> mWatchDirectories;
+        // created files are reported once they are closed, not while they are still written
+        std::unordered_set<std::string> mCreatedFiles;
+#else
+        std::unordered_map<std::string, std::filesystem::file_time_type> mFileTimes;
+        std::chrono::steady_clock::time_point                            mLastScanTime;
+#endif
+    };
+} // namespace MiniEngine
@@ -3,10 +3,153 @@
 #include "MRuntime/Resource/ConfigManager/ConfigManager.hpp"
 #include "MRuntime/Function/Global/GlobalContext.hpp"
 
+#include <algorithm>
 #include <filesystem>
 
 namespace MiniEngine
 {
+    void AssetManager::Initialize()
+    {
+        if (!gRuntimeGlobalContext.mConfigManager->IsHotReloadEnabled())
+        {
+            return;
+        }
+
+        // watch the normalized path, changed files are compared with paths from GetFullPath
+        std::filesystem::path asset_folder =
+            std::filesystem::absolute(gRuntimeGlobalContext.mConfigManager->GetAssetFolder()).lexically_normal();
+        mFileWatcher = std::make_unique<FileWatcher>();
+        if (!mFileWatcher->Initialize(asset_folder))
+        {
+            mFileWatcher.reset();
+            return;
+        }
+        LOG_INFO("hot reload enabled, watching {}", asset_folder.generic_string());
+    }
+
+    void AssetManager::Clear()
+    {
+        ClearAssetCache();
+        mFileChangeCallbacks.clear();
+        mFileChanges.clear();
+        mIgnoredFiles.clear();
+        mFileWatcher.reset();
+    }
+
+    void AssetManager::Tick()
+    {
+        if (mFileWatcher == nullptr)
+        {
+            return;
+        }
+
+        mFileChanges.clear();
+        mFileWatcher->PollChanges(mFileChanges);
+        if (mFileChanges.empty())
+        {
+            return;
+        }
+
+        auto is_ignored = [this](const FileChange& change) {
+            return change.mType != FileChangeType::Removed && mIgnoredFiles.erase(change.mPath.generic_string()) > 0;
+        };
+        mFileChanges.erase(std::remove_if(mFileChanges.begin(), mFileChanges.end(), is_ignored), mFileChanges.end());
+        if (mFileChanges.empty())
+        {
+            return;
+        }
+
+        for (const FileChange& change : mFileChanges)
+        {
+            LOG_DEBUG("asset changed: {}", change.mPath.generic_string());
+            evictCachedAsset(change.mPath.lexically_normal().generic_string());
+        }
+        for (FileChangeCallback& callback : mFileChangeCallbacks)
+        {
+            callback(mFileChanges);
+        }
+    }
+
+    void AssetManager::AddFileChangeCallback(FileChangeCallback callback)
+    {
+        mFileChangeCallbacks.push_back(std::move(callback));
+    }
+
+    void AssetManager::ignoreNextChange(const std::filesystem::path& path) const
+    {
+        if (mFileWatcher != nullptr)
+        {
+            mIgnoredFiles.insert(path.lexically_normal().generic_string());
+        }
+    }
+
+    void AssetManager::ClearAssetCache()
+    {
+        std::lock_guard<std::mutex> lock(mCacheMutex);
+        mCachedJsons.clear();
+        mSharedAssets.clear();
+    }
+
+    bool AssetManager::loadJson(const std::string& asset_url, Json& out_json) const
+    {
+        // read json file to string
+        std::filesystem::path asset_path = GetFullPath(asset_url);
+        std::ifstream         asset_json_file(asset_path);
+        if (!asset_json_file)
+        {
+            LOG_ERROR("open file: {} failed!", asset_path.generic_string());
+            return false;
+        }
+
+        std::stringstream buffer;
+        buffer << asset_json_file.rdbuf();
+        std::string asset_json_text(buffer.str());
+
+        // parse to json object
+        std::string error;
+        out_json = Json::parse(asset_json_text, error);
+        if (!error.empty())
+        {
+            LOG_ERROR("parse json file {} failed!", asset_url);
+            return false;
+        }
+        return true;
+    }
+
+    bool AssetManager::loadCachedJson(const std::string& asset_url, Json& out_json)
+    {
+        std::string key = getCacheKey(asset_url);
+        {
+            std::lock_guard<std::mutex> lock(mCacheMutex);
+            auto                        iter = mCachedJsons.find(key);
+            if (iter != mCachedJsons.end())
+            {
+                out_json = iter->second;
+                return true;
+            }
+        }
+
+        // failed loads are not cached, the file may appear later
+        if (!loadJson(asset_url, out_json))
+            return false;
+
+        std::lock_guard<std::mutex> lock(mCacheMutex);
+        mCachedJsons.emplace(key, out_json);
+        return true;
+    }
+
+    std::string AssetManager::getCacheKey(const std::string& asset_url) const
+    {
+        return GetFullPath(asset_url).lexically_normal().generic_string();
+    }
+
+    void AssetManager::evictCachedAsset(const std::string& key) const
+    {
+        std::lock_guard<std::mutex> lock(mCacheMutex);
+        mCachedJsons.erase(key);
+        mSharedAssets.erase(key);
+    }
+
     std::filesystem::path AssetManager::GetFullPath(const std::string& relative_path) const
     {
         return std::filesystem::absolute(gRuntimeGlobalContext.mConfigManager->GetRootFolder() / relative_path);
@@ -2,12 +2,18 @@
 
 #include "MRuntime/Core/Base/Marco.hpp"
 #include "MRuntime/Core/Meta/Serializer/Serializer.hpp"
+#include "MRuntime/Platform/FileSystem/FileWatcher.hpp"
 
 #include <filesystem>
 #include <fstream>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "Generated/Serializer/all_serializer.h"
 
@@ -16,39 +22,81 @@ namespace MiniEngine
     class AssetManager
     {
     public:
+        using FileChangeCallback = std::function<void(const std::vector<FileChange>&)>;
+
+        void Initialize();
+        void Clear();
+
+        // polls the watched asset folder and passes the changes to the callbacks, once per logic tick
+        void Tick();
+        void AddFileChangeCallback(FileChangeCallback callback);
+        bool IsHotReloadEnabled() const { return mFileWatcher != nullptr; }
+
         template<typename AssetType>
         bool LoadAsset(const std::string& asset_url, AssetType& out_asset) const
         {
-            // read json file to string
-            std::filesystem::path asset_path = GetFullPath(asset_url);
-            std::ifstream asset_json_file(asset_path);
-            if (!asset_json_file)
-            {
-                LOG_ERROR("open file: {} failed!", asset_path.generic_string());
+            Json asset_json;
+            if (!loadJson(asset_url, asset_json))
                 return false;
-            }
 
-            std::stringstream buffer;
-            buffer << asset_json_file.rdbuf();
-            std::string asset_json_text(buffer.str());
+            // read to runtime res object
+            Serializer::Read(asset_json, out_asset);
+            return true;
+        }
 
-            // parse to json object and read to runtime res object
-            std::string error;
-            auto&&      asset_json = Json::parse(asset_json_text, error);
-            if (!error.empty())
-            {
-                LOG_ERROR("parse json file {} failed!", asset_url);
+        // reads a new copy of the asset, the file is only read and parsed the first time.
+        // for assets with many instances like object definitions, every copy can be changed on its own
+        template<typename AssetType>
+        bool InstantiateAsset(const std::string& asset_url, AssetType& out_asset)
+        {
+            Json asset_json;
+            if (!loadCachedJson(asset_url, asset_json))
                 return false;
-            }
 
             Serializer::Read(asset_json, out_asset);
             return true;
         }
 
+        // reads and parses the file into the cache used by InstantiateAsset and LoadSharedAsset
+        bool PreloadAsset(const std::string& asset_url)
+        {
+            Json asset_json;
+            return loadCachedJson(asset_url, asset_json);
+        }
+
+        // one immutable copy of the asset shared by every caller, nullptr if it can not be loaded
+        template<typename AssetType>
+        std::shared_ptr<const AssetType> LoadSharedAsset(const std::string& asset_url)
+        {
+            std::string key = getCacheKey(asset_url);
+            {
+                std::lock_guard<std::mutex> lock(mCacheMutex);
+                auto                        iter = mSharedAssets.find(key);
+                if (iter != mSharedAssets.end())
+                    return std::static_pointer_cast<const AssetType>(iter->second);
+            }
+
+            std::shared_ptr<AssetType> asset = std::make_shared<AssetType>();
+            if (!InstantiateAsset(asset_url, *asset))
+                return nullptr;
+
+            // a concurrent load of the same url keeps the first copy
+            std::lock_guard<std::mutex> lock(mCacheMutex);
+            return std::static_pointer_cast<const AssetType>(
+                mSharedAssets.emplace(key, std::move(asset)).first->second);
+        }
+
+        // the cached copies of changed files are dropped before the file change callbacks run
+        void ClearAssetCache();
+
         template<typename AssetType>
         bool SaveAsset(const AssetType& out_asset, const std::string& asset_url) const
         {
-            std::ofstream asset_json_file(GetFullPath(asset_url));
+            std::filesystem::path asset_path = GetFullPath(asset_url);
+            ignoreNextChange(asset_path);
+            evictCachedAsset(getCacheKey(asset_url));
+
+            std::ofstream asset_json_file(asset_path);
             if (!asset_json_file)
             {
                 LOG_ERROR("open file {} failed!", asset_url);
@@ -67,5 +115,28 @@ namespace MiniEngine
         }
 
         std::filesystem::path GetFullPath(const std::string& relative_path) const;
+
+    private:
+        bool loadJson(const std::string& asset_url, Json& out_json) const;
+        bool loadCachedJson(const std::string& asset_url, Json& out_json);
+
+        // normalized full path, the same string the file watcher reports
+        std::string getCacheKey(const std::string& asset_url) const;
+        void        evictCachedAsset(const std::string& key) const;
+
+        // files written by the engine itself are not reloaded
+        void ignoreNextChange(const std::filesystem::path& path) const;
+
+    private:
+        std::unique_ptr<FileWatcher>    mFileWatcher;
+        std::vector<FileChange>         mFileChanges;
+        std::vector<FileChangeCallback> mFileChangeCallbacks;
+
+        mutable std::unordered_set<std::string> mIgnoredFiles;
+
+        // parsed files and shared assets by cache key, json values are immutable and copied by reference
+        mutable std::mutex                                                   mCacheMutex;
+        mutable std::unordered_map<std::string, Json>                        mCachedJsons;
+        mutable std::unordered_map<std::string, std::shared_ptr<const void>> mSharedAssets;
     };
 } // namespace MiniEngine
@@ -1,5 +1,6 @@
 #include "Resource/ConfigManager/ConfigManager.hpp"
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <string>
@@ -38,8 +39,37 @@ namespace MiniEngine
                     mEditorFontPath = mRootFolder / value;
                 else if (name == "GlobalRenderingRes")
                     mGlobalRenderingResURL = value;
+                else if (name == "Headless")
+                    mbHeadless = value == "1" || value == "true";
+                else if (name == "HeadlessFrameCount")
+                    mHeadlessFrameCount = static_cast<uint32_t>(std::stoul(value));
+                else if (name == "HeadlessTimingFile")
+                    mHeadlessTimingPath = mRootFolder / value;
+                else if (name == "LogLevel")
+                    mLogLevel = value;
+                else if (name == "BinaryLog")
+                    mbBinaryLog = value == "1" || value == "true";
+                else if (name == "HotReload")
+                    mbHotReload = value == "1" || value == "true";
+                else if (name == "LogicTickRate")
+                    mLogicTickRate = static_cast<uint32_t>(std::stoul(value));
+                else if (name == "MaxLogicStepsPerFrame")
+                    mMaxLogicStepsPerFrame = std::max(static_cast<uint32_t>(std::stoul(value)), 1u);
+                else if (name == "FramesInFlight")
+                    mFramesInFlight = std::max(static_cast<uint32_t>(std::stoul(value)), 1u);
+                else if (name == "PresentMode")
+                    mPresentMode = value;
+                else if (name == "FrameRateLimit")
+                    mFrameRateLimit = static_cast<uint32_t>(std::stoul(value));
+                else if (name == "DerivedDataFolder")
+                    mDerivedDataFolder = mRootFolder / value;
             }
         }
+
+        if (mHeadlessTimingPath.empty())
+        {
+            mHeadlessTimingPath = mRootFolder / "HeadlessTiming.csv";
+        }
     }
 } // namespace MiniEngine
 
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
+#include <string>
 
 namespace MiniEngine
 {
@@ -20,6 +22,33 @@ namespace MiniEngine
         const std::string& GetDefaultWorldURL() const { return mDefaultWorldURL; }
         const std::string& GetGlobalRenderingResURL() const { return mGlobalRenderingResURL; }
 
+        // headless runs render offscreen for a fixed number of frames and write the frame timings
+        bool IsHeadless() const { return mbHeadless; }
+        uint32_t GetHeadlessFrameCount() const { return mHeadlessFrameCount; }
+        const std::filesystem::path& GetHeadlessTimingPath() const { return mHeadlessTimingPath; }
+
+        // runtime log filter, levels compiled out by MINIENGINE_LOG_LEVEL stay out
+        const std::string& GetLogLevel() const { return mLogLevel; }
+        bool IsBinaryLogEnabled() const { return mbBinaryLog; }
+
+        // watch the asset folder and reload changed assets while running
+        bool IsHotReloadEnabled() const { return mbHotReload; }
+
+        // logic steps per second, 0 ticks the logic once per rendered frame with the frame time.
+        // a frame takes at most the max steps, the time the logic falls behind beyond that is dropped
+        uint32_t GetLogicTickRate() const { return mLogicTickRate; }
+        uint32_t GetMaxLogicStepsPerFrame() const { return mMaxLogicStepsPerFrame; }
+
+        // frames the cpu may record ahead of the gpu, 1 has the lowest latency
+        uint32_t GetFramesInFlight() const { return mFramesInFlight; }
+        // Fifo, FifoRelaxed, Mailbox or Immediate
+        const std::string& GetPresentMode() const { return mPresentMode; }
+        // frames per second the main loop sleeps down to, 0 runs unlimited
+        uint32_t GetFrameRateLimit() const { return mFrameRateLimit; }
+
+        // imported meshes and textures, empty when the derived data cache is off
+        const std::filesystem::path& GetDerivedDataFolder() const { return mDerivedDataFolder; }
+
     private:
         std::filesystem::path mRootFolder;
         std::filesystem::path mAssetFolder;
@@ -31,5 +60,23 @@ namespace MiniEngine
 
         std::string mDefaultWorldURL;
         std::string mGlobalRenderingResURL;
+
+        bool                  mbHeadless {false};
+        uint32_t              mHeadlessFrameCount {300};
+        std::filesystem::path mHeadlessTimingPath;
+
+        std::string mLogLevel {"Debug"};
+        bool        mbBinaryLog {false};
+
+        bool mbHotReload {false};
+
+        uint32_t mLogicTickRate {0};
+        uint32_t mMaxLogicStepsPerFrame {4};
+
+        uint32_t    mFramesInFlight {3};
+        std::string mPresentMode {"Mailbox"};
+        uint32_t    mFrameRateLimit {0};
+
+        std::filesystem::path mDerivedDataFolder;
     };
 }
\ No newline at end of file
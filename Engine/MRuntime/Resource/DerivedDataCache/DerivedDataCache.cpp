@@ -0,0 +1,227 @@
+#include "DerivedDataCache.hpp"
+
+#include "MRuntime/Core/Base/Marco.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <system_error>
+#include <thread>
+
+namespace MiniEngine
+{
+    namespace
+    {
+        // bump when the entry layout changes
+        const uint32_t s_entry_magic   = 0x4344444d; // "MDDC"
+        const uint32_t s_entry_version = 1;
+
+        struct EntryHeader
+        {
+            uint32_t magic;
+            uint32_t version;
+            uint64_t key;
+            uint64_t payload_size;
+            uint64_t payload_hash;
+        };
+
+        bool readFile(const std::filesystem::path& path, std::vector<uint8_t>& data)
+        {
+            std::error_code error;
+            if (!std::filesystem::is_regular_file(path, error))
+            {
+                return false;
+            }
+
+            std::ifstream file(path, std::ios::binary | std::ios::ate);
+            if (!file)
+            {
+                return false;
+            }
+            std::streamsize size = file.tellg();
+            if (size < 0)
+            {
+                return false;
+            }
+            data.resize(static_cast<size_t>(size));
+            file.seekg(0);
+            return static_cast<bool>(file.read(reinterpret_cast<char*>(data.data()), size));
+        }
+    } // namespace
+
+    void DerivedDataCache::Initialize(const std::filesystem::path& cache_folder)
+    {
+        mCacheFolder.clear();
+        if (cache_folder.empty())
+        {
+            return;
+        }
+
+        std::error_code error;
+        std::filesystem::create_directories(cache_folder, error);
+        if (error)
+        {
+            LOG_WARN("can't create derived data cache {}, assets are imported every start", cache_folder.generic_string());
+            return;
+        }
+        mCacheFolder = cache_folder;
+    }
+
+    void DerivedDataCache::Clear()
+    {
+        if (IsEnabled())
+        {
+            LOG_INFO("derived data cache: {} hits, {} misses", mHitCount.load(), mMissCount.load());
+        }
+        mCacheFolder.clear();
+    }
+
+    uint64_t DerivedDataCache::BuildKey(const std::filesystem::path& source_file,
+                                        const std::string&           importer,
+                                        uint32_t                     importer_version,
+                                        const std::string&           options) const
+    {
+        if (!IsEnabled())
+        {
+            return 0;
+        }
+
+        // the content and not the file time, copied or checked out files keep their entries
+        std::vector<uint8_t> content;
+        if (!readFile(source_file, content))
+        {
+            return 0;
+        }
+
+        uint64_t key = HashBytes(content.data(), content.size());
+        key          = HashBytes(importer.data(), importer.size(), key);
+        key          = HashBytes(&importer_version, sizeof(importer_version), key);
+        key          = HashBytes(options.data(), options.size(), key);
+        return key == 0 ? 1 : key;
+    }
+
+    bool DerivedDataCache::Load(uint64_t key, std::vector<uint8_t>& data)
+    {
+        if (key == 0 || !IsEnabled())
+        {
+            return false;
+        }
+
+        std::vector<uint8_t> entry;
+        if (!readFile(getEntryPath(key), entry) || entry.size() < sizeof(EntryHeader))
+        {
+            mMissCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        EntryHeader header;
+        memcpy(&header, entry.data(), sizeof(EntryHeader));
+        const uint8_t* payload = entry.data() + sizeof(EntryHeader);
+        if (header.magic != s_entry_magic || header.version != s_entry_version || header.key != key ||
+            header.payload_size != entry.size() - sizeof(EntryHeader) ||
+            header.payload_hash != HashBytes(payload, header.payload_size))
+        {
+            LOG_WARN("derived data cache entry {:016x} is invalid, importing again", key);
+            mMissCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        data.assign(payload, payload + header.payload_size);
+        mHitCount.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void DerivedDataCache::Save(uint64_t key, const std::vector<uint8_t>& data)
+    {
+        if (key == 0 || !IsEnabled())
+        {
+            return;
+        }
+
+        EntryHeader header;
+        header.magic        = s_entry_magic;
+        header.version      = s_entry_version;
+        header.key          = key;
+        header.payload_size = data.size();
+        header.payload_hash = HashBytes(data.data(), data.size());
+
+        // write a temporary file and rename it, readers never see a partial entry
+        std::filesystem::path entry_path = getEntryPath(key);
+        std::stringstream     temp_name;
+        temp_name << entry_path.filename().string() << '.' << std::hash<std::thread::id> {}(std::this_thread::get_id())
+                  << ".tmp";
+        std::filesystem::path temp_path = entry_path.parent_path() / temp_name.str();
+        {
+            std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+            if (!file)
+            {
+                LOG_WARN("can't write derived data cache entry {}", temp_path.generic_string());
+                return;
+            }
+            file.write(reinterpret_cast<const char*>(&header), sizeof(EntryHeader));
+            file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+            if (!file)
+            {
+                file.close();
+                std::error_code error;
+                std::filesystem::remove(temp_path, error);
+                return;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temp_path, entry_path, error);
+        if (error)
+        {
+            std::filesystem::remove(temp_path, error);
+        }
+    }
+
+    uint64_t DerivedDataCache::HashBytes(const void* data, size_t size, uint64_t seed)
+    {
+        // murmur64a, eight bytes per step so hashing stays far below the cost of reading the file
+        const uint64_t multiplier = 0xc6a4a7935bd1e995ull;
+        const int      shift      = 47;
+
+        uint64_t       hash  = seed ^ (size * multiplier);
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        const uint8_t* end   = bytes + (size / 8) * 8;
+        for (; bytes != end; bytes += 8)
+        {
+            uint64_t block;
+            memcpy(&block, bytes, sizeof(block));
+
+            block *= multiplier;
+            block ^= block >> shift;
+            block *= multiplier;
+
+            hash ^= block;
+            hash *= multiplier;
+        }
+
+        const size_t remain = size & 7;
+        if (remain > 0)
+        {
+            uint64_t block = 0;
+            for (size_t index = 0; index < remain; ++index)
+            {
+                block |= static_cast<uint64_t>(bytes[index]) << (8 * index);
+            }
+            hash ^= block;
+            hash *= multiplier;
+        }
+
+        hash ^= hash >> shift;
+        hash *= multiplier;
+        hash ^= hash >> shift;
+        return hash;
+    }
+
+    std::filesystem::path DerivedDataCache::getEntryPath(uint64_t key) const
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "%016llx.ddc", static_cast<unsigned long long>(key));
+        return mCacheFolder / name;
+    }
+} // namespace MiniEngine
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace MiniEngine
+{
+    /// Builds the payload of a cache entry, values are stored as plain memory copies
+    class DerivedDataWriter
+    {
+    public:
+        template<typename T>
+        void Write(const T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable values can be cached");
+            WriteBytes(&value, sizeof(T));
+        }
+
+        void WriteBytes(const void* data, size_t size)
+        {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            mData.insert(mData.end(), bytes, bytes + size);
+        }
+
+        const std::vector<uint8_t>& GetData() const { return mData; }
+
+    private:
+        std::vector<uint8_t> mData;
+    };
+
+    /// Reads a payload written by DerivedDataWriter, fails instead of reading past the end
+    class DerivedDataReader
+    {
+    public:
+        explicit DerivedDataReader(const std::vector<uint8_t>& data) : mData {data} {}
+
+        template<typename T>
+        bool Read(T& value)
+        {
+            static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable values can be cached");
+            return ReadBytes(&value, sizeof(T));
+        }
+
+        bool ReadBytes(void* data, size_t size)
+        {
+            if (size > mData.size() - mOffset)
+            {
+                return false;
+            }
+            memcpy(data, mData.data() + mOffset, size);
+            mOffset += size;
+            return true;
+        }
+
+        bool IsEnd() const { return mOffset == mData.size(); }
+
+    private:
+        const std::vector<uint8_t>& mData;
+        size_t                      mOffset {0};
+    };
+
+    /// Local cache of importer output (parsed meshes, decoded textures).
+    /// Entries are keyed by the content hash of the source file plus the importer name, version and options,
+    /// so edited sources and changed importers never see stale data. Load and Save can be called from any thread
+    class DerivedDataCache
+    {
+    public:
+        // an empty folder disables the cache
+        void Initialize(const std::filesystem::path& cache_folder);
+        void Clear();
+
+        bool IsEnabled() const { return !mCacheFolder.empty(); }
+
+        // zero when the cache is disabled or the source can't be read
+        uint64_t BuildKey(const std::filesystem::path& source_file,
+                          const std::string&           importer,
+                          uint32_t                     importer_version,
+                          const std::string&           options = "") const;
+
+        bool Load(uint64_t key, std::vector<uint8_t>& data);
+        void Save(uint64_t key, const std::vector<uint8_t>& data);
+
+        static uint64_t HashBytes(const void* data, size_t size, uint64_t seed = 0);
+
+    private:
+        std::filesystem::path getEntryPath(uint64_t key) const;
+
+    private:
+        std::filesystem::path mCacheFolder;
+
+        std::atomic<uint32_t> mHitCount {0};
+        std::atomic<uint32_t> mMissCount {0};
+    };
+} // namespace MiniEngine
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "MRuntime/Core/Math/Vector3.hpp"
 #include "MRuntime/Core/Meta/Reflection/Reflection.hpp"
 
 #include <string>
@@ -7,6 +8,20 @@
 
 namespace MiniEngine
 {
+    REFLECTION_TYPE(StreamingCellRes)
+    CLASS(StreamingCellRes, Fields)
+    {
+        REFLECTION_BODY(StreamingCellRes);
+
+    public:
+        // scene holding the objects of the cell
+        std::string mSceneURL;
+
+        // world space bounds of the cell, the camera distance to them decides when it is loaded
+        Vector3 mCenter {0.0f, 0.0f, 0.0f};
+        Vector3 mHalfExtent {0.0f, 0.0f, 0.0f};
+    };
+
     REFLECTION_TYPE(WorldRes)
     CLASS(WorldRes, Fields)
     {
@@ -21,5 +36,15 @@ namespace MiniEngine
 
         // the default scene for this world, which should be first loading scene
         std::string mDefaultSceneURL;
+
+        // scenes streamed in and out around the camera next to the default scene
+        std::vector<StreamingCellRes> mStreamingCells;
+
+        // cells closer than the load distance are loaded, cells further than the unload distance are unloaded
+        float mStreamingLoadDistance {200.0f};
+        float mStreamingUnloadDistance {250.0f};
+
+        // logic thread time spent creating the objects of loading cells per frame
+        float mStreamingTimeBudgetMs {2.0f};
     };
 } // namespace MiniEngine
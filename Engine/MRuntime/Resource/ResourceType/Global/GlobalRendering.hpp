@@ -7,6 +7,8 @@
 
 #include "MRuntime/Resource/ResourceType/Data/CameraConfig.hpp"
 
+#include <vector>
+
 namespace MiniEngine
 {
     REFLECTION_TYPE(SkyBoxIrradianceMap)
@@ -43,8 +45,24 @@ namespace MiniEngine
         REFLECTION_BODY(DirectionalLight);
 
     public:
-        Vector3 mDirection;
-        Color   mColor;
+        Vector3  mDirection;
+        Color    mColor;
+        uint32_t mCascadeCount {4};
+        float    mCascadeSplitLambda {0.75f};
+        float    mShadowDistance {200.0f};
+        // shadow casters are drawn this many levels coarser than the texel size alone would allow
+        uint32_t mShadowLodBias {1};
+    };
+
+    REFLECTION_TYPE(PointLightRes)
+    CLASS(PointLightRes, Fields)
+    {
+        REFLECTION_BODY(PointLightRes);
+
+    public:
+        Vector3 mPosition;
+        // radiant flux in W
+        Vector3 mFlux;
     };
 
     REFLECTION_TYPE(GlobalRenderingRes)
@@ -54,6 +72,10 @@ namespace MiniEngine
 
     public:
         bool                mbEnableFXAA {false};
+        // 16 bit positions, octahedral normals and tangents, half float texcoords
+        bool                mbEnableVertexQuantization {false};
+        // one material buffer and texture array through descriptor indexing, ignored when the device lacks it
+        bool                mbEnableBindlessMaterials {false};
         SkyBoxIrradianceMap mSkyboxIrradianceMap;
         SkyBoxSpecularMap   mSkyboxSpecularMap;
         std::string         mBrdfMap;
@@ -63,5 +85,14 @@ namespace MiniEngine
         Color            mAmbientLight;
         CameraConfig     mCameraConfig;
         DirectionalLight mDirectionalLight;
+
+        // culled per cluster, the scene may replace them through the render swap data
+        std::vector<PointLightRes> mPointLights;
+
+        // screen space error in pixels a mesh level of detail may have
+        float mLodErrorThreshold {1.0f};
+
+        // meshes and materials no entity uses any more are kept loaded up to this size
+        uint32_t mUnusedAssetCacheSizeMB {256};
     };
 } // namespace MiniEngine
\ No newline at end of file
@@ -6,6 +6,22 @@ class Global;
 class Function;
 class Enum;
 
+// the parts of a reflected class the generators need after parsing,
+// kept in the parser cache so unchanged headers don't have to be parsed again
+struct SchemaField
+{
+    std::string name;
+    std::string type;
+    std::string display_name;
+};
+
+struct SchemaClass
+{
+    std::string              name;
+    std::vector<std::string> base_classes;
+    std::vector<SchemaField> fields;
+};
+
 struct SchemaMoudle
 {
     std::string name;
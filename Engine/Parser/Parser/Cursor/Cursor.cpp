@@ -52,6 +52,23 @@ bool Cursor::IsDefinition(void) const
     return clang_isCursorDefinition(mHandle);
 }
 
+bool Cursor::IsFromMainFile(void) const
+{
+    // reflected types are declared through the CLASS macro, whose spelling location is not in any file,
+    // so the file the macro is expanded in decides
+    CXFile file;
+    clang_getExpansionLocation(clang_getCursorLocation(mHandle), &file, nullptr, nullptr, nullptr);
+    if (file == nullptr)
+        return false;
+
+    CXTranslationUnit translation_unit = clang_Cursor_getTranslationUnit(mHandle);
+    CXString          main_file_name   = clang_getTranslationUnitSpelling(translation_unit);
+    CXFile            main_file        = clang_getFile(translation_unit, clang_getCString(main_file_name));
+    clang_disposeString(main_file_name);
+
+    return clang_File_isEqual(file, main_file) != 0;
+}
+
 CursorType Cursor::GetType(void) const
 {
     return clang_getCursorType(mHandle);
@@ -14,6 +14,7 @@ public:
     std::string GetDisplayName(void) const;
     std::string GetSourceFile(void) const;
     bool IsDefinition(void) const;
+    bool IsFromMainFile(void) const;
     CursorType GetType(void) const;
     List GetChildren(void) const;
     void VisitChildren(Visitor visitor, void* data = nullptr);
@@ -13,20 +13,20 @@ namespace Generator
         }
     }
 
-    void GeneratorInterface::GenClassRenderData(std::shared_ptr<Class> classTmp, Mustache::data &classDef)
+    void GeneratorInterface::GenClassRenderData(const SchemaClass& classTmp, Mustache::data &classDef)
     {
-        classDef.set("class_name", classTmp->GetClassName());
-        classDef.set("class_base_class_size", std::to_string(classTmp->mBaseClasses.size()));
+        classDef.set("class_name", classTmp.name);
+        classDef.set("class_base_class_size", std::to_string(classTmp.base_classes.size()));
         classDef.set("class_need_register", true);
 
-        if (classTmp->mBaseClasses.size() > 0)
+        if (classTmp.base_classes.size() > 0)
         {
             Mustache::data class_base_class_defines(Mustache::data::type::list);
             classDef.set("class_has_base", true);
-            for (int index = 0; index < classTmp->mBaseClasses.size(); ++index)
+            for (int index = 0; index < classTmp.base_classes.size(); ++index)
             {
                 Mustache::data class_base_class_def;
-                class_base_class_def.set("class_base_class_name", classTmp->mBaseClasses[index]->mName);
+                class_base_class_def.set("class_base_class_name", classTmp.base_classes[index]);
                 class_base_class_def.set("class_base_class_index", std::to_string(index));
                 class_base_class_defines.push_back(class_base_class_def);
             }
@@ -38,20 +38,19 @@ namespace Generator
         classDef.set("class_field_defines", class_field_defines);
     }
 
-    void GeneratorInterface::GenClassFieldRenderData(std::shared_ptr<Class> classTmp, Mustache::data &fieldDefs)
+    void GeneratorInterface::GenClassFieldRenderData(const SchemaClass& classTmp, Mustache::data &fieldDefs)
     {
         static const std::string vector_prefix = "std::vector<";
 
-        for (auto& field : classTmp->mFields)
+        // only fields that should compile are kept in the schema class
+        for (auto& field : classTmp.fields)
         {
-            if (!field->ShouldCompile())
-                continue;
             Mustache::data filed_define;
 
-            filed_define.set("class_field_name", field->mName);
-            filed_define.set("class_field_type", field->mType);
-            filed_define.set("class_field_display_name", field->mDisplayName);
-            bool is_vector = field->mType.find(vector_prefix) == 0;
+            filed_define.set("class_field_name", field.name);
+            filed_define.set("class_field_type", field.type);
+            filed_define.set("class_field_display_name", field.display_name);
+            bool is_vector = field.type.find(vector_prefix) == 0;
             filed_define.set("class_field_is_vector", is_vector);
             fieldDefs.push_back(filed_define);
         }
@@ -20,14 +20,18 @@ namespace Generator
             , mGetIncludeFunc(getIncludeFunc)
         {}
         virtual int  Generate(std::string path, SchemaMoudle schema) = 0;
+        // registers a header restored from the parser cache, its generated file is already up to date
+        virtual void AddCachedSchema(std::string path, const std::vector<SchemaClass>& classes) = 0;
         virtual void Finish() {};
 
+        bool HasGeneratedFile(std::string path) { return fs::exists(ProcessFileName(path)); }
+
         virtual ~GeneratorInterface() {};
 
     protected:
         virtual void        PrepareStatus(std::string path);
-        virtual void        GenClassRenderData(std::shared_ptr<Class> classTmp, Mustache::data& classDef);
-        virtual void        GenClassFieldRenderData(std::shared_ptr<Class> classTmp, Mustache::data& fieldDefs);
+        virtual void        GenClassRenderData(const SchemaClass& classTmp, Mustache::data& classDef);
+        virtual void        GenClassFieldRenderData(const SchemaClass& classTmp, Mustache::data& fieldDefs);
         virtual std::string ProcessFileName(std::string path) = 0;
 
         std::string                             mOutPath {"GenSrc"};
@@ -44,7 +44,7 @@ namespace Generator
             Mustache::data class_def;
             Mustache::data vector_defines(Mustache::data::type::list);
 
-            GenClassRenderData(class_temp, class_def);
+            GenClassRenderData(class_temp->GetSchemaClass(), class_def);
             for (auto field : class_temp->mFields)
             {
                 if (!field->ShouldCompile())
@@ -102,6 +102,18 @@ namespace Generator
         return 0;
     }
 
+    void ReflectionGenerator::AddCachedSchema(std::string path, const std::vector<SchemaClass>& classes)
+    {
+        std::set<std::string> classNames;
+        for (auto& class_temp : classes)
+        {
+            classNames.insert(class_temp.name);
+        }
+        mTypeList.insert(mTypeList.end(), classNames.begin(), classNames.end());
+
+        mHeadFileList.emplace_back(Utils::MakeRelativePath(mRootPath, ProcessFileName(path)).string());
+    }
+
     void ReflectionGenerator::Finish()
     {
         Mustache::data mustache_data;
@@ -10,6 +10,7 @@ namespace Generator
         ReflectionGenerator() = delete;
         ReflectionGenerator(std::string sourceDirectory, std::function<std::string(std::string)> getIncludeFunc);
         virtual int  Generate(std::string path, SchemaMoudle schema) override;
+        virtual void AddCachedSchema(std::string path, const std::vector<SchemaClass>& classes) override;
         virtual void Finish() override;
         virtual ~ReflectionGenerator() override;
 
@@ -29,7 +29,7 @@ namespace Generator
                 continue;
 
             Mustache::data class_def;
-            GenClassRenderData(class_temp, class_def);
+            GenClassRenderData(class_temp->GetSchemaClass(), class_def);
 
             // deal base class
             for (int index = 0; index < class_temp->mBaseClasses.size(); ++index)
@@ -80,6 +80,19 @@ namespace Generator
         return 0;
     }
 
+    void SerializerGenerator::AddCachedSchema(std::string path, const std::vector<SchemaClass>& classes)
+    {
+        for (auto& class_temp : classes)
+        {
+            Mustache::data class_def;
+            GenClassRenderData(class_temp, class_def);
+            mClassDefines.push_back(class_def);
+        }
+
+        mIncludeHeadFiles.push_back(
+            Mustache::data("headfile_name", Utils::MakeRelativePath(mRootPath, ProcessFileName(path)).string()));
+    }
+
     void SerializerGenerator::Finish()
     {
         Mustache::data mustache_data;
@@ -11,6 +11,7 @@ namespace Generator
         SerializerGenerator(std::string sourceDirectory, std::function<std::string(std::string)> getIncludeFunc);
 
         virtual int Generate(std::string path, SchemaMoudle schema) override;
+        virtual void AddCachedSchema(std::string path, const std::vector<SchemaClass>& classes) override;
         virtual void Finish() override;
 
         virtual ~SerializerGenerator() override;
@@ -52,6 +52,23 @@ std::string Class::GetClassName(void)
     return mName;
 }
 
+SchemaClass Class::GetSchemaClass(void) const
+{
+    SchemaClass schema_class;
+    schema_class.name = mName;
+    for (auto& base_class : mBaseClasses)
+    {
+        schema_class.base_classes.emplace_back(base_class->mName);
+    }
+    for (auto& field : mFields)
+    {
+        if (!field->ShouldCompile())
+            continue;
+        schema_class.fields.push_back({field->mName, field->mType, field->mDisplayName});
+    }
+    return schema_class;
+}
+
 bool Class::IsAccessible(void) const
 {
     return mbEnabled;
@@ -26,6 +26,7 @@ public:
     using SharedPtrVector = std::vector<std::shared_ptr<T>>;
 
     std::string GetClassName(void);
+    SchemaClass GetSchemaClass(void) const;
     bool IsAccessible(void) const;
 
 public:
@@ -246,7 +246,7 @@ namespace Utils
         return template_stream.str();
     }
 
-    void SaveFile(const std::string &outputString, const std::string &outputFile)
+    bool SaveFile(const std::string &outputString, const std::string &outputFile)
     {
         fs::path out_path(outputFile);
 
@@ -254,12 +254,26 @@ namespace Utils
         {
             fs::create_directories(out_path.parent_path());
         }
+
+        // leave identical files untouched so their timestamps don't trigger recompiles
+        std::ifstream existing_file_stream(outputFile);
+        if (existing_file_stream.is_open())
+        {
+            std::string existing_string((std::istreambuf_iterator<char>(existing_file_stream)), std::istreambuf_iterator<char>());
+            existing_file_stream.close();
+            if (existing_string.size() == outputString.size() + 1 && existing_string.back() == '\n' &&
+                existing_string.compare(0, outputString.size(), outputString) == 0)
+            {
+                return false;
+            }
+        }
+
         std::fstream output_file_stream(outputFile, std::ios_base::out);
 
         output_file_stream << outputString << std::endl;
         output_file_stream.flush();
         output_file_stream.close();
-        return;
+        return true;
     }
 
     void ReplaceAll(std::string &resourceStr, std::string subStr, std::string newStr)
@@ -29,7 +29,7 @@ namespace Utils
     std::string Join(std::vector<std::string> context_list, std::string separator);
     std::string Trim(std::string& sourceString, const std::string trimChars);
     std::string LoadFile(std::string path);
-    void SaveFile(const std::string& outputString, const std::string& outputFile);
+    bool SaveFile(const std::string& outputString, const std::string& outputFile);
     void ReplaceAll(std::string& resourceStr, std::string subStr, std::string newStr);
     unsigned long FormatPathString(const std::string& pathString, std::string& outString);
 
@@ -6,7 +6,7 @@
 
 #include "Parser.hpp"
 
-#define RECURSE_NAMESPACES(kind, cursor, method, namespaces) \
+#define RECURSE_NAMESPACES(kind, cursor, method, namespaces, schema) \
     { \
         if (kind == CXCursor_Namespace) \
         { \
@@ -14,44 +14,41 @@
             if (!display_name.empty()) \
             { \
                 namespaces.emplace_back(display_name); \
-                method(cursor, namespaces); \
+                method(cursor, namespaces, schema); \
                 namespaces.pop_back(); \
             } \
         } \
     }
 
-#define TRY_ADD_LANGUAGE_TYPE(handle, container) \
+#define TRY_ADD_LANGUAGE_TYPE(handle, container, schema) \
     { \
         if (handle->ShouldCompile()) \
         { \
-            auto file = handle->GetSourceFile(); \
-            mSchemaModules[file].container.emplace_back(handle); \
-            mTypeTable[handle->mDisplayName] = file; \
+            schema.container.emplace_back(handle); \
         } \
     }
 
 MetaParser::MetaParser(
-    const std::string projectInputFile, 
-    const std::string includeFilePath, 
-    const std::string includePath, 
-    const std::string includeSys, 
+    const std::string projectInputFile,
+    const std::string includeFilePath,
+    const std::string includePath,
+    const std::string includeSys,
     const std::string moduleName, bool isShowErrors)
     : mProjectInputFile(projectInputFile)
     , mSrcIncludeFileName(includeFilePath)
-    , mIndex(nullptr)
-    , mTranslationUnit(nullptr)
     , mSysInclude(includeSys)
     , mModuleName(moduleName)
     , mbIsShowErrors(isShowErrors)
 {
     mWorkPaths = Utils::Split(includePath, ";");
+    mCacheFile = mWorkPaths[0] + "/Generated/ParserCache.txt";
 
     mGenerators.emplace_back(new Generator::SerializerGenerator(
-        mWorkPaths[0], 
+        mWorkPaths[0],
         std::bind(&MetaParser::getIncludeFile, this, std::placeholders::_1))
     );
     mGenerators.emplace_back(new Generator::ReflectionGenerator(
-        mWorkPaths[0], 
+        mWorkPaths[0],
         std::bind(&MetaParser::getIncludeFile, this, std::placeholders::_1))
     );
 }
@@ -64,11 +61,16 @@ MetaParser::~MetaParser(void)
     }
     mGenerators.clear();
 
-    if (mTranslationUnit)
-        clang_disposeTranslationUnit(mTranslationUnit);
+    for (auto& parsed_header : mParsedHeaders)
+    {
+        if (parsed_header.second.translation_unit)
+            clang_disposeTranslationUnit(parsed_header.second.translation_unit);
+    }
 
-    if (mIndex)
-        clang_disposeIndex(mIndex);
+    for (auto& index : mIndices)
+    {
+        clang_disposeIndex(index);
+    }
 }
 
 void MetaParser::Prepare(void)
@@ -92,9 +94,6 @@ int MetaParser::Parse(void)
         return -1;
     }
 
-    std::cerr << "Parsing the whole project..." << std::endl;
-    int is_show_errors      = mbIsShowErrors ? 1 : 0;
-    mIndex                 = clang_createIndex(true, is_show_errors);
     std::string pre_include = "-I";
     std::string sys_include_temp;
     if (!(mSysInclude == "*"))
@@ -111,38 +110,144 @@ int MetaParser::Parse(void)
         arguments.emplace_back(paths[index].c_str());
     }
 
-    fs::path input_path(mSrcIncludeFileName);
-    if (!fs::exists(input_path))
+    mConfigHash = computeConfigHash();
+    if (!mCache.Load(mCacheFile, mConfigHash))
     {
-        std::cerr << input_path << " is not exist" << std::endl;
-        return -2;
+        std::cerr << "Parser cache is missing or out of date, parsing all headers" << std::endl;
     }
 
-    mTranslationUnit = clang_createTranslationUnitFromSourceFile(
-        mIndex, mSrcIncludeFileName.c_str(), static_cast<int>(arguments.size()), arguments.data(), 0, nullptr);
-    auto cursor = clang_getTranslationUnitCursor(mTranslationUnit);
+    // generated code of unchanged headers looks up other types, remember where they were declared
+    std::unordered_map<std::string, std::string> cached_type_table;
+    for (auto& header : mCache.GetHeaders())
+    {
+        for (auto& type : header.second.types)
+        {
+            cached_type_table[type] = header.first;
+        }
+    }
 
-    Namespace temp_namespace;
+    std::vector<std::string> changed_headers;
+    for (auto& header : mHeaderFiles)
+    {
+        const HeaderCache* header_cache = mCache.Find(header);
+        bool up_to_date = header_cache != nullptr &&
+                          mCache.ComputeHash(header, header_cache->dependencies) == header_cache->hash;
+        if (up_to_date && !header_cache->types.empty())
+        {
+            for (auto& generator_iter : mGenerators)
+            {
+                up_to_date = up_to_date && generator_iter->HasGeneratedFile(header);
+            }
+        }
+
+        if (!up_to_date)
+        {
+            changed_headers.emplace_back(header);
+        }
+    }
 
-    buildClassAST(cursor, temp_namespace);
+    std::cerr << "Parsing " << changed_headers.size() << " of " << mHeaderFiles.size() << " headers..." << std::endl;
+    parseHeaders(changed_headers);
 
-    temp_namespace.clear();
+    auto build_type_table = [this]() {
+        mTypeTable.clear();
+        for (auto& header : mHeaderFiles)
+        {
+            auto parsed_iter = mParsedHeaders.find(header);
+            if (parsed_iter != mParsedHeaders.end())
+            {
+                for (auto& class_temp : parsed_iter->second.schema.classes)
+                {
+                    mTypeTable[class_temp->mDisplayName] = header;
+                }
+            }
+            else if (const HeaderCache* header_cache = mCache.Find(header))
+            {
+                for (auto& type : header_cache->types)
+                {
+                    mTypeTable[type] = header;
+                }
+            }
+        }
+    };
+    build_type_table();
+
+    if (mTypeTable != cached_type_table && mParsedHeaders.size() < mHeaderFiles.size())
+    {
+        std::cerr << "Reflected types were added or moved, parsing the remaining headers..." << std::endl;
+
+        std::vector<std::string> remaining_headers;
+        for (auto& header : mHeaderFiles)
+        {
+            if (mParsedHeaders.find(header) == mParsedHeaders.end())
+            {
+                remaining_headers.emplace_back(header);
+            }
+        }
+        parseHeaders(remaining_headers);
+        build_type_table();
+    }
+
+    for (auto& parsed_header : mParsedHeaders)
+    {
+        // headers that failed to parse stay out of the cache and are tried again next time
+        if (parsed_header.second.translation_unit == nullptr)
+            continue;
+
+        HeaderCache header_cache;
+        header_cache.dependencies = parsed_header.second.dependencies;
+        header_cache.hash         = mCache.ComputeHash(parsed_header.first, header_cache.dependencies);
+        for (auto& class_temp : parsed_header.second.schema.classes)
+        {
+            header_cache.types.emplace_back(class_temp->mDisplayName);
+            if (class_temp->ShouldCompileFields())
+            {
+                header_cache.classes.emplace_back(class_temp->GetSchemaClass());
+            }
+        }
+        mCache.Set(parsed_header.first, std::move(header_cache));
+    }
+    mCache.Prune(mHeaderFiles);
 
     return 0;
 }
 
 void MetaParser::GenerateFiles(void)
 {
-    std::cerr << "Start generate runtime schemas(" << mSchemaModules.size() << ")..." << std::endl;
-    for (auto& schema : mSchemaModules)
+    std::cerr << "Start generate runtime schemas(" << mParsedHeaders.size() << " parsed, "
+              << mHeaderFiles.size() - mParsedHeaders.size() << " cached)..." << std::endl;
+
+    // walk the headers in a fixed order so the combined files only change when their content does
+    for (auto& header : mHeaderFiles)
     {
-        for (auto& generator_iter : mGenerators)
+        auto parsed_iter = mParsedHeaders.find(header);
+        if (parsed_iter != mParsedHeaders.end())
+        {
+            if (parsed_iter->second.schema.classes.empty())
+                continue;
+
+            for (auto& generator_iter : mGenerators)
+            {
+                generator_iter->Generate(header, parsed_iter->second.schema);
+            }
+        }
+        else
         {
-            generator_iter->Generate(schema.first, schema.second);
+            const HeaderCache* header_cache = mCache.Find(header);
+            if (header_cache == nullptr || header_cache->types.empty())
+                continue;
+
+            for (auto& generator_iter : mGenerators)
+            {
+                generator_iter->AddCachedSchema(header, header_cache->classes);
+            }
         }
     }
 
     Finish();
+
+    // written last so an interrupted run is parsed again
+    mCache.Save(mCacheFile, mConfigHash);
 }
 
 bool MetaParser::parseProject(void)
@@ -163,15 +268,28 @@ bool MetaParser::parseProject(void)
 
     std::string context = buffer.str();
 
-    auto         inlcude_files = Utils::Split(context, ";");
-    std::fstream include_file;
-
-    include_file.open(mSrcIncludeFileName, std::ios::out);
-    if (!include_file.is_open())
+    // precompile.json joins the runtime and editor header lists with a comma
+    mHeaderFiles.clear();
+    for (auto& include_list : Utils::Split(context, ";"))
     {
-        std::cout << "Could not open the Source Include file: " << mSrcIncludeFileName << std::endl;
-        return false;
+        for (auto& include_item : Utils::Split(include_list, ","))
+        {
+            std::string temp_string(include_item);
+            Utils::Trim(temp_string, " \t\r\n\"");
+            Utils::Replace(temp_string, '\\', '/');
+            if (temp_string.empty())
+                continue;
+
+            if (!fs::exists(temp_string))
+            {
+                std::cout << "Skipping missing header: " << temp_string << std::endl;
+                continue;
+            }
+            mHeaderFiles.emplace_back(temp_string);
+        }
     }
+    std::sort(mHeaderFiles.begin(), mHeaderFiles.end());
+    mHeaderFiles.erase(std::unique(mHeaderFiles.begin(), mHeaderFiles.end()), mHeaderFiles.end());
 
     std::cout << "Generating the Source Include file: " << mSrcIncludeFileName << std::endl;
 
@@ -187,25 +305,141 @@ bool MetaParser::parseProject(void)
         Utils::Replace(output_filename, " ", "_");
         Utils::ToUpper(output_filename);
     }
+
+    std::ostringstream include_file;
     include_file << "#ifndef __" << output_filename << "__" << std::endl;
     include_file << "#define __" << output_filename << "__" << std::endl;
 
-    for (auto include_item : inlcude_files)
+    for (auto& include_item : mHeaderFiles)
     {
-        std::string temp_string(include_item);
-        Utils::Replace(temp_string, '\\', '/');
-        include_file << "#include  \"" << temp_string << "\"" << std::endl;
+        include_file << "#include  \"" << include_item << "\"" << std::endl;
     }
 
-    include_file << "#endif" << std::endl;
-    include_file.close();
+    include_file << "#endif";
+    Utils::SaveFile(include_file.str(), mSrcIncludeFileName);
     return result;
 }
 
-void MetaParser::buildClassAST(const Cursor &cursor, Namespace &currentNamespace)
+uint64_t MetaParser::computeConfigHash(void) const
+{
+    uint64_t hash = ParserCache::HashString(mModuleName);
+    for (auto argument : arguments)
+    {
+        hash = ParserCache::HashString(argument, hash);
+    }
+
+    // changed templates have to regenerate every header
+    auto&                              template_pool = TemplateManager::GetInstance()->GetTemplates();
+    std::map<std::string, std::string> templates(template_pool.begin(), template_pool.end());
+    for (auto& template_item : templates)
+    {
+        hash = ParserCache::HashString(template_item.first, hash);
+        hash = ParserCache::HashString(template_item.second, hash);
+    }
+    return hash;
+}
+
+void MetaParser::parseHeaders(const std::vector<std::string>& headers)
+{
+    if (headers.empty())
+        return;
+
+    size_t thread_count = std::max(1u, std::thread::hardware_concurrency());
+    thread_count        = std::min(thread_count, headers.size());
+
+    // libclang may be used from several threads as long as each of them has its own index
+    int is_show_errors = mbIsShowErrors ? 1 : 0;
+    std::vector<CXIndex> indices;
+    for (size_t thread_index = 0; thread_index < thread_count; ++thread_index)
+    {
+        indices.emplace_back(clang_createIndex(true, is_show_errors));
+    }
+    mIndices.insert(mIndices.end(), indices.begin(), indices.end());
+
+    std::vector<HeaderParseResult> results(headers.size());
+    std::atomic<size_t>            next_header {0};
+    std::vector<std::thread>       workers;
+    for (size_t thread_index = 0; thread_index < thread_count; ++thread_index)
+    {
+        workers.emplace_back([&, index = indices[thread_index]]() {
+            for (size_t header_index = next_header++; header_index < headers.size(); header_index = next_header++)
+            {
+                parseHeader(index, headers[header_index], results[header_index]);
+            }
+        });
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    for (size_t header_index = 0; header_index < headers.size(); ++header_index)
+    {
+        mParsedHeaders[headers[header_index]] = std::move(results[header_index]);
+    }
+}
+
+void MetaParser::parseHeader(CXIndex index, const std::string& header, HeaderParseResult& result) const
+{
+    result.translation_unit = clang_createTranslationUnitFromSourceFile(
+        index, header.c_str(), static_cast<int>(arguments.size()), arguments.data(), 0, nullptr);
+    if (result.translation_unit == nullptr)
+    {
+        std::cerr << "Could not parse " << header << std::endl;
+        return;
+    }
+
+    // only project headers are tracked, system headers are not expected to change between runs
+    struct InclusionData
+    {
+        std::vector<std::string> work_paths;
+        std::set<std::string>    files;
+    } inclusion_data {mWorkPaths, {}};
+    for (auto& work_path : inclusion_data.work_paths)
+    {
+        Utils::Replace(work_path, '\\', '/');
+    }
+
+    clang_getInclusions(
+        result.translation_unit,
+        [](CXFile includedFile, CXSourceLocation*, unsigned includeLength, CXClientData clientData) {
+            // the header itself comes with an empty include stack
+            if (includeLength == 0)
+                return;
+
+            auto*       data = static_cast<InclusionData*>(clientData);
+            std::string file_name;
+            Utils::ToString(clang_getFileName(includedFile), file_name);
+            Utils::Replace(file_name, '\\', '/');
+            for (auto& work_path : data->work_paths)
+            {
+                if (file_name.compare(0, work_path.size(), work_path) == 0)
+                {
+                    data->files.insert(file_name);
+                    break;
+                }
+            }
+        },
+        &inclusion_data);
+    result.dependencies.assign(inclusion_data.files.begin(), inclusion_data.files.end());
+
+    auto cursor = clang_getTranslationUnitCursor(result.translation_unit);
+
+    Namespace temp_namespace;
+
+    buildClassAST(cursor, temp_namespace, result.schema);
+
+    temp_namespace.clear();
+}
+
+void MetaParser::buildClassAST(const Cursor &cursor, Namespace &currentNamespace, SchemaMoudle &schema) const
 {
     for (auto& child : cursor.GetChildren())
     {
+        // types of included headers belong to the translation units of those headers
+        if (!child.IsFromMainFile())
+            continue;
+
         auto kind = child.GetKind();
 
         // actual definition and a class or struct
@@ -213,11 +447,11 @@ void MetaParser::buildClassAST(const Cursor &cursor, Namespace &currentNamespace
         {
             auto class_ptr = std::make_shared<Class>(child, currentNamespace);
 
-            TRY_ADD_LANGUAGE_TYPE(class_ptr, classes);
+            TRY_ADD_LANGUAGE_TYPE(class_ptr, classes, schema);
         }
         else
         {
-            RECURSE_NAMESPACES(kind, child, buildClassAST, currentNamespace);
+            RECURSE_NAMESPACES(kind, child, buildClassAST, currentNamespace, schema);
         }
     }
 }
@@ -9,6 +9,8 @@
 #include "Generator/Generator.hpp"
 #include "TemplateManager/TemplateManager.hpp"
 
+#include "ParserCache.hpp"
+
 class Class;
 
 class MetaParser
@@ -30,8 +32,18 @@ public:
     void GenerateFiles(void);
 
 private:
+    struct HeaderParseResult
+    {
+        CXTranslationUnit        translation_unit {nullptr};
+        SchemaMoudle             schema;
+        std::vector<std::string> dependencies;
+    };
+
     bool        parseProject(void);
-    void        buildClassAST(const Cursor& cursor, Namespace& currentNamespace);
+    uint64_t    computeConfigHash(void) const;
+    void        parseHeaders(const std::vector<std::string>& headers);
+    void        parseHeader(CXIndex index, const std::string& header, HeaderParseResult& result) const;
+    void        buildClassAST(const Cursor& cursor, Namespace& currentNamespace, SchemaMoudle& schema) const;
     std::string getIncludeFile(std::string name);
 
 private:
@@ -42,11 +54,16 @@ private:
     std::string              mSysInclude;
     std::string              mSrcIncludeFileName;
 
-    CXIndex           mIndex;
-    CXTranslationUnit mTranslationUnit;
+    // every header is parsed as its own translation unit so unchanged ones can be skipped
+    std::vector<std::string>                 mHeaderFiles;
+    std::vector<CXIndex>                     mIndices;
+    std::map<std::string, HeaderParseResult> mParsedHeaders;
+
+    ParserCache mCache;
+    std::string mCacheFile;
+    uint64_t    mConfigHash {0};
 
-    std::unordered_map<std::string, std::string>  mTypeTable;
-    std::unordered_map<std::string, SchemaMoudle> mSchemaModules;
+    std::unordered_map<std::string, std::string> mTypeTable;
 
     std::vector<const char*> arguments = {
         {"-x",
@@ -0,0 +1,195 @@
+#include "Common/PreCompiled.hpp"
+
+#include "ParserCache.hpp"
+
+namespace
+{
+    // bump when the cached data or the generated code changes in a way the templates don't show
+    const std::string s_parser_cache_version = "1";
+
+    uint64_t hashBytes(const char* data, size_t size, uint64_t hash)
+    {
+        // fnv-1a
+        for (size_t index = 0; index < size; ++index)
+        {
+            hash ^= static_cast<unsigned char>(data[index]);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    std::vector<std::string> splitLine(const std::string& line)
+    {
+        std::vector<std::string> items;
+        std::stringstream        line_stream(line);
+        std::string              item;
+        while (std::getline(line_stream, item, '\t'))
+        {
+            items.emplace_back(item);
+        }
+        return items;
+    }
+} // namespace
+
+bool ParserCache::Load(const std::string& cacheFile, uint64_t configHash)
+{
+    mHeaders.clear();
+
+    std::ifstream cache_file(cacheFile);
+    if (!cache_file.is_open())
+    {
+        return false;
+    }
+
+    std::string line;
+    if (!std::getline(cache_file, line) ||
+        line != "ParserCache\t" + s_parser_cache_version + "\t" + std::to_string(configHash))
+    {
+        return false;
+    }
+
+    HeaderCache* header_cache = nullptr;
+    while (std::getline(cache_file, line))
+    {
+        auto items = splitLine(line);
+        if (items.empty())
+            continue;
+
+        if (items[0] == "header" && items.size() == 3)
+        {
+            header_cache       = &mHeaders[items[1]];
+            header_cache->hash = std::stoull(items[2]);
+        }
+        else if (header_cache == nullptr)
+        {
+            continue;
+        }
+        else if (items[0] == "dependency" && items.size() == 2)
+        {
+            header_cache->dependencies.emplace_back(items[1]);
+        }
+        else if (items[0] == "type" && items.size() == 2)
+        {
+            header_cache->types.emplace_back(items[1]);
+        }
+        else if (items[0] == "class" && items.size() == 2)
+        {
+            header_cache->classes.emplace_back();
+            header_cache->classes.back().name = items[1];
+        }
+        else if (items[0] == "base" && items.size() == 2 && !header_cache->classes.empty())
+        {
+            header_cache->classes.back().base_classes.emplace_back(items[1]);
+        }
+        else if (items[0] == "field" && items.size() == 4 && !header_cache->classes.empty())
+        {
+            header_cache->classes.back().fields.push_back({items[1], items[2], items[3]});
+        }
+        else
+        {
+            std::cerr << "Invalid parser cache " << cacheFile << ", parsing all headers" << std::endl;
+            mHeaders.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+void ParserCache::Save(const std::string& cacheFile, uint64_t configHash) const
+{
+    std::ostringstream cache_stream;
+    cache_stream << "ParserCache\t" << s_parser_cache_version << "\t" << configHash;
+    for (auto& header : mHeaders)
+    {
+        cache_stream << "\nheader\t" << header.first << "\t" << header.second.hash;
+        for (auto& dependency : header.second.dependencies)
+        {
+            cache_stream << "\ndependency\t" << dependency;
+        }
+        for (auto& type : header.second.types)
+        {
+            cache_stream << "\ntype\t" << type;
+        }
+        for (auto& schema_class : header.second.classes)
+        {
+            cache_stream << "\nclass\t" << schema_class.name;
+            for (auto& base_class : schema_class.base_classes)
+            {
+                cache_stream << "\nbase\t" << base_class;
+            }
+            for (auto& field : schema_class.fields)
+            {
+                cache_stream << "\nfield\t" << field.name << "\t" << field.type << "\t" << field.display_name;
+            }
+        }
+    }
+    Utils::SaveFile(cache_stream.str(), cacheFile);
+}
+
+const HeaderCache* ParserCache::Find(const std::string& header) const
+{
+    auto iter = mHeaders.find(header);
+    return iter == mHeaders.end() ? nullptr : &iter->second;
+}
+
+void ParserCache::Set(const std::string& header, HeaderCache cache)
+{
+    mHeaders[header] = std::move(cache);
+}
+
+void ParserCache::Prune(const std::vector<std::string>& headers)
+{
+    std::set<std::string> header_set(headers.begin(), headers.end());
+    for (auto iter = mHeaders.begin(); iter != mHeaders.end();)
+    {
+        if (header_set.find(iter->first) == header_set.end())
+            iter = mHeaders.erase(iter);
+        else
+            ++iter;
+    }
+}
+
+uint64_t ParserCache::ComputeHash(const std::string& header, const std::vector<std::string>& dependencies)
+{
+    uint64_t hash = getFileHash(header);
+    if (hash == 0)
+    {
+        return 0;
+    }
+    for (auto& dependency : dependencies)
+    {
+        uint64_t dependency_hash = getFileHash(dependency);
+        if (dependency_hash == 0)
+        {
+            return 0;
+        }
+        hash = HashString(dependency, hash);
+        hash = hashBytes(reinterpret_cast<const char*>(&dependency_hash), sizeof(dependency_hash), hash);
+    }
+    return hash;
+}
+
+uint64_t ParserCache::HashString(const std::string& input, uint64_t hash)
+{
+    return hashBytes(input.data(), input.size(), hash);
+}
+
+uint64_t ParserCache::getFileHash(const std::string& path)
+{
+    // headers are shared by many translation units, read each of them once per run
+    auto iter = mFileHashes.find(path);
+    if (iter != mFileHashes.end())
+    {
+        return iter->second;
+    }
+
+    uint64_t      hash = 0;
+    std::ifstream file(path, std::ios::binary);
+    if (file.is_open())
+    {
+        std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        hash = HashString(content);
+    }
+    mFileHashes.emplace(path, hash);
+    return hash;
+}
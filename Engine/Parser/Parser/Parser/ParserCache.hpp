@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Common/PreCompiled.hpp"
+#include "Common/SchemaModule.hpp"
+
+// what the parser needs to know about a header without parsing it again
+struct HeaderCache
+{
+    // content hash of the header and the project headers it includes
+    uint64_t                 hash {0};
+    std::vector<std::string> dependencies;
+    // display names of the reflected types, for the type table
+    std::vector<std::string> types;
+    // classes with reflected fields, for the generators
+    std::vector<SchemaClass> classes;
+};
+
+class ParserCache
+{
+public:
+    // drops the old entries when the cache was written with a different configuration
+    bool Load(const std::string& cacheFile, uint64_t configHash);
+    void Save(const std::string& cacheFile, uint64_t configHash) const;
+
+    const HeaderCache* Find(const std::string& header) const;
+    void               Set(const std::string& header, HeaderCache cache);
+    // removes headers that are no longer part of the project
+    void               Prune(const std::vector<std::string>& headers);
+
+    const std::map<std::string, HeaderCache>& GetHeaders() const { return mHeaders; }
+
+    // zero when the header or one of its dependencies is missing
+    uint64_t ComputeHash(const std::string& header, const std::vector<std::string>& dependencies);
+
+    static uint64_t HashString(const std::string& input, uint64_t hash = s_hash_seed);
+
+private:
+    uint64_t getFileHash(const std::string& path);
+
+    static const uint64_t s_hash_seed = 14695981039346656037ull;
+
+    std::map<std::string, HeaderCache>        mHeaders;
+    std::unordered_map<std::string, uint64_t> mFileHashes;
+};
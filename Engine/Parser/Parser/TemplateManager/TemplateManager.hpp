@@ -16,6 +16,8 @@ public:
 
     std::string RenderByTemplate(std::string templateName, Mustache::data& templateData);
 
+    const std::unordered_map<std::string, std::string>& GetTemplates() const { return mTemplatePool; }
+
 private:
     TemplateManager() {}
     TemplateManager(const TemplateManager&);
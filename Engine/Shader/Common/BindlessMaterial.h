@@ -0,0 +1,33 @@
+// needs GL_EXT_nonuniform_qualifier, the material index may differ between the invocations of a draw
+
+// mirrors VulkanBindlessMaterial
+struct BindlessMaterial
+{
+    highp vec4  baseColorFactor;
+    highp float metallicFactor;
+    highp float roughnessFactor;
+    highp float normalScale;
+    highp float occlusionStrength;
+    highp vec3  emissiveFactor;
+    highp uint  isBlend;
+    highp uint  isDoubleSided;
+    highp uint  baseColorTextureIndex;
+    highp uint  metallicRoughnessTextureIndex;
+    highp uint  normalTextureIndex;
+    highp uint  occlusionTextureIndex;
+    highp uint  emissiveTextureIndex;
+    highp uint  _padding_texture_index_1;
+    highp uint  _padding_texture_index_2;
+};
+
+layout(set = 2, binding = 0) readonly buffer _bindless_materials
+{
+    BindlessMaterial bindlessMaterials[MAX_BINDLESS_MATERIAL_COUNT];
+};
+
+layout(set = 2, binding = 1) uniform sampler2D bindlessTextures[];
+
+highp vec4 SampleBindlessTexture(highp uint textureIndex, highp vec2 texcoord)
+{
+    return texture(bindlessTextures[nonuniformEXT(textureIndex)], texcoord);
+}
@@ -0,0 +1,28 @@
+// mirrors VulkanMeshVertexDecode, the identity for float streams
+struct VulkanMeshVertexDecode
+{
+    highp vec3 positionScale;
+    highp uint enableVertexQuantization;
+    highp vec3 positionOffset;
+    highp float _padding_position_offset;
+};
+
+// the quantized position is unorm within the mesh bounds
+highp vec3 DecodeMeshPosition(VulkanMeshVertexDecode decode, highp vec3 inPosition)
+{
+    return decode.positionOffset + inPosition * decode.positionScale;
+}
+
+highp vec3 DecodeOctahedron(highp vec2 encoded)
+{
+    highp vec3 direction = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+    highp float fold     = max(-direction.z, 0.0);
+    direction.xy += mix(vec2(fold), vec2(-fold), greaterThanEqual(direction.xy, vec2(0.0)));
+    return normalize(direction);
+}
+
+// quantized normals and tangents arrive as the two octahedral snorm components, z is filled with 0
+highp vec3 DecodeMeshDirection(VulkanMeshVertexDecode decode, highp vec3 inDirection)
+{
+    return decode.enableVertexQuantization != 0U ? DecodeOctahedron(inDirection.xy) : inDirection;
+}
@@ -1,7 +1,7 @@
 struct VulkanMeshInstance
 {
     highp float bEnableVertexBlending;
-    highp float _padding_enable_vertex_blending_1;
+    highp uint  materialIndex;
     highp float _padding_enable_vertex_blending_2;
     highp float _padding_enable_vertex_blending_3;
     highp mat4  modelMatrix;
@@ -0,0 +1,96 @@
+#include "MRuntime/Core/Base/Marco.hpp"
+#include "MRuntime/Function/Global/GlobalContext.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using namespace MiniEngine;
+
+// the log lines go to stdout, run with stdout redirected to keep the console out of the numbers:
+//   BenchmarkLog > /dev/null
+namespace
+{
+    uint32_t const s_call_count = 200000;
+    // fits into a binary log ring, the log thread gets time to drain it between bursts
+    uint32_t const s_burst_size = 512;
+
+    template<typename TFUNC>
+    double measureNanosecondsPerCall(TFUNC&& func)
+    {
+        auto begin = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < s_call_count; ++i)
+        {
+            func(i);
+        }
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - begin).count() / s_call_count;
+    }
+
+    // the cost a frame pays for a burst of messages, without waiting for the sink
+    template<typename TFUNC>
+    double measureBurstNanosecondsPerCall(TFUNC&& func)
+    {
+        double   nanoseconds = 0.0;
+        uint32_t call_index  = 0;
+        while (call_index < s_call_count)
+        {
+            auto begin = std::chrono::steady_clock::now();
+            for (uint32_t i = 0; i < s_burst_size; ++i)
+            {
+                func(call_index++);
+            }
+            auto end = std::chrono::steady_clock::now();
+            nanoseconds += std::chrono::duration<double, std::nano>(end - begin).count();
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return nanoseconds / call_index;
+    }
+
+    void logFrame(uint32_t i) { LOG_INFO("frame {} took {} ms on {}", i, 16.6f + i * 0.001f, "render thread"); }
+
+    void report(const char* name, double nanoseconds_per_call) { std::fprintf(stderr, "%-28s %8.1f ns/call\n", name, nanoseconds_per_call); }
+} // namespace
+
+int main()
+{
+    gRuntimeGlobalContext.mLoggerSystem = std::make_shared<LogSystem>();
+    LogSystem& log_system               = *gRuntimeGlobalContext.mLoggerSystem;
+
+    // below the level only the ShouldLog check runs
+    log_system.SetLevel(LogSystem::LogLevel::Warning);
+    report("filtered", measureNanosecondsPerCall(logFrame));
+
+    log_system.SetLevel(LogSystem::LogLevel::Debug);
+    report("formatted", measureNanosecondsPerCall(logFrame));
+    report("formatted, bursts", measureBurstNanosecondsPerCall(logFrame));
+
+    // sustained logging is bound by the sink, full rings are drained by their writers
+    log_system.SetBinaryMode(true);
+    report("binary", measureNanosecondsPerCall(logFrame));
+    report("binary, bursts", measureBurstNanosecondsPerCall(logFrame));
+
+    // every thread writes its own ring, the rings are freed once the threads are gone
+    for (uint32_t thread_count : {2u, 4u})
+    {
+        std::vector<double>      results(thread_count);
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < thread_count; ++t)
+        {
+            threads.emplace_back([&results, t]() { results[t] = measureBurstNanosecondsPerCall(logFrame); });
+        }
+        double sum = 0.0;
+        for (uint32_t t = 0; t < thread_count; ++t)
+        {
+            threads[t].join();
+            sum += results[t];
+        }
+        char name[64];
+        std::snprintf(name, sizeof(name), "binary, bursts, %u threads", thread_count);
+        report(name, sum / thread_count);
+    }
+
+    gRuntimeGlobalContext.mLoggerSystem.reset();
+    return 0;
+}
@@ -0,0 +1,211 @@
+#include "MRuntime/Function/Render/Interface/Vulkan/VulkanRHI.hpp"
+#include "MRuntime/Function/Render/Interface/Vulkan/VulkanRHIResource.hpp"
+#include "MRuntime/Core/Memory/HeapStats.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+using namespace MiniEngine;
+
+// records the commands of a mesh draw through the rhi into sinks instead of a driver, so only the translation
+// of the rhi arrays into vulkan ones is measured. the std::vector version is how the wrappers translated before
+namespace
+{
+#if !defined(MINIENGINE_HEAP_STATS)
+    std::atomic<uint64_t> g_heap_allocation_count {0};
+#endif
+
+    // the engine counts allocations itself when it is built with MINIENGINE_HEAP_STATS
+    uint64_t heapAllocationCount()
+    {
+#if defined(MINIENGINE_HEAP_STATS)
+        return GetHeapAllocationCount();
+#else
+        return g_heap_allocation_count.load(std::memory_order_relaxed);
+#endif
+    }
+
+    uint32_t const s_draw_count = 2000000;
+    uint32_t const s_run_count  = 5;
+
+    // the sinks read the arrays, so the translation can't be optimized away
+    uint64_t g_sink_value = 0;
+
+    void VKAPI_CALL sinkBindVertexBuffers(VkCommandBuffer, uint32_t, uint32_t binding_count, const VkBuffer* buffers, const VkDeviceSize* offsets)
+    {
+        for (uint32_t i = 0; i < binding_count; ++i)
+        {
+            g_sink_value += reinterpret_cast<uintptr_t>(buffers[i]) + offsets[i];
+        }
+    }
+
+    void VKAPI_CALL sinkBindDescriptorSets(VkCommandBuffer,
+                                           VkPipelineBindPoint,
+                                           VkPipelineLayout,
+                                           uint32_t,
+                                           uint32_t               set_count,
+                                           const VkDescriptorSet* sets,
+                                           uint32_t               offset_count,
+                                           const uint32_t*        offsets)
+    {
+        for (uint32_t i = 0; i < set_count; ++i)
+        {
+            g_sink_value += reinterpret_cast<uintptr_t>(sets[i]);
+        }
+        for (uint32_t i = 0; i < offset_count; ++i)
+        {
+            g_sink_value += offsets[i];
+        }
+    }
+
+    void VKAPI_CALL sinkDrawIndexed(VkCommandBuffer, uint32_t index_count, uint32_t instance_count, uint32_t, int32_t, uint32_t)
+    {
+        g_sink_value += index_count + instance_count;
+    }
+
+    struct DrawResources
+    {
+        VulkanCommandBuffer  command_buffer;
+        VulkanPipelineLayout pipeline_layout;
+        VulkanBuffer         vertex_buffers[3];
+        VulkanDescriptorSet  descriptor_sets[2];
+
+        RHIBuffer*              vertex_buffer_list[3];
+        RHIDeviceSize           vertex_offsets[3] {0, 0, 0};
+        const RHIDescriptorSet* descriptor_set_list[2];
+        uint32_t                dynamic_offsets[3] {0, 256, 512};
+    };
+
+    template<typename T>
+    T fakeHandle(uintptr_t value)
+    {
+        return reinterpret_cast<T>(value);
+    }
+
+    void initializeResources(DrawResources& resources)
+    {
+        resources.command_buffer.SetResource(fakeHandle<VkCommandBuffer>(0x1000));
+        resources.pipeline_layout.SetResource(fakeHandle<VkPipelineLayout>(0x2000));
+        for (uint32_t i = 0; i < 3; ++i)
+        {
+            resources.vertex_buffers[i].SetResource(fakeHandle<VkBuffer>(0x3000 + i * 0x100));
+            resources.vertex_buffer_list[i] = &resources.vertex_buffers[i];
+        }
+        for (uint32_t i = 0; i < 2; ++i)
+        {
+            resources.descriptor_sets[i].SetResource(fakeHandle<VkDescriptorSet>(0x4000 + i * 0x100));
+            resources.descriptor_set_list[i] = &resources.descriptor_sets[i];
+        }
+    }
+
+    void recordDraw(VulkanRHI& rhi, DrawResources& resources, uint32_t draw_index)
+    {
+        resources.dynamic_offsets[0] = draw_index * 256;
+        rhi.CmdBindVertexBuffersPFN(&resources.command_buffer, 0, 3, resources.vertex_buffer_list, resources.vertex_offsets);
+        rhi.CmdBindDescriptorSetsPFN(&resources.command_buffer,
+                                     RHI_PIPELINE_BIND_POINT_GRAPHICS,
+                                     &resources.pipeline_layout,
+                                     0,
+                                     2,
+                                     resources.descriptor_set_list,
+                                     3,
+                                     resources.dynamic_offsets);
+        rhi.CmdDrawIndexed(&resources.command_buffer, 36, 1, 0, 0, 0);
+    }
+
+    void recordDrawWithVectors(DrawResources& resources, uint32_t draw_index)
+    {
+        resources.dynamic_offsets[0] = draw_index * 256;
+        VkCommandBuffer command_buffer = resources.command_buffer.GetResource();
+
+        std::vector<VkBuffer>     vk_buffer_list(3);
+        std::vector<VkDeviceSize> vk_device_size_list(3);
+        for (uint32_t i = 0; i < 3; ++i)
+        {
+            vk_buffer_list[i]      = static_cast<VulkanBuffer*>(resources.vertex_buffer_list[i])->GetResource();
+            vk_device_size_list[i] = resources.vertex_offsets[i];
+        }
+        sinkBindVertexBuffers(command_buffer, 0, 3, vk_buffer_list.data(), vk_device_size_list.data());
+
+        std::vector<VkDescriptorSet> vk_descriptor_set_list(2);
+        std::vector<uint32_t>        vk_offset_list(3);
+        for (uint32_t i = 0; i < 2; ++i)
+        {
+            vk_descriptor_set_list[i] = ((VulkanDescriptorSet*)resources.descriptor_set_list[i])->GetResource();
+        }
+        for (uint32_t i = 0; i < 3; ++i)
+        {
+            vk_offset_list[i] = resources.dynamic_offsets[i];
+        }
+        sinkBindDescriptorSets(command_buffer,
+                               VK_PIPELINE_BIND_POINT_GRAPHICS,
+                               resources.pipeline_layout.GetResource(),
+                               0,
+                               2,
+                               vk_descriptor_set_list.data(),
+                               3,
+                               vk_offset_list.data());
+        sinkDrawIndexed(command_buffer, 36, 1, 0, 0, 0);
+    }
+
+    template<typename TFUNC>
+    void report(const char* name, TFUNC&& record)
+    {
+        double   best_nanoseconds = 0.0;
+        uint64_t allocation_count = 0;
+        for (uint32_t run = 0; run < s_run_count; ++run)
+        {
+            uint64_t allocations_before = heapAllocationCount();
+            auto     begin              = std::chrono::steady_clock::now();
+            for (uint32_t i = 0; i < s_draw_count; ++i)
+            {
+                record(i);
+            }
+            auto   end         = std::chrono::steady_clock::now();
+            double nanoseconds = std::chrono::duration<double, std::nano>(end - begin).count() / s_draw_count;
+            best_nanoseconds   = run == 0 ? nanoseconds : std::min(best_nanoseconds, nanoseconds);
+            allocation_count   = heapAllocationCount() - allocations_before;
+        }
+        std::printf("%-24s %7.1f ns per draw, %.1f heap allocations per draw\n",
+                    name,
+                    best_nanoseconds,
+                    static_cast<double>(allocation_count) / s_draw_count);
+    }
+} // namespace
+
+#if !defined(MINIENGINE_HEAP_STATS)
+void* operator new(size_t size)
+{
+    g_heap_allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size == 0 ? 1 : size))
+    {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, size_t) noexcept { std::free(pointer); }
+#endif
+
+int main()
+{
+    // only the function pointers are set, the rhi is never initialized
+    VulkanRHI rhi;
+    rhi.pfnVkCmdBindVertexBuffers  = sinkBindVertexBuffers;
+    rhi.pfnVkCmdBindDescriptorSets = sinkBindDescriptorSets;
+    rhi.pfnVkCmdDrawIndexed        = sinkDrawIndexed;
+
+    DrawResources resources;
+    initializeResources(resources);
+
+    report("std::vector translation", [&resources](uint32_t i) { recordDrawWithVectors(resources, i); });
+    report("rhi translation", [&rhi, &resources](uint32_t i) { recordDraw(rhi, resources, i); });
+
+    std::printf("sink value %llu\n", static_cast<unsigned long long>(g_sink_value));
+    return 0;
+}
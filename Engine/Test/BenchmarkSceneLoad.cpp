@@ -0,0 +1,177 @@
+#include "MRuntime/Core/Base/ThreadPool.hpp"
+#include "MRuntime/Core/Log/LogSystem.hpp"
+#include "MRuntime/Core/Meta/Reflection/ReflectionRegister.hpp"
+#include "MRuntime/Function/Framework/Scene/Scene.hpp"
+#include "MRuntime/Function/Global/GlobalContext.hpp"
+#include "MRuntime/Resource/AssetManager/AssetManager.hpp"
+#include "MRuntime/Resource/ConfigManager/ConfigManager.hpp"
+
+#include <json11.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+using namespace MiniEngine;
+using json11::Json;
+
+// loads a generated scene of 50k objects through Scene::Load with 1 to N workers, the loading thread runs batches
+// as well. every object instances its own transform and shares one of 32 definitions with a transform and a mesh
+// component of four sub meshes
+namespace
+{
+    uint32_t const s_object_count     = 50000;
+    uint32_t const s_definition_count = 32;
+    uint32_t const s_material_count   = 8;
+    uint32_t const s_sub_mesh_count   = 4;
+    uint32_t const s_run_count        = 3;
+
+    const char* const s_scene_url = "Asset/Benchmark/Benchmark.scene.json";
+
+    // the reflection serializer names json keys after the fields, with a leading m_ removed
+    Json vector3Json(float x, float y, float z) { return Json::object {{"x", x}, {"y", y}, {"z", z}}; }
+
+    Json transformJson(float x, float y, float z)
+    {
+        return Json::object {{"position", vector3Json(x, y, z)},
+                             {"scale", vector3Json(1.0f, 1.0f, 1.0f)},
+                             {"rotation", Json::object {{"w", 1.0f}, {"x", 0.0f}, {"y", 0.0f}, {"z", 0.0f}}}};
+    }
+
+    Json componentJson(const char* type_name, Json context)
+    {
+        return Json::object {{"$typeName", type_name}, {"$context", std::move(context)}};
+    }
+
+    void writeJson(const std::filesystem::path& path, const Json& json)
+    {
+        std::filesystem::create_directories(path.parent_path());
+        std::ofstream(path) << json.dump();
+    }
+
+    void writeAssets(const std::filesystem::path& root_folder)
+    {
+        for (uint32_t material_index = 0; material_index < s_material_count; ++material_index)
+        {
+            writeJson(root_folder / ("Asset/Benchmark/Material" + std::to_string(material_index) + ".material.json"),
+                      Json::object {{"mBaseColorTextureFile", "Textures/default/albedo.jpg"},
+                                    {"mMetallicRoughnessTextureFile", "Textures/default/mr.jpg"},
+                                    {"mNormalTextureFile", "Textures/default/normal.jpg"},
+                                    {"mOcclusionTextureFile", ""},
+                                    {"mEmissiveTextureFile", ""}});
+        }
+
+        for (uint32_t definition_index = 0; definition_index < s_definition_count; ++definition_index)
+        {
+            Json::array sub_meshes;
+            for (uint32_t sub_mesh_index = 0; sub_mesh_index < s_sub_mesh_count; ++sub_mesh_index)
+            {
+                uint32_t material_index = (definition_index + sub_mesh_index) % s_material_count;
+                sub_meshes.push_back(Json::object {
+                    {"mObjectFileRef", "Asset/Benchmark/Mesh" + std::to_string(definition_index) + ".obj"},
+                    {"mTransform", transformJson(0.0f, 0.0f, static_cast<float>(sub_mesh_index))},
+                    {"mMaterial", "Asset/Benchmark/Material" + std::to_string(material_index) + ".material.json"}});
+            }
+
+            Json::array components {
+                componentJson("TransformComponent", Json::object {{"mTransform", transformJson(0.0f, 0.0f, 0.0f)}}),
+                componentJson("MeshComponent", Json::object {{"mMeshRes", Json::object {{"mSubMeshes", sub_meshes}}}})};
+            writeJson(root_folder / ("Asset/Benchmark/Object" + std::to_string(definition_index) + ".object.json"),
+                      Json::object {{"mComponents", components}});
+        }
+
+        Json::array objects;
+        objects.reserve(s_object_count);
+        for (uint32_t object_index = 0; object_index < s_object_count; ++object_index)
+        {
+            float       x = static_cast<float>(object_index % 256);
+            float       y = static_cast<float>(object_index / 256);
+            Json::array instanced_components {
+                componentJson("TransformComponent", Json::object {{"mTransform", transformJson(x, y, 0.0f)}})};
+            objects.push_back(Json::object {
+                {"mName", "Object" + std::to_string(object_index)},
+                {"mDefinition", "Asset/Benchmark/Object" + std::to_string(object_index % s_definition_count) + ".object.json"},
+                {"mInstancedComponents", instanced_components}});
+        }
+        writeJson(root_folder / s_scene_url, Json::object {{"mObjects", objects}});
+    }
+
+    // cold load, the parsed definitions and materials are dropped before every run
+    double measureLoadMilliseconds(size_t& object_count)
+    {
+        double best_milliseconds = 0.0;
+        for (uint32_t run = 0; run < s_run_count; ++run)
+        {
+            gRuntimeGlobalContext.mAssetManager->ClearAssetCache();
+
+            Scene scene;
+            auto  begin = std::chrono::steady_clock::now();
+            scene.Load(s_scene_url);
+            auto  end   = std::chrono::steady_clock::now();
+
+            double milliseconds = std::chrono::duration<double, std::milli>(end - begin).count();
+            best_milliseconds   = run == 0 ? milliseconds : std::min(best_milliseconds, milliseconds);
+            object_count        = scene.GetAllGObjects().size();
+        }
+        return best_milliseconds;
+    }
+} // namespace
+
+int main()
+{
+    std::filesystem::path root_folder = std::filesystem::temp_directory_path() / "MiniEngineSceneLoadBenchmark";
+    std::filesystem::remove_all(root_folder);
+    std::filesystem::create_directories(root_folder);
+    std::ofstream(root_folder / "Benchmark.ini") << "BinaryRootFolder=.\nAssetFolder=Asset\nHotReload=0\n";
+    writeAssets(root_folder);
+
+    Reflection::TypeMetaRegister::MetaRegister();
+    gRuntimeGlobalContext.mConfigManager = std::make_shared<ConfigManager>();
+    gRuntimeGlobalContext.mConfigManager->Initialize(root_folder / "Benchmark.ini");
+    gRuntimeGlobalContext.mLoggerSystem = std::make_shared<LogSystem>();
+    gRuntimeGlobalContext.mLoggerSystem->SetLevel(LogSystem::LogLevel::Warning);
+    gRuntimeGlobalContext.mAssetManager = std::make_shared<AssetManager>();
+    gRuntimeGlobalContext.mAssetManager->Initialize();
+    gRuntimeGlobalContext.mThreadPool = std::make_shared<ThreadPool>();
+
+    std::vector<uint32_t> worker_counts = {1, 2, 4, 8};
+    uint32_t const        hardware_count = std::thread::hardware_concurrency();
+    if (hardware_count > worker_counts.back())
+    {
+        worker_counts.push_back(hardware_count);
+    }
+
+    std::printf("%u objects, %u hardware threads\n", s_object_count, hardware_count);
+    double single_worker_milliseconds = 0.0;
+    for (uint32_t worker_count : worker_counts)
+    {
+        gRuntimeGlobalContext.mThreadPool->Clear();
+        gRuntimeGlobalContext.mThreadPool->Initialize(worker_count);
+
+        size_t object_count = 0;
+        double milliseconds = measureLoadMilliseconds(object_count);
+        if (worker_count == 1)
+        {
+            single_worker_milliseconds = milliseconds;
+        }
+        std::printf("%2u workers: %8.1f ms, %.2fx, %zu objects loaded\n",
+                    worker_count,
+                    milliseconds,
+                    single_worker_milliseconds / milliseconds,
+                    object_count);
+    }
+
+    gRuntimeGlobalContext.mThreadPool->Clear();
+    gRuntimeGlobalContext.mThreadPool.reset();
+    gRuntimeGlobalContext.mAssetManager->Clear();
+    gRuntimeGlobalContext.mAssetManager.reset();
+    gRuntimeGlobalContext.mLoggerSystem.reset();
+    gRuntimeGlobalContext.mConfigManager.reset();
+    Reflection::TypeMetaRegister::MetaUnregister();
+    std::filesystem::remove_all(root_folder);
+    return 0;
+}
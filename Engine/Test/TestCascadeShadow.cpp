@@ -0,0 +1,165 @@
+#include "TestCommon.hpp"
+
+#include "MRuntime/Function/Render/RenderCamera.hpp"
+#include "MRuntime/Function/Render/RenderHelper.hpp"
+
+#include <cfloat>
+
+using namespace MiniEngine;
+
+namespace
+{
+    uint32_t const s_shadow_map_dimension = 2048;
+
+    BoundingBox emptyBoundingBox()
+    {
+        BoundingBox bounding_box;
+        bounding_box.mMinBound = Vector3(FLT_MAX, FLT_MAX, FLT_MAX);
+        bounding_box.mMaxBound = Vector3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+        return bounding_box;
+    }
+
+    void setupCamera(RenderCamera& camera, const Vector3& position, const Vector3& target)
+    {
+        camera.mZNear = 0.1f;
+        camera.mZFar  = 1000.0f;
+        camera.SetAspect(16.0f / 9.0f);
+        camera.LookAt(position, target, Vector3::UNIT_Z);
+    }
+
+    void testSplits()
+    {
+        float const z_near = 0.1f;
+        float const z_far  = 100.0f;
+        float       split_far[4];
+
+        // lambda 1 is the logarithmic scheme, every cascade covers the same depth ratio
+        CalculateCascadeSplits(z_near, z_far, 4, 1.0f, split_far);
+        float split_near = z_near;
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            TEST_CHECK_NEAR(split_far[i] / split_near, std::pow(z_far / z_near, 0.25f), 1e-3f);
+            split_near = split_far[i];
+        }
+
+        // lambda 0 is the uniform scheme
+        CalculateCascadeSplits(z_near, z_far, 4, 0.0f, split_far);
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            TEST_CHECK_NEAR(split_far[i], z_near + (z_far - z_near) * (i + 1) / 4.0f, 1e-4f);
+        }
+
+        // blended splits lie between the two and the last one ends exactly at the shadow distance
+        float log_split_far[4];
+        float uniform_split_far[4];
+        CalculateCascadeSplits(z_near, z_far, 4, 1.0f, log_split_far);
+        CalculateCascadeSplits(z_near, z_far, 4, 0.0f, uniform_split_far);
+        CalculateCascadeSplits(z_near, z_far, 4, 0.75f, split_far);
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            TEST_CHECK(split_far[i] >= log_split_far[i] - 1e-4f && split_far[i] <= uniform_split_far[i] + 1e-4f);
+            TEST_CHECK(i == 0 || split_far[i] > split_far[i - 1]);
+        }
+        TEST_CHECK(split_far[3] == z_far);
+
+        CalculateCascadeSplits(z_near, z_far, 1, 0.75f, split_far);
+        TEST_CHECK(split_far[0] == z_far);
+    }
+
+    void testContainment()
+    {
+        Vector3 const positions[] = {Vector3(0.0f, 0.0f, 2.0f), Vector3(37.5f, -12.25f, 8.0f), Vector3(-500.0f, 250.0f, 40.0f)};
+        Vector3 const directions[] = {Vector3(0.0f, 1.0f, 0.0f), Vector3(1.0f, 1.0f, -0.5f), Vector3(-0.3f, 0.2f, -1.0f)};
+        Vector3 const light_directions[] = {
+            Vector3(0.0f, 0.0f, -1.0f), Vector3(0.5f, 0.3f, -0.8f), Vector3(1.0f, 0.0f, -0.1f)};
+
+        BoundingBox scene_bounding_box = emptyBoundingBox();
+        scene_bounding_box.Merge(Vector3(-100.0f, -100.0f, -10.0f));
+        scene_bounding_box.Merge(Vector3(100.0f, 100.0f, 50.0f));
+
+        for (const Vector3& position : positions)
+        {
+            for (const Vector3& direction : directions)
+            {
+                RenderCamera camera;
+                setupCamera(camera, position, position + direction);
+
+                float split_far[4];
+                CalculateCascadeSplits(camera.mZNear, 150.0f, 4, 0.75f, split_far);
+                for (const Vector3& light_direction : light_directions)
+                {
+                    for (uint32_t cascade_index = 0; cascade_index < 4; ++cascade_index)
+                    {
+                        float     split_near = cascade_index == 0 ? camera.mZNear : split_far[cascade_index - 1];
+                        Matrix4x4 cascade_proj_view =
+                            CalculateDirectionalLightCascadeCamera(camera,
+                                                                   light_direction.NormalizedCopy(),
+                                                                   scene_bounding_box,
+                                                                   split_near,
+                                                                   split_far[cascade_index],
+                                                                   s_shadow_map_dimension);
+                        TEST_CHECK(CascadeContainsFrustumSlice(camera, cascade_proj_view, split_near, split_far[cascade_index]));
+                    }
+                }
+            }
+        }
+    }
+
+    void testSnapping()
+    {
+        Vector3 const light_direction = Vector3(0.5f, 0.3f, -0.8f).NormalizedCopy();
+        BoundingBox   scene_bounding_box = emptyBoundingBox();
+
+        RenderCamera camera;
+        setupCamera(camera, Vector3(3.0f, 4.0f, 2.0f), Vector3(3.0f, 5.0f, 2.0f));
+        Matrix4x4 reference = CalculateDirectionalLightCascadeCamera(
+            camera, light_direction, scene_bounding_box, 10.0f, 40.0f, s_shadow_map_dimension);
+
+        // clip space spans two units, a texel is 2 / dimension of it
+        float const texel_clip_size = 2.0f / static_cast<float>(s_shadow_map_dimension);
+        for (uint32_t step = 1; step <= 64; ++step)
+        {
+            // moving the camera only shifts the projection by whole texels
+            Vector3 offset(0.013f * step, -0.007f * step, 0.002f * step);
+            setupCamera(camera, Vector3(3.0f, 4.0f, 2.0f) + offset, Vector3(3.0f, 5.0f, 2.0f) + offset);
+            Matrix4x4 moved = CalculateDirectionalLightCascadeCamera(
+                camera, light_direction, scene_bounding_box, 10.0f, 40.0f, s_shadow_map_dimension);
+
+            for (size_t row = 0; row < 2; ++row)
+            {
+                for (size_t column = 0; column < 3; ++column)
+                {
+                    TEST_CHECK_NEAR(moved[row][column], reference[row][column], 1e-6f);
+                }
+                float texel_shift = (moved[row][3] - reference[row][3]) / texel_clip_size;
+                TEST_CHECK_NEAR(texel_shift, std::round(texel_shift), 1e-2f);
+            }
+        }
+
+        // rotating the camera in place keeps the texel size, only the bounding sphere decides it
+        for (uint32_t step = 0; step < 16; ++step)
+        {
+            float angle = 0.4f * step;
+            setupCamera(camera,
+                        Vector3(3.0f, 4.0f, 2.0f),
+                        Vector3(3.0f + std::cos(angle), 4.0f + std::sin(angle), 2.0f - 0.1f * step));
+            Matrix4x4 rotated = CalculateDirectionalLightCascadeCamera(
+                camera, light_direction, scene_bounding_box, 10.0f, 40.0f, s_shadow_map_dimension);
+            for (size_t row = 0; row < 2; ++row)
+            {
+                for (size_t column = 0; column < 3; ++column)
+                {
+                    TEST_CHECK_NEAR(rotated[row][column], reference[row][column], 1e-6f);
+                }
+            }
+        }
+    }
+} // namespace
+
+int main()
+{
+    testSplits();
+    testContainment();
+    testSnapping();
+    return TestResult("TestCascadeShadow");
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+
+namespace MiniEngine
+{
+    // failed checks are counted and reported, the test keeps running to show every failure at once
+    inline int gTestFailureCount = 0;
+
+    inline int TestResult(const char* test_name)
+    {
+        if (gTestFailureCount == 0)
+        {
+            std::printf("%s passed\n", test_name);
+            return 0;
+        }
+        std::printf("%s failed %d checks\n", test_name, gTestFailureCount);
+        return 1;
+    }
+} // namespace MiniEngine
+
+#define TEST_CHECK(condition) \
+    do \
+    { \
+        if (!(condition)) \
+        { \
+            std::printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            ++::MiniEngine::gTestFailureCount; \
+        } \
+    } while (false)
+
+#define TEST_CHECK_NEAR(value, expected, tolerance) \
+    do \
+    { \
+        double test_value_    = static_cast<double>(value); \
+        double test_expected_ = static_cast<double>(expected); \
+        if (!(std::fabs(test_value_ - test_expected_) <= static_cast<double>(tolerance))) \
+        { \
+            std::printf("%s:%d: check failed: %s = %g, expected %g +- %g\n", \
+                        __FILE__, \
+                        __LINE__, \
+                        #value, \
+                        test_value_, \
+                        test_expected_, \
+                        static_cast<double>(tolerance)); \
+            ++::MiniEngine::gTestFailureCount; \
+        } \
+    } while (false)
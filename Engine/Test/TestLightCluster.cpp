@@ -0,0 +1,211 @@
+#include "TestCommon.hpp"
+
+#include "MRuntime/Core/Base/ThreadPool.hpp"
+#include "MRuntime/Function/Render/LightCluster.hpp"
+
+#include <algorithm>
+#include <random>
+
+using namespace MiniEngine;
+
+namespace
+{
+    // same cluster lookup as the shader, UINT32_MAX outside of the grid
+    uint32_t findCluster(const LightClusterBuilder& builder, const LightClusterBuildInfo& build_info, const Vector3& view_position)
+    {
+        float depth = -view_position.z;
+        if (depth <= build_info.z_near || depth >= build_info.z_far)
+        {
+            return UINT32_MAX;
+        }
+
+        float ndc_x = build_info.proj_scale_x * view_position.x / depth;
+        float ndc_y = build_info.proj_scale_y * view_position.y / depth;
+        if (std::abs(ndc_x) >= 1.0f || std::abs(ndc_y) >= 1.0f)
+        {
+            return UINT32_MAX;
+        }
+
+        uint32_t x = std::min(static_cast<uint32_t>((ndc_x * 0.5f + 0.5f) * s_light_cluster_dimension_x), s_light_cluster_dimension_x - 1);
+        uint32_t y = std::min(static_cast<uint32_t>((ndc_y * 0.5f + 0.5f) * s_light_cluster_dimension_y), s_light_cluster_dimension_y - 1);
+        uint32_t z = static_cast<uint32_t>(std::clamp(std::floor(std::log(depth) * builder.GetZSliceScale() - builder.GetZSliceBias()),
+                                                      0.0f,
+                                                      static_cast<float>(s_light_cluster_dimension_z - 1)));
+        return (z * s_light_cluster_dimension_y + y) * s_light_cluster_dimension_x + x;
+    }
+
+    bool clusterListsLight(const LightClusterBuilder& builder, uint32_t cluster_index, uint32_t light_index)
+    {
+        const std::vector<uint32_t>& grid    = builder.GetClusterGrid();
+        const std::vector<uint32_t>& indices = builder.GetLightIndices();
+        auto                         begin   = indices.begin() + grid[cluster_index * 2 + 0];
+        auto                         end     = begin + grid[cluster_index * 2 + 1];
+        return std::find(begin, end, light_index) != end;
+    }
+
+    std::vector<PointLight> makeLights(uint32_t light_count, uint32_t seed)
+    {
+        std::mt19937                          random(seed);
+        std::uniform_real_distribution<float> horizontal(-150.0f, 150.0f);
+        std::uniform_real_distribution<float> depth(-260.0f, 5.0f);
+        std::uniform_real_distribution<float> flux(20.0f, 3000.0f);
+
+        std::vector<PointLight> lights(light_count);
+        for (PointLight& light : lights)
+        {
+            light.mPosition = Vector3(horizontal(random), horizontal(random) * 0.5f, depth(random));
+            float light_flux = flux(random);
+            light.mFlux      = Vector3(light_flux, light_flux * 0.8f, light_flux * 0.6f);
+        }
+        return lights;
+    }
+
+    LightClusterBuildInfo makeBuildInfo()
+    {
+        // vulkan style projection, y is flipped
+        float const tan_half_fov_x = std::tan(0.5f * 1.4f);
+        float const aspect         = 16.0f / 9.0f;
+
+        LightClusterBuildInfo build_info;
+        build_info.view_matrix  = Matrix4x4::IDENTITY;
+        build_info.proj_scale_x = 1.0f / tan_half_fov_x;
+        build_info.proj_scale_y = -aspect / tan_half_fov_x;
+        build_info.z_near       = 0.1f;
+        build_info.z_far        = 250.0f;
+        return build_info;
+    }
+
+    // every point of a light sphere that falls into the grid must find the light in its cluster
+    void testAgainstBruteForce(const LightClusterBuilder&     builder,
+                               const LightClusterBuildInfo&   build_info,
+                               const std::vector<PointLight>& lights)
+    {
+        std::mt19937                          random(7);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+        uint32_t sampled_point_count = 0;
+        uint32_t missing_count       = 0;
+        for (uint32_t light_index = 0; light_index < lights.size(); ++light_index)
+        {
+            const PointLight& light  = lights[light_index];
+            float             radius = light.CalculateRadius() * 0.999f;
+
+            std::vector<Vector3> offsets = {Vector3::ZERO,
+                                            Vector3(radius, 0.0f, 0.0f),
+                                            Vector3(-radius, 0.0f, 0.0f),
+                                            Vector3(0.0f, radius, 0.0f),
+                                            Vector3(0.0f, -radius, 0.0f),
+                                            Vector3(0.0f, 0.0f, radius),
+                                            Vector3(0.0f, 0.0f, -radius)};
+            while (offsets.size() < 64)
+            {
+                Vector3 offset(unit(random), unit(random), unit(random));
+                if (offset.SquaredLength() <= 1.0f)
+                {
+                    offsets.push_back(offset * radius);
+                }
+            }
+
+            for (const Vector3& offset : offsets)
+            {
+                uint32_t cluster_index = findCluster(builder, build_info, light.mPosition + offset);
+                if (cluster_index == UINT32_MAX)
+                {
+                    continue;
+                }
+                ++sampled_point_count;
+                if (!clusterListsLight(builder, cluster_index, light_index))
+                {
+                    ++missing_count;
+                }
+            }
+        }
+
+        TEST_CHECK(sampled_point_count > lights.size());
+        TEST_CHECK(missing_count == 0);
+    }
+
+    // a listed light has to reach into the depth slice of the cluster
+    void testNoDistantLights(const LightClusterBuilder& builder, const std::vector<PointLight>& lights)
+    {
+        uint32_t const tile_count = s_light_cluster_dimension_x * s_light_cluster_dimension_y;
+        const std::vector<uint32_t>& grid    = builder.GetClusterGrid();
+        const std::vector<uint32_t>& indices = builder.GetLightIndices();
+
+        uint32_t far_away_count = 0;
+        for (uint32_t cluster_index = 0; cluster_index < s_light_cluster_count; ++cluster_index)
+        {
+            uint32_t slice      = cluster_index / tile_count;
+            float    slice_near = std::exp((slice + builder.GetZSliceBias()) / builder.GetZSliceScale());
+            float    slice_far  = std::exp((slice + 1 + builder.GetZSliceBias()) / builder.GetZSliceScale());
+
+            for (uint32_t i = 0; i < grid[cluster_index * 2 + 1]; ++i)
+            {
+                const PointLight& light  = lights[indices[grid[cluster_index * 2 + 0] + i]];
+                float             depth  = -light.mPosition.z;
+                float             radius = light.CalculateRadius();
+                if (depth + radius < slice_near * 0.999f || depth - radius > slice_far * 1.001f)
+                {
+                    ++far_away_count;
+                }
+            }
+        }
+        TEST_CHECK(far_away_count == 0);
+    }
+
+    // the render scene hands its light list to the builder, every light in view must end up in the clusters
+    void testSceneLightsReachClusters(const LightClusterBuildInfo& build_info, ThreadPool* thread_pool)
+    {
+        PointLightList point_light_list;
+        point_light_list.mLights.push_back({Vector3(0.0f, 0.0f, -3.0f), Vector3(120.0f, 100.0f, 80.0f)});
+        point_light_list.mLights.push_back({Vector3(-4.0f, 1.0f, -20.0f), Vector3(80.0f, 100.0f, 120.0f)});
+        point_light_list.mLights.push_back({Vector3(10.0f, -2.0f, -90.0f), Vector3(2000.0f, 2000.0f, 2000.0f)});
+
+        LightClusterBuilder builder;
+        builder.Build(point_light_list.mLights, build_info, thread_pool);
+
+        TEST_CHECK(builder.GetPointLights().size() == point_light_list.mLights.size());
+        TEST_CHECK(builder.GetLightIndices().size() >= point_light_list.mLights.size());
+        for (uint32_t light_index = 0; light_index < point_light_list.mLights.size(); ++light_index)
+        {
+            uint32_t cluster_index = findCluster(builder, build_info, point_light_list.mLights[light_index].mPosition);
+            TEST_CHECK(cluster_index != UINT32_MAX);
+            if (cluster_index != UINT32_MAX)
+            {
+                TEST_CHECK(clusterListsLight(builder, cluster_index, light_index));
+            }
+        }
+    }
+} // namespace
+
+int main()
+{
+    ThreadPool thread_pool;
+    thread_pool.Initialize(4);
+
+    LightClusterBuildInfo build_info = makeBuildInfo();
+
+    for (uint32_t light_count : {1u, 64u, 1000u, s_max_clustered_point_light_count})
+    {
+        std::vector<PointLight> lights = makeLights(light_count, light_count);
+
+        LightClusterBuilder serial_builder;
+        serial_builder.Build(lights, build_info, nullptr);
+        LightClusterBuilder parallel_builder;
+        parallel_builder.Build(lights, build_info, &thread_pool);
+
+        // the parallel build fills the slices independently and merges them in order
+        TEST_CHECK(serial_builder.GetClusterGrid() == parallel_builder.GetClusterGrid());
+        TEST_CHECK(serial_builder.GetLightIndices() == parallel_builder.GetLightIndices());
+        // a truncated list would drop lights on purpose
+        TEST_CHECK(parallel_builder.GetLightIndices().size() < s_max_light_cluster_index_count);
+
+        testAgainstBruteForce(parallel_builder, build_info, lights);
+        testNoDistantLights(parallel_builder, lights);
+    }
+
+    testSceneLightsReachClusters(build_info, &thread_pool);
+
+    thread_pool.Clear();
+    return TestResult("TestLightCluster");
+}
@@ -0,0 +1,136 @@
+#include "TestCommon.hpp"
+
+#include "MRuntime/Core/Base/ThreadPool.hpp"
+
+#include <chrono>
+#include <stdexcept>
+
+using namespace MiniEngine;
+
+namespace
+{
+    void testCoverage(ThreadPool& thread_pool)
+    {
+        for (uint32_t count : {1u, 7u, 1000u, 100000u})
+        {
+            std::vector<std::atomic<uint32_t>> visits(count);
+            thread_pool.ParallelFor(count, 16, [&visits](uint32_t begin, uint32_t end) {
+                for (uint32_t i = begin; i < end; ++i)
+                {
+                    visits[i].fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+
+            uint32_t wrong_count = 0;
+            for (const std::atomic<uint32_t>& visit : visits)
+            {
+                wrong_count += visit.load() != 1 ? 1 : 0;
+            }
+            TEST_CHECK(wrong_count == 0);
+        }
+    }
+
+    void testNested(ThreadPool& thread_pool)
+    {
+        std::atomic<uint32_t> sum {0};
+        thread_pool.ParallelFor(64, 1, [&thread_pool, &sum](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i)
+            {
+                thread_pool.ParallelFor(100, 1, [&sum](uint32_t inner_begin, uint32_t inner_end) {
+                    sum.fetch_add(inner_end - inner_begin, std::memory_order_relaxed);
+                });
+            }
+        });
+        TEST_CHECK(sum.load() == 6400);
+    }
+
+    // the caller must not pick up a queued task that has nothing to do with its loop
+    void testCallerSkipsUnrelatedTasks(ThreadPool& thread_pool)
+    {
+        std::atomic<bool> release {false};
+        std::atomic<bool> unrelated_ran_on_caller {false};
+        std::atomic<uint32_t> blocked_worker_count {0};
+
+        // occupy every worker, then queue one more task behind them
+        for (uint32_t i = 0; i < thread_pool.GetThreadCount(); ++i)
+        {
+            thread_pool.Enqueue([&release, &blocked_worker_count]() {
+                blocked_worker_count.fetch_add(1);
+                while (!release.load())
+                {
+                    std::this_thread::yield();
+                }
+            });
+        }
+        std::thread::id caller_id = std::this_thread::get_id();
+        std::atomic<bool> unrelated_done {false};
+        thread_pool.Enqueue([&unrelated_ran_on_caller, &unrelated_done, caller_id]() {
+            unrelated_ran_on_caller.store(std::this_thread::get_id() == caller_id);
+            unrelated_done.store(true);
+        });
+        while (blocked_worker_count.load() != thread_pool.GetThreadCount())
+        {
+            std::this_thread::yield();
+        }
+
+        // all workers are busy, the caller has to finish the loop alone
+        std::atomic<uint32_t> sum {0};
+        thread_pool.ParallelFor(1000, 1, [&sum](uint32_t begin, uint32_t end) { sum.fetch_add(end - begin); });
+        TEST_CHECK(sum.load() == 1000);
+        TEST_CHECK(!unrelated_done.load());
+
+        release.store(true);
+        while (!unrelated_done.load())
+        {
+            std::this_thread::yield();
+        }
+        TEST_CHECK(!unrelated_ran_on_caller.load());
+    }
+
+    void testException(ThreadPool& thread_pool)
+    {
+        for (uint32_t throwing_batch : {0u, 3u})
+        {
+            std::atomic<uint32_t> started_batch_count {0};
+            bool                  caught = false;
+            try
+            {
+                thread_pool.ParallelFor(64, 1, [&started_batch_count, throwing_batch](uint32_t begin, uint32_t end) {
+                    started_batch_count.fetch_add(1);
+                    if (begin <= throwing_batch && throwing_batch < end)
+                    {
+                        throw std::runtime_error("batch failed");
+                    }
+                    std::this_thread::sleep_for(std::chrono::microseconds(100));
+                });
+            }
+            catch (const std::runtime_error&)
+            {
+                caught = true;
+            }
+            TEST_CHECK(caught);
+
+            // nothing runs after the call returned, the helpers may only touch their own job state
+            uint32_t started_after_return = started_batch_count.load();
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            TEST_CHECK(started_batch_count.load() == started_after_return);
+        }
+
+        // the pool is still usable
+        testCoverage(thread_pool);
+    }
+} // namespace
+
+int main()
+{
+    ThreadPool thread_pool;
+    thread_pool.Initialize(3);
+
+    testCoverage(thread_pool);
+    testNested(thread_pool);
+    testCallerSkipsUnrelatedTasks(thread_pool);
+    testException(thread_pool);
+
+    thread_pool.Clear();
+    return TestResult("TestThreadPool");
+}
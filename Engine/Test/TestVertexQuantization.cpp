@@ -0,0 +1,138 @@
+#include "TestCommon.hpp"
+
+#include "MRuntime/Function/Render/VertexQuantization.hpp"
+
+#include <algorithm>
+#include <random>
+
+using namespace MiniEngine;
+
+namespace
+{
+    uint32_t const s_sample_count = 1000000;
+
+    void testHalfFloat()
+    {
+        // every finite half survives the trip through float unchanged
+        uint32_t mismatch_count = 0;
+        for (uint32_t bits = 0; bits <= 0xffff; ++bits)
+        {
+            uint16_t half = static_cast<uint16_t>(bits);
+            if ((half & 0x7c00) == 0x7c00)
+            {
+                continue;
+            }
+            mismatch_count += FloatToHalf(HalfToFloat(half)) != half ? 1 : 0;
+        }
+        TEST_CHECK(mismatch_count == 0);
+
+        TEST_CHECK(FloatToHalf(1.0e6f) == 0x7bff);
+        TEST_CHECK(FloatToHalf(-1.0e6f) == 0xfbff);
+        TEST_CHECK(HalfToFloat(FloatToHalf(1.0f)) == 1.0f);
+
+        // texture coordinates, round to nearest costs at most half a step of 11 significant bits
+        std::mt19937                          random(1);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::uniform_real_distribution<float> tiled(-2.0f, 3.0f);
+        float                                 max_unit_error  = 0.0f;
+        float                                 max_tiled_error = 0.0f;
+        uint32_t                              out_of_bound    = 0;
+        for (uint32_t i = 0; i < s_sample_count; ++i)
+        {
+            float value = i % 2 == 0 ? unit(random) : tiled(random);
+            float error = std::fabs(HalfToFloat(FloatToHalf(value)) - value);
+            if (error > std::fabs(value) * std::ldexp(1.0f, -11) + 1e-7f)
+            {
+                ++out_of_bound;
+            }
+            float& max_error = i % 2 == 0 ? max_unit_error : max_tiled_error;
+            max_error        = std::max(max_error, error);
+        }
+        TEST_CHECK(out_of_bound == 0);
+        TEST_CHECK(max_unit_error <= 2.45e-4f);
+        TEST_CHECK(max_tiled_error <= 9.8e-4f);
+    }
+
+    void testNormalized()
+    {
+        std::mt19937                          random(2);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::uniform_real_distribution<float> signed_unit(-1.0f, 1.0f);
+
+        // positions are stored relative to the mesh bounds, half a step of the extent at most
+        float max_unorm_error = 0.0f;
+        float max_snorm_error = 0.0f;
+        for (uint32_t i = 0; i < s_sample_count; ++i)
+        {
+            float value     = unit(random);
+            max_unorm_error = std::max(max_unorm_error, std::fabs(DequantizeUnorm16(QuantizeUnorm16(value)) - value));
+            value           = signed_unit(random);
+            max_snorm_error = std::max(max_snorm_error, std::fabs(DequantizeSnorm16(QuantizeSnorm16(value)) - value));
+        }
+        TEST_CHECK(max_unorm_error <= 0.5f / 65535.0f + 1e-7f);
+        TEST_CHECK(max_snorm_error <= 0.5f / 32767.0f + 1e-7f);
+
+        TEST_CHECK(DequantizeUnorm16(QuantizeUnorm16(0.0f)) == 0.0f);
+        TEST_CHECK(DequantizeUnorm16(QuantizeUnorm16(1.0f)) == 1.0f);
+        TEST_CHECK(DequantizeSnorm16(QuantizeSnorm16(-1.0f)) == -1.0f);
+        TEST_CHECK(DequantizeSnorm16(QuantizeSnorm16(2.0f)) == 1.0f);
+    }
+
+    // acos of a float dot product can't resolve a few hundredths of a degree, atan2 in double can
+    float angleDegrees(const Vector3& a, const Vector3& b)
+    {
+        double cross_x = static_cast<double>(a.y) * b.z - static_cast<double>(a.z) * b.y;
+        double cross_y = static_cast<double>(a.z) * b.x - static_cast<double>(a.x) * b.z;
+        double cross_z = static_cast<double>(a.x) * b.y - static_cast<double>(a.y) * b.x;
+        double dot     = static_cast<double>(a.x) * b.x + static_cast<double>(a.y) * b.y + static_cast<double>(a.z) * b.z;
+        double angle   = std::atan2(std::sqrt(cross_x * cross_x + cross_y * cross_y + cross_z * cross_z), dot);
+        return static_cast<float>(angle * 180.0 / 3.14159265358979);
+    }
+
+    void testOctahedron()
+    {
+        std::mt19937                    random(3);
+        std::normal_distribution<float> normal(0.0f, 1.0f);
+        float                           max_angle = 0.0f;
+        double                          sum_angle = 0.0;
+        for (uint32_t i = 0; i < s_sample_count; ++i)
+        {
+            Vector3 direction(normal(random), normal(random), normal(random));
+            if (direction.SquaredLength() < 1e-6f)
+            {
+                continue;
+            }
+            direction.Normalize();
+
+            int16_t encoded[2];
+            EncodeOctahedron(direction, encoded);
+            float angle = angleDegrees(DecodeOctahedron(encoded), direction);
+            max_angle   = std::max(max_angle, angle);
+            sum_angle += angle;
+        }
+        TEST_CHECK(max_angle <= 0.01f);
+        TEST_CHECK(sum_angle / s_sample_count <= 0.003);
+
+        // the axes land exactly on a code
+        Vector3 const axes[] = {Vector3::UNIT_X,
+                                Vector3::NEGATIVE_UNIT_X,
+                                Vector3::UNIT_Y,
+                                Vector3::NEGATIVE_UNIT_Y,
+                                Vector3::UNIT_Z,
+                                Vector3::NEGATIVE_UNIT_Z};
+        for (const Vector3& axis : axes)
+        {
+            int16_t encoded[2];
+            EncodeOctahedron(axis, encoded);
+            TEST_CHECK(DecodeOctahedron(encoded) == axis);
+        }
+    }
+} // namespace
+
+int main()
+{
+    testHalfFloat();
+    testNormalized();
+    testOctahedron();
+    return TestResult("TestVertexQuantization");
+}